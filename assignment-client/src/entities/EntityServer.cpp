@@ -339,6 +339,26 @@ void EntityServer::readAdditionalConfiguration(const QJsonObject& settingsSectio
     tree->setWantEditLogging(wantEditLogging);
     tree->setWantTerseEditLogging(wantTerseEditLogging);
 
+    bool simulateOwnerlessEntities = false;
+    readOptionBool(QString("simulateOwnerlessEntities"), settingsSectionObject, simulateOwnerlessEntities);
+    qDebug("simulateOwnerlessEntities=%s", debug::valueOf(simulateOwnerlessEntities));
+    if (simulateOwnerlessEntities && !_serverSimulation) {
+        // the persist file hasn't been loaded yet, so the simulation can still be swapped out for free
+        _serverSimulation = ServerEntitySimulationPointer { new ServerEntitySimulation() };
+        _serverSimulation->setEntityTree(tree);
+        tree->setSimulation(_serverSimulation);
+        _entitySimulation = _serverSimulation;
+
+        auto nodeList = DependencyManager::get<NodeList>();
+        auto setSessionID = [this, tree](const QUuid& sessionID) {
+            tree->withWriteLock([&] {
+                _serverSimulation->setSessionID(sessionID);
+            });
+        };
+        connect(nodeList.data(), &LimitedNodeList::uuidChanged, this, setSessionID);
+        setSessionID(nodeList->getSessionUUID());
+    }
+
     QString entityScriptSourceWhitelist;
     if (readOptionString("entityScriptSourceWhitelist", settingsSectionObject, entityScriptSourceWhitelist)) {
         tree->setEntityScriptSourceWhitelist(entityScriptSourceWhitelist);
@@ -414,6 +434,13 @@ QString EntityServer::serverSubclassStats() {
     statsString += QString().sprintf("       EntityItem size... %ld bytes\r\n", sizeof(EntityItem));
     statsString += "\r\n\r\n";
 
+    if (_serverSimulation) {
+        statsString += "<b>Entity Server Simulation Statistics</b>\r\n";
+        statsString += QString().sprintf("Ownerless entities simulated... %d\r\n", _serverSimulation->getNumAdoptedEntities());
+        statsString += QString().sprintf("Entities around them......... %d\r\n", _serverSimulation->getNumEnvironmentEntities());
+        statsString += "\r\n\r\n";
+    }
+
     statsString += "<b>Entity Server Sending to Viewer Statistics</b>\r\n";
     statsString += "----- Viewer Node ID -----------------    ----- Entity ID ----------------------    "
                    "---------- Last Sent To ----------    ---------- Last Edited -----------\r\n";
@@ -455,6 +482,25 @@ QString EntityServer::serverSubclassStats() {
     }
     statsString += "\r\n\r\n";
 
+    statsString += "<b>Entity Edit Filter Statistics</b>\r\n";
+    statsString += "----- Zone ID ------------------------    ---------- Calls -------    --------- Skipped ------    "
+                   "------- Avg Usecs -------    ------- Max Usecs -------\r\n";
+    auto filterStats = DependencyManager::get<EntityEditFilters>()->getFilterStats();
+    for (auto itr = filterStats.constBegin(); itr != filterStats.constEnd(); ++itr) {
+        auto stats = itr.value().toObject();
+        statsString += itr.key().leftJustified(38, ' ');
+        statsString += "    ";
+        statsString += locale.toString(stats["calls"].toDouble()).rightJustified(COLUMN_WIDTH, ' ');
+        statsString += locale.toString(stats["skipped"].toDouble()).rightJustified(COLUMN_WIDTH + 4, ' ');
+        statsString += locale.toString(stats["avgUsecs"].toDouble(), 'f', 1).rightJustified(COLUMN_WIDTH + 4, ' ');
+        statsString += locale.toString(stats["maxUsecs"].toDouble()).rightJustified(COLUMN_WIDTH + 4, ' ');
+        statsString += "\r\n";
+    }
+    if (filterStats.isEmpty()) {
+        statsString += "    no filters... \r\n";
+    }
+    statsString += "\r\n\r\n";
+
     return statsString;
 }
 
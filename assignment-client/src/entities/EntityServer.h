@@ -18,6 +18,7 @@
 
 #include <EntityItem.h>
 #include <EntityTree.h>
+#include <ServerEntitySimulation.h>
 #include <SimpleEntitySimulation.h>
 
 #include "EntityServerConsts.h"
@@ -75,6 +76,7 @@ private slots:
 
 private:
     SimpleEntitySimulationPointer _entitySimulation;
+    ServerEntitySimulationPointer _serverSimulation;
     QTimer* _pruneDeletedEntitiesTimer = nullptr;
 
     QReadWriteLock _viewerSendingStatsLock;
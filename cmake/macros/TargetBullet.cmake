@@ -17,6 +17,8 @@ macro(TARGET_BULLET)
         list(APPEND BULLET_LIBRARIES ${LIB_DIR}/libBulletSoftBody.a)
     else()
         find_package(Bullet REQUIRED)
+        # our bullet is built with BULLET2_MULTITHREADING, the headers must agree
+        target_compile_definitions(${TARGET_NAME} PRIVATE BT_THREADSAFE=1)
    endif()
     # perform the system include hack for OS X to ignore warnings
     if (APPLE)
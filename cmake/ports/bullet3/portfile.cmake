@@ -1,4 +1,4 @@
-# Updated June 6th, 2019, to force new vckpg hash
+# Updated October 19th, 2019, to force new vckpg hash
 #
 # Common Ambient Variables:
 #
@@ -45,6 +45,7 @@ vcpkg_configure_cmake(
         -DBUILD_EXTRAS=OFF
         -DBUILD_UNIT_TESTS=OFF
         -DBUILD_SHARED_LIBS=ON
+        -DBULLET2_MULTITHREADING=ON
         -DINSTALL_LIBS=ON
 )
 
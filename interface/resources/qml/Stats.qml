@@ -131,6 +131,11 @@ Item {
                         visible: root.expanded
                         text: "Avatars NOT Updated: " + root.notUpdatedAvatarCount
                     }
+                    StatText {
+                        visible: root.expanded
+                        text: "Avatar Simulation: " + root.avatarSimulationTime.toFixed(2) + " ms (joints " +
+                            root.avatarJointSimulationTime.toFixed(2) + " ms on all threads)"
+                    }
                     StatText {
                         visible: root.expanded
                         text: "Total picks:\n    " +
@@ -2870,6 +2870,11 @@ Application::~Application() {
     // the _shapeManager should have zero references
     _shapeManager.collectGarbage();
     assert(_shapeManager.getNumShapes() == 0);
+    qCDebug(interfaceapp) << "Collision hull cache hits:" << _shapeManager.getNumHullCacheHits()
+        << "misses:" << _shapeManager.getNumHullCacheMisses();
+    auto hfmModelCache = DependencyManager::get<ModelCache>()->getHFMModelCache();
+    qCDebug(interfaceapp) << "Processed model cache hits:" << hfmModelCache->getNumHits()
+        << "misses:" << hfmModelCache->getNumMisses();
 
     // shutdown graphics engine
     _graphicsEngine.shutdown();
@@ -5556,8 +5561,16 @@ void Application::init() {
         return atan2(maxSize, distance);
     });
 
+    auto hullCache = std::make_shared<HullCache>();
+    hullCache->initialize();
+    _shapeManager.setHullCache(hullCache);
     ObjectMotionState::setShapeManager(&_shapeManager);
-    _physicsEngine->init();
+    int numPhysicsThreads = 1;
+    if (Menu::getInstance()->isOptionChecked(MenuOption::PhysicsMultithreaded)) {
+        // leave the rest of the worker pool to rendering and avatars
+        numPhysicsThreads = std::max(2, QThread::idealThreadCount() / 2);
+    }
+    _physicsEngine->init(numPhysicsThreads);
 
     EntityTreePointer tree = getEntities()->getTree();
     _entitySimulation->init(tree, _physicsEngine, &_entityEditSender);
@@ -6642,6 +6655,11 @@ void Application::update(float deltaTime) {
         _postUpdateLambdas.clear();
     }
 
+    {
+        PerformanceTimer perfTimer("blendPendingModels");
+        DependencyManager::get<ModelBlender>()->blendPendingModels();
+    }
+
 
     updateRenderArgs(deltaTime);
 
@@ -146,6 +146,7 @@ namespace MenuOption {
     const QString Overlays = "Show Overlays";
     const QString PackageModel = "Package Avatar as .fst...";
     const QString Pair = "Pair";
+    const QString PhysicsMultithreaded = "Multithreaded Physics (requires restart)";
     const QString PhysicsShowOwned = "Highlight Simulation Ownership";
     const QString VerboseLogging = "Verbose Logging";
     const QString PhysicsShowBulletWireframe = "Show Bullet Collision";
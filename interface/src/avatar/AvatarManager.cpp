@@ -11,9 +11,11 @@
 
 #include "AvatarManager.h"
 
+#include <atomic>
 #include <string>
 
 #include <QScriptEngine>
+#include <QThread>
 
 #include "AvatarLogging.h"
 
@@ -31,6 +33,7 @@
 #include <shared/QtHelpers.h>
 #include <AvatarData.h>
 #include <PerfStat.h>
+#include <TBBHelpers.h>
 #include <PrioritySortUtil.h>
 #include <RegisteredMetaTypes.h>
 #include <Rig.h>
@@ -52,6 +55,9 @@
 // in the update loop - this also results in ~30hz when in desktop mode which is essentially
 // what we want
 
+// number of other-avatar simulation jobs handed to each worker thread between two checks of the time budget
+const size_t AVATAR_SIMULATION_JOBS_PER_THREAD = 2;
+
 // We add _myAvatar into the hash with all the other AvatarData, and we use the default NULL QUid as the key.
 const QUuid MY_AVATAR_KEY;  // NULL key
 
@@ -296,6 +302,19 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
     render::Transaction renderTransaction;
     workload::Transaction workloadTransaction;
 
+    // Avatars are simulated in waves, in priority order. For each wave the main thread prepares every avatar,
+    // the rig evaluation, joint unpacking and skinning matrices run as one job per avatar on the worker pool,
+    // then the main thread applies the scene, workload and physics side effects. The time budget is checked
+    // between waves.
+    const size_t SIMULATION_WAVE_SIZE = (size_t)std::max(1, QThread::idealThreadCount()) * AVATAR_SIMULATION_JOBS_PER_THREAD;
+    struct SimulationJob {
+        std::shared_ptr<OtherAvatar> avatar;
+        bool inView;
+    };
+    std::vector<SimulationJob> wave;
+    wave.reserve(SIMULATION_WAVE_SIZE);
+    std::atomic<uint64_t> jointSimulationTime { 0 };
+
     for (int p = kHero; p < NumVariants; p++) {
         auto& priorityQueue = avatarPriorityQueues[p];
         // Sorting the current queue HERE as part of the measured timing.
@@ -303,33 +322,63 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
 
         auto passExpiry = updatePriorityExpiries[p];
 
-        for (auto it = sortedAvatarVector.begin(); it != sortedAvatarVector.end(); ++it) {
-            const SortableAvatar& sortData = *it;
-            const auto avatar = std::static_pointer_cast<OtherAvatar>(sortData.getAvatar());
-            if (!avatar->_isClientAvatar) {
-                avatar->setIsClientAvatar(true);
-            }
-            // TODO: to help us scale to more avatars it would be nice to not have to poll this stuff every update
-            if (avatar->getSkeletonModel()->isLoaded()) {
-                // remove the orb if it is there
-                avatar->removeOrb();
-                if (avatar->needsPhysicsUpdate()) {
-                    _otherAvatarsToChangeInPhysics.insert(avatar);
+        auto it = sortedAvatarVector.begin();
+        while (it != sortedAvatarVector.end()) {
+            uint64_t now = usecTimestampNow();
+            if (now >= passExpiry) {
+                // we've spent our time budget for this priority bucket
+                // let's deal with the reminding avatars if this pass and BREAK from the while loop
+
+                if (p == kHero) {
+                    // Hero,
+                    // --> put them back in the non hero queue
+
+                    auto& crowdQueue = avatarPriorityQueues[kNonHero];
+                    while (it != sortedAvatarVector.end()) {
+                        crowdQueue.push(SortableAvatar((*it).getAvatar()));
+                        ++it;
+                    }
+                } else {
+                    // Non Hero
+                    // --> bail on the rest of the avatar updates
+                    // --> more avatars may freeze until their priority trickles up
+                    // --> some scale animations may glitch
+                    // --> some avatar velocity measurements may be a little off
+
+                    // no time to simulate, but we take the time to count how many were tragically missed
+                    numAvatarsNotUpdated = sortedAvatarVector.end() - it;
                 }
-            } else {
-                avatar->updateOrbPosition();
-            }
 
-            // for ALL avatars...
-            if (_shouldRender) {
-                avatar->ensureInScene(avatar, qApp->getMain3DScene());
+                // We had to cut short this pass, we must break out of the while loop here
+                break;
             }
 
-            avatar->animateScaleChanges(deltaTime);
+            // main thread: prepare the next wave
+            wave.clear();
+            for (; it != sortedAvatarVector.end() && wave.size() < SIMULATION_WAVE_SIZE; ++it) {
+                const SortableAvatar& sortData = *it;
+                const auto avatar = std::static_pointer_cast<OtherAvatar>(sortData.getAvatar());
+                if (!avatar->_isClientAvatar) {
+                    avatar->setIsClientAvatar(true);
+                }
+                // TODO: to help us scale to more avatars it would be nice to not have to poll this stuff every update
+                if (avatar->getSkeletonModel()->isLoaded()) {
+                    // remove the orb if it is there
+                    avatar->removeOrb();
+                    if (avatar->needsPhysicsUpdate()) {
+                        _otherAvatarsToChangeInPhysics.insert(avatar);
+                    }
+                } else {
+                    avatar->updateOrbPosition();
+                }
+
+                // for ALL avatars...
+                if (_shouldRender) {
+                    avatar->ensureInScene(avatar, qApp->getMain3DScene());
+                }
+
+                avatar->animateScaleChanges(deltaTime);
 
-            uint64_t now = usecTimestampNow();
-            if (now < passExpiry) {
-                // we're within budget
                 bool inView = sortData.getPriority() > OUT_OF_VIEW_THRESHOLD;
                 if (inView && avatar->hasNewJointData()) {
                     numAvatarsUpdated++;
@@ -340,7 +389,21 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
                     avatar->_transit.reset();
                     avatar->setIsNewAvatar(false);
                 }
-                avatar->simulate(deltaTime, inView);
+                avatar->beginSimulation(inView);
+                wave.push_back({ avatar, inView });
+            }
+
+            // worker pool: one job per avatar, each job only touches its own avatar
+            tbb::parallel_for(size_t(0), wave.size(), [&](size_t i) {
+                uint64_t jobStart = usecTimestampNow();
+                wave[i].avatar->simulateJoints(deltaTime, wave[i].inView);
+                jointSimulationTime += usecTimestampNow() - jobStart;
+            });
+
+            // main thread: apply the results of the wave
+            for (const auto& job : wave) {
+                const auto& avatar = job.avatar;
+                avatar->endSimulation(deltaTime, job.inView);
                 if (avatar->getSkeletonModel()->isLoaded() && avatar->getWorkloadRegion() == workload::Region::R1) {
                     _myAvatar->addAvatarHandsToFlow(avatar);
                 }
@@ -351,33 +414,6 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
                 avatar->updateRenderItem(renderTransaction);
                 avatar->updateSpaceProxy(workloadTransaction);
                 avatar->setLastRenderUpdateTime(startTime);
-
-            } else {
-                // we've spent our time budget for this priority bucket
-                // let's deal with the reminding avatars if this pass and BREAK from the for loop
-
-                if (p == kHero) {
-                    // Hero,
-                    // --> put them back in the non hero queue
-
-                    auto& crowdQueue = avatarPriorityQueues[kNonHero];
-                    while (it != sortedAvatarVector.end()) {
-                        crowdQueue.push(SortableAvatar((*it).getAvatar()));
-                        ++it;
-                    }
-                } else {
-                    // Non Hero
-                    // --> bail on the rest of the avatar updates
-                    // --> more avatars may freeze until their priority trickles up
-                    // --> some scale animations may glitch
-                    // --> some avatar velocity measurements may be a little off
-
-                    // no time to simulate, but we take the time to count how many were tragically missed
-                    numAvatarsNotUpdated = sortedAvatarVector.end() - it;
-                }
-
-                // We had to cut short this pass, we must break out of the for loop here
-                break;
             }
         }
 
@@ -397,6 +433,7 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
     _numHeroAvatarsUpdated = numHerosUpdated;
 
     _avatarSimulationTime = (float)(usecTimestampNow() - startTime) / (float)USECS_PER_MSEC;
+    _avatarJointSimulationTime = (float)jointSimulationTime / (float)USECS_PER_MSEC;
 }
 
 void AvatarManager::postUpdate(float deltaTime, const render::ScenePointer& scene) {
@@ -118,6 +118,7 @@ public:
     int getNumHeroAvatars() const { return _numHeroAvatars; }
     int getNumHeroAvatarsUpdated() const { return _numHeroAvatarsUpdated; }
     float getAvatarSimulationTime() const { return _avatarSimulationTime; }
+    float getAvatarJointSimulationTime() const { return _avatarJointSimulationTime; }
 
     void updateMyAvatar(float deltaTime);
     void updateOtherAvatars(float deltaTime);
@@ -305,6 +306,7 @@ private:
     int _numHeroAvatars{ 0 };
     int _numHeroAvatarsUpdated{ 0 };
     float _avatarSimulationTime { 0.0f };
+    float _avatarJointSimulationTime { 0.0f }; // summed over all worker threads
     bool _shouldRender { true };
     bool _myAvatarDataPacketsPaused { false };
 
@@ -245,7 +245,12 @@ void OtherAvatar::setCollisionWithOtherAvatarsFlags() {
 
 void OtherAvatar::simulate(float deltaTime, bool inView) {
     PROFILE_RANGE(simulation, "simulate");
+    beginSimulation(inView);
+    simulateJoints(deltaTime, inView);
+    endSimulation(deltaTime, inView);
+}
 
+void OtherAvatar::beginSimulation(bool inView) {
     _globalPosition = _transit.isActive() ? _transit.getCurrentPosition() : _serverPosition;
     if (!hasParent()) {
         setLocalPosition(_globalPosition);
@@ -255,40 +260,54 @@ void OtherAvatar::simulate(float deltaTime, bool inView) {
     if (inView) {
         _simulationInViewRate.increment();
     }
+}
 
+void OtherAvatar::simulateJoints(float deltaTime, bool inView) {
+    PROFILE_RANGE(simulation, "simulateJoints");
     PerformanceTimer perfTimer("simulate");
-    {
-        PROFILE_RANGE(simulation, "updateJoints");
-        if (inView) {
-            Head* head = getHead();
-            if (_hasNewJointData || _transit.isActive()) {
-                _skeletonModel->getRig().copyJointsFromJointData(_jointData);
-                glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
-                _skeletonModel->getRig().computeExternalPoses(rootTransform);
-                _jointDataSimulationRate.increment();
-
-                head->simulate(deltaTime);
-                _skeletonModel->simulate(deltaTime, true);
-
-                locationChanged(); // joints changed, so if there are any children, update them.
-                _hasNewJointData = false;
-
-                glm::vec3 headPosition = getWorldPosition();
-                if (!_skeletonModel->getHeadPosition(headPosition)) {
-                    headPosition = getWorldPosition();
-                }
-                head->setPosition(headPosition);
-            } else {
-                head->simulate(deltaTime);
-                _skeletonModel->simulate(deltaTime, false);
+    if (inView) {
+        Head* head = getHead();
+        if (_hasNewJointData || _transit.isActive()) {
+            _skeletonModel->getRig().copyJointsFromJointData(_jointData);
+            glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
+            _skeletonModel->getRig().computeExternalPoses(rootTransform);
+            _jointDataSimulationRate.increment();
+
+            head->simulate(deltaTime);
+            _skeletonModel->simulate(deltaTime, true);
+
+            // children are notified from endSimulation(), on the main thread
+            _jointsChangedDuringSimulation = true;
+            _hasNewJointData = false;
+
+            glm::vec3 headPosition = getWorldPosition();
+            if (!_skeletonModel->getHeadPosition(headPosition)) {
+                headPosition = getWorldPosition();
             }
-            head->setScale(getModelScale());
-            relayJointDataToChildren();
+            head->setPosition(headPosition);
         } else {
-            // a non-full update is still required so that the position, rotation, scale and bounds of the skeletonModel are updated.
+            head->simulate(deltaTime);
             _skeletonModel->simulate(deltaTime, false);
         }
-        _skeletonModelSimulationRate.increment();
+        head->setScale(getModelScale());
+    } else {
+        // a non-full update is still required so that the position, rotation, scale and bounds of the skeletonModel are updated.
+        _skeletonModel->simulate(deltaTime, false);
+    }
+    _skeletonModelSimulationRate.increment();
+
+    // compute the skinning matrices here rather than lazily in the render-item update on the main thread
+    _skeletonModel->updateClusterMatrices();
+}
+
+void OtherAvatar::endSimulation(float deltaTime, bool inView) {
+    PROFILE_RANGE(simulation, "endSimulation");
+    if (_jointsChangedDuringSimulation) {
+        _jointsChangedDuringSimulation = false;
+        locationChanged(); // joints changed, so if there are any children, update them.
+    }
+    if (inView) {
+        relayJointDataToChildren();
     }
 
     // update animation for display name fade in/out
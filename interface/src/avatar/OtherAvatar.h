@@ -64,6 +64,14 @@ public:
     void setCollisionWithOtherAvatarsFlags() override;
 
     void simulate(float deltaTime, bool inView) override;
+
+    // simulate() is split in three stages so that AvatarManager can evaluate the rigs of many avatars in parallel.
+    // beginSimulation() and endSimulation() touch the scene graph and must run on the main thread, while
+    // simulateJoints() only touches this avatar's rig, head and skeleton model and may run on a worker thread.
+    void beginSimulation(bool inView);
+    void simulateJoints(float deltaTime, bool inView);
+    void endSimulation(float deltaTime, bool inView);
+
     void debugJointData() const;
     friend AvatarManager;
 
@@ -91,6 +99,7 @@ protected:
     uint8_t _workloadRegion { workload::Region::INVALID };
     BodyLOD _bodyLOD { BodyLOD::Sphere };
     bool _needsDetailedRebuild { false };
+    bool _jointsChangedDuringSimulation { false };
 };
 
 using OtherAvatarPointer = std::shared_ptr<OtherAvatar>;
@@ -141,6 +141,7 @@ private: \
  * @property {number} batchFrameTime - <em>Read-only.</em>
  * @property {number} engineFrameTime - <em>Read-only.</em>
  * @property {number} avatarSimulationTime - <em>Read-only.</em>
+ * @property {number} avatarJointSimulationTime - <em>Read-only.</em>
  *
  *
  * @property {number} x
@@ -308,6 +309,7 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(float, batchFrameTime, 0)
     STATS_PROPERTY(float, engineFrameTime, 0)
     STATS_PROPERTY(float, avatarSimulationTime, 0)
+    STATS_PROPERTY(float, avatarJointSimulationTime, 0)
 
     STATS_PROPERTY(int, stylusPicksCount, 0)
     STATS_PROPERTY(int, rayPicksCount, 0)
@@ -1086,6 +1088,13 @@ signals:
      */
     void avatarSimulationTimeChanged();
 
+    /**jsdoc
+     * Triggered when the value of the <code>avatarJointSimulationTime</code> property changes.
+     * @function Stats.avatarJointSimulationTimeChanged
+     * @returns {Signal}
+     */
+    void avatarJointSimulationTimeChanged();
+
     /**jsdoc
      * Triggered when the value of the <code>rectifiedTextureCount</code> property changes.
      * @function Stats.rectifiedTextureCountChanged
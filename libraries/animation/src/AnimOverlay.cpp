@@ -64,10 +64,7 @@ const AnimPoseVec& AnimOverlay::evaluate(const AnimVariantMap& animVars, const A
                 _poses.resize(underPoses.size());
                 assert(_boneSetVec.size() == _poses.size());
 
-                for (size_t i = 0; i < _poses.size(); i++) {
-                    float alpha = _boneSetVec[i] * _alpha;
-                    ::blend(1, &underPoses[i], &overPoses[i], alpha, &_poses[i]);
-                }
+                ::blendWeighted(_poses.size(), underPoses.data(), overPoses.data(), _alpha, _boneSetVec.data(), _poses.data());
             }
         }
     }
@@ -15,6 +15,7 @@
 #include <GLMHelpers.h>
 
 #include "AnimationLogging.h"
+#include "AnimUtil.h"
 
 AnimSkeleton::AnimSkeleton(const HFMModel& hfmModel) {
 
@@ -154,12 +155,22 @@ void AnimSkeleton::convertAbsolutePosesToRelative(AnimPoseVec& poses) const {
 
 void AnimSkeleton::convertRelativeRotationsToAbsolute(std::vector<glm::quat>& rotations) const {
     // rotations start off relative and leave in absolute frame
-    int lastIndex = std::min((int)rotations.size(), _jointsSize);
-    for (int i = 0; i < lastIndex; ++i) {
-        int parentIndex = _parentIndices[i];
-        if (parentIndex != -1) {
-            rotations[i] = rotations[parentIndex] * rotations[i];
+    if ((int)rotations.size() < _jointsSize) {
+        int lastIndex = (int)rotations.size();
+        for (int i = 0; i < lastIndex; ++i) {
+            int parentIndex = _parentIndices[i];
+            if (parentIndex != -1) {
+                rotations[i] = rotations[parentIndex] * rotations[i];
+            }
         }
+        return;
+    }
+
+    // one depth level at a time, the joints within a level are independent of each other.
+    for (size_t depth = 0; depth + 1 < _depthOffsets.size(); ++depth) {
+        int begin = _depthOffsets[depth];
+        int end = _depthOffsets[depth + 1];
+        multiplyByParentRotations(rotations.data(), &_jointIndicesByDepth[begin], &_parentIndicesByDepth[begin], end - begin);
     }
 }
 
@@ -215,6 +226,32 @@ void AnimSkeleton::buildSkeletonFromJoints(const std::vector<HFMJoint>& joints,
     }
 
     _jointsSize = (int)joints.size();
+
+    // sort the non-root joints by depth, so that each level of the hierarchy can be processed as one batch.
+    std::vector<int> depths(_jointsSize, 0);
+    int maxDepth = 0;
+    for (int i = 0; i < _jointsSize; i++) {
+        int depth = 0;
+        for (int parentIndex = _parentIndices[i]; parentIndex != -1 && depth < _jointsSize; parentIndex = _parentIndices[parentIndex]) {
+            depth++;
+        }
+        depths[i] = depth;
+        maxDepth = std::max(maxDepth, depth);
+    }
+    _jointIndicesByDepth.clear();
+    _parentIndicesByDepth.clear();
+    _depthOffsets.clear();
+    for (int depth = 1; depth <= maxDepth; depth++) {
+        _depthOffsets.push_back((int)_jointIndicesByDepth.size());
+        for (int i = 0; i < _jointsSize; i++) {
+            if (depths[i] == depth) {
+                _jointIndicesByDepth.push_back(i);
+                _parentIndicesByDepth.push_back(_parentIndices[i]);
+            }
+        }
+    }
+    _depthOffsets.push_back((int)_jointIndicesByDepth.size());
+
     // build a cache of bind poses
 
     // build a chache of default poses
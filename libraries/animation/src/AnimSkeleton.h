@@ -76,6 +76,12 @@ protected:
     std::vector<HFMJoint> _joints;
     std::vector<int> _parentIndices;
     int _jointsSize { 0 };
+
+    // non-root joints sorted by depth in the hierarchy, with their parents alongside.
+    // the joints in the range [_depthOffsets[d], _depthOffsets[d + 1]) only depend on joints of lower depths.
+    std::vector<int> _jointIndicesByDepth;
+    std::vector<int> _parentIndicesByDepth;
+    std::vector<int> _depthOffsets;
     AnimPoseVec _relativeDefaultPoses;
     AnimPoseVec _absoluteDefaultPoses;
     AnimPoseVec _relativePreRotationPoses;
@@ -13,9 +13,7 @@
 #include <NumericalConstants.h>
 #include <DebugDraw.h>
 
-// TODO: use restrict keyword
-// TODO: excellent candidate for simd vectorization.
-void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
+void blend_ref(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
     for (size_t i = 0; i < numPoses; i++) {
         const AnimPose& aPose = a[i];
         const AnimPose& bPose = b[i];
@@ -26,6 +24,12 @@ void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, A
     }
 }
 
+static void blendWeighted_ref(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, const float* weights, AnimPose* result) {
+    for (size_t i = 0; i < numPoses; i++) {
+        blend_ref(1, &a[i], &b[i], alpha * weights[i], &result[i]);
+    }
+}
+
 void blend3(size_t numPoses, const AnimPose* a, const AnimPose* b, const AnimPose* c, float* alphas, AnimPose* result) {
     for (size_t i = 0; i < numPoses; i++) {
         const AnimPose& aPose = a[i];
@@ -38,7 +42,7 @@ void blend3(size_t numPoses, const AnimPose* a, const AnimPose* b, const AnimPos
     }
 }
 
-void blend4(size_t numPoses, const AnimPose* a, const AnimPose* b, const AnimPose* c, const AnimPose* d, float* alphas, AnimPose* result) {
+void blend4_ref(size_t numPoses, const AnimPose* a, const AnimPose* b, const AnimPose* c, const AnimPose* d, float* alphas, AnimPose* result) {
     for (size_t i = 0; i < numPoses; i++) {
         const AnimPose& aPose = a[i];
         const AnimPose& bPose = b[i];
@@ -52,7 +56,7 @@ void blend4(size_t numPoses, const AnimPose* a, const AnimPose* b, const AnimPos
 }
 
 // additive blend
-void blendAdd(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
+void blendAdd_ref(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
 
     const glm::vec3 IDENTITY_SCALE = glm::vec3(1.0f);
     const glm::quat IDENTITY_ROT = glm::quat();
@@ -75,6 +79,106 @@ void blendAdd(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha
     }
 }
 
+void multiplyByParentRotations_ref(glm::quat* rotations, const int* jointIndices, const int* parentIndices, size_t numJoints) {
+    for (size_t i = 0; i < numJoints; i++) {
+        rotations[jointIndices[i]] = rotations[parentIndices[i]] * rotations[jointIndices[i]];
+    }
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+//
+// Runtime CPU dispatch
+//
+// The AVX2 kernels process the poses in blocks of 8, deinterleaved into structure-of-arrays registers,
+// and return how many they processed. The reference code finishes the tail.
+//
+#include <CPUDetect.h>
+
+int blend_AVX2(const float (*a)[10], const float (*b)[10], float alpha, const float* weights, float (*result)[10], int size);
+int blend4_AVX2(const float (*a)[10], const float (*b)[10], const float (*c)[10], const float (*d)[10],
+                const float alphas[4], float (*result)[10], int size);
+int blendAdd_AVX2(const float (*a)[10], const float (*b)[10], float alpha, float (*result)[10], int size);
+int multiplyByParentRotations_AVX2(float (*rotations)[4], const int* jointIndices, const int* parentIndices, int size);
+
+// AnimPose is scale.xyz, rot.xyzw, trans.xyz
+static_assert(sizeof(AnimPose) == 10 * sizeof(float), "class AnimPose size doesn't match.");
+static_assert(sizeof(glm::quat) == 4 * sizeof(float), "struct glm::quat size doesn't match.");
+
+#define POSES(p) ((float(*)[10])(p))
+#define CONST_POSES(p) ((const float(*)[10])(p))
+
+void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
+    static bool _cpuSupportsAVX2 = cpuSupportsAVX2();
+    size_t i = 0;
+    if (_cpuSupportsAVX2) {
+        i = blend_AVX2(CONST_POSES(a), CONST_POSES(b), alpha, nullptr, POSES(result), (int)numPoses);
+    }
+    blend_ref(numPoses - i, a + i, b + i, alpha, result + i);
+}
+
+void blendWeighted(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, const float* weights, AnimPose* result) {
+    static bool _cpuSupportsAVX2 = cpuSupportsAVX2();
+    size_t i = 0;
+    if (_cpuSupportsAVX2) {
+        i = blend_AVX2(CONST_POSES(a), CONST_POSES(b), alpha, weights, POSES(result), (int)numPoses);
+    }
+    blendWeighted_ref(numPoses - i, a + i, b + i, alpha, weights + i, result + i);
+}
+
+void blend4(size_t numPoses, const AnimPose* a, const AnimPose* b, const AnimPose* c, const AnimPose* d, float* alphas, AnimPose* result) {
+    static bool _cpuSupportsAVX2 = cpuSupportsAVX2();
+    size_t i = 0;
+    if (_cpuSupportsAVX2) {
+        i = blend4_AVX2(CONST_POSES(a), CONST_POSES(b), CONST_POSES(c), CONST_POSES(d), alphas, POSES(result), (int)numPoses);
+    }
+    blend4_ref(numPoses - i, a + i, b + i, c + i, d + i, alphas, result + i);
+}
+
+void blendAdd(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
+    static bool _cpuSupportsAVX2 = cpuSupportsAVX2();
+    size_t i = 0;
+    if (_cpuSupportsAVX2) {
+        i = blendAdd_AVX2(CONST_POSES(a), CONST_POSES(b), alpha, POSES(result), (int)numPoses);
+    }
+    blendAdd_ref(numPoses - i, a + i, b + i, alpha, result + i);
+}
+
+void multiplyByParentRotations(glm::quat* rotations, const int* jointIndices, const int* parentIndices, size_t numJoints) {
+    static bool _cpuSupportsAVX2 = cpuSupportsAVX2();
+    size_t i = 0;
+    if (_cpuSupportsAVX2) {
+        i = multiplyByParentRotations_AVX2((float(*)[4])rotations, jointIndices, parentIndices, (int)numJoints);
+    }
+    multiplyByParentRotations_ref(rotations, jointIndices + i, parentIndices + i, numJoints - i);
+}
+
+#undef POSES
+#undef CONST_POSES
+
+#else   // portable reference code
+
+void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
+    blend_ref(numPoses, a, b, alpha, result);
+}
+
+void blendWeighted(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, const float* weights, AnimPose* result) {
+    blendWeighted_ref(numPoses, a, b, alpha, weights, result);
+}
+
+void blend4(size_t numPoses, const AnimPose* a, const AnimPose* b, const AnimPose* c, const AnimPose* d, float* alphas, AnimPose* result) {
+    blend4_ref(numPoses, a, b, c, d, alphas, result);
+}
+
+void blendAdd(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
+    blendAdd_ref(numPoses, a, b, alpha, result);
+}
+
+void multiplyByParentRotations(glm::quat* rotations, const int* jointIndices, const int* parentIndices, size_t numJoints) {
+    multiplyByParentRotations_ref(rotations, jointIndices, parentIndices, numJoints);
+}
+
+#endif
+
 glm::quat averageQuats(size_t numQuats, const glm::quat* quats) {
     if (numQuats == 0) {
         return glm::quat();
@@ -16,6 +16,9 @@
 // this is where the magic happens
 void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result);
 
+// blend with a per-pose alpha of alpha * weights[i]
+void blendWeighted(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, const float* weights, AnimPose* result);
+
 // blend between three sets of poses
 void blend3(size_t numPoses, const AnimPose* a, const AnimPose* b, const AnimPose* c, float* alphas, AnimPose* result);
 
@@ -25,6 +28,16 @@ void blend4(size_t numPoses, const AnimPose* a, const AnimPose* b, const AnimPos
 // additive blending
 void blendAdd(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result);
 
+// rotations[jointIndices[i]] = rotations[parentIndices[i]] * rotations[jointIndices[i]]
+// the joints must not depend on each other, i.e. no joint in jointIndices may appear in parentIndices.
+void multiplyByParentRotations(glm::quat* rotations, const int* jointIndices, const int* parentIndices, size_t numJoints);
+
+// reference versions, without runtime CPU dispatch
+void blend_ref(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result);
+void blend4_ref(size_t numPoses, const AnimPose* a, const AnimPose* b, const AnimPose* c, const AnimPose* d, float* alphas, AnimPose* result);
+void blendAdd_ref(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result);
+void multiplyByParentRotations_ref(glm::quat* rotations, const int* jointIndices, const int* parentIndices, size_t numJoints);
+
 glm::quat averageQuats(size_t numQuats, const glm::quat* quats);
 
 float accumulateTime(float startFrame, float endFrame, float timeScale, float currentFrame, float dt, bool loopFlag,
@@ -0,0 +1,301 @@
+//
+//  AnimUtil_avx2.cpp
+//  libraries/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <stdint.h>
+#include <immintrin.h>
+
+#if defined(_MSC_VER)
+#define FORCEINLINE __forceinline
+#define ALIGN32 __declspec(align(32))
+#elif defined(__GNUC__)
+#define FORCEINLINE inline __attribute__((always_inline))
+#define ALIGN32 __attribute__((aligned(32)))
+#else
+#define FORCEINLINE inline
+#define ALIGN32
+#endif
+
+//
+// Poses are passed as float[10] in AnimPose memory order:
+//   scale.xyz, rot.xyzw, trans.xyz
+// Each kernel processes blocks of 8 poses, deinterleaved into a structure-of-arrays of 8-wide registers,
+// and returns the number of poses processed (a multiple of 8). The caller finishes the tail.
+//
+
+static const int POSE_STRIDE = 10;
+static const int BLOCK_SIZE = 8;
+
+// 8 poses in structure-of-arrays form
+struct PoseBlock {
+    __m256 sx, sy, sz;
+    __m256 rx, ry, rz, rw;
+    __m256 tx, ty, tz;
+};
+
+// 8 quaternions in structure-of-arrays form
+struct QuatBlock {
+    __m256 x, y, z, w;
+};
+
+static FORCEINLINE PoseBlock loadPoses(const float (*poses)[10]) {
+    const float* base = poses[0];
+    const __m256i index = _mm256_setr_epi32(0, 10, 20, 30, 40, 50, 60, 70);
+    PoseBlock p;
+    p.sx = _mm256_i32gather_ps(base + 0, index, sizeof(float));
+    p.sy = _mm256_i32gather_ps(base + 1, index, sizeof(float));
+    p.sz = _mm256_i32gather_ps(base + 2, index, sizeof(float));
+    p.rx = _mm256_i32gather_ps(base + 3, index, sizeof(float));
+    p.ry = _mm256_i32gather_ps(base + 4, index, sizeof(float));
+    p.rz = _mm256_i32gather_ps(base + 5, index, sizeof(float));
+    p.rw = _mm256_i32gather_ps(base + 6, index, sizeof(float));
+    p.tx = _mm256_i32gather_ps(base + 7, index, sizeof(float));
+    p.ty = _mm256_i32gather_ps(base + 8, index, sizeof(float));
+    p.tz = _mm256_i32gather_ps(base + 9, index, sizeof(float));
+    return p;
+}
+
+static FORCEINLINE void storePoses(const PoseBlock& p, float (*poses)[10]) {
+    ALIGN32 float soa[POSE_STRIDE][BLOCK_SIZE];
+    _mm256_store_ps(soa[0], p.sx);
+    _mm256_store_ps(soa[1], p.sy);
+    _mm256_store_ps(soa[2], p.sz);
+    _mm256_store_ps(soa[3], p.rx);
+    _mm256_store_ps(soa[4], p.ry);
+    _mm256_store_ps(soa[5], p.rz);
+    _mm256_store_ps(soa[6], p.rw);
+    _mm256_store_ps(soa[7], p.tx);
+    _mm256_store_ps(soa[8], p.ty);
+    _mm256_store_ps(soa[9], p.tz);
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+        for (int j = 0; j < POSE_STRIDE; j++) {
+            poses[i][j] = soa[j][i];
+        }
+    }
+}
+
+// a + alpha * (b - a)
+static FORCEINLINE __m256 lerp(__m256 a, __m256 b, __m256 alpha) {
+    return _mm256_fmadd_ps(alpha, _mm256_sub_ps(b, a), a);
+}
+
+static FORCEINLINE __m256 dot4(__m256 ax, __m256 ay, __m256 az, __m256 aw, __m256 bx, __m256 by, __m256 bz, __m256 bw) {
+    __m256 d = _mm256_mul_ps(ax, bx);
+    d = _mm256_fmadd_ps(ay, by, d);
+    d = _mm256_fmadd_ps(az, bz, d);
+    return _mm256_fmadd_ps(aw, bw, d);
+}
+
+// returns the sign bit of each lane where dot(a, b) < 0, to flip b into the same hemisphere as a
+static FORCEINLINE __m256 hemisphereSign(const PoseBlock& a, const PoseBlock& b) {
+    __m256 d = dot4(a.rx, a.ry, a.rz, a.rw, b.rx, b.ry, b.rz, b.rw);
+    return _mm256_and_ps(_mm256_cmp_ps(d, _mm256_setzero_ps(), _CMP_LT_OQ), _mm256_set1_ps(-0.0f));
+}
+
+static FORCEINLINE void normalize(__m256& x, __m256& y, __m256& z, __m256& w) {
+    // full precision sqrt, to match glm::normalize()
+    __m256 lengthSquared = dot4(x, y, z, w, x, y, z, w);
+    __m256 invLength = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(lengthSquared));
+
+    // like glm::normalize(), a zero length quaternion becomes the identity rather than NaN
+    __m256 isZero = _mm256_cmp_ps(lengthSquared, _mm256_setzero_ps(), _CMP_LE_OQ);
+    x = _mm256_andnot_ps(isZero, _mm256_mul_ps(x, invLength));
+    y = _mm256_andnot_ps(isZero, _mm256_mul_ps(y, invLength));
+    z = _mm256_andnot_ps(isZero, _mm256_mul_ps(z, invLength));
+    w = _mm256_blendv_ps(_mm256_mul_ps(w, invLength), _mm256_set1_ps(1.0f), isZero);
+}
+
+// q = p * q, as glm::quat operator*
+static FORCEINLINE QuatBlock multiply(const QuatBlock& p, const QuatBlock& q) {
+    QuatBlock r;
+    r.w = _mm256_fnmadd_ps(p.z, q.z, _mm256_fnmadd_ps(p.y, q.y, _mm256_fnmadd_ps(p.x, q.x, _mm256_mul_ps(p.w, q.w))));
+    r.x = _mm256_fnmadd_ps(p.z, q.y, _mm256_fmadd_ps(p.y, q.z, _mm256_fmadd_ps(p.x, q.w, _mm256_mul_ps(p.w, q.x))));
+    r.y = _mm256_fnmadd_ps(p.x, q.z, _mm256_fmadd_ps(p.z, q.x, _mm256_fmadd_ps(p.y, q.w, _mm256_mul_ps(p.w, q.y))));
+    r.z = _mm256_fnmadd_ps(p.y, q.x, _mm256_fmadd_ps(p.x, q.y, _mm256_fmadd_ps(p.z, q.w, _mm256_mul_ps(p.w, q.z))));
+    return r;
+}
+
+//
+// result = lerp(a, b, alpha * weights[i]), with normalized lerp of the rotations
+// weights may be null, in which case alpha is used for every pose
+//
+int blend_AVX2(const float (*a)[10], const float (*b)[10], float alpha, const float* weights, float (*result)[10], int size) {
+
+    int i = 0;
+    for (; i < size - 7; i += BLOCK_SIZE) {
+
+        __m256 t = _mm256_set1_ps(alpha);
+        if (weights) {
+            t = _mm256_mul_ps(t, _mm256_loadu_ps(&weights[i]));
+        }
+
+        PoseBlock pa = loadPoses(&a[i]);
+        PoseBlock pb = loadPoses(&b[i]);
+
+        PoseBlock r;
+        r.sx = lerp(pa.sx, pb.sx, t);
+        r.sy = lerp(pa.sy, pb.sy, t);
+        r.sz = lerp(pa.sz, pb.sz, t);
+
+        __m256 sign = hemisphereSign(pa, pb);
+        r.rx = lerp(pa.rx, _mm256_xor_ps(pb.rx, sign), t);
+        r.ry = lerp(pa.ry, _mm256_xor_ps(pb.ry, sign), t);
+        r.rz = lerp(pa.rz, _mm256_xor_ps(pb.rz, sign), t);
+        r.rw = lerp(pa.rw, _mm256_xor_ps(pb.rw, sign), t);
+        normalize(r.rx, r.ry, r.rz, r.rw);
+
+        r.tx = lerp(pa.tx, pb.tx, t);
+        r.ty = lerp(pa.ty, pb.ty, t);
+        r.tz = lerp(pa.tz, pb.tz, t);
+
+        storePoses(r, &result[i]);
+    }
+    return i;
+}
+
+//
+// result = alphas[0] * a + alphas[1] * b + alphas[2] * c + alphas[3] * d,
+// with b, c and d rotations flipped into the hemisphere of a, and the rotation normalized
+//
+int blend4_AVX2(const float (*a)[10], const float (*b)[10], const float (*c)[10], const float (*d)[10],
+                const float alphas[4], float (*result)[10], int size) {
+
+    const __m256 alpha0 = _mm256_set1_ps(alphas[0]);
+    const __m256 alpha1 = _mm256_set1_ps(alphas[1]);
+    const __m256 alpha2 = _mm256_set1_ps(alphas[2]);
+    const __m256 alpha3 = _mm256_set1_ps(alphas[3]);
+
+    int i = 0;
+    for (; i < size - 7; i += BLOCK_SIZE) {
+
+        PoseBlock pa = loadPoses(&a[i]);
+        PoseBlock pb = loadPoses(&b[i]);
+        PoseBlock pc = loadPoses(&c[i]);
+        PoseBlock pd = loadPoses(&d[i]);
+
+        __m256 signB = hemisphereSign(pa, pb);
+        __m256 signC = hemisphereSign(pa, pc);
+        __m256 signD = hemisphereSign(pa, pd);
+
+        // the sign flip is folded into the per-lane weights
+        __m256 rotAlpha1 = _mm256_xor_ps(alpha1, signB);
+        __m256 rotAlpha2 = _mm256_xor_ps(alpha2, signC);
+        __m256 rotAlpha3 = _mm256_xor_ps(alpha3, signD);
+
+        PoseBlock r;
+        r.sx = _mm256_fmadd_ps(alpha3, pd.sx, _mm256_fmadd_ps(alpha2, pc.sx, _mm256_fmadd_ps(alpha1, pb.sx, _mm256_mul_ps(alpha0, pa.sx))));
+        r.sy = _mm256_fmadd_ps(alpha3, pd.sy, _mm256_fmadd_ps(alpha2, pc.sy, _mm256_fmadd_ps(alpha1, pb.sy, _mm256_mul_ps(alpha0, pa.sy))));
+        r.sz = _mm256_fmadd_ps(alpha3, pd.sz, _mm256_fmadd_ps(alpha2, pc.sz, _mm256_fmadd_ps(alpha1, pb.sz, _mm256_mul_ps(alpha0, pa.sz))));
+
+        r.rx = _mm256_fmadd_ps(rotAlpha3, pd.rx, _mm256_fmadd_ps(rotAlpha2, pc.rx, _mm256_fmadd_ps(rotAlpha1, pb.rx, _mm256_mul_ps(alpha0, pa.rx))));
+        r.ry = _mm256_fmadd_ps(rotAlpha3, pd.ry, _mm256_fmadd_ps(rotAlpha2, pc.ry, _mm256_fmadd_ps(rotAlpha1, pb.ry, _mm256_mul_ps(alpha0, pa.ry))));
+        r.rz = _mm256_fmadd_ps(rotAlpha3, pd.rz, _mm256_fmadd_ps(rotAlpha2, pc.rz, _mm256_fmadd_ps(rotAlpha1, pb.rz, _mm256_mul_ps(alpha0, pa.rz))));
+        r.rw = _mm256_fmadd_ps(rotAlpha3, pd.rw, _mm256_fmadd_ps(rotAlpha2, pc.rw, _mm256_fmadd_ps(rotAlpha1, pb.rw, _mm256_mul_ps(alpha0, pa.rw))));
+        normalize(r.rx, r.ry, r.rz, r.rw);
+
+        r.tx = _mm256_fmadd_ps(alpha3, pd.tx, _mm256_fmadd_ps(alpha2, pc.tx, _mm256_fmadd_ps(alpha1, pb.tx, _mm256_mul_ps(alpha0, pa.tx))));
+        r.ty = _mm256_fmadd_ps(alpha3, pd.ty, _mm256_fmadd_ps(alpha2, pc.ty, _mm256_fmadd_ps(alpha1, pb.ty, _mm256_mul_ps(alpha0, pa.ty))));
+        r.tz = _mm256_fmadd_ps(alpha3, pd.tz, _mm256_fmadd_ps(alpha2, pc.tz, _mm256_fmadd_ps(alpha1, pb.tz, _mm256_mul_ps(alpha0, pa.tz))));
+
+        storePoses(r, &result[i]);
+    }
+    return i;
+}
+
+//
+// additive blend: b is a delta pose applied on top of a, scaled by alpha
+//
+int blendAdd_AVX2(const float (*a)[10], const float (*b)[10], float alpha, float (*result)[10], int size) {
+
+    const __m256 t = _mm256_set1_ps(alpha);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 oneMinusT = _mm256_set1_ps(1.0f - alpha);
+
+    int i = 0;
+    for (; i < size - 7; i += BLOCK_SIZE) {
+
+        PoseBlock pa = loadPoses(&a[i]);
+        PoseBlock pb = loadPoses(&b[i]);
+
+        PoseBlock r;
+        r.sx = _mm256_mul_ps(pa.sx, lerp(one, pb.sx, t));
+        r.sy = _mm256_mul_ps(pa.sy, lerp(one, pb.sy, t));
+        r.sz = _mm256_mul_ps(pa.sz, lerp(one, pb.sz, t));
+
+        // flip the delta into the same hemisphere as the identity quat, then lerp from identity
+        __m256 sign = _mm256_and_ps(_mm256_cmp_ps(pb.rw, _mm256_setzero_ps(), _CMP_LT_OQ), _mm256_set1_ps(-0.0f));
+        QuatBlock delta;
+        delta.x = _mm256_mul_ps(t, _mm256_xor_ps(pb.rx, sign));
+        delta.y = _mm256_mul_ps(t, _mm256_xor_ps(pb.ry, sign));
+        delta.z = _mm256_mul_ps(t, _mm256_xor_ps(pb.rz, sign));
+        delta.w = _mm256_fmadd_ps(t, _mm256_xor_ps(pb.rw, sign), oneMinusT);
+
+        QuatBlock rot = multiply({ pa.rx, pa.ry, pa.rz, pa.rw }, delta);
+        normalize(rot.x, rot.y, rot.z, rot.w);
+        r.rx = rot.x;
+        r.ry = rot.y;
+        r.rz = rot.z;
+        r.rw = rot.w;
+
+        r.tx = _mm256_fmadd_ps(t, pb.tx, pa.tx);
+        r.ty = _mm256_fmadd_ps(t, pb.ty, pa.ty);
+        r.tz = _mm256_fmadd_ps(t, pb.tz, pa.tz);
+
+        storePoses(r, &result[i]);
+    }
+    return i;
+}
+
+//
+// rotations[jointIndices[k]] = rotations[parentIndices[k]] * rotations[jointIndices[k]]
+// All joints passed in one call must be independent of each other (e.g. one depth level of a skeleton).
+//
+int multiplyByParentRotations_AVX2(float (*rotations)[4], const int* jointIndices, const int* parentIndices, int size) {
+
+    const float* base = rotations[0];
+
+    int k = 0;
+    for (; k < size - 7; k += BLOCK_SIZE) {
+
+        __m256i joints = _mm256_slli_epi32(_mm256_loadu_si256((const __m256i*)&jointIndices[k]), 2);
+        __m256i parents = _mm256_slli_epi32(_mm256_loadu_si256((const __m256i*)&parentIndices[k]), 2);
+
+        QuatBlock p;
+        p.x = _mm256_i32gather_ps(base + 0, parents, sizeof(float));
+        p.y = _mm256_i32gather_ps(base + 1, parents, sizeof(float));
+        p.z = _mm256_i32gather_ps(base + 2, parents, sizeof(float));
+        p.w = _mm256_i32gather_ps(base + 3, parents, sizeof(float));
+
+        QuatBlock q;
+        q.x = _mm256_i32gather_ps(base + 0, joints, sizeof(float));
+        q.y = _mm256_i32gather_ps(base + 1, joints, sizeof(float));
+        q.z = _mm256_i32gather_ps(base + 2, joints, sizeof(float));
+        q.w = _mm256_i32gather_ps(base + 3, joints, sizeof(float));
+
+        QuatBlock r = multiply(p, q);
+
+        ALIGN32 float soa[4][BLOCK_SIZE];
+        _mm256_store_ps(soa[0], r.x);
+        _mm256_store_ps(soa[1], r.y);
+        _mm256_store_ps(soa[2], r.z);
+        _mm256_store_ps(soa[3], r.w);
+        for (int i = 0; i < BLOCK_SIZE; i++) {
+            float* rotation = rotations[jointIndices[k + i]];
+            rotation[0] = soa[0][i];
+            rotation[1] = soa[1][i];
+            rotation[2] = soa[2][i];
+            rotation[3] = soa[3][i];
+        }
+    }
+    return k;
+}
+
+#endif
@@ -13,6 +13,7 @@
 
 #include <glm/gtx/transform.hpp>
 #include <QMultiMap>
+#include <QThread>
 
 #include <recording/Deck.h>
 #include <DebugDraw.h>
@@ -173,7 +174,12 @@ void SkeletonModel::simulate(float deltaTime, bool fullUpdate) {
     // but Avatars don't get updates in the same way
     if (!_texturesLoaded && getGeometry() && getGeometry()->areTexturesLoaded()) {
         _texturesLoaded = true;
-        updateRenderItems();
+        // other avatars are simulated on worker threads, their render items are updated from the main thread
+        if (QThread::currentThread() != thread()) {
+            QMetaObject::invokeMethod(this, "updateRenderItems", Qt::QueuedConnection);
+        } else {
+            updateRenderItems();
+        }
     }
 
     if (!isActive() || !_owningAvatar->isMyAvatar()) {
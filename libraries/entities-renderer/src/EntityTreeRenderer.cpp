@@ -574,7 +574,7 @@ void EntityTreeRenderer::handleSpaceUpdate(std::pair<int32_t, glm::vec4> proxyUp
 
 void EntityTreeRenderer::findBestZoneAndMaybeContainingEntities(QSet<EntityItemID>& entitiesContainingAvatar) {
     float radius = 0.01f; // for now, assume 0.01 meter radius, because we actually check the point inside later
-    QVector<QUuid> entityIDs;
+    std::vector<EntityTree::SpatialQuery> queries { EntityTree::SpatialQuery::sphere(_avatarPosition, radius, PickFilter()) };
 
     // find the entities near us
     // don't let someone else change our tree while we search
@@ -582,18 +582,13 @@ void EntityTreeRenderer::findBestZoneAndMaybeContainingEntities(QSet<EntityItemI
         auto entityTree = std::static_pointer_cast<EntityTree>(_tree);
 
         // FIXME - if EntityTree had a findEntitiesContainingPoint() this could theoretically be a little faster
-        entityTree->evalEntitiesInSphere(_avatarPosition, radius, PickFilter(), entityIDs);
+        entityTree->evalSpatialQueries(queries);
 
         LayeredZones oldLayeredZones(_layeredZones);
         _layeredZones.clear();
 
         // create a list of entities that actually contain the avatar's position
-        for (auto& entityID : entityIDs) {
-            auto entity = entityTree->findEntityByID(entityID);
-            if (!entity) {
-                continue;
-            }
-
+        for (auto& entity : queries[0].entities) {
             auto isZone = entity->getType() == EntityTypes::Zone;
             auto hasScript = !entity->getScript().isEmpty();
 
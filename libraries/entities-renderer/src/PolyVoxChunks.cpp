@@ -0,0 +1,121 @@
+//
+//  PolyVoxChunks.cpp
+//  libraries/entities-renderer/src/
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PolyVoxChunks.h"
+
+#ifdef _WIN32
+#pragma warning(push)
+#pragma warning( disable : 4267 )
+#endif
+#include <PolyVoxCore/CubicSurfaceExtractorWithNormals.h>
+#include <PolyVoxCore/MarchingCubesSurfaceExtractor.h>
+#include <PolyVoxCore/SurfaceMesh.h>
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+
+PolyVoxChunks::PolyVoxChunks(const glm::ivec3& highCorner) {
+    _numChunks = glm::max((highCorner + POLYVOX_CHUNK_SIZE - 1) / POLYVOX_CHUNK_SIZE, glm::ivec3(1));
+    _chunks.resize(_numChunks.x * _numChunks.y * _numChunks.z);
+    glm::ivec3 c;
+    for (c.z = 0; c.z < _numChunks.z; ++c.z) {
+        for (c.y = 0; c.y < _numChunks.y; ++c.y) {
+            for (c.x = 0; c.x < _numChunks.x; ++c.x) {
+                Chunk& chunk = _chunks[getIndex(c)];
+                chunk.lowCorner = c * POLYVOX_CHUNK_SIZE;
+                chunk.highCorner = glm::min(chunk.lowCorner + POLYVOX_CHUNK_SIZE, highCorner);
+            }
+        }
+    }
+}
+
+void PolyVoxChunks::markVoxel(const glm::ivec3& voxel) {
+    glm::ivec3 low = glm::max(voxel - 1, glm::ivec3(0));
+    glm::ivec3 lowChunk = glm::max((low + POLYVOX_CHUNK_SIZE - 1) / POLYVOX_CHUNK_SIZE - 1, glm::ivec3(0));
+    glm::ivec3 highChunk = glm::min((voxel + 1) / POLYVOX_CHUNK_SIZE, _numChunks - 1);
+    glm::ivec3 c;
+    for (c.z = lowChunk.z; c.z <= highChunk.z; ++c.z) {
+        for (c.y = lowChunk.y; c.y <= highChunk.y; ++c.y) {
+            for (c.x = lowChunk.x; c.x <= highChunk.x; ++c.x) {
+                _chunks[getIndex(c)].meshDirty = true;
+            }
+        }
+    }
+}
+
+void PolyVoxChunks::markAll() {
+    for (auto& chunk : _chunks) {
+        chunk.meshDirty = true;
+    }
+}
+
+std::vector<int> PolyVoxChunks::takeDirtyMeshes() {
+    std::vector<int> dirty;
+    for (int i = 0; i < (int)_chunks.size(); i++) {
+        if (_chunks[i].meshDirty) {
+            _chunks[i].meshDirty = false;
+            dirty.push_back(i);
+        }
+    }
+    return dirty;
+}
+
+void PolyVoxChunks::extractMesh(int index, PolyVox::SimpleVolume<uint8_t>* volData,
+                                PolyVoxEntityItem::PolyVoxSurfaceStyle voxelSurfaceStyle) {
+    Chunk& chunk = _chunks[index];
+    PolyVox::Region region(PolyVox::Vector3DInt32(chunk.lowCorner.x, chunk.lowCorner.y, chunk.lowCorner.z),
+                           PolyVox::Vector3DInt32(chunk.highCorner.x, chunk.highCorner.y, chunk.highCorner.z));
+
+    // A mesh object to hold the result of surface extraction
+    PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal> polyVoxMesh;
+    switch (voxelSurfaceStyle) {
+        case PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES:
+        case PolyVoxEntityItem::SURFACE_MARCHING_CUBES: {
+            PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
+                (volData, region, &polyVoxMesh);
+            surfaceExtractor.execute();
+            break;
+        }
+        case PolyVoxEntityItem::SURFACE_EDGED_CUBIC:
+        case PolyVoxEntityItem::SURFACE_CUBIC: {
+            PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
+                (volData, region, &polyVoxMesh);
+            surfaceExtractor.execute();
+            break;
+        }
+    }
+
+    // the extractors emit positions relative to the region, move them into _volData coordinates
+    const PolyVox::Vector3DFloat regionOffset((float)chunk.lowCorner.x, (float)chunk.lowCorner.y, (float)chunk.lowCorner.z);
+    chunk.vertices = polyVoxMesh.getRawVertexData();
+    for (auto& vertex : chunk.vertices) {
+        vertex.setPosition(vertex.getPosition() + regionOffset);
+    }
+    chunk.indices = polyVoxMesh.getIndices();
+    chunk.shapeDirty = true;
+}
+
+void PolyVoxChunks::stitchMeshes(std::vector<PolyVox::PositionMaterialNormal>& vertices, std::vector<uint32_t>& indices) const {
+    size_t numVertices = 0;
+    size_t numIndices = 0;
+    for (const auto& chunk : _chunks) {
+        numVertices += chunk.vertices.size();
+        numIndices += chunk.indices.size();
+    }
+    vertices.reserve(vertices.size() + numVertices);
+    indices.reserve(indices.size() + numIndices);
+    for (const auto& chunk : _chunks) {
+        uint32_t baseVertex = (uint32_t)vertices.size();
+        vertices.insert(vertices.end(), chunk.vertices.begin(), chunk.vertices.end());
+        for (uint32_t index : chunk.indices) {
+            indices.push_back(baseVertex + index);
+        }
+    }
+}
@@ -0,0 +1,67 @@
+//
+//  PolyVoxChunks.h
+//  libraries/entities-renderer/src/
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PolyVoxChunks_h
+#define hifi_PolyVoxChunks_h
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <PolyVoxCore/SimpleVolume.h>
+#include <PolyVoxCore/VertexTypes.h>
+
+#include <PolyVoxEntityItem.h>
+#include <ShapeInfo.h>
+
+const int POLYVOX_CHUNK_SIZE = 16;
+
+// Splits the cells of a _volData into blocks that are extracted and hulled independently.  Chunk regions are in
+// _volData coordinates and share their boundary voxels with their neighbors, like PolyVox regions do.
+class PolyVoxChunks {
+public:
+    struct Chunk {
+        glm::ivec3 lowCorner;
+        glm::ivec3 highCorner;
+        std::vector<PolyVox::PositionMaterialNormal> vertices; // in _volData coordinates
+        std::vector<uint32_t> indices;
+        ShapeInfo::PointCollection hulls; // in voxel coordinates, voxelToLocalMatrix is applied when stitching
+        bool meshDirty { true };
+        bool shapeDirty { true };
+    };
+
+    PolyVoxChunks(const glm::ivec3& highCorner);
+
+    // A voxel feeds the cells on both sides of it and the gradients of the vertices next to it, so
+    // mark every chunk whose region comes within one voxel of it
+    void markVoxel(const glm::ivec3& voxel);
+    // when every chunk's mesh is stale, e.g. after switching between cubic and marching cubes
+    void markAll();
+
+    // called with the entity write-locked, the returned chunks are then owned by the mesh worker
+    std::vector<int> takeDirtyMeshes();
+
+    // runs the extractor for voxelSurfaceStyle over one chunk's region, volData must be read-locked
+    void extractMesh(int index, PolyVox::SimpleVolume<uint8_t>* volData,
+                     PolyVoxEntityItem::PolyVoxSurfaceStyle voxelSurfaceStyle);
+    // concatenates the chunk meshes into one
+    void stitchMeshes(std::vector<PolyVox::PositionMaterialNormal>& vertices, std::vector<uint32_t>& indices) const;
+
+    Chunk& getChunk(int index) { return _chunks[index]; }
+    std::vector<Chunk>& getChunks() { return _chunks; }
+    const glm::ivec3& getNumChunks() const { return _numChunks; }
+    int getIndex(const glm::ivec3& c) const { return (c.z * _numChunks.y + c.y) * _numChunks.x + c.x; }
+
+private:
+    glm::ivec3 _numChunks;
+    std::vector<Chunk> _chunks;
+};
+
+#endif // hifi_PolyVoxChunks_h
@@ -40,13 +40,7 @@ static ShapePipelinePointer shapePipelineFactory(const ShapePlumber& plumber, co
     return std::make_shared<render::ShapePipeline>(texturedPipeline, nullptr, nullptr, nullptr);
 }
 
-struct GpuParticle {
-    GpuParticle(const glm::vec3& xyzIn, const glm::vec2& uvIn) : xyz(xyzIn), uv(uvIn) {}
-    glm::vec3 xyz; // Position
-    glm::vec2 uv; // Lifetime + seed
-};
-
-using GpuParticles = std::vector<GpuParticle>;
+using GpuParticle = ParticleSimulation::Instance;
 
 ParticleEffectEntityRenderer::ParticleEffectEntityRenderer(const EntityItemPointer& entity) : Parent(entity) {
     ParticleUniforms uniforms;
@@ -64,6 +58,10 @@ ParticleEffectEntityRenderer::ParticleEffectEntityRenderer(const EntityItemPoint
     });
 }
 
+ParticleEffectEntityRenderer::~ParticleEffectEntityRenderer() {
+    _simulationTask.wait();
+}
+
 void ParticleEffectEntityRenderer::doRenderUpdateSynchronousTyped(const ScenePointer& scene, Transaction& transaction, const TypedEntityPointer& entity) {
     auto newParticleProperties = entity->getParticleProperties();
     if (!newParticleProperties.valid()) {
@@ -367,9 +365,11 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
     return particle;
 }
 
-void ParticleEffectEntityRenderer::stepSimulation() {
+// Runs on a worker thread, only touches the simulation state and _simulatedParticles
+void ParticleEffectEntityRenderer::stepSimulation(const Transform& modelTransform) {
     if (_lastSimulated == 0) {
         _lastSimulated = usecTimestampNow();
+        _simulatedParticles.clear();
         return;
     }
 
@@ -386,7 +386,6 @@ void ParticleEffectEntityRenderer::stepSimulation() {
         geometryResource = _geometryResource;
     });
 
-    const auto& modelTransform = getModelTransform();
     if (_emitting && particleProperties.emitting() &&
         (shapeType != SHAPE_TYPE_COMPOUND || (geometryResource && geometryResource->isLoaded()))) {
         uint64_t emitInterval = particleProperties.emitIntervalUsecs();
@@ -397,7 +396,7 @@ void ParticleEffectEntityRenderer::stepSimulation() {
                     computeTriangles(geometryResource->getHFMModel());
                 }
                 // emit particle
-                _cpuParticles.push_back(createParticle(now, modelTransform, particleProperties, shapeType, geometryResource, _triangleInfo));
+                _cpuParticles.add(createParticle(now, modelTransform, particleProperties, shapeType, geometryResource, _triangleInfo));
                 _timeUntilNextEmit = emitInterval;
                 if (emitInterval < timeRemaining) {
                     timeRemaining -= emitInterval;
@@ -409,39 +408,18 @@ void ParticleEffectEntityRenderer::stepSimulation() {
     }
 
     // Kill any particles that have expired or are over the max size
-    while (_cpuParticles.size() > particleProperties.maxParticles || (!_cpuParticles.empty() && _cpuParticles.front().expiration <= now)) {
-        _cpuParticles.pop_front();
-    }
+    _cpuParticles.expire(now, particleProperties.maxParticles);
 
     const float deltaTime = (float)interval / (float)USECS_PER_SECOND;
     // update the particles
-    for (auto& particle : _cpuParticles) {
-        if (_prevEmitterShouldTrail != particleProperties.emission.shouldTrail) {
-            if (_prevEmitterShouldTrail) {
-                particle.relativePosition = particle.relativePosition + particle.basePosition - modelTransform.getTranslation();
-            }
-            particle.basePosition = modelTransform.getTranslation();
-        }
-        particle.integrate(deltaTime);
+    if (_prevEmitterShouldTrail != particleProperties.emission.shouldTrail) {
+        _cpuParticles.rebase(modelTransform.getTranslation(), _prevEmitterShouldTrail);
     }
+    _cpuParticles.integrate(deltaTime);
     _prevEmitterShouldTrail = particleProperties.emission.shouldTrail;
 
     // Build particle primitives
-    static GpuParticles gpuParticles;
-    gpuParticles.clear();
-    gpuParticles.reserve(_cpuParticles.size()); // Reserve space
-    std::transform(_cpuParticles.begin(), _cpuParticles.end(), std::back_inserter(gpuParticles), [&particleProperties, &modelTransform] (const CpuParticle& particle) {
-        glm::vec3 position = particle.relativePosition + (particleProperties.emission.shouldTrail ? particle.basePosition : modelTransform.getTranslation());
-        return GpuParticle(position, glm::vec2(particle.lifetime, particle.seed));
-    });
-
-    // Update particle buffer
-    auto& particleBuffer = _particleBuffer;
-    size_t numBytes = sizeof(GpuParticle) * gpuParticles.size();
-    particleBuffer->resize(numBytes);
-    if (numBytes != 0) {
-        particleBuffer->setData(numBytes, (const gpu::Byte*)gpuParticles.data());
-    }
+    _cpuParticles.writeInstances(modelTransform.getTranslation(), particleProperties.emission.shouldTrail, _simulatedParticles);
 }
 
 void ParticleEffectEntityRenderer::doRender(RenderArgs* args) {
@@ -449,8 +427,24 @@ void ParticleEffectEntityRenderer::doRender(RenderArgs* args) {
         return;
     }
 
-    // FIXME migrate simulation to a compute stage
-    stepSimulation();
+    // Pick up the particles simulated during the previous frame and start on the next step, so the
+    // emitters integrate on the worker pool in parallel with each other and with rendering
+    if (_simulationPending) {
+        _simulationTask.wait();
+        _simulationPending = false;
+        size_t numBytes = sizeof(GpuParticle) * _simulatedParticles.size();
+        _particleBuffer->resize(numBytes);
+        if (numBytes != 0) {
+            _particleBuffer->setData(numBytes, (const gpu::Byte*)_simulatedParticles.data());
+        }
+    }
+    Transform modelTransform = resultWithReadLock<Transform>([&] {
+        return getModelTransform();
+    });
+    _simulationPending = true;
+    _simulationTask.run([this, modelTransform] {
+        stepSimulation(modelTransform);
+    });
 
     gpu::Batch& batch = *args->_batch;
     batch.setResourceTexture(0, _networkTexture->getGPUTexture());
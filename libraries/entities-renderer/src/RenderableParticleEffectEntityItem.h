@@ -11,8 +11,11 @@
 #ifndef hifi_RenderableParticleEffectEntityItem_h
 #define hifi_RenderableParticleEffectEntityItem_h
 
+#include <tbb/task_group.h>
+
 #include "RenderableEntityItem.h"
 #include <ParticleEffectEntityItem.h>
+#include <ParticleSimulation.h>
 #include <TextureCache.h>
 
 namespace render { namespace entities {
@@ -23,6 +26,7 @@ class ParticleEffectEntityRenderer : public TypedEntityRenderer<ParticleEffectEn
 
 public:
     ParticleEffectEntityRenderer(const EntityItemPointer& entity);
+    ~ParticleEffectEntityRenderer();
 
 protected:
     virtual void doRenderUpdateSynchronousTyped(const ScenePointer& scene, Transaction& transaction, const TypedEntityPointer& entity) override;
@@ -42,25 +46,8 @@ private:
     using BufferView = gpu::BufferView;
 
     // CPU particles
-    // FIXME either switch to GPU compute particles or switch to simd updating of the particles
-    struct CpuParticle {
-        float seed { 0.0f };
-        uint64_t expiration { 0 };
-        float lifetime { 0.0f };
-        glm::vec3 basePosition;
-        glm::vec3 relativePosition;
-        glm::vec3 velocity;
-        glm::vec3 acceleration;
-
-        void integrate(float deltaTime) {
-            glm::vec3 atSquared = (0.5f * deltaTime * deltaTime) * acceleration;
-            relativePosition += velocity * deltaTime + atSquared;
-            velocity += acceleration * deltaTime;
-            lifetime += deltaTime;
-        }
-    };
-    using CpuParticles = std::deque<CpuParticle>;
-
+    using CpuParticle = ParticleSimulation::Particle;
+    using GpuParticles = ParticleSimulation::Instances;
 
     template<typename T>
     struct InterpolationData {
@@ -91,15 +78,21 @@ private:
     static CpuParticle createParticle(uint64_t now, const Transform& baseTransform, const particle::Properties& particleProperties,
                                       const ShapeType& shapeType, const GeometryResource::Pointer& geometryResource,
                                       const TriangleInfo& triangleInfo);
-    void stepSimulation();
+    void stepSimulation(const Transform& modelTransform);
 
     particle::Properties _particleProperties;
     bool _prevEmitterShouldTrail;
     bool _prevEmitterShouldTrailInitialized { false };
-    CpuParticles _cpuParticles;
+    ParticleSimulation _cpuParticles;
     bool _emitting { false };
     uint64_t _timeUntilNextEmit { 0 };
     BufferPointer _particleBuffer { std::make_shared<Buffer>() };
+
+    // The simulation steps on a worker while the frame renders, writing into _simulatedParticles.
+    // doRender waits for the previous step, uploads its instances and starts the next one.
+    tbb::task_group _simulationTask;
+    bool _simulationPending { false };
+    GpuParticles _simulatedParticles;
     BufferView _uniformBuffer;
     quint64 _lastSimulated { 0 };
 
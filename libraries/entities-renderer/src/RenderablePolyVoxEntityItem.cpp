@@ -73,6 +73,7 @@
 
 #include "RenderablePolyVoxEntityItem.h"
 #include "PhysicalEntitySimulation.h"
+#include "PolyVoxChunks.h"
 
 const float MARCHING_CUBE_COLLISION_HULL_OFFSET = 0.5;
 
@@ -147,6 +148,10 @@ const float MARCHING_CUBE_COLLISION_HULL_OFFSET = 0.5;
   knit together.  This is handled by tellNeighborsToRecopyEdges and copyUpperEdgesFromNeighbors.  In these functions, variable
   names have XP for x-positive, XN x-negative, etc.
 
+  _volData is meshed in chunks of POLYVOX_CHUNK_SIZE^3 voxels (see PolyVoxChunks).  Every voxel change marks the
+  chunks whose surface it can affect, and recomputeMesh only re-extracts those chunks before stitching all the
+  chunk meshes into _mesh.  computeShapeInfoWorker likewise only rebuilds the collision hulls of re-meshed chunks.
+
  */
 
  // FIXME move to GLM helpers
@@ -223,6 +228,9 @@ void RenderablePolyVoxEntityItem::setVoxelSurfaceStyle(PolyVoxSurfaceStyle voxel
             _volData.reset();
             _voxelDataDirty = true;
             volSizeChanged = true;
+        } else if (_chunks) {
+            // the voxels are kept but every chunk was meshed with the other extractor
+            _chunks->markAll();
         }
         _voxelSurfaceStyle = voxelSurfaceStyle;
         startUpdates();
@@ -940,6 +948,7 @@ void RenderablePolyVoxEntityItem::setVoxelVolumeSize(const glm::vec3& voxelVolum
         _volData.reset(new PolyVox::SimpleVolume<uint8_t>(PolyVox::Region(lowCorner, highCorner)));
         // having the "outside of voxel-space" value be 255 has helped me notice some problems.
         _volData->setBorderValue(255);
+        _chunks = std::make_shared<PolyVoxChunks>(ivec3(highCorner.getX(), highCorner.getY(), highCorner.getZ()));
     });
 
     tellNeighborsToRecopyEdges(true);
@@ -990,8 +999,16 @@ uint8_t RenderablePolyVoxEntityItem::getVoxelInternal(const ivec3& v) const {
 }
 
 
+void RenderablePolyVoxEntityItem::markVoxelDirty(int x, int y, int z) {
+    // x, y, z are in _volData coordinates.  This assumes that the caller has write-locked the entity.
+    if (_chunks) {
+        _chunks->markVoxel(ivec3(x, y, z));
+    }
+}
+
 void RenderablePolyVoxEntityItem::setVoxelMarkNeighbors(int x, int y, int z, uint8_t toValue) {
     _volData->setVoxelAt(x, y, z, toValue);
+    markVoxelDirty(x, y, z);
     if (x == 0) {
         _neighborXNeedsUpdate = true;
         startUpdates();
@@ -1145,13 +1162,20 @@ void RenderablePolyVoxEntityItem::compressVolumeDataAndSendEditPacket() {
 
 void RenderablePolyVoxEntityItem::compressVolumeDataFinished(const QByteArray& voxelData) {
     // compressed voxel information from the entity-server
+    bool changed = false;
     withWriteLock([&] {
         if (voxelData.size() > 0 && _voxelData != voxelData) {
             _voxelData = voxelData;
+            changed = true;
         }
         _state = PolyVoxState::CompressingFinished;
     });
 
+    if (!changed) {
+        // the edits cancelled out (or didn't fit), there's nothing new to send
+        return;
+    }
+
     auto now = usecTimestampNow();
     setLastEdited(now);
     setLastBroadcast(now);
@@ -1244,6 +1268,7 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                         uint8_t prevValue = _volData->getVoxelAt(x, y, z);
                         if (prevValue != neighborValue) {
                             _volData->setVoxelAt(x, y, z, neighborValue);
+                            markVoxelDirty(x, y, z);
                             _volDataDirty = true;
                         }
                     }
@@ -1264,6 +1289,7 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                         uint8_t prevValue = _volData->getVoxelAt(x, y, z);
                         if (prevValue != neighborValue) {
                             _volData->setVoxelAt(x, y, z, neighborValue);
+                            markVoxelDirty(x, y, z);
                             _volDataDirty = true;
                         }
                     }
@@ -1284,6 +1310,7 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                         uint8_t prevValue = _volData->getVoxelAt(x, y, z);
                         if (prevValue != neighborValue) {
                             _volData->setVoxelAt(x, y, z, neighborValue);
+                            markVoxelDirty(x, y, z);
                             _volDataDirty = true;
                         }
                     }
@@ -1324,49 +1351,47 @@ void RenderablePolyVoxEntityItem::tellNeighborsToRecopyEdges(bool force) {
 
 
 void RenderablePolyVoxEntityItem::recomputeMesh() {
-    // use _volData to make a renderable mesh
+    // use _volData to make a renderable mesh, re-extracting only the chunks that changed since the last time
     PolyVoxSurfaceStyle voxelSurfaceStyle;
-    withReadLock([&] {
+    std::shared_ptr<PolyVoxChunks> chunks;
+    std::vector<int> dirtyChunks;
+    withWriteLock([&] {
         voxelSurfaceStyle = _voxelSurfaceStyle;
+        chunks = _chunks;
+        if (chunks) {
+            dirtyChunks = chunks->takeDirtyMeshes();
+        }
     });
 
     auto entity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(getThisPointer());
 
-    QtConcurrent::run([entity, voxelSurfaceStyle] {
+    QtConcurrent::run([entity, voxelSurfaceStyle, chunks, dirtyChunks] {
         graphics::MeshPointer mesh(new graphics::Mesh());
 
-        // A mesh object to hold the result of surface extraction
-        PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal> polyVoxMesh;
-
         entity->withReadLock([&] {
             PolyVox::SimpleVolume<uint8_t>* volData = entity->getVolData();
-            switch (voxelSurfaceStyle) {
-                case PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES:
-                case PolyVoxEntityItem::SURFACE_MARCHING_CUBES: {
-                    PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
-                }
-                case PolyVoxEntityItem::SURFACE_EDGED_CUBIC:
-                case PolyVoxEntityItem::SURFACE_CUBIC: {
-                    PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
-                }
+            if (!volData || !chunks) {
+                return;
+            }
+            for (int index : dirtyChunks) {
+                chunks->extractMesh(index, volData, voxelSurfaceStyle);
             }
         });
 
+        // stitch the chunks back into a single mesh
+        std::vector<PolyVox::PositionMaterialNormal> vecVertices;
+        std::vector<uint32_t> vecIndices;
+        if (chunks) {
+            chunks->stitchMeshes(vecVertices, vecIndices);
+        }
+
         // convert PolyVox mesh to a Sam mesh
-        const std::vector<uint32_t>& vecIndices = polyVoxMesh.getIndices();
         auto indexBuffer = std::make_shared<gpu::Buffer>(vecIndices.size() * sizeof(uint32_t),
                                                          (gpu::Byte*)vecIndices.data());
         auto indexBufferPtr = gpu::BufferPointer(indexBuffer);
         gpu::BufferView indexBufferView(indexBufferPtr, gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::INDEX));
         mesh->setIndexBuffer(indexBufferView);
 
-        const std::vector<PolyVox::PositionMaterialNormal>& vecVertices = polyVoxMesh.getRawVertexData();
         auto vertexBuffer = std::make_shared<gpu::Buffer>(vecVertices.size() * sizeof(PolyVox::PositionMaterialNormal),
                                                           (gpu::Byte*)vecVertices.data());
         auto vertexBufferPtr = gpu::BufferPointer(vertexBuffer);
@@ -1413,132 +1438,125 @@ void RenderablePolyVoxEntityItem::setMesh(graphics::MeshPointer mesh) {
 
 void RenderablePolyVoxEntityItem::computeShapeInfoWorker() {
     // this creates a collision-shape for the physics engine.  The shape comes from
-    // _volData for cubic extractors and from _mesh for marching-cube extractors
+    // _volData for cubic extractors and from the chunk meshes for marching-cube extractors.
+    // Only the chunks that were re-meshed since the last shape have their hulls rebuilt.
 
     EntityItemPointer entity = getThisPointer();
 
     PolyVoxSurfaceStyle voxelSurfaceStyle;
     glm::vec3 voxelVolumeSize;
-    graphics::MeshPointer mesh;
+    std::shared_ptr<PolyVoxChunks> chunks;
 
     withReadLock([&] {
         voxelSurfaceStyle = _voxelSurfaceStyle;
         voxelVolumeSize = _voxelVolumeSize;
-        mesh = _mesh;
+        chunks = _chunks;
     });
 
-    QtConcurrent::run([entity, voxelSurfaceStyle, voxelVolumeSize, mesh] {
+    QtConcurrent::run([entity, voxelSurfaceStyle, voxelVolumeSize, chunks] {
         auto polyVoxEntity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity);
         QVector<QVector<glm::vec3>> pointCollection;
         AABox box;
         glm::mat4 vtoM = std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity)->voxelToLocalMatrix();
 
-        if (voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_MARCHING_CUBES ||
-            voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES) {
-            // pull each triangle in the mesh into a polyhedron which can be collided with
-            unsigned int i = 0;
-
-            const gpu::BufferView& vertexBufferView = mesh->getVertexBuffer();
-            const gpu::BufferView& indexBufferView = mesh->getIndexBuffer();
+        if (!chunks) {
+            polyVoxEntity->setCollisionPoints(pointCollection, box);
+            return;
+        }
 
-            gpu::BufferView::Iterator<const uint32_t> it = indexBufferView.cbegin<uint32_t>();
-            while (it != indexBufferView.cend<uint32_t>()) {
-                uint32_t p0Index = *(it++);
-                uint32_t p1Index = *(it++);
-                uint32_t p2Index = *(it++);
+        bool marchingCubes = voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_MARCHING_CUBES ||
+            voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES;
+        // chunks are in _volData coordinates, the cubic hulls are built from user voxel coordinates
+        ivec3 edgeOffset = ivec3(PolyVoxEntityItem::isEdged(voxelSurfaceStyle) ? 1 : 0);
 
-                const glm::vec3& p0 = vertexBufferView.get<const glm::vec3>(p0Index);
-                const glm::vec3& p1 = vertexBufferView.get<const glm::vec3>(p1Index);
-                const glm::vec3& p2 = vertexBufferView.get<const glm::vec3>(p2Index);
+        for (auto& chunk : chunks->getChunks()) {
+            if (!chunk.shapeDirty) {
+                continue;
+            }
+            chunk.shapeDirty = false;
+            chunk.hulls.clear();
+
+            if (marchingCubes) {
+                // pull each triangle in the mesh into a polyhedron which can be collided with
+                for (size_t i = 0; i + 2 < chunk.indices.size(); i += 3) {
+                    const auto& p0Position = chunk.vertices[chunk.indices[i]].getPosition();
+                    const auto& p1Position = chunk.vertices[chunk.indices[i + 1]].getPosition();
+                    const auto& p2Position = chunk.vertices[chunk.indices[i + 2]].getPosition();
+                    glm::vec3 p0(p0Position.getX(), p0Position.getY(), p0Position.getZ());
+                    glm::vec3 p1(p1Position.getX(), p1Position.getY(), p1Position.getZ());
+                    glm::vec3 p2(p2Position.getX(), p2Position.getY(), p2Position.getZ());
+
+                    glm::vec3 av = (p0 + p1 + p2) / 3.0f; // center of the triangular face
+                    glm::vec3 normal = glm::normalize(glm::cross(p1 - p0, p2 - p0));
+                    glm::vec3 p3 = av - normal * MARCHING_CUBE_COLLISION_HULL_OFFSET;
 
-                glm::vec3 av = (p0 + p1 + p2) / 3.0f; // center of the triangular face
-                glm::vec3 normal = glm::normalize(glm::cross(p1 - p0, p2 - p0));
-                glm::vec3 p3 = av - normal * MARCHING_CUBE_COLLISION_HULL_OFFSET;
+                    QVector<glm::vec3> pointsInPart;
+                    pointsInPart << p0;
+                    pointsInPart << p1;
+                    pointsInPart << p2;
+                    pointsInPart << p3;
+                    chunk.hulls << pointsInPart;
+                }
+            } else {
+                ivec3 low = glm::max(chunk.lowCorner - edgeOffset, ivec3(0));
+                ivec3 high = glm::min(chunk.highCorner - edgeOffset, ivec3(voxelVolumeSize));
+                polyVoxEntity->withReadLock([&] {
+                    loop3(low, high, [&](const ivec3& v) {
+                        if (polyVoxEntity->getVoxelInternal(v) == 0) {
+                            return;
+                        }
+                        const auto& x = v.x;
+                        const auto& y = v.y;
+                        const auto& z = v.z;
+                        if (glm::all(glm::greaterThan(v, ivec3(0))) &&
+                            glm::all(glm::lessThan(v, ivec3(voxelVolumeSize) - 1)) &&
+                            (polyVoxEntity->getVoxelInternal({ x - 1, y, z }) > 0) &&
+                            (polyVoxEntity->getVoxelInternal({ x, y - 1, z }) > 0) &&
+                            (polyVoxEntity->getVoxelInternal({ x, y, z - 1 }) > 0) &&
+                            (polyVoxEntity->getVoxelInternal({ x + 1, y, z }) > 0) &&
+                            (polyVoxEntity->getVoxelInternal({ x, y + 1, z }) > 0) &&
+                            (polyVoxEntity->getVoxelInternal({ x, y, z + 1 }) > 0)) {
+                            // this voxel has neighbors in every cardinal direction, so there's no need
+                            // to include it in the collision hull.
+                            return;
+                        }
 
-                glm::vec3 p0Model = glm::vec3(vtoM * glm::vec4(p0, 1.0f));
-                glm::vec3 p1Model = glm::vec3(vtoM * glm::vec4(p1, 1.0f));
-                glm::vec3 p2Model = glm::vec3(vtoM * glm::vec4(p2, 1.0f));
-                glm::vec3 p3Model = glm::vec3(vtoM * glm::vec4(p3, 1.0f));
+                        float offL = -0.5f;
+                        float offH = 0.5f;
+                        if (voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_EDGED_CUBIC) {
+                            offL += 1.0f;
+                            offH += 1.0f;
+                        }
 
-                box += p0Model;
-                box += p1Model;
-                box += p2Model;
-                box += p3Model;
+                        QVector<glm::vec3> pointsInPart;
+                        pointsInPart << glm::vec3(x + offL, y + offL, z + offL);
+                        pointsInPart << glm::vec3(x + offL, y + offL, z + offH);
+                        pointsInPart << glm::vec3(x + offL, y + offH, z + offL);
+                        pointsInPart << glm::vec3(x + offL, y + offH, z + offH);
+                        pointsInPart << glm::vec3(x + offH, y + offL, z + offL);
+                        pointsInPart << glm::vec3(x + offH, y + offL, z + offH);
+                        pointsInPart << glm::vec3(x + offH, y + offH, z + offL);
+                        pointsInPart << glm::vec3(x + offH, y + offH, z + offH);
+                        chunk.hulls << pointsInPart;
+                    });
+                });
+            }
+        }
 
+        // the hulls are kept in voxel space so a change of registration point or dimensions
+        // doesn't invalidate them, move them into model space here
+        for (const auto& chunk : chunks->getChunks()) {
+            for (const auto& hull : chunk.hulls) {
                 QVector<glm::vec3> pointsInPart;
-                pointsInPart << p0Model;
-                pointsInPart << p1Model;
-                pointsInPart << p2Model;
-                pointsInPart << p3Model;
+                pointsInPart.reserve(hull.size());
+                for (const auto& point : hull) {
+                    glm::vec3 pointModel = glm::vec3(vtoM * glm::vec4(point, 1.0f));
+                    box += pointModel;
+                    pointsInPart << pointModel;
+                }
                 // add next convex hull
-                QVector<glm::vec3> newMeshPoints;
-                pointCollection << newMeshPoints;
-                // add points to the new convex hull
-                pointCollection[i++] << pointsInPart;
+                pointCollection << pointsInPart;
             }
-        } else {
-            unsigned int i = 0;
-            polyVoxEntity->forEachVoxelValue(voxelVolumeSize, [&](const ivec3& v, uint8_t value) {
-                if (value > 0) {
-                    const auto& x = v.x;
-                    const auto& y = v.y;
-                    const auto& z = v.z;
-                    if (glm::all(glm::greaterThan(v, ivec3(0))) &&
-                        glm::all(glm::lessThan(v, ivec3(voxelVolumeSize) - 1)) &&
-                        (polyVoxEntity->getVoxelInternal({ x - 1, y, z }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x, y - 1, z }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x, y, z - 1 }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x + 1, y, z }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x, y + 1, z }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x, y, z + 1 }) > 0)) {
-                        // this voxel has neighbors in every cardinal direction, so there's no need
-                        // to include it in the collision hull.
-                        return;
-                    }
-
-                    QVector<glm::vec3> pointsInPart;
-
-                    float offL = -0.5f;
-                    float offH = 0.5f;
-                    if (voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_EDGED_CUBIC) {
-                        offL += 1.0f;
-                        offH += 1.0f;
-                    }
-
-                    glm::vec3 p000 = glm::vec3(vtoM * glm::vec4(x + offL, y + offL, z + offL, 1.0f));
-                    glm::vec3 p001 = glm::vec3(vtoM * glm::vec4(x + offL, y + offL, z + offH, 1.0f));
-                    glm::vec3 p010 = glm::vec3(vtoM * glm::vec4(x + offL, y + offH, z + offL, 1.0f));
-                    glm::vec3 p011 = glm::vec3(vtoM * glm::vec4(x + offL, y + offH, z + offH, 1.0f));
-                    glm::vec3 p100 = glm::vec3(vtoM * glm::vec4(x + offH, y + offL, z + offL, 1.0f));
-                    glm::vec3 p101 = glm::vec3(vtoM * glm::vec4(x + offH, y + offL, z + offH, 1.0f));
-                    glm::vec3 p110 = glm::vec3(vtoM * glm::vec4(x + offH, y + offH, z + offL, 1.0f));
-                    glm::vec3 p111 = glm::vec3(vtoM * glm::vec4(x + offH, y + offH, z + offH, 1.0f));
-
-                    box += p000;
-                    box += p001;
-                    box += p010;
-                    box += p011;
-                    box += p100;
-                    box += p101;
-                    box += p110;
-                    box += p111;
-
-                    pointsInPart << p000;
-                    pointsInPart << p001;
-                    pointsInPart << p010;
-                    pointsInPart << p011;
-                    pointsInPart << p100;
-                    pointsInPart << p101;
-                    pointsInPart << p110;
-                    pointsInPart << p111;
-
-                    // add next convex hull
-                    QVector<glm::vec3> newMeshPoints;
-                    pointCollection << newMeshPoints;
-                    // add points to the new convex hull
-                    pointCollection[i++] << pointsInPart;
-                }
-            });
         }
         polyVoxEntity->setCollisionPoints(pointCollection, box);
     });
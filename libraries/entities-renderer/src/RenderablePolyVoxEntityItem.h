@@ -32,6 +32,8 @@ namespace render { namespace entities {
 class PolyVoxEntityRenderer;
 } }
 
+class PolyVoxChunks;
+
 
 enum class PolyVoxState {
     Ready,
@@ -132,6 +134,7 @@ public:
     uint8_t getVoxelInternal(const ivec3& v) const;
     bool setVoxelInternal(const ivec3& v, uint8_t toValue);
     void setVoxelMarkNeighbors(int x, int y, int z, uint8_t toValue);
+    void markVoxelDirty(int x, int y, int z);
 
     void compressVolumeDataFinished(const QByteArray& voxelData);
     void neighborXEdgeChanged() { withWriteLock([&] { _updateFromNeighborXEdge = true; }); startUpdates(); }
@@ -177,6 +180,7 @@ private:
     ShapeInfo _shapeInfo;
 
     std::shared_ptr<PolyVox::SimpleVolume<uint8_t>> _volData;
+    std::shared_ptr<PolyVoxChunks> _chunks; // per chunk meshes and collision hulls of _volData, and which are stale
     int _onCount; // how many non-zero voxels are in _volData
 
     bool _neighborXNeedsUpdate { false };
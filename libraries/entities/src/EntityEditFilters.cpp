@@ -14,6 +14,7 @@
 #include <QUrl>
 
 #include <ResourceManager.h>
+#include <SharedUtil.h>
 #include <shared/ScriptInitializerMixin.h>
 
 QList<EntityItemID> EntityEditFilters::getZonesByPosition(glm::vec3& position) {
@@ -73,8 +74,21 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
                 return true; // accept the message
             }
 
-            auto oldProperties = propertiesIn.getDesiredProperties();
             auto specifiedProperties = propertiesIn.getChangedProperties();
+            if (!filterData.wantsAllProperties) {
+                // only marshal the properties the filter said it reads, and don't call it at all for
+                // edits that don't touch any of them
+                specifiedProperties &= filterData.includedProperties;
+                if (specifiedProperties.isEmpty() &&
+                    (filterType == EntityTree::FilterType::Edit || filterType == EntityTree::FilterType::Physics)) {
+                    filterData.stats->skipped++;
+                    continue;
+                }
+            }
+
+            quint64 startTime = usecTimestampNow();
+
+            auto oldProperties = propertiesIn.getDesiredProperties();
             propertiesIn.setDesiredProperties(specifiedProperties);
             QScriptValue inputValues = propertiesIn.copyToScriptValue(filterData.engine, false, true, true);
             propertiesIn.setDesiredProperties(oldProperties);
@@ -131,6 +145,13 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
 
             QScriptValue result = filterData.filterFn.call(_nullObjectForFilter, args);
 
+            quint64 elapsed = usecTimestampNow() - startTime;
+            auto& stats = *filterData.stats;
+            stats.calls++;
+            stats.totalUsecs += elapsed;
+            quint64 maxUsecs = stats.maxUsecs;
+            while (elapsed > maxUsecs && !stats.maxUsecs.compare_exchange_weak(maxUsecs, elapsed)) { }
+
             if (filterData.uncaughtExceptions()) {
                 return false;
             }
@@ -164,6 +185,22 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
     return true;
 }
 
+QJsonObject EntityEditFilters::getFilterStats() {
+    QJsonObject result;
+    QReadLocker readLock(&_lock);
+    for (auto itr = _filterDataMap.cbegin(); itr != _filterDataMap.cend(); ++itr) {
+        const auto& stats = *itr.value().stats;
+        quint64 calls = stats.calls;
+        QJsonObject filterStats;
+        filterStats["calls"] = (double)calls;
+        filterStats["skipped"] = (double)stats.skipped;
+        filterStats["avgUsecs"] = calls > 0 ? (double)stats.totalUsecs / calls : 0.0;
+        filterStats["maxUsecs"] = (double)stats.maxUsecs;
+        result[itr.key().isInvalidID() ? "domain" : itr.key().toString()] = filterStats;
+    }
+    return result;
+}
+
 void EntityEditFilters::removeFilter(EntityItemID entityID) {
     QWriteLocker writeLock(&_lock);
     FilterData filterData = _filterDataMap.value(entityID);
@@ -307,6 +344,16 @@ void EntityEditFilters::scriptRequestFinished(EntityItemID entityID) {
                 QScriptValue wantsToFilterDeleteValue = filterData.filterFn.property("wantsToFilterDelete");
                 filterData.wantsToFilterDelete = wantsToFilterDeleteValue.isBool() ? wantsToFilterDeleteValue.toBool() : false;
 
+                // check to see if the filterFn declares which of the incoming properties it reads
+                QScriptValue wantsPropertiesValue = filterData.filterFn.property("wantsProperties");
+                // if the wantsProperties is a string, or list of strings, then only those properties are passed
+                // to the filter, and edits which change none of them skip the filter. Otherwise all of the
+                // changed properties are passed.
+                if (wantsPropertiesValue.isString() || wantsPropertiesValue.isArray()) {
+                    EntityPropertyFlagsFromScriptValue(wantsPropertiesValue, filterData.includedProperties);
+                    filterData.wantsAllProperties = false;
+                }
+
                 // check to see if the filterFn has properties asking for Original props
                 QScriptValue wantsOriginalPropertiesValue = filterData.filterFn.property("wantsOriginalProperties");
                 // if the wantsOriginalProperties is a boolean, or a string, or list of strings, then evaluate as follows:
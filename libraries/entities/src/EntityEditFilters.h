@@ -12,12 +12,15 @@
 #define hifi_EntityEditFilters_h
 
 #include <QObject>
+#include <QJsonObject>
 #include <QMap>
 #include <QScriptValue>
 #include <QScriptEngine>
 #include <glm/glm.hpp>
 
+#include <atomic>
 #include <functional>
+#include <memory>
 
 #include "EntityItemID.h"
 #include "EntityItemProperties.h"
@@ -26,8 +29,17 @@
 class EntityEditFilters : public QObject, public Dependency {
     Q_OBJECT
 public:
+    // shared by all copies of a FilterData, so the counters survive the copy made under the read lock in filter()
+    struct FilterStats {
+        std::atomic<quint64> calls { 0 };
+        std::atomic<quint64> skipped { 0 };
+        std::atomic<quint64> totalUsecs { 0 };
+        std::atomic<quint64> maxUsecs { 0 };
+    };
+
     struct FilterData {
         QScriptValue filterFn;
+        bool wantsAllProperties { true };
         bool wantsOriginalProperties { false };
         bool wantsZoneProperties { false };
 
@@ -36,6 +48,7 @@ public:
         bool wantsToFilterPhysics { true };
         bool wantsToFilterDelete { true };
 
+        EntityPropertyFlags includedProperties;
         EntityPropertyFlags includedOriginalProperties;
         EntityPropertyFlags includedZoneProperties;
         bool wantsZoneBoundingBox { false };
@@ -43,6 +56,7 @@ public:
         std::function<bool()> uncaughtExceptions;
         QScriptEngine* engine;
         bool rejectAll;
+        std::shared_ptr<FilterStats> stats { std::make_shared<FilterStats>() };
         
         FilterData(): engine(nullptr), rejectAll(false) {};
         bool valid() { return (rejectAll || (engine != nullptr && filterFn.isFunction() && uncaughtExceptions)); }
@@ -57,6 +71,9 @@ public:
     bool filter(glm::vec3& position, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut, bool& wasChanged, 
                 EntityTree::FilterType filterType, EntityItemID& entityID, EntityItemPointer& existingEntity);
 
+    // per filter call counts and script time, keyed by zone ID (the domain wide filter is the null ID)
+    QJsonObject getFilterStats();
+
 signals:
     void filterAdded(EntityItemID id, bool success);
 
@@ -1903,9 +1903,7 @@ void EntityItem::setUnscaledDimensions(const glm::vec3& value) {
     glm::vec3 newDimensions = glm::max(value, glm::vec3(ENTITY_ITEM_MIN_DIMENSION));
     const float MIN_SCALE_CHANGE_SQUARED = 1.0e-6f;
     if (glm::length2(getUnscaledDimensions() - newDimensions) > MIN_SCALE_CHANGE_SQUARED) {
-        withWriteLock([&] {
-            _unscaledDimensions = newDimensions;
-        });
+        _unscaledDimensions.set(newDimensions);
         locationChanged();
         dimensionsChanged();
         withWriteLock([&] {
@@ -1916,9 +1914,7 @@ void EntityItem::setUnscaledDimensions(const glm::vec3& value) {
 }
 
 glm::vec3 EntityItem::getUnscaledDimensions() const {
-   return resultWithReadLock<glm::vec3>([&] {
-        return _unscaledDimensions;
-    });
+    return _unscaledDimensions.get();
 }
 
 void EntityItem::setRotation(glm::quat rotation) {
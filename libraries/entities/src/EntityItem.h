@@ -590,7 +590,7 @@ protected:
 
     virtual void dimensionsChanged() override;
 
-    glm::vec3 _unscaledDimensions { ENTITY_ITEM_DEFAULT_DIMENSIONS };
+    SeqLocked<glm::vec3> _unscaledDimensions { ENTITY_ITEM_DEFAULT_DIMENSIONS }; // read on every bounds query, so kept out of the entity lock
     EntityTypes::EntityType _type { EntityTypes::Unknown };
     quint64 _lastSimulated { 0 }; // last time this entity called simulate(), this includes velocity, angular velocity,
                             // and physics changes
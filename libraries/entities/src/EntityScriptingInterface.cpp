@@ -780,75 +780,57 @@ QScriptValue EntityScriptingInterface::getMultipleEntityPropertiesInternal(QScri
     return finalResult;
 }
 
-QUuid EntityScriptingInterface::editEntity(const QUuid& id, const EntityItemProperties& scriptSideProperties) {
-    PROFILE_RANGE(script_entities, __FUNCTION__);
-
-    _activityTracking.editedEntityCount++;
-
-    const auto sessionID = DependencyManager::get<NodeList>()->getSessionUUID();
-
-    EntityItemProperties properties = scriptSideProperties;
-
-    EntityItemID entityID(id);
-    if (!_entityTree) {
-        properties.setLastEditedBy(sessionID);
-        queueEntityMessage(PacketType::EntityEdit, entityID, properties);
-        return id;
-    }
+static void applySimulationOwnershipToEdit(const EntityItemPointer& entity, const SimulationOwner& simulationOwner,
+                                           const QUuid& sessionID, bool bidOnSimulationOwnership,
+                                           EntityItemProperties& properties) {
+    if (bidOnSimulationOwnership) {
+        // flag for simulation ownership, or upgrade existing ownership priority
+        // (actual bids for simulation ownership are sent by the PhysicalEntitySimulation)
+        entity->upgradeScriptSimulationPriority(properties.computeSimulationBidPriority());
+        if (simulationOwner.getID() == sessionID) {
+            // we own the simulation --> copy ALL restricted properties
+            properties.copySimulationRestrictedProperties(entity);
+        } else {
+            // we don't own the simulation but think we would like to
 
-    EntityItemPointer entity(nullptr);
-    SimulationOwner simulationOwner;
-    _entityTree->withReadLock([&] {
-        // make a copy of entity for local logic outside of tree lock
-        entity = _entityTree->findEntityByEntityItemID(entityID);
-        if (!entity) {
-            return;
+            uint8_t desiredPriority = entity->getScriptSimulationPriority();
+            if (desiredPriority < simulationOwner.getPriority()) {
+                // the priority at which we'd like to own it is not high enough
+                // --> assume failure and clear all restricted property changes
+                properties.clearSimulationRestrictedProperties();
+            } else {
+                // the priority at which we'd like to own it is high enough to win.
+                // --> assume success and copy ALL restricted properties
+                properties.copySimulationRestrictedProperties(entity);
+            }
         }
+    } else if (!simulationOwner.getID().isNull()) {
+        // someone owns this but not us
+        // clear restricted properties
+        properties.clearSimulationRestrictedProperties();
+    }
+    // clear the cached simulationPriority level
+    entity->upgradeScriptSimulationPriority(0);
+}
 
+// The per entity rules of an edit, shared by editEntity() and editEntityTransforms(). The entity is null when it isn't
+// known locally. Returns false when the entity is another avatar's avatar entity, whose edit is emptied.
+static bool prepareEntityEdit(const EntityItemPointer& entity, const SimulationOwner& simulationOwner, const QUuid& sessionID,
+                              bool bidOnSimulationOwnership, EntityItemProperties& properties) {
+    bool editable = true;
+    QString previousUserdata;
+    if (entity) {
         if (entity->isAvatarEntity() && entity->getOwningAvatarID() != sessionID && entity->getOwningAvatarID() != AVATAR_SELF_ID) {
             // don't edit other avatar's avatarEntities
             properties = EntityItemProperties();
-            return;
+            editable = false;
         }
-        // make a copy of simulationOwner for local logic outside of tree lock
-        simulationOwner = entity->getSimulationOwner();
-    });
-
-    QString previousUserdata;
-    if (entity) {
         if (properties.hasTransformOrVelocityChanges() && entity->hasGrabs()) {
             // if an entity is grabbed, the grab will override any position changes
             properties.clearTransformOrVelocityChanges();
         }
         if (properties.hasSimulationRestrictedChanges()) {
-            if (_bidOnSimulationOwnership) {
-                // flag for simulation ownership, or upgrade existing ownership priority
-                // (actual bids for simulation ownership are sent by the PhysicalEntitySimulation)
-                entity->upgradeScriptSimulationPriority(properties.computeSimulationBidPriority());
-                if (simulationOwner.getID() == sessionID) {
-                    // we own the simulation --> copy ALL restricted properties
-                    properties.copySimulationRestrictedProperties(entity);
-                } else {
-                    // we don't own the simulation but think we would like to
-
-                    uint8_t desiredPriority = entity->getScriptSimulationPriority();
-                    if (desiredPriority < simulationOwner.getPriority()) {
-                        // the priority at which we'd like to own it is not high enough
-                        // --> assume failure and clear all restricted property changes
-                        properties.clearSimulationRestrictedProperties();
-                    } else {
-                        // the priority at which we'd like to own it is high enough to win.
-                        // --> assume success and copy ALL restricted properties
-                        properties.copySimulationRestrictedProperties(entity);
-                    }
-                }
-            } else if (!simulationOwner.getID().isNull()) {
-                // someone owns this but not us
-                // clear restricted properties
-                properties.clearSimulationRestrictedProperties();
-            }
-            // clear the cached simulationPriority level
-            entity->upgradeScriptSimulationPriority(0);
+            applySimulationOwnershipToEdit(entity, simulationOwner, sessionID, bidOnSimulationOwnership, properties);
         }
 
         // set these to make EntityItemProperties::getScalesWithParent() work correctly
@@ -863,9 +845,6 @@ QUuid EntityScriptingInterface::editEntity(const QUuid& id, const EntityItemProp
         properties.setType(entity->getType());
 
         previousUserdata = entity->getUserData();
-    } else if (_bidOnSimulationOwnership) {
-        // bail when simulation participants don't know about entity
-        return QUuid();
     }
     // TODO: it is possible there is no remaining useful changes in properties and we should bail early.
     // How to check for this cheaply?
@@ -873,6 +852,41 @@ QUuid EntityScriptingInterface::editEntity(const QUuid& id, const EntityItemProp
     properties = convertPropertiesFromScriptSemantics(properties, properties.getScalesWithParent());
     synchronizeEditedGrabProperties(properties, previousUserdata);
     properties.setLastEditedBy(sessionID);
+    return editable;
+}
+
+QUuid EntityScriptingInterface::editEntity(const QUuid& id, const EntityItemProperties& scriptSideProperties) {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
+
+    _activityTracking.editedEntityCount++;
+
+    const auto sessionID = DependencyManager::get<NodeList>()->getSessionUUID();
+
+    EntityItemProperties properties = scriptSideProperties;
+
+    EntityItemID entityID(id);
+    if (!_entityTree) {
+        properties.setLastEditedBy(sessionID);
+        queueEntityMessage(PacketType::EntityEdit, entityID, properties);
+        return id;
+    }
+
+    EntityItemPointer entity(nullptr);
+    SimulationOwner simulationOwner;
+    _entityTree->withReadLock([&] {
+        // make a copy of entity for local logic outside of tree lock
+        entity = _entityTree->findEntityByEntityItemID(entityID);
+        if (entity) {
+            // make a copy of simulationOwner for local logic outside of tree lock
+            simulationOwner = entity->getSimulationOwner();
+        }
+    });
+
+    if (!entity && _bidOnSimulationOwnership) {
+        // bail when simulation participants don't know about entity
+        return QUuid();
+    }
+    prepareEntityEdit(entity, simulationOwner, sessionID, _bidOnSimulationOwnership, properties);
 
     // done reading and modifying properties --> start write
     bool updatedEntity = false;
@@ -965,6 +979,167 @@ QUuid EntityScriptingInterface::editEntity(const QUuid& id, const EntityItemProp
     return id;
 }
 
+// Packs one group of floats per entity, entities that aren't known locally are left zero.
+static QByteArray readEntityFloats(const EntityTreePointer& entityTree, const QVector<QUuid>& entityIDs, int floatsPerEntity,
+                                   std::function<void(const EntityItemPointer&, float*)> read) {
+    QByteArray result(entityIDs.size() * floatsPerEntity * (int)sizeof(float), 0);
+    if (!entityTree) {
+        return result;
+    }
+    float* values = reinterpret_cast<float*>(result.data());
+    entityTree->withReadLock([&] {
+        for (int i = 0; i < entityIDs.size(); ++i) {
+            EntityItemPointer entity = entityTree->findEntityByEntityItemID(EntityItemID(entityIDs[i]));
+            if (entity) {
+                read(entity, values + i * floatsPerEntity);
+            }
+        }
+    });
+    return result;
+}
+
+QByteArray EntityScriptingInterface::getEntityPositions(const QVector<QUuid>& entityIDs) {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
+    return readEntityFloats(_entityTree, entityIDs, 3, [](const EntityItemPointer& entity, float* out) {
+        glm::vec3 position = entity->getWorldPosition();
+        memcpy(out, &position, sizeof(glm::vec3));
+    });
+}
+
+QByteArray EntityScriptingInterface::getEntityRotations(const QVector<QUuid>& entityIDs) {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
+    return readEntityFloats(_entityTree, entityIDs, 4, [](const EntityItemPointer& entity, float* out) {
+        glm::quat rotation = entity->getWorldOrientation();
+        out[0] = rotation.x;
+        out[1] = rotation.y;
+        out[2] = rotation.z;
+        out[3] = rotation.w;
+    });
+}
+
+QByteArray EntityScriptingInterface::getEntityVelocities(const QVector<QUuid>& entityIDs) {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
+    return readEntityFloats(_entityTree, entityIDs, 3, [](const EntityItemPointer& entity, float* out) {
+        glm::vec3 velocity = entity->getWorldVelocity();
+        memcpy(out, &velocity, sizeof(glm::vec3));
+    });
+}
+
+int EntityScriptingInterface::editEntityTransforms(const QVector<QUuid>& entityIDs, const QByteArray& positions,
+                                                   const QByteArray& rotations, const QByteArray& velocities) {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
+
+    const int numEntities = entityIDs.size();
+    auto checkSize = [&](const QByteArray& values, int floatsPerEntity, const char* name) {
+        if (!values.isEmpty() && values.size() != numEntities * floatsPerEntity * (int)sizeof(float)) {
+            qCWarning(entities) << "editEntityTransforms:" << name << "should hold" << floatsPerEntity
+                << "floats for each of the" << numEntities << "entities";
+            return false;
+        }
+        return true;
+    };
+    if (!checkSize(positions, 3, "positions") || !checkSize(rotations, 4, "rotations") ||
+        !checkSize(velocities, 3, "velocities")) {
+        return 0;
+    }
+    if (positions.isEmpty() && rotations.isEmpty() && velocities.isEmpty()) {
+        return 0;
+    }
+
+    _activityTracking.editedEntityCount += numEntities;
+
+    const auto sessionID = DependencyManager::get<NodeList>()->getSessionUUID();
+    const float* positionValues = reinterpret_cast<const float*>(positions.constData());
+    const float* rotationValues = reinterpret_cast<const float*>(rotations.constData());
+    const float* velocityValues = reinterpret_cast<const float*>(velocities.constData());
+
+    struct TransformEdit {
+        EntityItemID entityID;
+        EntityItemPointer entity;
+        EntityItemProperties properties;
+    };
+    std::vector<TransformEdit> edits;
+    edits.reserve(numEntities);
+
+    // one pass under a single tree read lock, with the same per entity rules as editEntity()
+    auto readEntities = [&] {
+        for (int i = 0; i < numEntities; ++i) {
+            TransformEdit edit;
+            edit.entityID = EntityItemID(entityIDs[i]);
+            if (!positions.isEmpty()) {
+                const float* value = positionValues + i * 3;
+                edit.properties.setPosition(glm::vec3(value[0], value[1], value[2]));
+            }
+            if (!rotations.isEmpty()) {
+                const float* value = rotationValues + i * 4;
+                edit.properties.setRotation(glm::quat(value[3], value[0], value[1], value[2]));
+            }
+            if (!velocities.isEmpty()) {
+                const float* value = velocityValues + i * 3;
+                edit.properties.setVelocity(glm::vec3(value[0], value[1], value[2]));
+            }
+
+            SimulationOwner simulationOwner;
+            if (_entityTree) {
+                edit.entity = _entityTree->findEntityByEntityItemID(edit.entityID);
+            }
+            if (edit.entity) {
+                simulationOwner = edit.entity->getSimulationOwner();
+            } else if (_bidOnSimulationOwnership) {
+                // simulation participants don't edit entities they don't know about
+                continue;
+            }
+            if (!prepareEntityEdit(edit.entity, simulationOwner, sessionID, _bidOnSimulationOwnership, edit.properties)) {
+                continue;
+            }
+            edits.push_back(edit);
+        }
+    };
+    if (_entityTree) {
+        _entityTree->withReadLock(readEntities);
+    } else {
+        readEntities();
+    }
+
+    if (_entityTree) {
+        _entityTree->withWriteLock([&] {
+            for (auto& edit : edits) {
+                if (edit.entity) {
+                    _entityTree->updateEntity(edit.entityID, edit.properties);
+                }
+            }
+        });
+
+        uint64_t now = usecTimestampNow();
+        _entityTree->withReadLock([&] {
+            for (auto& edit : edits) {
+                if (!edit.entity) {
+                    continue;
+                }
+                edit.entity->setLastBroadcast(now);
+                if (edit.properties.queryAACubeRelatedPropertyChanged()) {
+                    edit.properties.setQueryAACube(edit.entity->getQueryAACube());
+                    edit.entity->forEachDescendant([&](SpatiallyNestablePointer descendant) {
+                        if (descendant->getNestableType() == NestableType::Entity && descendant->updateQueryAACube()) {
+                            EntityItemProperties newQueryCubeProperties;
+                            newQueryCubeProperties.setQueryAACube(descendant->getQueryAACube());
+                            newQueryCubeProperties.setLastEdited(edit.properties.getLastEdited());
+                            queueEntityMessage(PacketType::EntityEdit, descendant->getID(), newQueryCubeProperties);
+                            std::static_pointer_cast<EntityItem>(descendant)->setLastBroadcast(now);
+                        }
+                    });
+                }
+            }
+        });
+    }
+
+    // the edits are queued back to back so the packet sender packs as many as fit into each EntityEdit packet
+    for (auto& edit : edits) {
+        queueEntityMessage(PacketType::EntityEdit, edit.entityID, edit.properties);
+    }
+    return (int)edits.size();
+}
+
 void EntityScriptingInterface::deleteEntity(const QUuid& id) {
     PROFILE_RANGE(script_entities, __FUNCTION__);
 
@@ -418,6 +418,65 @@ public slots:
      */
     Q_INVOKABLE QUuid editEntity(const QUuid& entityID, const EntityItemProperties& properties);
 
+    /**jsdoc
+     * Gets the world positions of many entities at once, without building a properties object for each.
+     * @function Entities.getEntityPositions
+     * @param {Uuid[]} entityIDs - The IDs of the entities.
+     * @returns {ArrayBuffer} Three 32-bit floats <code>x, y, z</code> per entity, in the order of <code>entityIDs</code>.
+     *     Entities that aren't known locally are reported at <code>0, 0, 0</code>.
+     * @example <caption>Report the height of several entities.</caption>
+     * var positions = new Float32Array(Entities.getEntityPositions(entityIDs));
+     * for (var i = 0; i < entityIDs.length; i++) {
+     *     print(entityIDs[i] + " is at height " + positions[3 * i + 1]);
+     * }
+     */
+    Q_INVOKABLE QByteArray getEntityPositions(const QVector<QUuid>& entityIDs);
+
+    /**jsdoc
+     * Gets the world rotations of many entities at once, without building a properties object for each.
+     * @function Entities.getEntityRotations
+     * @param {Uuid[]} entityIDs - The IDs of the entities.
+     * @returns {ArrayBuffer} Four 32-bit floats <code>x, y, z, w</code> per entity, in the order of <code>entityIDs</code>.
+     *     Entities that aren't known locally are reported as all zeros.
+     */
+    Q_INVOKABLE QByteArray getEntityRotations(const QVector<QUuid>& entityIDs);
+
+    /**jsdoc
+     * Gets the world velocities of many entities at once, without building a properties object for each.
+     * @function Entities.getEntityVelocities
+     * @param {Uuid[]} entityIDs - The IDs of the entities.
+     * @returns {ArrayBuffer} Three 32-bit floats <code>x, y, z</code> per entity, in the order of <code>entityIDs</code>.
+     *     Entities that aren't known locally are reported at <code>0, 0, 0</code>.
+     */
+    Q_INVOKABLE QByteArray getEntityVelocities(const QVector<QUuid>& entityIDs);
+
+    /**jsdoc
+     * Sets the world positions, rotations and/or velocities of many entities at once. This is the same as calling
+     * {@link Entities.editEntity} with just those properties for each entity, but without building a properties object per
+     * entity, and the edits are packed into as few edit packets as possible.
+     * @function Entities.editEntityTransforms
+     * @param {Uuid[]} entityIDs - The IDs of the entities to edit.
+     * @param {Float32Array|ArrayBuffer} positions - Three floats <code>x, y, z</code> per entity, or an empty array to leave
+     *     the positions unchanged.
+     * @param {Float32Array|ArrayBuffer} [rotations] - Four floats <code>x, y, z, w</code> per entity. If omitted or empty the
+     *     rotations are left unchanged.
+     * @param {Float32Array|ArrayBuffer} [velocities] - Three floats <code>x, y, z</code> per entity. If omitted or empty the
+     *     velocities are left unchanged.
+     * @returns {number} The number of edits made. Another avatar's avatar entities are skipped. As with
+     *     {@link Entities.editEntity}, the grab of a grabbed entity overrides the transform changes.
+     * @example <caption>Bob a crowd of entities up and down.</caption>
+     * var positions = new Float32Array(Entities.getEntityPositions(entityIDs));
+     * Script.update.connect(function (deltaTime) {
+     *     var time = Date.now() / 1000;
+     *     for (var i = 0; i < entityIDs.length; i++) {
+     *         positions[3 * i + 1] += 0.01 * Math.sin(time + i);
+     *     }
+     *     Entities.editEntityTransforms(entityIDs, positions);
+     * });
+     */
+    Q_INVOKABLE int editEntityTransforms(const QVector<QUuid>& entityIDs, const QByteArray& positions,
+        const QByteArray& rotations = QByteArray(), const QByteArray& velocities = QByteArray());
+
     /**jsdoc
      * Deletes an entity.
      * @function Entities.deleteEntity
@@ -0,0 +1,81 @@
+//
+//  EntitySpatialIndex.cpp
+//  libraries/entities/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntitySpatialIndex.h"
+
+#include <cmath>
+
+const float EntitySpatialIndex::CELL_SIZE = 16.0f;
+const EntitySpatialIndex::CellKey EntitySpatialIndex::LARGE_ENTITIES_KEY = (CellKey)-1;
+
+int EntitySpatialIndex::toCellCoord(float value) {
+    return (int)std::floor(value / CELL_SIZE);
+}
+
+EntitySpatialIndex::CellKey EntitySpatialIndex::toCellKey(int x, int y, int z) {
+    // 21 bits per axis covers the whole tree scale at this cell size
+    const CellKey MASK = (1 << 21) - 1;
+    return ((CellKey)x & MASK) | (((CellKey)y & MASK) << 21) | (((CellKey)z & MASK) << 42);
+}
+
+EntitySpatialIndex::Cell& EntitySpatialIndex::getCell(CellKey key) {
+    return key == LARGE_ENTITIES_KEY ? _largeEntities : _cells[key];
+}
+
+void EntitySpatialIndex::insert(const EntityItemPointer& entity, const AACube& bounds) {
+    CellKey key = LARGE_ENTITIES_KEY;
+    if (bounds.getScale() <= CELL_SIZE) {
+        glm::vec3 center = bounds.calcCenter();
+        key = toCellKey(toCellCoord(center.x), toCellCoord(center.y), toCellCoord(center.z));
+    }
+
+    QWriteLocker locker(&_lock);
+    removeLocked(entity.get());
+    Cell& cell = getCell(key);
+    _locations[entity.get()] = { key, cell.size() };
+    cell.push_back({ entity, AABox(bounds) });
+}
+
+void EntitySpatialIndex::remove(const EntityItem* entity) {
+    QWriteLocker locker(&_lock);
+    removeLocked(entity);
+}
+
+void EntitySpatialIndex::removeLocked(const EntityItem* entity) {
+    auto itr = _locations.find(entity);
+    if (itr == _locations.end()) {
+        return;
+    }
+    Location location = itr->second;
+    _locations.erase(itr);
+
+    // swap with the last entry of the cell so removal is O(1)
+    Cell& cell = getCell(location.key);
+    if (location.index != cell.size() - 1) {
+        cell[location.index] = std::move(cell.back());
+        _locations[cell[location.index].entity.get()].index = location.index;
+    }
+    cell.pop_back();
+    if (cell.empty() && location.key != LARGE_ENTITIES_KEY) {
+        _cells.erase(location.key);
+    }
+}
+
+void EntitySpatialIndex::clear() {
+    QWriteLocker locker(&_lock);
+    _cells.clear();
+    _largeEntities.clear();
+    _locations.clear();
+}
+
+size_t EntitySpatialIndex::size() const {
+    QReadLocker locker(&_lock);
+    return _locations.size();
+}
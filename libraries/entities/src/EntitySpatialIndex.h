@@ -0,0 +1,112 @@
+//
+//  EntitySpatialIndex.h
+//  libraries/entities/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntitySpatialIndex_h
+#define hifi_EntitySpatialIndex_h
+
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QReadWriteLock>
+
+#include <AABox.h>
+#include <AACube.h>
+
+#include "EntityTypes.h"
+
+// A flat loose grid over the entities of an EntityTree, used to answer region queries without recursing the octree.
+// Each entity is filed under the cube of the octree element that contains it, so the index only changes when an
+// entity changes elements, which EntityTreeElement reports through insert() and remove().  Entities are binned by
+// the center of that cube; cubes larger than a cell are kept in a separate list that every query checks.
+class EntitySpatialIndex {
+public:
+    static const float CELL_SIZE;
+
+    void insert(const EntityItemPointer& entity, const AACube& bounds);
+    void remove(const EntityItem* entity);
+    void clear();
+
+    size_t size() const;
+
+    // calls f for every entity whose indexed bounds touch box, entities still need an exact test
+    template <typename F>
+    void forEachCandidate(const AABox& box, F&& f) const;
+
+private:
+    struct Entry {
+        EntityItemPointer entity;
+        AABox bounds;
+    };
+    using Cell = std::vector<Entry>;
+    using CellKey = uint64_t;
+    static const CellKey LARGE_ENTITIES_KEY;
+
+    struct Location {
+        CellKey key;
+        size_t index;
+    };
+
+    static int toCellCoord(float value);
+    static CellKey toCellKey(int x, int y, int z);
+
+    Cell& getCell(CellKey key);
+    void removeLocked(const EntityItem* entity);
+
+    mutable QReadWriteLock _lock;
+    std::unordered_map<CellKey, Cell> _cells;
+    Cell _largeEntities;
+    std::unordered_map<const EntityItem*, Location> _locations;
+};
+
+template <typename F>
+inline void EntitySpatialIndex::forEachCandidate(const AABox& box, F&& f) const {
+    QReadLocker locker(&_lock);
+    for (const auto& entry : _largeEntities) {
+        if (entry.bounds.touches(box)) {
+            f(entry.entity);
+        }
+    }
+
+    auto visitCell = [&](const Cell& cell) {
+        for (const auto& entry : cell) {
+            if (entry.bounds.touches(box)) {
+                f(entry.entity);
+            }
+        }
+    };
+
+    // binned entities reach at most half a cell past their cell
+    const float HALF_CELL = CELL_SIZE * 0.5f;
+    glm::vec3 minimum = box.getMinimumPoint() - glm::vec3(HALF_CELL);
+    glm::vec3 maximum = box.getMaximumPoint() + glm::vec3(HALF_CELL);
+    int minX = toCellCoord(minimum.x), minY = toCellCoord(minimum.y), minZ = toCellCoord(minimum.z);
+    int maxX = toCellCoord(maximum.x), maxY = toCellCoord(maximum.y), maxZ = toCellCoord(maximum.z);
+    uint64_t numCellsInBox = (uint64_t)(maxX - minX + 1) * (uint64_t)(maxY - minY + 1) * (uint64_t)(maxZ - minZ + 1);
+
+    if (numCellsInBox > _cells.size()) {
+        // big query boxes (e.g. a frustum with a far clip) visit the occupied cells instead
+        for (const auto& cell : _cells) {
+            visitCell(cell.second);
+        }
+        return;
+    }
+    for (int x = minX; x <= maxX; ++x) {
+        for (int y = minY; y <= maxY; ++y) {
+            for (int z = minZ; z <= maxZ; ++z) {
+                auto itr = _cells.find(toCellKey(x, y, z));
+                if (itr != _cells.end()) {
+                    visitCell(itr->second);
+                }
+            }
+        }
+    }
+}
+
+#endif // hifi_EntitySpatialIndex_h
@@ -153,6 +153,7 @@ void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
     });
     localMap.clear();
     Octree::eraseAllOctreeElements(createNewRoot);
+    _spatialIndex.clear();
 
     resetClientEditStats();
     clearDeletedEntities();
@@ -985,194 +986,128 @@ QUuid EntityTree::evalClosestEntity(const glm::vec3& position, float targetRadiu
     return args.closestEntity;
 }
 
-class FindEntitiesInSphereArgs {
-public:
-    // Inputs
-    glm::vec3 position;
-    float targetRadius;
-    PickFilter searchFilter;
-
-    // Outputs
-    QVector<QUuid> entities;
-};
-
-bool evalInSphereOperation(const OctreeElementPointer& element, void* extraData) {
-    FindEntitiesInSphereArgs* args = static_cast<FindEntitiesInSphereArgs*>(extraData);
-    glm::vec3 penetration;
-    bool sphereIntersection = element->getAACube().findSpherePenetration(args->position, args->targetRadius, penetration);
-
-    // If this element contains the point, then search it...
-    if (sphereIntersection) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->evalEntitiesInSphere(args->position, args->targetRadius, args->searchFilter, args->entities);
-        return true; // keep searching in case children have closer entities
+EntityTree::SpatialQuery EntityTree::SpatialQuery::sphere(const glm::vec3& center, float radius, PickFilter searchFilter) {
+    SpatialQuery query;
+    query.shape = SPHERE;
+    query.center = center;
+    query.radius = radius;
+    query.bounds = AABox(center - glm::vec3(radius), 2.0f * radius);
+    query.searchFilter = searchFilter;
+    return query;
+}
+
+EntityTree::SpatialQuery EntityTree::SpatialQuery::box(const AABox& box, PickFilter searchFilter) {
+    SpatialQuery query;
+    query.shape = BOX;
+    query.bounds = box;
+    query.searchFilter = searchFilter;
+    return query;
+}
+
+EntityTree::SpatialQuery EntityTree::SpatialQuery::frustum(const ViewFrustum& frustum, PickFilter searchFilter) {
+    SpatialQuery query;
+    query.shape = FRUSTUM;
+    query.viewFrustum = &frustum;
+    // the corners bound the frustum, and the keyhole is a sphere around the eye
+    glm::vec3 position = frustum.getPosition();
+    float keyholeRadius = frustum.getCenterRadius();
+    query.bounds = AABox(position - glm::vec3(keyholeRadius), 2.0f * keyholeRadius);
+    query.bounds += frustum.getNearTopLeft();
+    query.bounds += frustum.getNearTopRight();
+    query.bounds += frustum.getNearBottomLeft();
+    query.bounds += frustum.getNearBottomRight();
+    query.bounds += frustum.getFarTopLeft();
+    query.bounds += frustum.getFarTopRight();
+    query.bounds += frustum.getFarBottomLeft();
+    query.bounds += frustum.getFarBottomRight();
+    query.searchFilter = searchFilter;
+    return query;
+}
+
+bool EntityTree::SpatialQuery::matches(const EntityItemPointer& entity) const {
+    if (!EntityTreeElement::checkFilterSettings(entity, searchFilter)) {
+        return false;
+    }
+    if (type != EntityTypes::Unknown && entity->getType() != type) {
+        return false;
+    }
+    if (!name.isNull()) {
+        QString entityName = entity->getName();
+        if ((caseSensitive && name != entityName) || (!caseSensitive && name.toLower() != entityName.toLower())) {
+            return false;
+        }
+    }
+    if (shape == SPHERE) {
+        return EntityTreeElement::entityTouchesSphere(entity, center, radius);
     }
 
-    // if this element doesn't contain the point, then none of it's children can contain the point, so stop searching
-    return false;
+    bool success;
+    AABox entityBox = entity->getAABox(success);
+    if (!success) {
+        return false;
+    }
+    if (shape == BOX) {
+        // If the entities AABox touches the search box then consider it to be found
+        return entityBox.touches(bounds);
+    }
+    return viewFrustum->boxIntersectsFrustum(entityBox) || viewFrustum->boxIntersectsKeyhole(entityBox);
 }
 
 // NOTE: assumes caller has handled locking
-void EntityTree::evalEntitiesInSphere(const glm::vec3& center, float radius, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
-    FindEntitiesInSphereArgs args = { center, radius, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(evalInSphereOperation, &args);
-    foundEntities.swap(args.entities);
-}
-
-class FindEntitiesInSphereWithTypeArgs {
-public:
-    // Inputs
-    glm::vec3 position;
-    float targetRadius;
-    EntityTypes::EntityType type;
-    PickFilter searchFilter;
-
-    // Outputs
-    QVector<QUuid> entities;
-};
-
-bool evalInSphereWithTypeOperation(const OctreeElementPointer& element, void* extraData) {
-    FindEntitiesInSphereWithTypeArgs* args = static_cast<FindEntitiesInSphereWithTypeArgs*>(extraData);
-    glm::vec3 penetration;
-    bool sphereIntersection = element->getAACube().findSpherePenetration(args->position, args->targetRadius, penetration);
-
-    // If this element contains the point, then search it...
-    if (sphereIntersection) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->evalEntitiesInSphereWithType(args->position, args->targetRadius, args->type, args->searchFilter, args->entities);
-        return true; // keep searching in case children have closer entities
+void EntityTree::evalSpatialQueries(std::vector<SpatialQuery>& queries) const {
+    for (auto& query : queries) {
+        query.entities.clear();
+        _spatialIndex.forEachCandidate(query.bounds, [&](const EntityItemPointer& entity) {
+            if (query.matches(entity)) {
+                query.entities.push_back(entity);
+            }
+        });
     }
+}
 
-    // if this element doesn't contain the point, then none of it's children can contain the point, so stop searching
-    return false;
+void EntityTree::evalSpatialQuery(const SpatialQuery& query, QVector<QUuid>& foundEntities) const {
+    QVector<QUuid> result;
+    _spatialIndex.forEachCandidate(query.bounds, [&](const EntityItemPointer& entity) {
+        if (query.matches(entity)) {
+            result.push_back(entity->getID());
+        }
+    });
+    foundEntities.swap(result);
 }
 
 // NOTE: assumes caller has handled locking
-void EntityTree::evalEntitiesInSphereWithType(const glm::vec3& center, float radius, EntityTypes::EntityType type, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
-    FindEntitiesInSphereWithTypeArgs args = { center, radius, type, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(evalInSphereWithTypeOperation, &args);
-    foundEntities.swap(args.entities);
+void EntityTree::evalEntitiesInSphere(const glm::vec3& center, float radius, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
+    evalSpatialQuery(SpatialQuery::sphere(center, radius, searchFilter), foundEntities);
 }
 
-class FindEntitiesInSphereWithNameArgs {
-public:
-    // Inputs
-    glm::vec3 position;
-    float targetRadius;
-    QString name;
-    bool caseSensitive;
-    PickFilter searchFilter;
-
-    // Outputs
-    QVector<QUuid> entities;
-};
-
-bool evalInSphereWithNameOperation(const OctreeElementPointer& element, void* extraData) {
-    FindEntitiesInSphereWithNameArgs* args = static_cast<FindEntitiesInSphereWithNameArgs*>(extraData);
-    glm::vec3 penetration;
-    bool sphereIntersection = element->getAACube().findSpherePenetration(args->position, args->targetRadius, penetration);
-
-    // If this element contains the point, then search it...
-    if (sphereIntersection) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->evalEntitiesInSphereWithName(args->position, args->targetRadius, args->name, args->caseSensitive, args->searchFilter, args->entities);
-        return true; // keep searching in case children have closer entities
-    }
-
-    // if this element doesn't contain the point, then none of it's children can contain the point, so stop searching
-    return false;
+// NOTE: assumes caller has handled locking
+void EntityTree::evalEntitiesInSphereWithType(const glm::vec3& center, float radius, EntityTypes::EntityType type, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
+    SpatialQuery query = SpatialQuery::sphere(center, radius, searchFilter);
+    query.type = type;
+    evalSpatialQuery(query, foundEntities);
 }
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInSphereWithName(const glm::vec3& center, float radius, const QString& name, bool caseSensitive, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
-    FindEntitiesInSphereWithNameArgs args = { center, radius, name, caseSensitive, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(evalInSphereWithNameOperation, &args);
-    foundEntities.swap(args.entities);
-}
-
-class FindEntitiesInCubeArgs {
-public:
-    // Inputs
-    AACube cube;
-    PickFilter searchFilter;
-
-    // Outputs
-    QVector<QUuid> entities;
-};
-
-bool findInCubeOperation(const OctreeElementPointer& element, void* extraData) {
-    FindEntitiesInCubeArgs* args = static_cast<FindEntitiesInCubeArgs*>(extraData);
-    if (element->getAACube().touches(args->cube)) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->evalEntitiesInCube(args->cube, args->searchFilter, args->entities);
-        return true;
-    }
-    return false;
+    SpatialQuery query = SpatialQuery::sphere(center, radius, searchFilter);
+    query.name = name.isNull() ? QString("") : name;
+    query.caseSensitive = caseSensitive;
+    evalSpatialQuery(query, foundEntities);
 }
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInCube(const AACube& cube, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
-    FindEntitiesInCubeArgs args { cube, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(findInCubeOperation, &args);
-    foundEntities.swap(args.entities);
-}
-
-class FindEntitiesInBoxArgs {
-public:
-    // Inputs
-    AABox box;
-    PickFilter searchFilter;
-
-    // Outputs
-    QVector<QUuid> entities;
-};
-
-bool findInBoxOperation(const OctreeElementPointer& element, void* extraData) {
-    FindEntitiesInBoxArgs* args = static_cast<FindEntitiesInBoxArgs*>(extraData);
-    if (element->getAACube().touches(args->box)) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->evalEntitiesInBox(args->box, args->searchFilter, args->entities);
-        return true;
-    }
-    return false;
+    evalSpatialQuery(SpatialQuery::box(AABox(cube), searchFilter), foundEntities);
 }
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInBox(const AABox& box, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
-    FindEntitiesInBoxArgs args { box, searchFilter, QVector<QUuid>() };
-    // NOTE: This should use recursion, since this is a spatial operation
-    recurseTreeWithOperation(findInBoxOperation, &args);
-    // swap the two lists of entity pointers instead of copy
-    foundEntities.swap(args.entities);
-}
-
-class FindEntitiesInFrustumArgs {
-public:
-    // Inputs
-    ViewFrustum frustum;
-    PickFilter searchFilter;
-
-    // Outputs
-    QVector<QUuid> entities;
-};
-
-bool findInFrustumOperation(const OctreeElementPointer& element, void* extraData) {
-    FindEntitiesInFrustumArgs* args = static_cast<FindEntitiesInFrustumArgs*>(extraData);
-    if (element->isInView(args->frustum)) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->evalEntitiesInFrustum(args->frustum, args->searchFilter, args->entities);
-        return true;
-    }
-    return false;
+    evalSpatialQuery(SpatialQuery::box(box, searchFilter), foundEntities);
 }
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInFrustum(const ViewFrustum& frustum, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
-    FindEntitiesInFrustumArgs args = { frustum, searchFilter, QVector<QUuid>() };
-    // NOTE: This should use recursion, since this is a spatial operation
-    recurseTreeWithOperation(findInFrustumOperation, &args);
-    // swap the two lists of entity pointers instead of copy
-    foundEntities.swap(args.entities);
+    evalSpatialQuery(SpatialQuery::frustum(frustum, searchFilter), foundEntities);
 }
 
 EntityItemPointer EntityTree::findEntityByID(const QUuid& id) const {
@@ -21,6 +21,7 @@
 #include "AddEntityOperator.h"
 #include "EntityTreeElement.h"
 #include "DeleteEntityOperator.h"
+#include "EntitySpatialIndex.h"
 #include "MovingEntitiesOperator.h"
 
 class EntityTree;
@@ -78,6 +79,8 @@ public:
     virtual void eraseDomainAndNonOwnedEntities() override;
     virtual void eraseAllOctreeElements(bool createNewRoot = true) override;
 
+    EntitySpatialIndex& getSpatialIndex() { return _spatialIndex; }
+
     virtual void readBitstreamToTree(const unsigned char* bitstream,
             uint64_t bufferSizeBytes, ReadBitstreamToTreeParams& args) override;
     int readEntityDataFromBuffer(const unsigned char* data, int bytesLeftToRead, ReadBitstreamToTreeParams& args);
@@ -134,6 +137,36 @@ public:
 
     EntityItemID assignEntityID(const EntityItemID& entityItemID); /// Assigns a known ID for a creator token ID
 
+    /// A region query answered from the spatial index. Build with sphere(), box() or frustum() and optionally
+    /// narrow by type or name; evalSpatialQueries() fills in the matching entities.
+    class SpatialQuery {
+    public:
+        enum Shape { SPHERE, BOX, FRUSTUM };
+
+        static SpatialQuery sphere(const glm::vec3& center, float radius, PickFilter searchFilter);
+        static SpatialQuery box(const AABox& box, PickFilter searchFilter);
+        static SpatialQuery frustum(const ViewFrustum& frustum, PickFilter searchFilter);
+
+        bool matches(const EntityItemPointer& entity) const;
+
+        Shape shape { SPHERE };
+        glm::vec3 center;
+        float radius { 0.0f };
+        AABox bounds;
+        const ViewFrustum* viewFrustum { nullptr };
+        PickFilter searchFilter;
+        EntityTypes::EntityType type { EntityTypes::Unknown };
+        QString name; // null matches any name
+        bool caseSensitive { false };
+
+        QVector<EntityItemPointer> entities; // [out]
+    };
+
+    /// Answers a batch of region queries from the spatial index, each visiting only the cells its bounds reach,
+    /// and returns entity pointers so callers don't need to find each entity by ID again. Assumes the caller holds
+    /// the tree lock.
+    void evalSpatialQueries(std::vector<SpatialQuery>& queries) const;
+
     QUuid evalClosestEntity(const glm::vec3& position, float targetRadius, PickFilter searchFilter);
     void evalEntitiesInSphere(const glm::vec3& center, float radius, PickFilter searchFilter, QVector<QUuid>& foundEntities);
     void evalEntitiesInSphereWithType(const glm::vec3& center, float radius, EntityTypes::EntityType type, PickFilter searchFilter, QVector<QUuid>& foundEntities);
@@ -393,6 +426,10 @@ private:
 
     std::map<QString, QString> _namedPaths;
 
+    EntitySpatialIndex _spatialIndex;
+
+    void evalSpatialQuery(const SpatialQuery& query, QVector<QUuid>& foundEntities) const;
+
     void updateEntityQueryAACubeWorker(SpatiallyNestablePointer object, EntityEditPacketSender* packetSender,
                                        MovingEntitiesOperator& moveOperator, bool force, bool tellServer);
 };
@@ -303,7 +303,7 @@ void ModelEntityItem::setModelURL(const QString& url) {
 
 glm::vec3 ModelEntityItem::getScaledDimensions() const {
     glm::vec3 parentScale =  getTransform().getScale();
-    return _unscaledDimensions * parentScale;
+    return _unscaledDimensions.get() * parentScale;
 }
 
 void ModelEntityItem::setScaledDimensions(const glm::vec3& value) {
@@ -11,8 +11,6 @@
 
 #include "FBXSerializer.h"
 
-#include <QBuffer>
-
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtx/quaternion.hpp>
 #include <glm/gtx/transform.hpp>
@@ -1668,10 +1666,7 @@ std::unique_ptr<hfm::Serializer::Factory> FBXSerializer::getFactory() const {
 }
 
 HFMModel::Pointer FBXSerializer::read(const hifi::ByteArray& data, const hifi::VariantHash& mapping, const hifi::URL& url) {
-    QBuffer buffer(const_cast<hifi::ByteArray*>(&data));
-    buffer.open(QIODevice::ReadOnly);
-
-    _rootNode = parseFBX(&buffer);
+    _rootNode = parseFBX(data);
 
     // FBXSerializer's mapping parameter supports the bool "deduplicateIndices," which is passed into FBXSerializer::extractMesh as "deduplicate"
 
@@ -116,6 +116,8 @@ public:
 
     FBXNode _rootNode;
     static FBXNode parseFBX(QIODevice* device);
+    static FBXNode parseFBX(const hifi::ByteArray& data);
+    static FBXNode parseTextFBX(QIODevice* device);
 
     HFMModel* extractHFMModel(const hifi::VariantHash& mapping, const QString& url);
 
@@ -11,9 +11,10 @@
 
 #include "FBXSerializer.h"
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <QtCore/QBuffer>
-#include <QtCore/QDataStream>
 #include <QtCore/QIODevice>
 #include <QtCore/QStringList>
 #include <QtCore/QTextStream>
@@ -21,161 +22,174 @@
 #include <QtCore/QtEndian>
 #include <QtCore/QFileInfo>
 
+#include <zlib.h>
+
 #include <shared/NsightHelpers.h>
 #include <hfm/ModelFormatLogging.h>
+#include <TBBHelpers.h>
+
+template <class T>
+static void arrayFromLittleEndian(void* values, size_t count) {
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+    char* bytes = (char*)values;
+    for (size_t i = 0; i < count; i++) {
+        std::reverse(bytes + i * sizeof(T), bytes + (i + 1) * sizeof(T));
+    }
+#else
+    Q_UNUSED(values);
+    Q_UNUSED(count);
+#endif
+}
+
+// Reads a binary FBX document straight from its bytes into the usual FBXNode / QVariant tree.
+// Arrays are copied once into their final QVector storage. Compressed arrays are only sized while the tree is
+// built, then all of them are inflated in place at once, in parallel.
+class BinaryFBXParser {
+public:
+    BinaryFBXParser(const hifi::ByteArray& data) : _data(data.constData()), _size(data.size()) {}
+
+    void setHas64BitPositions(bool has64BitPositions) { _has64BitPositions = has64BitPositions; }
+    void skip(qint64 length) { take(length); }
+    bool atEnd() const { return _position >= _size; }
+
+    template <class T>
+    T read() {
+        T value;
+        memcpy(&value, take(sizeof(T)), sizeof(T));
+        return qFromLittleEndian(value);
+    }
+
+    FBXNode parseNode();
+
+    // Inflates the compressed arrays of the nodes parsed so far
+    void inflateArrays();
 
-template<class T>
-int streamSize() {
-    return sizeof(T);
+private:
+    struct CompressedArray {
+        const char* compressed;
+        quint32 compressedLength;
+        char* values;
+        size_t length;
+        size_t count;
+        void (*fromLittleEndian)(void* values, size_t count);
+    };
+
+    const char* take(qint64 length) {
+        if (length < 0 || length > _size - _position) {
+            throw QString("FBX file most likely corrupt: unexpected end of file");
+        }
+        const char* bytes = _data + _position;
+        _position += length;
+        return bytes;
+    }
+
+    template <class T>
+    QVariant readArray();
+    QVariant parseProperty();
+
+    const char* _data;
+    qint64 _size;
+    qint64 _position { 0 };
+    bool _has64BitPositions { false };
+    std::vector<CompressedArray> _compressedArrays;
+};
+
+template <>
+bool BinaryFBXParser::read<bool>() {
+    return *take(1) != 0;
 }
 
-template<bool>
-int streamSize() {
-    return 1;
+template <>
+float BinaryFBXParser::read<float>() {
+    quint32 value = read<quint32>();
+    float result;
+    memcpy(&result, &value, sizeof(float));
+    return result;
 }
 
-template<class T>
-QVariant readBinaryArray(QDataStream& in, int& position) {
-    quint32 arrayLength;
-    quint32 encoding;
-    quint32 compressedLength;
+template <>
+double BinaryFBXParser::read<double>() {
+    quint64 value = read<quint64>();
+    double result;
+    memcpy(&result, &value, sizeof(double));
+    return result;
+}
 
-    in >> arrayLength;
+template <class T>
+QVariant BinaryFBXParser::readArray() {
+    quint32 arrayLength = read<quint32>();
     if (arrayLength > std::numeric_limits<int>::max() / sizeof(T)) { // Upcoming byte containers are limited to max signed int
         throw QString("FBX file most likely corrupt: binary data exceeds data limits");
     }
-    in >> encoding;
-    in >> compressedLength;
+    quint32 encoding = read<quint32>();
+    quint32 compressedLength = read<quint32>();
     if (compressedLength > std::numeric_limits<int>::max() / sizeof(T)) { // Upcoming byte containers are limited to max signed int
         throw QString("FBX file most likely corrupt: compressed binary data exceeds data limits");
     }
-    position += sizeof(quint32) * 3;
-
-    QVector<T> values;
-    if ((int)QSysInfo::ByteOrder == (int)in.byteOrder()) {
-        values.resize(arrayLength);
-        hifi::ByteArray arrayData;
-        if (encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
-            // preface encoded data with uncompressed length
-            hifi::ByteArray compressed(sizeof(quint32) + compressedLength, 0);
-            *((quint32*)compressed.data()) = qToBigEndian<quint32>(arrayLength * sizeof(T));
-            in.readRawData(compressed.data() + sizeof(quint32), compressedLength);
-            position += compressedLength;
-            arrayData = qUncompress(compressed);
-            if (arrayData.isEmpty() ||
-                (unsigned int)arrayData.size() != (sizeof(T) * arrayLength)) { // answers empty byte array if corrupt
-                throw QString("corrupt fbx file");
-            }
-        } else {
-            arrayData.resize(sizeof(T) * arrayLength);
-            position += sizeof(T) * arrayLength;
-            in.readRawData(arrayData.data(), arrayData.size());
-        }
 
-        if (arrayData.size() > 0) {
-            memcpy(&values[0], arrayData.constData(), arrayData.size());
-        }
-    } else {
-        values.reserve(arrayLength);
-        if (encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
-            // preface encoded data with uncompressed length
-            hifi::ByteArray compressed(sizeof(quint32) + compressedLength, 0);
-            *((quint32*)compressed.data()) = qToBigEndian<quint32>(arrayLength * sizeof(T));
-            in.readRawData(compressed.data() + sizeof(quint32), compressedLength);
-            position += compressedLength;
-            hifi::ByteArray uncompressed = qUncompress(compressed);
-            if (uncompressed.isEmpty()) { // answers empty byte array if corrupt
-                throw QString("corrupt fbx file");
-            }
-            QDataStream uncompressedIn(uncompressed);
-            uncompressedIn.setByteOrder(QDataStream::LittleEndian);
-            uncompressedIn.setVersion(QDataStream::Qt_4_5); // for single/double precision switch
-            for (quint32 i = 0; i < arrayLength; i++) {
-                T value;
-                uncompressedIn >> value;
-                values.append(value);
-            }
-        } else {
-            for (quint32 i = 0; i < arrayLength; i++) {
-                T value;
-                in >> value;
-                position += streamSize<T>();
-                values.append(value);
-            }
+    QVector<T> values(arrayLength);
+    if (encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
+        const char* compressed = take(compressedLength);
+        if (arrayLength > 0) {
+            // the values are shared with the returned variant, they are filled in before anything reads them
+            _compressedArrays.push_back({ compressed, compressedLength, (char*)values.data(), sizeof(T) * arrayLength,
+                arrayLength, &arrayFromLittleEndian<T> });
         }
+    } else if (arrayLength > 0) {
+        memcpy(values.data(), take(sizeof(T) * arrayLength), sizeof(T) * arrayLength);
+        arrayFromLittleEndian<T>(values.data(), arrayLength);
     }
     return QVariant::fromValue(values);
 }
 
-QVariant parseBinaryFBXProperty(QDataStream& in, int& position) {
-    char ch;
-    in.device()->getChar(&ch);
-    position++;
+QVariant BinaryFBXParser::parseProperty() {
+    char ch = *take(1);
     switch (ch) {
         case 'Y': {
-            qint16 value;
-            in >> value;
-            position += sizeof(qint16);
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(read<qint16>());
         }
         case 'C': {
-            bool value;
-            in >> value;
-            position++;
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(read<bool>());
         }
         case 'I': {
-            qint32 value;
-            in >> value;
-            position += sizeof(qint32);
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(read<qint32>());
         }
         case 'F': {
-            float value;
-            in >> value;
-            position += sizeof(float);
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(read<float>());
         }
         case 'D': {
-            double value;
-            in >> value;
-            position += sizeof(double);
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(read<double>());
         }
         case 'L': {
-            qint64 value;
-            in >> value;
-            position += sizeof(qint64);
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(read<qint64>());
         }
         case 'f': {
-            return readBinaryArray<float>(in, position);
+            return readArray<float>();
         }
         case 'd': {
-            return readBinaryArray<double>(in, position);
+            return readArray<double>();
         }
         case 'l': {
-            return readBinaryArray<qint64>(in, position);
+            return readArray<qint64>();
         }
         case 'i': {
-            return readBinaryArray<qint32>(in, position);
+            return readArray<qint32>();
         }
         case 'b': {
-            return readBinaryArray<bool>(in, position);
+            return readArray<bool>();
         }
         case 'S':
         case 'R': {
-            quint32 length;
-            in >> length;
-            position += sizeof(quint32) + length;
-            return QVariant::fromValue(in.device()->read(length));
+            quint32 length = read<quint32>();
+            const char* bytes = take(length);
+            return QVariant::fromValue(hifi::ByteArray(bytes, length));
         }
         default:
             throw QString("Unknown property type: ") + ch;
     }
 }
 
-FBXNode parseBinaryFBXNode(QDataStream& in, int& position, bool has64BitPositions = false) {
+FBXNode BinaryFBXParser::parseNode() {
     qint64 endOffset;
     quint64 propertyCount;
     quint64 propertyListLength;
@@ -183,27 +197,19 @@ FBXNode parseBinaryFBXNode(QDataStream& in, int& position, bool has64BitPosition
 
     // FBX 2016 and beyond uses 64bit positions in the node headers, pre-2016 used 32bit values
     // our code generally doesn't care about the size that much, so we will use 64bit values
-    // from here on out, but if the file is an older format we read the stream into temp 32bit 
-    // values and then assign to our actual 64bit values.
-    if (has64BitPositions) {
-        in >> endOffset;
-        in >> propertyCount;
-        in >> propertyListLength;
-        position += sizeof(quint64) * 3;
+    // from here on out, but if the file is an older format we read the temp 32bit values
+    // and then assign to our actual 64bit values.
+    if (_has64BitPositions) {
+        endOffset = read<qint64>();
+        propertyCount = read<quint64>();
+        propertyListLength = read<quint64>();
     } else {
-        qint32 tempEndOffset;
-        quint32 tempPropertyCount;
-        quint32 tempPropertyListLength;
-        in >> tempEndOffset;
-        in >> tempPropertyCount;
-        in >> tempPropertyListLength;
-        position += sizeof(quint32) * 3;
-        endOffset = tempEndOffset;
-        propertyCount = tempPropertyCount;
-        propertyListLength = tempPropertyListLength;
-    }
-    in >> nameLength;
-    position += sizeof(quint8);
+        endOffset = read<qint32>();
+        propertyCount = read<quint32>();
+        propertyListLength = read<quint32>();
+    }
+    Q_UNUSED(propertyListLength);
+    nameLength = read<quint8>();
 
     FBXNode node;
     const int MIN_VALID_OFFSET = 40;
@@ -211,15 +217,15 @@ FBXNode parseBinaryFBXNode(QDataStream& in, int& position, bool has64BitPosition
         // use a null name to indicate a null node
         return node;
     }
-    node.name = in.device()->read(nameLength);
-    position += nameLength;
+    const char* name = take(nameLength);
+    node.name = hifi::ByteArray(name, nameLength);
 
-    for (quint32 i = 0; i < propertyCount; i++) {
-        node.properties.append(parseBinaryFBXProperty(in, position));
+    for (quint64 i = 0; i < propertyCount; i++) {
+        node.properties.append(parseProperty());
     }
 
-    while (endOffset > position) {
-        FBXNode child = parseBinaryFBXNode(in, position, has64BitPositions);
+    while (endOffset > _position) {
+        FBXNode child = parseNode();
         if (!child.name.isNull()) {
             node.children.append(child);
         }
@@ -228,6 +234,27 @@ FBXNode parseBinaryFBXNode(QDataStream& in, int& position, bool has64BitPosition
     return node;
 }
 
+void BinaryFBXParser::inflateArrays() {
+    std::atomic<bool> corrupt { false };
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, _compressedArrays.size()), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i) {
+            const auto& array = _compressedArrays[i];
+            uLongf length = (uLongf)array.length;
+            int result = uncompress((Bytef*)array.values, &length, (const Bytef*)array.compressed, array.compressedLength);
+            if (result != Z_OK || length != array.length) {
+                corrupt = true;
+                continue;
+            }
+            array.fromLittleEndian(array.values, array.count);
+        }
+    });
+    _compressedArrays.clear();
+
+    if (corrupt) {
+        throw QString("corrupt fbx file");
+    }
+}
+
 class Tokenizer {
 public:
 
@@ -352,26 +379,21 @@ FBXNode parseTextFBXNode(Tokenizer& tokenizer) {
 }
 
 FBXNode FBXSerializer::parseFBX(QIODevice* device) {
-    PROFILE_RANGE_EX(resource_parse, __FUNCTION__, 0xff0000ff, device);
     // verify the prolog
     if (device->peek(FBX_BINARY_PROLOG.size()) != FBX_BINARY_PROLOG) {
-        // parse as a text file
-        FBXNode top;
-        Tokenizer tokenizer(device);
-        while (device->bytesAvailable()) {
-            FBXNode next = parseTextFBXNode(tokenizer);
-            if (next.name.isNull()) {
-                return top;
+        return parseTextFBX(device);
+    }
+    return parseFBX(device->readAll());
+}
 
-            } else {
-                top.children.append(next);
-            }
-        }
-        return top;
+FBXNode FBXSerializer::parseFBX(const hifi::ByteArray& data) {
+    PROFILE_RANGE_EX(resource_parse, __FUNCTION__, 0xff0000ff, data.size());
+    // verify the prolog
+    if (!data.startsWith(FBX_BINARY_PROLOG)) {
+        QBuffer buffer(const_cast<hifi::ByteArray*>(&data));
+        buffer.open(QIODevice::ReadOnly);
+        return parseTextFBX(&buffer);
     }
-    QDataStream in(device);
-    in.setByteOrder(QDataStream::LittleEndian);
-    in.setVersion(QDataStream::Qt_4_5); // for single/double precision switch
 
     // see http://code.blender.org/index.php/2013/08/fbx-binary-file-format-specification/ for an explanation
     // of the FBX binary format
@@ -380,17 +402,33 @@ FBXNode FBXSerializer::parseFBX(QIODevice* device) {
     //   Bytes 0 - 20: Kaydara FBX Binary  \x00(file - magic, with 2 spaces at the end, then a NULL terminator).
     //   Bytes 21 - 22: [0x1A, 0x00](unknown but all observed files show these bytes).
     //   Bytes 23 - 26 : unsigned int, the version number. 7300 for version 7.3 for example.
-    in.skipRawData(FBX_HEADER_BYTES_BEFORE_VERSION);
-    int position = FBX_HEADER_BYTES_BEFORE_VERSION;
-    quint32 fileVersion;
-    in >> fileVersion;
-    position += sizeof(fileVersion);
-    bool has64BitPositions = (fileVersion >= FBX_VERSION_2016);
+    BinaryFBXParser parser(data);
+    parser.skip(FBX_HEADER_BYTES_BEFORE_VERSION);
+    quint32 fileVersion = parser.read<quint32>();
+    parser.setHas64BitPositions(fileVersion >= FBX_VERSION_2016);
 
     // parse the top-level node
     FBXNode top;
+    while (!parser.atEnd()) {
+        FBXNode next = parser.parseNode();
+        if (next.name.isNull()) {
+            break;
+
+        } else {
+            top.children.append(next);
+        }
+    }
+    parser.inflateArrays();
+
+    return top;
+}
+
+FBXNode FBXSerializer::parseTextFBX(QIODevice* device) {
+    PROFILE_RANGE_EX(resource_parse, __FUNCTION__, 0xff0000ff, device);
+    FBXNode top;
+    Tokenizer tokenizer(device);
     while (device->bytesAvailable()) {
-        FBXNode next = parseBinaryFBXNode(in, position, has64BitPositions);
+        FBXNode next = parseTextFBXNode(tokenizer);
         if (next.name.isNull()) {
             return top;
 
@@ -398,7 +436,6 @@ FBXNode FBXSerializer::parseFBX(QIODevice* device) {
             top.children.append(next);
         }
     }
-
     return top;
 }
 
@@ -409,13 +446,11 @@ glm::vec3 FBXSerializer::getVec3(const QVariantList& properties, int index) {
 }
 
 QVector<glm::vec4> FBXSerializer::createVec4Vector(const QVector<double>& doubleVector) {
-    QVector<glm::vec4> values;
-    for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 4) * 4); it != end; ) {
-        float x = *it++;
-        float y = *it++;
-        float z = *it++;
-        float w = *it++;
-        values.append(glm::vec4(x, y, z, w));
+    QVector<glm::vec4> values(doubleVector.size() / 4);
+    const double* it = doubleVector.constData();
+    for (auto& value : values) {
+        value = glm::vec4((float)it[0], (float)it[1], (float)it[2], (float)it[3]);
+        it += 4;
     }
     return values;
 }
@@ -439,22 +474,21 @@ QVector<glm::vec4> FBXSerializer::createVec4VectorRGBA(const QVector<double>& do
 }
 
 QVector<glm::vec3> FBXSerializer::createVec3Vector(const QVector<double>& doubleVector) {
-    QVector<glm::vec3> values;
-    for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 3) * 3); it != end; ) {
-        float x = *it++;
-        float y = *it++;
-        float z = *it++;
-        values.append(glm::vec3(x, y, z));
+    QVector<glm::vec3> values(doubleVector.size() / 3);
+    const double* it = doubleVector.constData();
+    for (auto& value : values) {
+        value = glm::vec3((float)it[0], (float)it[1], (float)it[2]);
+        it += 3;
     }
     return values;
 }
 
 QVector<glm::vec2> FBXSerializer::createVec2Vector(const QVector<double>& doubleVector) {
-    QVector<glm::vec2> values;
-    for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 2) * 2); it != end; ) {
-        float s = *it++;
-        float t = *it++;
-        values.append(glm::vec2(s, -t));
+    QVector<glm::vec2> values(doubleVector.size() / 2);
+    const double* it = doubleVector.constData();
+    for (auto& value : values) {
+        value = glm::vec2((float)it[0], -(float)it[1]);
+        it += 2;
     }
     return values;
 }
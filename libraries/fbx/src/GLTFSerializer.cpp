@@ -11,7 +11,13 @@
 
 #include "GLTFSerializer.h"
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
 #include <QtCore/QBuffer>
+#include <QtCore/QtEndian>
 #include <QtCore/QIODevice>
 #include <QtCore/QEventLoop>
 #include <QtCore/qjsondocument.h>
@@ -149,26 +155,30 @@ bool GLTFSerializer::getObjectArrayVal(const QJsonObject& object, const QString&
 }
 
 hifi::ByteArray GLTFSerializer::setGLBChunks(const hifi::ByteArray& data) {
-    int byte = 4; 
-    int jsonStart = data.indexOf("JSON", Qt::CaseSensitive);
-    int binStart = data.indexOf("BIN", Qt::CaseSensitive);
-    int jsonLength, binLength;
-    hifi::ByteArray jsonLengthChunk, binLengthChunk;
-
-    jsonLengthChunk = data.mid(jsonStart - byte, byte);
-    QDataStream tempJsonLen(jsonLengthChunk);
-    tempJsonLen.setByteOrder(QDataStream::LittleEndian);
-    tempJsonLen >> jsonLength;
-    hifi::ByteArray jsonChunk = data.mid(jsonStart + byte, jsonLength);
-
-    if (binStart != -1) {
-        binLengthChunk = data.mid(binStart - byte, byte);
-
-        QDataStream tempBinLen(binLengthChunk);
-        tempBinLen.setByteOrder(QDataStream::LittleEndian);
-        tempBinLen >> binLength;
+    // The 12 byte header is followed by the JSON chunk and an optional binary chunk, each preceded by its length and type
+    static const int GLB_HEADER_SIZE = 12;
+    static const int GLB_CHUNK_HEADER_SIZE = 8;
+    static const quint32 GLB_JSON_CHUNK = 0x4E4F534A;
+    static const quint32 GLB_BIN_CHUNK = 0x004E4942;
+
+    hifi::ByteArray jsonChunk;
+    int offset = GLB_HEADER_SIZE;
+    while (offset + GLB_CHUNK_HEADER_SIZE <= data.size()) {
+        quint32 chunkLength = qFromLittleEndian<quint32>(data.constData() + offset);
+        quint32 chunkType = qFromLittleEndian<quint32>(data.constData() + offset + sizeof(quint32));
+        offset += GLB_CHUNK_HEADER_SIZE;
+        if (chunkLength > (quint32)(data.size() - offset)) {
+            qWarning(modelformat) << "Truncated GLB chunk in model" << _url;
+            break;
+        }
 
-        _glbBinary = data.mid(binStart + byte, binLength);
+        // The chunks are read in place rather than copied out of data
+        if (chunkType == GLB_JSON_CHUNK) {
+            jsonChunk = hifi::ByteArray::fromRawData(data.constData() + offset, (int)chunkLength);
+        } else if (chunkType == GLB_BIN_CHUNK) {
+            _glbBinary = hifi::ByteArray::fromRawData(data.constData() + offset, (int)chunkLength);
+        }
+        offset += (int)chunkLength;
     }
     return jsonChunk;
 }
@@ -388,6 +398,7 @@ bool GLTFSerializer::addBufferView(const QJsonObject& object) {
     getIntVal(object, "buffer", bufferview.buffer, bufferview.defined);
     getIntVal(object, "byteLength", bufferview.byteLength, bufferview.defined);
     getIntVal(object, "byteOffset", bufferview.byteOffset, bufferview.defined);
+    getIntVal(object, "byteStride", bufferview.byteStride, bufferview.defined);
     getIntVal(object, "target", bufferview.target, bufferview.defined);
     
     _file.bufferviews.push_back(bufferview);
@@ -647,9 +658,9 @@ bool GLTFSerializer::parseGLTF(const hifi::ByteArray& data) {
 
     hifi::ByteArray jsonChunk = data;
 
-    if (_url.toString().endsWith("glb") && data.indexOf("glTF") == 0 && data.contains("JSON")) {
+    if (_url.toString().endsWith("glb") && data.startsWith("glTF")) {
         jsonChunk = setGLBChunks(data);
-    }    
+    }
    
     QJsonDocument d = QJsonDocument::fromJson(jsonChunk);
     QJsonObject jsFile = d.object();
@@ -1653,6 +1664,10 @@ HFMModel::Pointer GLTFSerializer::read(const hifi::ByteArray& data, const hifi::
         HFMModel& hfmModel = *hfmModelPtr;
         buildGeometry(hfmModel, mapping, _url);
 
+        // The GLB binary chunk points into data, which can go away once we return
+        _glbBinary.clear();
+        _file.buffers.clear();
+
         //hfmDebugDump(data);
         return hfmModelPtr;
     } else {
@@ -1747,13 +1762,12 @@ HFMTexture GLTFSerializer::getHFMTexture(const GLTFTexture& texture) {
         fbxtex.filename = textureUrl.toEncoded();
         
         if (_url.toString().endsWith("glb") && !_glbBinary.isEmpty()) {
-            int bufferView = _file.images[texture.source].bufferView;
-       
-            GLTFBufferView& imagesBufferview = _file.bufferviews[bufferView];
-            int offset = imagesBufferview.byteOffset;
-            int length = imagesBufferview.byteLength;
-
-            fbxtex.content = _glbBinary.mid(offset, length);
+            const auto& image = _file.images[texture.source];
+            hifi::ByteArray imageData;
+            // Copied, since the binary chunk only points into the data being read
+            if (image.defined.value("bufferView") && getBufferViewData(image.bufferView, imageData)) {
+                fbxtex.content = hifi::ByteArray(imageData.constData(), imageData.size());
+            }
             fbxtex.filename = textureUrl.toEncoded().append(texture.source);
         }
 
@@ -1824,149 +1838,201 @@ void GLTFSerializer::setHFMMaterial(HFMMaterial& fbxmat, const GLTFMaterial& mat
 
 }
 
-template<typename T, typename L>
-bool GLTFSerializer::readArray(const hifi::ByteArray& bin, int byteOffset, int count,
-                           QVector<L>& outarray, int accessorType) {
-    
-    QDataStream blobstream(bin);
-    blobstream.setByteOrder(QDataStream::LittleEndian);
-    blobstream.setVersion(QDataStream::Qt_5_9);
-    blobstream.setFloatingPointPrecision(QDataStream::FloatingPointPrecision::SinglePrecision);
-    blobstream.skipRawData(byteOffset);
-
-    int bufferCount = 0;
+int GLTFSerializer::getAccessorTypeComponentCount(int accessorType) {
     switch (accessorType) {
     case GLTFAccessorType::SCALAR:
-        bufferCount = 1;
-        break;
+        return 1;
     case GLTFAccessorType::VEC2:
-        bufferCount = 2;
-        break;
+        return 2;
     case GLTFAccessorType::VEC3:
-        bufferCount = 3;
-        break;
+        return 3;
     case GLTFAccessorType::VEC4:
-        bufferCount = 4;
-        break;
+        return 4;
     case GLTFAccessorType::MAT2:
-        bufferCount = 4;
-        break;
+        return 4;
     case GLTFAccessorType::MAT3:
-        bufferCount = 9;
-        break;
+        return 9;
     case GLTFAccessorType::MAT4:
-        bufferCount = 16;
-        break;
+        return 16;
     default:
         qWarning(modelformat) << "Unknown accessorType: " << accessorType;
-        blobstream.setDevice(nullptr);
-        return false;
+        return 0;
     }
-    for (int i = 0; i < count; ++i) {
-        for (int j = 0; j < bufferCount; ++j) {
-            if (!blobstream.atEnd()) {
+}
+
+// Converts count elements of numComponents T, byteStride bytes apart, into L.
+// Normalized integers map to [0, 1] when unsigned and to [-1, 1] when signed.
+// The components are loaded with memcpy since buffers don't guarantee their alignment, which keeps the loops vectorizable.
+template<typename T, typename L>
+static void convertComponents(const char* src, int byteStride, int count, int numComponents, bool normalized, L* dst) {
+    if (normalized && std::is_integral<T>::value && std::is_floating_point<L>::value) {
+        const float scale = 1.0f / (float)std::numeric_limits<T>::max();
+        for (int i = 0; i < count; ++i, src += byteStride, dst += numComponents) {
+            for (int j = 0; j < numComponents; ++j) {
+                T value;
+                memcpy(&value, src + j * sizeof(T), sizeof(T));
+                dst[j] = (L)std::max((float)value * scale, -1.0f);
+            }
+        }
+    } else {
+        for (int i = 0; i < count; ++i, src += byteStride, dst += numComponents) {
+            for (int j = 0; j < numComponents; ++j) {
                 T value;
-                blobstream >> value;
-                outarray.push_back(value);
-            } else {
-                blobstream.setDevice(nullptr);
-                return false;
+                memcpy(&value, src + j * sizeof(T), sizeof(T));
+                dst[j] = (L)value;
             }
         }
     }
+}
+
+template<typename T, typename L>
+bool GLTFSerializer::readArray(const hifi::ByteArray& bin, int byteOffset, int byteStride, int count,
+                               QVector<L>& outarray, int accessorType, bool normalized) {
+    int numComponents = getAccessorTypeComponentCount(accessorType);
+    if (numComponents == 0) {
+        return false;
+    }
+    if (count <= 0) {
+        return count == 0;
+    }
+
+    // A zero stride means the elements are tightly packed
+    const int elementSize = numComponents * (int)sizeof(T);
+    const int stride = byteStride > 0 ? byteStride : elementSize;
+    if (byteOffset < 0 || stride < elementSize ||
+        (qint64)byteOffset + (qint64)(count - 1) * stride + elementSize > (qint64)bin.size()) {
+        return false;
+    }
 
-    blobstream.setDevice(nullptr);
+    const char* src = bin.constData() + byteOffset;
+    const int start = outarray.size();
+    outarray.resize(start + count * numComponents);
+    L* dst = outarray.data() + start;
+
+    // Tightly packed data already in the type we want is copied in one go
+    if (std::is_same<T, L>::value && !normalized && stride == elementSize) {
+        memcpy(dst, src, (size_t)count * elementSize);
+    } else {
+        convertComponents<T>(src, stride, count, numComponents, normalized, dst);
+    }
     return true;
 }
 template<typename T>
-bool GLTFSerializer::addArrayOfType(const hifi::ByteArray& bin, int byteOffset, int count,
-                                QVector<T>& outarray, int accessorType, int componentType) {
+bool GLTFSerializer::addArrayOfType(const hifi::ByteArray& bin, int byteOffset, int byteStride, int count,
+                                    QVector<T>& outarray, int accessorType, int componentType, bool normalized) {
     
     switch (componentType) {
-    case GLTFAccessorComponentType::BYTE: {}
+    case GLTFAccessorComponentType::BYTE: {
+        return readArray<signed char>(bin, byteOffset, byteStride, count, outarray, accessorType, normalized);
+    }
     case GLTFAccessorComponentType::UNSIGNED_BYTE: {
-        return readArray<uchar>(bin, byteOffset, count, outarray, accessorType);
+        return readArray<uchar>(bin, byteOffset, byteStride, count, outarray, accessorType, normalized);
     }
     case GLTFAccessorComponentType::SHORT: {
-        return readArray<short>(bin, byteOffset, count, outarray, accessorType);
+        return readArray<short>(bin, byteOffset, byteStride, count, outarray, accessorType, normalized);
     }
     case GLTFAccessorComponentType::UNSIGNED_INT: {
-        return readArray<uint>(bin, byteOffset, count, outarray, accessorType);
+        return readArray<uint>(bin, byteOffset, byteStride, count, outarray, accessorType, normalized);
     }
     case GLTFAccessorComponentType::UNSIGNED_SHORT: {
-        return readArray<ushort>(bin, byteOffset, count, outarray, accessorType);
+        return readArray<ushort>(bin, byteOffset, byteStride, count, outarray, accessorType, normalized);
     }
     case GLTFAccessorComponentType::FLOAT: {
-        return readArray<float>(bin, byteOffset, count, outarray, accessorType);
+        return readArray<float>(bin, byteOffset, byteStride, count, outarray, accessorType, normalized);
     }
     }
     return false;
 }
 
+bool GLTFSerializer::getBufferViewData(int bufferViewIndex, hifi::ByteArray& outdata) {
+    if (bufferViewIndex < 0 || bufferViewIndex >= _file.bufferviews.size()) {
+        return false;
+    }
+    const GLTFBufferView& bufferview = _file.bufferviews[bufferViewIndex];
+    if (!bufferview.defined.value("buffer") || !bufferview.defined.value("byteLength") ||
+        bufferview.buffer < 0 || bufferview.buffer >= _file.buffers.size()) {
+        return false;
+    }
+    const hifi::ByteArray& blob = _file.buffers[bufferview.buffer].blob;
+    if (bufferview.byteOffset < 0 || bufferview.byteLength < 0 ||
+        (qint64)bufferview.byteOffset + (qint64)bufferview.byteLength > (qint64)blob.size()) {
+        return false;
+    }
+
+    // Accessors are bounds checked against their view rather than the whole buffer
+    outdata = hifi::ByteArray::fromRawData(blob.constData() + bufferview.byteOffset, bufferview.byteLength);
+    return true;
+}
+
 template <typename T>
 bool GLTFSerializer::addArrayFromAccessor(GLTFAccessor& accessor, QVector<T>& outarray) {
     bool success = true;
+    const int start = outarray.size();
+    const int numComponents = getAccessorTypeComponentCount(accessor.type);
+    if (accessor.count < 0 || numComponents == 0) {
+        return false;
+    }
 
     if (accessor.defined["bufferView"]) {
-        GLTFBufferView& bufferview = _file.bufferviews[accessor.bufferView];
-        GLTFBuffer& buffer = _file.buffers[bufferview.buffer];
-
-        int accBoffset = accessor.defined["byteOffset"] ? accessor.byteOffset : 0;
-
-        success = addArrayOfType(buffer.blob, bufferview.byteOffset + accBoffset, accessor.count, outarray, accessor.type,
-                                 accessor.componentType);
+        hifi::ByteArray bufferViewData;
+        success = getBufferViewData(accessor.bufferView, bufferViewData);
+        if (success) {
+            int accBoffset = accessor.defined["byteOffset"] ? accessor.byteOffset : 0;
+            success = addArrayOfType(bufferViewData, accBoffset, _file.bufferviews[accessor.bufferView].byteStride,
+                                     accessor.count, outarray, accessor.type, accessor.componentType, accessor.normalized);
+        }
     } else {
-        for (int i = 0; i < accessor.count; ++i) {
-            T value;
-            memset(&value, 0, sizeof(T));  // Make sure the dummy array is initalised to zero.
-            outarray.push_back(value);
+        // Without a buffer view the accessor is all zeros, apart from its sparse values
+        qint64 size = (qint64)start + (qint64)accessor.count * numComponents;
+        if (size > std::numeric_limits<int>::max()) {
+            return false;
         }
+        outarray.resize((int)size);
     }
 
     if (success) {
         if (accessor.defined["sparse"]) {
             QVector<int> out_sparse_indices_array;
 
-            GLTFBufferView& sparseIndicesBufferview = _file.bufferviews[accessor.sparse.indices.bufferView];
-            GLTFBuffer& sparseIndicesBuffer = _file.buffers[sparseIndicesBufferview.buffer];
-
-            int accSIBoffset = accessor.sparse.indices.defined["byteOffset"] ? accessor.sparse.indices.byteOffset : 0;
-
-            success = addArrayOfType(sparseIndicesBuffer.blob, sparseIndicesBufferview.byteOffset + accSIBoffset,
-                                     accessor.sparse.count, out_sparse_indices_array, GLTFAccessorType::SCALAR,
-                                     accessor.sparse.indices.componentType);
+            hifi::ByteArray sparseIndicesData;
+            success = getBufferViewData(accessor.sparse.indices.bufferView, sparseIndicesData);
+            if (success) {
+                int accSIBoffset = accessor.sparse.indices.defined["byteOffset"] ? accessor.sparse.indices.byteOffset : 0;
+                success = addArrayOfType(sparseIndicesData, accSIBoffset, 0, accessor.sparse.count, out_sparse_indices_array,
+                                         GLTFAccessorType::SCALAR, accessor.sparse.indices.componentType, false);
+            }
             if (success) {
                 QVector<T> out_sparse_values_array;
 
-                GLTFBufferView& sparseValuesBufferview = _file.bufferviews[accessor.sparse.values.bufferView];
-                GLTFBuffer& sparseValuesBuffer = _file.buffers[sparseValuesBufferview.buffer];
-
-                int accSVBoffset = accessor.sparse.values.defined["byteOffset"] ? accessor.sparse.values.byteOffset : 0;
-
-                success = addArrayOfType(sparseValuesBuffer.blob, sparseValuesBufferview.byteOffset + accSVBoffset,
-                                         accessor.sparse.count, out_sparse_values_array, accessor.type, accessor.componentType);
+                hifi::ByteArray sparseValuesData;
+                success = getBufferViewData(accessor.sparse.values.bufferView, sparseValuesData);
+                if (success) {
+                    int accSVBoffset = accessor.sparse.values.defined["byteOffset"] ? accessor.sparse.values.byteOffset : 0;
+                    success = addArrayOfType(sparseValuesData, accSVBoffset, 0, accessor.sparse.count, out_sparse_values_array,
+                                             accessor.type, accessor.componentType, accessor.normalized);
+                }
 
                 if (success) {
+                    T* values = outarray.data() + start;
+                    const int numElements = (outarray.size() - start) / numComponents;
                     for (int i = 0; i < accessor.sparse.count; ++i) {
-                        if ((i * 3) + 2 < out_sparse_values_array.size()) { 
-                            if ((out_sparse_indices_array[i] * 3) + 2 < outarray.length()) {
-                                for (int j = 0; j < 3; ++j) {
-                                    outarray[(out_sparse_indices_array[i] * 3) + j] = out_sparse_values_array[(i * 3) + j];
-                                }
-                            } else {
-                                success = false;
-                                break;
-                            }
-                        } else {
+                        int index = out_sparse_indices_array[i];
+                        if (index < 0 || index >= numElements) {
                             success = false;
                             break;
                         }
+                        memcpy(values + index * numComponents, out_sparse_values_array.constData() + i * numComponents,
+                               numComponents * sizeof(T));
                     }
                 }
             }
         }
     }
 
+    if (!success) {
+        // Leave nothing half read or half patched behind
+        outarray.resize(start);
+    }
     return success;
 }
 
@@ -206,6 +206,7 @@ struct GLTFBufferView {
     int buffer; //required
     int byteLength; //required
     int byteOffset { 0 };
+    int byteStride { 0 };
     int target;
     QMap<QString, bool> defined;
     void dump() {
@@ -218,6 +219,9 @@ struct GLTFBufferView {
         if (defined["byteOffset"]) {
             qCDebug(modelformat) << "byteOffset: " << byteOffset;
         }
+        if (defined["byteStride"]) {
+            qCDebug(modelformat) << "byteStride: " << byteStride;
+        }
         if (defined["target"]) {
             qCDebug(modelformat) << "target: " << target;
         }
@@ -772,6 +776,7 @@ public:
 private:
     GLTFFile _file;
     hifi::URL _url;
+    // Points into the data given to read(), so it is only valid while reading
     hifi::ByteArray _glbBinary;
 
     glm::mat4 getModelTransform(const GLTFNode& node);
@@ -832,13 +837,18 @@ private:
 
     bool readBinary(const QString& url, hifi::ByteArray& outdata);
 
+    int getAccessorTypeComponentCount(int accessorType);
+
+    // The bytes of a buffer view, false if the view or its buffer is missing or the view doesn't fit in its buffer
+    bool getBufferViewData(int bufferViewIndex, hifi::ByteArray& outdata);
+
     template<typename T, typename L>
-    bool readArray(const hifi::ByteArray& bin, int byteOffset, int count,
-                   QVector<L>& outarray, int accessorType);
+    bool readArray(const hifi::ByteArray& bin, int byteOffset, int byteStride, int count,
+                   QVector<L>& outarray, int accessorType, bool normalized);
 
     template<typename T>
-    bool addArrayOfType(const hifi::ByteArray& bin, int byteOffset, int count,
-                        QVector<T>& outarray, int accessorType, int componentType);
+    bool addArrayOfType(const hifi::ByteArray& bin, int byteOffset, int byteStride, int count,
+                        QVector<T>& outarray, int accessorType, int componentType, bool normalized);
 
     template <typename T>
     bool addArrayFromAccessor(GLTFAccessor& accessor, QVector<T>& outarray);
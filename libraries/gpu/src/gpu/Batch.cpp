@@ -106,6 +106,28 @@ void Batch::clear() {
     _enableSkybox = false;
 }
 
+void Batch::setArena(const BatchArenaPointer& arena) {
+    assert(_commands.empty() && _params.empty() && _data.empty());
+    if (arena == _arena) {
+        return;
+    }
+
+    // Replacing the streams releases the previous storage while the previous arena is still alive
+    BatchArena* rawArena = arena.get();
+    _commands = Commands(ArenaAllocator<Command>(rawArena));
+    _commandOffsets = CommandOffsets(ArenaAllocator<size_t>(rawArena));
+    _params = Params(ArenaAllocator<Param>(rawArena));
+    _data = Bytes(ArenaAllocator<Byte>(rawArena));
+    _arena = arena;
+
+    if (_arena) {
+        _commands.reserve(_commandsMax);
+        _commandOffsets.reserve(_commandOffsetsMax);
+        _params.reserve(_paramsMax);
+        _data.reserve(_dataMax);
+    }
+}
+
 size_t Batch::cacheData(size_t size, const void* data) {
     size_t offset = _data.size();
     size_t numBytes = size;
@@ -18,6 +18,7 @@
 
 #include <shared/NsightHelpers.h>
 
+#include "BatchArena.h"
 #include "Framebuffer.h"
 #include "Pipeline.h"
 #include "Query.h"
@@ -99,6 +100,11 @@ public:
     const std::string& getName() const { return _name; }
     void clear();
 
+    // Move the command streams to the storage of the arena, or back to the heap without one.
+    // MUST only be called on an empty batch
+    void setArena(const BatchArenaPointer& arena);
+    const BatchArenaPointer& getArena() const { return _arena; }
+
     // Batches may need to override the context level stereo settings
     // if they're performing framebuffer copy operations, like the 
     // deferred lighting resolution mechanism
@@ -370,8 +376,8 @@ public:
 
         NUM_COMMANDS,
     };
-    typedef std::vector<Command> Commands;
-    typedef std::vector<size_t> CommandOffsets;
+    typedef std::vector<Command, ArenaAllocator<Command>> Commands;
+    typedef std::vector<size_t, ArenaAllocator<size_t>> CommandOffsets;
 
     const Commands& getCommands() const { return _commands; }
     const CommandOffsets& getCommandOffsets() const { return _commandOffsets; }
@@ -394,7 +400,7 @@ public:
         Param(uint32 val) : _uint(val) {}
         Param(float val) : _float(val) {}
     };
-    typedef std::vector<Param> Params;
+    typedef std::vector<Param, ArenaAllocator<Param>> Params;
 
     const Params& getParams() const { return _params; }
 
@@ -467,7 +473,7 @@ public:
     // Cache Data in a byte array if too big to fit in Param
     // FOr example Mat4s are going there
     typedef unsigned char Byte;
-    typedef std::vector<Byte> Bytes;
+    typedef std::vector<Byte, ArenaAllocator<Byte>> Bytes;
     size_t cacheData(size_t size, const void* data);
     Byte* editData(size_t offset) {
         if (offset >= _data.size()) {
@@ -483,6 +489,9 @@ public:
         return (_data.data() + offset);
     }
 
+    // Keeps the arena of the streams alive, so it must be declared before them
+    BatchArenaPointer _arena;
+
     Commands _commands;
     static size_t _commandsMax;
 
@@ -0,0 +1,58 @@
+//
+//  BatchArena.cpp
+//  libraries/gpu/src/gpu
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#include "BatchArena.h"
+
+#include <algorithm>
+
+using namespace gpu;
+
+const size_t BatchArena::BLOCK_SIZE;
+
+void* BatchArena::allocate(size_t size, size_t alignment) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stats.allocationCount++;
+    _stats.allocatedSize += size;
+
+    // The tail of a block too small for the request is skipped until the next reset
+    while (_currentBlock < _blocks.size()) {
+        auto& block = _blocks[_currentBlock];
+        size_t offset = (_offset + alignment - 1) & ~(alignment - 1);
+        if (offset + size <= block.size) {
+            _offset = offset + size;
+            return block.data.get() + offset;
+        }
+        _currentBlock++;
+        _offset = 0;
+    }
+
+    Block block;
+    block.size = std::max(size, BLOCK_SIZE);
+    block.data.reset(new uint8_t[block.size]);
+    _stats.blockCount++;
+    _stats.blockSize += block.size;
+
+    _blocks.push_back(std::move(block));
+    _currentBlock = _blocks.size() - 1;
+    _offset = size;
+    return _blocks.back().data.get();
+}
+
+void BatchArena::reset() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _currentBlock = 0;
+    _offset = 0;
+    _stats.allocationCount = 0;
+    _stats.allocatedSize = 0;
+}
+
+BatchArena::Stats BatchArena::getStats() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
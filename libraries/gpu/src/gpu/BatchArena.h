@@ -0,0 +1,108 @@
+//
+//  BatchArena.h
+//  libraries/gpu/src/gpu
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#ifndef hifi_gpu_BatchArena_h
+#define hifi_gpu_BatchArena_h
+
+#include <stdint.h>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace gpu {
+
+// Storage for the command streams of the batches recorded during one frame.
+// Allocations are carved from large blocks and never freed one by one: reset() rewinds all the blocks at once
+// and keeps them for the next frame, so a frame in steady state doesn't touch the heap at all.
+// Batches recorded on different threads can share the same arena.
+class BatchArena {
+public:
+    static const size_t BLOCK_SIZE = 1024 * 1024;
+
+    struct Stats {
+        uint32_t allocationCount { 0 };
+        uint64_t allocatedSize { 0 };
+        uint32_t blockCount { 0 };
+        uint64_t blockSize { 0 };
+    };
+
+    BatchArena() {}
+    BatchArena(const BatchArena&) = delete;
+    BatchArena& operator=(const BatchArena&) = delete;
+
+    void* allocate(size_t size, size_t alignment);
+
+    // MUST only be called when none of the previous allocations are in use anymore
+    void reset();
+
+    Stats getStats() const;
+
+private:
+    struct Block {
+        std::unique_ptr<uint8_t[]> data;
+        size_t size;
+    };
+
+    mutable std::mutex _mutex;
+    std::vector<Block> _blocks;
+    size_t _currentBlock { 0 };
+    size_t _offset { 0 };
+    Stats _stats;
+};
+using BatchArenaPointer = std::shared_ptr<BatchArena>;
+
+// Standard allocator on top of a BatchArena, deallocation is a no-op.
+// Without an arena it falls back to the heap.
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    ArenaAllocator() {}
+    ArenaAllocator(BatchArena* arena) : _arena(arena) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : _arena(other.getArena()) {}
+
+    T* allocate(size_t count) {
+        if (_arena) {
+            return static_cast<T*>(_arena->allocate(count * sizeof(T), alignof(T)));
+        }
+        return static_cast<T*>(::operator new(count * sizeof(T)));
+    }
+
+    void deallocate(T* pointer, size_t) {
+        if (!_arena) {
+            ::operator delete(pointer);
+        }
+    }
+
+    BatchArena* getArena() const { return _arena; }
+
+private:
+    BatchArena* _arena { nullptr };
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& left, const ArenaAllocator<U>& right) {
+    return left.getArena() == right.getArena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& left, const ArenaAllocator<U>& right) {
+    return left.getArena() != right.getArena();
+}
+
+};  // namespace gpu
+
+#endif
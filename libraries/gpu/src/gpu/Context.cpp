@@ -12,6 +12,7 @@
 #include "Context.h"
 
 #include <shared/GlobalAppProperties.h>
+#include <TBBHelpers.h>
 
 #include "Frame.h"
 #include "GPULogging.h"
@@ -79,6 +80,8 @@ void Context::beginFrame(const glm::mat4& renderView, const glm::mat4& renderPos
     _currentFrame->pose = renderPose;
     _currentFrame->view = renderView;
 
+    beginBatchArenaFrame();
+
     if (!_frameRangeTimer) {
         _frameRangeTimer = std::make_shared<RangeTimer>("gpu::Context::Frame");
     }
@@ -101,6 +104,8 @@ FramePointer Context::endFrame() {
 
     result->stereoState = _stereo;
     result->finish();
+
+    endBatchArenaFrame();
     return result;
 }
 
@@ -396,25 +401,77 @@ void Context::processProgramsToSync() {
 std::mutex Context::_batchPoolMutex;
 std::list<Batch*> Context::_batchPool;
 
+BatchArenaPointer Context::_currentBatchArena;
+std::vector<BatchArenaPointer> Context::_batchArenas;
+BatchArena::Stats Context::_frameBatchArenaStats;
+
 void Context::clearBatches() {
+    Lock lock(_batchPoolMutex);
     for (auto batch : _batchPool) {
         delete batch;
     }
     _batchPool.clear();
+    _currentBatchArena.reset();
+    _batchArenas.clear();
+}
+
+void Context::beginBatchArenaFrame() {
+    Lock lock(_batchPoolMutex);
+    // Only the list refers to an arena whose batches have all been released
+    for (const auto& arena : _batchArenas) {
+        if (arena.use_count() == 1) {
+            arena->reset();
+            _currentBatchArena = arena;
+            return;
+        }
+    }
+    _currentBatchArena = std::make_shared<BatchArena>();
+    _batchArenas.push_back(_currentBatchArena);
+}
+
+void Context::endBatchArenaFrame() {
+    Lock lock(_batchPoolMutex);
+    if (_currentBatchArena) {
+        _frameBatchArenaStats = _currentBatchArena->getStats();
+    }
+    // Batches acquired between frames, by executeBatch for instance, go back to the heap
+    _currentBatchArena.reset();
+}
+
+uint32_t Context::getFrameBatchAllocationCount() {
+    Lock lock(_batchPoolMutex);
+    return _frameBatchArenaStats.allocationCount;
+}
+
+Context::Size Context::getFrameBatchAllocationSize() {
+    Lock lock(_batchPoolMutex);
+    return _frameBatchArenaStats.allocatedSize;
+}
+
+Context::Size Context::getBatchArenaMemSize() {
+    Lock lock(_batchPoolMutex);
+    Size size = 0;
+    for (const auto& arena : _batchArenas) {
+        size += arena->getStats().blockSize;
+    }
+    return size;
 }
 
 BatchPointer Context::acquireBatch(const char* name) {
     Batch* rawBatch = nullptr;
+    BatchArenaPointer arena;
     {
         Lock lock(_batchPoolMutex);
         if (!_batchPool.empty()) {
             rawBatch = _batchPool.front();
             _batchPool.pop_front();
         }
+        arena = _currentBatchArena;
     }
     if (!rawBatch) {
         rawBatch = new Batch();
     }
+    rawBatch->setArena(arena);
     if (name) {
         rawBatch->setName(name);
     }
@@ -423,6 +480,8 @@ BatchPointer Context::acquireBatch(const char* name) {
 
 void Context::releaseBatch(Batch* batch) {
     batch->clear();
+    // Don't keep the arena of the frame alive from the pool
+    batch->setArena(nullptr);
     Lock lock(_batchPoolMutex);
     _batchPool.push_back(batch);
 }
@@ -434,3 +493,25 @@ void gpu::doInBatch(const char* name,
     f(*batch);
     context->appendFrameBatch(batch);
 }
+
+std::vector<BatchPointer> gpu::recordBatches(const char* name,
+                                             const std::vector<std::function<void(Batch& batch)>>& functions) {
+    // Acquiring reads the preallocation sizes the batches share, so only the recording is parallel
+    std::vector<BatchPointer> batches;
+    batches.reserve(functions.size());
+    for (size_t i = 0; i < functions.size(); ++i) {
+        batches.push_back(Context::acquireBatch(name));
+    }
+    tbb::parallel_for((size_t)0, functions.size(), [&](size_t i) {
+        functions[i](*batches[i]);
+    });
+    return batches;
+}
+
+void gpu::doInBatches(const char* name,
+                      const std::shared_ptr<gpu::Context>& context,
+                      const std::vector<std::function<void(Batch& batch)>>& functions) {
+    for (const auto& batch : recordBatches(name, functions)) {
+        context->appendFrameBatch(batch);
+    }
+}
@@ -164,6 +164,7 @@ public:
     void appendFrameBatch(const BatchPointer& batch);
     FramePointer endFrame();
 
+    // Batches acquired during a frame store their commands in the arena of that frame
     static BatchPointer acquireBatch(const char* name = nullptr);
     static void releaseBatch(Batch* batch);
 
@@ -256,6 +257,11 @@ public:
     static Size getTextureResourcePopulatedGPUMemSize();
     static Size getTextureResourceIdealGPUMemSize();
 
+    // Batch command storage handed out by the arena of the last complete frame, and the memory of all the arenas
+    static uint32_t getFrameBatchAllocationCount();
+    static Size getFrameBatchAllocationSize();
+    static Size getBatchArenaMemSize();
+
     struct ProgramsToSync {
         ProgramsToSync(const std::vector<gpu::ShaderPointer>& programs, std::function<void()> callback, size_t rate) :
             programs(programs), callback(callback), rate(rate) {}
@@ -295,6 +301,13 @@ protected:
     static std::mutex _batchPoolMutex;
     static std::list<Batch*> _batchPool;
 
+    // One arena per frame in flight, an arena is reset and reused once no batch refers to it anymore
+    static void beginBatchArenaFrame();
+    static void endBatchArenaFrame();
+    static BatchArenaPointer _currentBatchArena;
+    static std::vector<BatchArenaPointer> _batchArenas;
+    static BatchArena::Stats _frameBatchArenaStats;
+
     friend class Shader;
     friend class Backend;
 };
@@ -302,6 +315,14 @@ typedef std::shared_ptr<Context> ContextPointer;
 
 void doInBatch(const char* name, const std::shared_ptr<gpu::Context>& context, const std::function<void(Batch& batch)>& f);
 
+// Record each function into its own batch on worker threads, and return the batches in the order of the functions.
+// The functions MUST NOT share any mutable state, RenderArgs::_batch included.
+std::vector<BatchPointer> recordBatches(const char* name, const std::vector<std::function<void(Batch& batch)>>& functions);
+
+// Record the batches as recordBatches() does, then append them to the frame in the order of the functions,
+// whichever order they finished recording in.
+void doInBatches(const char* name, const std::shared_ptr<gpu::Context>& context, const std::vector<std::function<void(Batch& batch)>>& functions);
+
 };  // namespace gpu
 
 #endif
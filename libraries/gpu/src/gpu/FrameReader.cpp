@@ -759,8 +759,10 @@ BatchPointer Deserializer::readBatch(const json& node) {
                                                            return result;
                                                        });
 
-    readOptionalTransformed<std::vector<uint8_t>>(batch._data, node, keys::data,
-                                                  [](const json& node) { return fromBase64(node); });
+    readOptionalTransformed<Batch::Bytes>(batch._data, node, keys::data, [](const json& node) {
+        auto data = fromBase64(node);
+        return Batch::Bytes(data.begin(), data.end());
+    });
 
     for (const auto& commandNode : node[keys::commands]) {
         readCommand(commandNode, batch);
@@ -134,7 +134,7 @@ public:
 
     void findCapturableTextures(const Frame& frame);
     void writeBinaryBlob();
-    static std::string toBase64(const std::vector<uint8_t>& v);
+    static std::string toBase64(const Batch::Bytes& v);
     static json writeIrradiance(const SHPointer& irradiance);
     static json writeMat4(const glm::mat4& m) {
         static const glm::mat4 IDENTITY;
@@ -178,7 +178,7 @@ using namespace gpu;
 const TextureView Serializer::DEFAULT_TEXTURE_VIEW = TextureView();
 const Sampler Serializer::DEFAULT_SAMPLER = Sampler();
 
-std::string Serializer::toBase64(const std::vector<uint8_t>& v) {
+std::string Serializer::toBase64(const Batch::Bytes& v) {
     return QByteArray((const char*)v.data(), (int)v.size()).toBase64().toStdString();
 }
 
@@ -270,7 +270,10 @@ PixelsPointer KtxStorage::getMipFace(uint16 level, uint8 face) const {
         qWarning() << "Failed to get a valid storageView for faceSize=" << faceSize << "  faceOffset=" << faceOffset
                     << "out of valid file " << QString::fromStdString(_filename);
     }
-    return storageView->toMemoryStorage();
+    auto result = storageView->toMemoryStorage();
+    // The mip now lives in its own memory, don't keep the mapped file pages around until the file is closed
+    storageView->releaseResidency();
+    return result;
 }
 
 Size KtxStorage::getMipFaceSize(uint16 level, uint8 face) const {
@@ -27,14 +27,18 @@ class Backend : public gpu::Backend {
     // Context Backend static interface required
     friend class gpu::Context;
     static void init() {}
-    static gpu::Backend* createBackend() { return new Backend(); }
+    static BackendPointer createBackend() { return std::make_shared<Backend>(); }
 
-protected:
+public:
     explicit Backend(bool syncCache) : Parent() { }
     Backend() : Parent() { }
-public:
     ~Backend() { }
 
+    const std::string& getVersion() const final {
+        static const std::string NULL_VERSION { "Null" };
+        return NULL_VERSION;
+    }
+
     void render(const Batch& batch) final { }
 
     // This call synchronize the Full Backend cache with the current GLState
@@ -45,9 +49,15 @@ public:
 
     void syncProgram(const gpu::ShaderPointer& program) final {}
 
+    void recycle() const final { }
+
     // This is the ugly "download the pixels to sysmem for taking a snapshot"
     // Just avoid using it, it's ugly and will break performances
     virtual void downloadFramebuffer(const FramebufferPointer& srcFramebuffer, const Vec4i& region, QImage& destImage) final { }
+
+    // Every format is accepted and no texture memory is ever managed, so the CPU side of the engine runs as usual
+    bool supportedTextureFormat(const gpu::Element& format) final { return true; }
+    bool isTextureManagementSparseEnabled() const final { return false; }
 };
 
 } }
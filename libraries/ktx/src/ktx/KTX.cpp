@@ -224,6 +224,57 @@ storage::StoragePointer KTX::getMipFaceTexelsData(uint16_t mip, uint8_t face) co
     return result;
 }
 
+size_t KTX::getMipSize(uint16_t mip) const {
+    return mip < _images.size() ? _images[mip]._imageSize : 0;
+}
+
+void KTX::requestMip(uint16_t mip) {
+    if (mip >= _images.size() || !_storage) {
+        return;
+    }
+    _residentMips.resize(_images.size(), false);
+    if (!_residentMips[mip]) {
+        _residentMips[mip] = true;
+        _storage->requestResidency(_images[mip]._imageSize, _images[mip]._faceBytes[0] - _storage->data());
+    }
+}
+
+void KTX::releaseMip(uint16_t mip) {
+    if (mip >= _residentMips.size() || !_storage) {
+        return;
+    }
+    if (_residentMips[mip]) {
+        _residentMips[mip] = false;
+        _storage->releaseResidency(_images[mip]._imageSize, _images[mip]._faceBytes[0] - _storage->data());
+    }
+}
+
+bool KTX::isMipResident(uint16_t mip) const {
+    if (mip >= _images.size() || !_storage) {
+        return false;
+    }
+    if (!_storage->isMapped()) {
+        return true;
+    }
+    return mip < _residentMips.size() && _residentMips[mip];
+}
+
+size_t KTX::evalResidentSize() const {
+    if (!_storage) {
+        return 0;
+    }
+    if (!_storage->isMapped()) {
+        return _storage->size();
+    }
+    size_t result = sizeof(Header) + getKeyValueDataSize();
+    for (uint16_t mip = 0; mip < _residentMips.size(); ++mip) {
+        if (_residentMips[mip]) {
+            result += _images[mip]._imageSize;
+        }
+    }
+    return result;
+}
+
 size_t KTXDescriptor::getMipFaceTexelsSize(uint16_t mip, uint8_t face) const {
     size_t result { 0 };
     if (mip < images.size()) {
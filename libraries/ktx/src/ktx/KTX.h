@@ -378,10 +378,21 @@ namespace ktx {
         size_t getTexelsDataSize() const;
         bool isValid() const;
 
+        // Mip residency, for a KTX backed by a memory mapped file (see KTX::create(const StoragePointer&)).
+        // The pages of a mip are only read from disk when requested or touched, and releasing a mip gives them back to the OS.
+        // A KTX held in memory is always fully resident.
+        void requestMip(uint16_t mip);
+        void releaseMip(uint16_t mip);
+        bool isMipResident(uint16_t mip) const;
+        size_t getMipSize(uint16_t mip) const;
+        // Bytes of the container expected to be resident: the header, key values and requested mips
+        size_t evalResidentSize() const;
+
         Header _header;
         StoragePointer _storage;
         KeyValues _keyValues;
         Images _images;
+        std::vector<bool> _residentMips;
 
         friend struct KTXDescriptor;
     };
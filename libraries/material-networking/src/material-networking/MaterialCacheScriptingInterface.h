@@ -37,6 +37,9 @@ class MaterialCacheScriptingInterface : public ScriptableResourceCache, public D
      * @property {number} numCached - Total number of cached resource. <em>Read-only.</em>
      * @property {number} sizeTotal - Size in bytes of all resources. <em>Read-only.</em>
      * @property {number} sizeCached - Size in bytes of all cached resources. <em>Read-only.</em>
+     * @property {number} numHits - Number of requests served by a resource already known to the cache. <em>Read-only.</em>
+     * @property {number} numMisses - Number of requests that created a new resource. <em>Read-only.</em>
+     * @property {number} numEvictions - Number of cached resources evicted to make room. <em>Read-only.</em>
      *
      * @borrows ResourceCache.getResourceList as getResourceList
      * @borrows ResourceCache.updateTotalSize as updateTotalSize
@@ -23,6 +23,10 @@
 namespace baker {
     class Baker {
     public:
+        // Whenever a change is made to the baker that changes the models it outputs, this value should be incremented.
+        // Models processed by an older baker are then ignored by HFMModelCache and processed again
+        static const uint32_t VERSION;
+
         Baker(const hfm::Model::Pointer& hfmModel, const hifi::VariantHash& mapping, const hifi::URL& materialMappingBaseURL);
 
         std::shared_ptr<TaskConfig> getConfiguration();
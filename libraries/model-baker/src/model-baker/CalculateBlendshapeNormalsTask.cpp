@@ -11,6 +11,8 @@
 
 #include "CalculateBlendshapeNormalsTask.h"
 
+#include <TBBHelpers.h>
+
 #include "ModelMath.h"
 
 void CalculateBlendshapeNormalsTask::run(const baker::BakeContextPointer& context, const Input& input, Output& output) {
@@ -18,20 +20,22 @@ void CalculateBlendshapeNormalsTask::run(const baker::BakeContextPointer& contex
     const auto& meshes = input.get1();
     auto& normalsPerBlendshapePerMeshOut = output;
 
-    normalsPerBlendshapePerMeshOut.reserve(blendshapesPerMesh.size());
+    normalsPerBlendshapePerMeshOut.resize(blendshapesPerMesh.size());
     for (size_t i = 0; i < blendshapesPerMesh.size(); i++) {
-        const auto& mesh = meshes[i];
-        const auto& blendshapes = blendshapesPerMesh[i];
-        normalsPerBlendshapePerMeshOut.emplace_back();
-        auto& normalsPerBlendshapeOut = normalsPerBlendshapePerMeshOut[normalsPerBlendshapePerMeshOut.size()-1];
+        normalsPerBlendshapePerMeshOut[i].resize(blendshapesPerMesh[i].size());
+    }
 
-        normalsPerBlendshapeOut.reserve(blendshapes.size());
-        for (size_t j = 0; j < blendshapes.size(); j++) {
-            const auto& blendshape = blendshapes[j];
+    // Each blendshape only writes its own normals, so the blendshapes of all meshes are processed in parallel
+    const auto blendshapeIndices = baker::listBlendshapes(blendshapesPerMesh);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, blendshapeIndices.size()), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t k = range.begin(); k < range.end(); k++) {
+            const auto& mesh = meshes[blendshapeIndices[k].first];
+            const auto& blendshape = blendshapesPerMesh[blendshapeIndices[k].first][blendshapeIndices[k].second];
+            auto& normals = normalsPerBlendshapePerMeshOut[blendshapeIndices[k].first][blendshapeIndices[k].second];
             const auto& normalsIn = blendshape.normals;
             // Check if normals are already defined. Otherwise, calculate them from existing blendshape vertices.
             if (!normalsIn.empty()) {
-                normalsPerBlendshapeOut.push_back(normalsIn.toStdVector());
+                normals = normalsIn.toStdVector();
             } else {
                 // Create lookup to get index in blendshape from vertex index in mesh
                 std::vector<int> reverseIndices;
@@ -42,8 +46,6 @@ void CalculateBlendshapeNormalsTask::run(const baker::BakeContextPointer& contex
                     reverseIndices[indexInMesh] = indexInBlendShape;
                 }
 
-                normalsPerBlendshapeOut.emplace_back();
-                auto& normals = normalsPerBlendshapeOut[normalsPerBlendshapeOut.size()-1];
                 normals.resize(mesh.vertices.size());
                 baker::calculateNormals(mesh,
                     [&reverseIndices, &blendshape, &normals](int normalIndex) /* NormalAccessor */ {
@@ -66,5 +68,5 @@ void CalculateBlendshapeNormalsTask::run(const baker::BakeContextPointer& contex
                     });
             }
         }
-    }
+    });
 }
@@ -13,6 +13,8 @@
 
 #include <set>
 
+#include <TBBHelpers.h>
+
 #include "ModelMath.h"
 
 void CalculateBlendshapeTangentsTask::run(const baker::BakeContextPointer& context, const Input& input, Output& output) {
@@ -20,21 +22,23 @@ void CalculateBlendshapeTangentsTask::run(const baker::BakeContextPointer& conte
     const auto& blendshapesPerMesh = input.get1();
     const auto& meshes = input.get2();
     auto& tangentsPerBlendshapePerMeshOut = output;
-    
-    tangentsPerBlendshapePerMeshOut.reserve(normalsPerBlendshapePerMesh.size());
+
+    tangentsPerBlendshapePerMeshOut.resize(blendshapesPerMesh.size());
     for (size_t i = 0; i < blendshapesPerMesh.size(); i++) {
-        const auto& normalsPerBlendshape = baker::safeGet(normalsPerBlendshapePerMesh, i);
-        const auto& blendshapes = blendshapesPerMesh[i];
-        const auto& mesh = meshes[i];
-        tangentsPerBlendshapePerMeshOut.emplace_back();
-        auto& tangentsPerBlendshapeOut = tangentsPerBlendshapePerMeshOut[tangentsPerBlendshapePerMeshOut.size()-1];
+        tangentsPerBlendshapePerMeshOut[i].resize(blendshapesPerMesh[i].size());
+    }
 
-        for (size_t j = 0; j < blendshapes.size(); j++) {
-            const auto& blendshape = blendshapes[j];
+    // Each blendshape only writes its own tangents, so the blendshapes of all meshes are processed in parallel
+    const auto blendshapeIndices = baker::listBlendshapes(blendshapesPerMesh);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, blendshapeIndices.size()), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t k = range.begin(); k < range.end(); k++) {
+            const size_t i = blendshapeIndices[k].first;
+            const size_t j = blendshapeIndices[k].second;
+            const auto& normals = baker::safeGet(baker::safeGet(normalsPerBlendshapePerMesh, i), j);
+            const auto& blendshape = blendshapesPerMesh[i][j];
+            const auto& mesh = meshes[i];
             const auto& tangentsIn = blendshape.tangents;
-            const auto& normals = baker::safeGet(normalsPerBlendshape, j);
-            tangentsPerBlendshapeOut.emplace_back();
-            auto& tangentsOut = tangentsPerBlendshapeOut[tangentsPerBlendshapeOut.size()-1];
+            auto& tangentsOut = tangentsPerBlendshapePerMeshOut[i][j];
 
             // Check if we already have tangents
             if (!tangentsIn.empty()) {
@@ -80,5 +84,5 @@ void CalculateBlendshapeTangentsTask::run(const baker::BakeContextPointer& conte
                 }
             });
         }
-    }
+    });
 }
@@ -0,0 +1,907 @@
+//
+//  HFMModelCache.cpp
+//  model-baker/src/model-baker
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HFMModelCache.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QFile>
+
+#include <gpu/Stream.h>
+#include <graphics/Geometry.h>
+#include <graphics/Material.h>
+
+#include "Baker.h"
+#include "ModelBakerLogging.h"
+
+const uint32_t HFMModelCache::CURRENT_VERSION = 1;
+const std::string HFMModelCache::DIRNAME { "hfm_cache" };
+const std::string HFMModelCache::EXT { "hfm" };
+
+static const uint32_t HFM_CACHE_MAGIC = 0x434d4648; // "HFMC"
+static const uint32_t HFM_CACHE_ALIGNMENT = 16;
+
+struct HFMCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t bakerVersion;
+    uint32_t alignment;
+    uint64_t size;
+};
+
+namespace {
+
+// Appends values to an entry.  Arrays are padded to HFM_CACHE_ALIGNMENT from the start of the entry.
+class CacheWriter {
+public:
+    CacheWriter(hifi::ByteArray& data) : _data(data) {}
+
+    // only for plain data: integers, floats and glm types
+    template <typename T>
+    void write(const T& value) { _data.append((const char*)&value, sizeof(T)); }
+
+    void writeBool(bool value) { write<uint8_t>(value ? 1 : 0); }
+    void writeBytes(const hifi::ByteArray& bytes) {
+        write<uint32_t>((uint32_t)bytes.size());
+        _data.append(bytes);
+    }
+    void writeString(const QString& string) { writeBytes(string.toUtf8()); }
+    void writeString(const std::string& string) {
+        write<uint32_t>((uint32_t)string.size());
+        _data.append(string.data(), (int)string.size());
+    }
+
+    template <typename T>
+    void writeArray(const T* values, size_t count) {
+        write<uint32_t>((uint32_t)count);
+        align();
+        _data.append((const char*)values, (int)(count * sizeof(T)));
+    }
+    template <typename T>
+    void writeArray(const QVector<T>& values) { writeArray(values.constData(), values.size()); }
+    template <typename T>
+    void writeArray(const std::vector<T>& values) { writeArray(values.data(), values.size()); }
+
+private:
+    void align() {
+        int padding = (int)((HFM_CACHE_ALIGNMENT - (uint32_t)_data.size() % HFM_CACHE_ALIGNMENT) % HFM_CACHE_ALIGNMENT);
+        _data.append(padding, '\0');
+    }
+
+    hifi::ByteArray& _data;
+};
+
+// Reads an entry back.  Running past the end of the entry invalidates the reader, every read after that
+// returns empty values, so callers only check isValid() once they are done.
+class CacheReader {
+public:
+    CacheReader(const char* data, size_t size) : _data(data), _size(size) {}
+
+    bool isValid() const { return _valid; }
+    bool atEnd() const { return _offset == _size; }
+
+    template <typename T>
+    T read() {
+        T value {};
+        const char* source = take(sizeof(T));
+        if (source) {
+            memcpy(&value, source, sizeof(T));
+        }
+        return value;
+    }
+
+    bool readBool() { return read<uint8_t>() != 0; }
+
+    // A count of things that take at least a byte each, so garbage can't make us loop for long
+    uint32_t readCount() {
+        uint32_t count = read<uint32_t>();
+        if (count > _size - _offset) {
+            _valid = false;
+            return 0;
+        }
+        return count;
+    }
+
+    hifi::ByteArray readBytes() {
+        uint32_t size = read<uint32_t>();
+        const char* source = take(size);
+        return source ? hifi::ByteArray(source, (int)size) : hifi::ByteArray();
+    }
+    QString readString() { return QString::fromUtf8(readBytes()); }
+    std::string readStdString() {
+        uint32_t size = read<uint32_t>();
+        const char* source = take(size);
+        return source ? std::string(source, size) : std::string();
+    }
+
+    // Points into the entry, the count elements of elementSize bytes are aligned to HFM_CACHE_ALIGNMENT
+    const char* readArrayData(size_t elementSize, uint32_t& count) {
+        count = read<uint32_t>();
+        size_t aligned = (_offset + HFM_CACHE_ALIGNMENT - 1) & ~(size_t)(HFM_CACHE_ALIGNMENT - 1);
+        if (!_valid || aligned > _size) {
+            _valid = false;
+            count = 0;
+            return nullptr;
+        }
+        _offset = aligned;
+        const char* source = take((size_t)count * elementSize);
+        if (!source) {
+            count = 0;
+        }
+        return source;
+    }
+
+    template <typename T>
+    void readArray(QVector<T>& values) {
+        uint32_t count;
+        const char* source = readArrayData(sizeof(T), count);
+        values.resize((int)count);
+        if (count > 0) {
+            memcpy(values.data(), source, count * sizeof(T));
+        }
+    }
+    template <typename T>
+    void readArray(std::vector<T>& values) {
+        uint32_t count;
+        const char* source = readArrayData(sizeof(T), count);
+        values.resize(count);
+        if (count > 0) {
+            memcpy(values.data(), source, count * sizeof(T));
+        }
+    }
+
+private:
+    const char* take(size_t length) {
+        if (!_valid || length > _size - _offset) {
+            _valid = false;
+            return nullptr;
+        }
+        const char* source = _data + _offset;
+        _offset += length;
+        return source;
+    }
+
+    const char* _data;
+    size_t _size;
+    size_t _offset { 0 };
+    bool _valid { true };
+};
+
+}
+
+// QHash iteration order changes from one run to the next, so hashes and maps are hashed in key order
+static void hashVariant(QCryptographicHash& hasher, const QVariant& value) {
+    switch (value.type()) {
+        case QVariant::Hash: {
+            auto hash = value.toHash();
+            auto keys = hash.uniqueKeys();
+            std::sort(keys.begin(), keys.end());
+            for (const auto& key : keys) {
+                hasher.addData(key.toUtf8());
+                for (const auto& item : hash.values(key)) {
+                    hashVariant(hasher, item);
+                }
+            }
+            break;
+        }
+        case QVariant::Map: {
+            auto map = value.toMap();
+            for (const auto& key : map.uniqueKeys()) {
+                hasher.addData(key.toUtf8());
+                for (const auto& item : map.values(key)) {
+                    hashVariant(hasher, item);
+                }
+            }
+            break;
+        }
+        case QVariant::List:
+            for (const auto& item : value.toList()) {
+                hashVariant(hasher, item);
+            }
+            break;
+        default: {
+            QByteArray bytes;
+            QDataStream stream(&bytes, QIODevice::WriteOnly);
+            stream << value;
+            hasher.addData(bytes);
+            break;
+        }
+    }
+}
+
+static void writeTransform(CacheWriter& writer, const Transform& transform) {
+    writer.write(transform.getTranslation());
+    writer.write(transform.getRotation());
+    writer.write(transform.getScale());
+}
+
+static Transform readTransform(CacheReader& reader) {
+    // the setters keep the flags, so an identity transform reads back as one
+    Transform transform;
+    transform.setTranslation(reader.read<glm::vec3>());
+    transform.setRotation(reader.read<glm::quat>());
+    transform.setScale(reader.read<glm::vec3>());
+    return transform;
+}
+
+static void writeExtents(CacheWriter& writer, const Extents& extents) {
+    writer.write(extents.minimum);
+    writer.write(extents.maximum);
+}
+
+static Extents readExtents(CacheReader& reader) {
+    Extents extents;
+    extents.minimum = reader.read<glm::vec3>();
+    extents.maximum = reader.read<glm::vec3>();
+    return extents;
+}
+
+static void writeTexture(CacheWriter& writer, const hfm::Texture& texture) {
+    writer.writeString(texture.id);
+    writer.writeString(texture.name);
+    writer.writeBytes(texture.filename);
+    writer.writeBytes(texture.content);
+    writer.write<uint8_t>((uint8_t)texture.sourceChannel);
+    writeTransform(writer, texture.transform);
+    writer.write<int32_t>(texture.maxNumPixels);
+    writer.write<int32_t>(texture.texcoordSet);
+    writer.writeString(texture.texcoordSetName);
+    writer.writeBool(texture.isBumpmap);
+}
+
+static void readTexture(CacheReader& reader, hfm::Texture& texture) {
+    texture.id = reader.readString();
+    texture.name = reader.readString();
+    texture.filename = reader.readBytes();
+    texture.content = reader.readBytes();
+    texture.sourceChannel = (image::ColorChannel)reader.read<uint8_t>();
+    texture.transform = readTransform(reader);
+    texture.maxNumPixels = reader.read<int32_t>();
+    texture.texcoordSet = reader.read<int32_t>();
+    texture.texcoordSetName = reader.readString();
+    texture.isBumpmap = reader.readBool();
+}
+
+// The serializers only set the properties of the graphics material, its texture maps are made later by NetworkMaterial
+static void writeGraphicsMaterial(CacheWriter& writer, const graphics::MaterialPointer& material) {
+    writer.writeBool((bool)material);
+    if (!material) {
+        return;
+    }
+    writer.writeString(material->getName());
+    writer.writeString(material->getModel());
+    writer.write<uint32_t>((uint32_t)material->getKey()._flags.to_ulong());
+    writer.write(material->getEmissive(false));
+    writer.write(material->getAlbedo(false));
+    writer.write(material->getOpacity());
+    writer.write(material->getRoughness());
+    writer.write(material->getMetallic());
+    writer.write(material->getScattering());
+    writer.write(material->getOpacityCutoff());
+    for (int i = 0; i < graphics::Material::NUM_TEXCOORD_TRANSFORMS; i++) {
+        writer.write(material->getTexCoordTransform(i));
+    }
+    writer.writeBool(material->getDefaultFallthrough());
+}
+
+static graphics::MaterialPointer readGraphicsMaterial(CacheReader& reader) {
+    if (!reader.readBool()) {
+        return nullptr;
+    }
+    auto material = std::make_shared<graphics::Material>();
+    material->setName(reader.readStdString());
+    material->setModel(reader.readStdString());
+    graphics::MaterialKey key(graphics::MaterialKey::Flags(reader.read<uint32_t>()));
+    auto emissive = reader.read<glm::vec3>();
+    auto albedo = reader.read<glm::vec3>();
+    auto opacity = reader.read<float>();
+    auto roughness = reader.read<float>();
+    auto metallic = reader.read<float>();
+    auto scattering = reader.read<float>();
+    auto opacityCutoff = reader.read<float>();
+
+    // The setters derive the key from the values, only call the ones the original material went through
+    // so the key comes out the same
+    material->setEmissive(emissive, false);
+    if (key.isAlbedo()) {
+        material->setAlbedo(albedo, false);
+    }
+    if (opacity != graphics::Material::DEFAULT_OPACITY) {
+        material->setOpacity(opacity);
+    }
+    if (roughness != graphics::Material::DEFAULT_ROUGHNESS) {
+        material->setRoughness(roughness);
+    }
+    if (metallic != graphics::Material::DEFAULT_METALLIC) {
+        material->setMetallic(metallic);
+    }
+    if (scattering != graphics::Material::DEFAULT_SCATTERING) {
+        material->setScattering(scattering);
+    }
+    material->setOpacityCutoff(opacityCutoff);
+    if (key.isOpacityMapMode()) {
+        material->setOpacityMapMode(key.getOpacityMapMode());
+    }
+    material->setUnlit(key.isUnlit());
+
+    for (int i = 0; i < graphics::Material::NUM_TEXCOORD_TRANSFORMS; i++) {
+        material->setTexCoordTransform(i, reader.read<glm::mat4>());
+    }
+    material->setDefaultFallthrough(reader.readBool());
+    return material;
+}
+
+static void writeMaterial(CacheWriter& writer, const hfm::Material& material) {
+    writer.write(material.diffuseColor);
+    writer.write(material.diffuseFactor);
+    writer.write(material.specularColor);
+    writer.write(material.specularFactor);
+    writer.write(material.emissiveColor);
+    writer.write(material.emissiveFactor);
+    writer.write(material.shininess);
+    writer.write(material.opacity);
+    writer.write(material.metallic);
+    writer.write(material.roughness);
+    writer.write(material.emissiveIntensity);
+    writer.write(material.ambientFactor);
+    writer.write(material.bumpMultiplier);
+
+    writer.writeString(material.materialID);
+    writer.writeString(material.name);
+    writer.writeString(material.shadingModel);
+    writeGraphicsMaterial(writer, material._material);
+
+    writeTexture(writer, material.normalTexture);
+    writeTexture(writer, material.albedoTexture);
+    writeTexture(writer, material.opacityTexture);
+    writeTexture(writer, material.glossTexture);
+    writeTexture(writer, material.roughnessTexture);
+    writeTexture(writer, material.specularTexture);
+    writeTexture(writer, material.metallicTexture);
+    writeTexture(writer, material.emissiveTexture);
+    writeTexture(writer, material.occlusionTexture);
+    writeTexture(writer, material.scatteringTexture);
+    writeTexture(writer, material.lightmapTexture);
+    writer.write(material.lightmapParams);
+
+    writer.writeBool(material.isPBSMaterial);
+    writer.writeBool(material.useNormalMap);
+    writer.writeBool(material.useAlbedoMap);
+    writer.writeBool(material.useOpacityMap);
+    writer.writeBool(material.useRoughnessMap);
+    writer.writeBool(material.useSpecularMap);
+    writer.writeBool(material.useMetallicMap);
+    writer.writeBool(material.useEmissiveMap);
+    writer.writeBool(material.useOcclusionMap);
+}
+
+static void readMaterial(CacheReader& reader, hfm::Material& material) {
+    material.diffuseColor = reader.read<glm::vec3>();
+    material.diffuseFactor = reader.read<float>();
+    material.specularColor = reader.read<glm::vec3>();
+    material.specularFactor = reader.read<float>();
+    material.emissiveColor = reader.read<glm::vec3>();
+    material.emissiveFactor = reader.read<float>();
+    material.shininess = reader.read<float>();
+    material.opacity = reader.read<float>();
+    material.metallic = reader.read<float>();
+    material.roughness = reader.read<float>();
+    material.emissiveIntensity = reader.read<float>();
+    material.ambientFactor = reader.read<float>();
+    material.bumpMultiplier = reader.read<float>();
+
+    material.materialID = reader.readString();
+    material.name = reader.readString();
+    material.shadingModel = reader.readString();
+    material._material = readGraphicsMaterial(reader);
+
+    readTexture(reader, material.normalTexture);
+    readTexture(reader, material.albedoTexture);
+    readTexture(reader, material.opacityTexture);
+    readTexture(reader, material.glossTexture);
+    readTexture(reader, material.roughnessTexture);
+    readTexture(reader, material.specularTexture);
+    readTexture(reader, material.metallicTexture);
+    readTexture(reader, material.emissiveTexture);
+    readTexture(reader, material.occlusionTexture);
+    readTexture(reader, material.scatteringTexture);
+    readTexture(reader, material.lightmapTexture);
+    material.lightmapParams = reader.read<glm::vec2>();
+
+    material.isPBSMaterial = reader.readBool();
+    material.useNormalMap = reader.readBool();
+    material.useAlbedoMap = reader.readBool();
+    material.useOpacityMap = reader.readBool();
+    material.useRoughnessMap = reader.readBool();
+    material.useSpecularMap = reader.readBool();
+    material.useMetallicMap = reader.readBool();
+    material.useEmissiveMap = reader.readBool();
+    material.useOcclusionMap = reader.readBool();
+}
+
+static void writeElement(CacheWriter& writer, const gpu::Element& element) {
+    writer.write<uint8_t>((uint8_t)element.getDimension());
+    writer.write<uint8_t>((uint8_t)element.getType());
+    writer.write<uint8_t>((uint8_t)element.getSemantic());
+}
+
+static gpu::Element readElement(CacheReader& reader) {
+    auto dimension = (gpu::Dimension)reader.read<uint8_t>();
+    auto type = (gpu::Type)reader.read<uint8_t>();
+    auto semantic = (gpu::Semantic)reader.read<uint8_t>();
+    return gpu::Element(dimension, type, semantic);
+}
+
+static void writeBuffer(CacheWriter& writer, const gpu::BufferPointer& buffer) {
+    if (buffer) {
+        writer.writeArray(buffer->getData(), buffer->getSize());
+    } else {
+        writer.writeArray((const gpu::Byte*)nullptr, 0);
+    }
+}
+
+static gpu::BufferPointer readBuffer(CacheReader& reader) {
+    uint32_t size;
+    const char* data = reader.readArrayData(1, size);
+    auto buffer = std::make_shared<gpu::Buffer>();
+    if (size > 0) {
+        buffer->setData(size, (const gpu::Byte*)data);
+    }
+    return buffer;
+}
+
+static void writeBufferView(CacheWriter& writer, const gpu::BufferView& view) {
+    writeElement(writer, view._element);
+    writer.write<uint64_t>(view._offset);
+    writer.write<uint64_t>(view._size);
+    writer.write<uint16_t>(view._stride);
+    writeBuffer(writer, view._buffer);
+}
+
+static gpu::BufferView readBufferView(CacheReader& reader) {
+    auto element = readElement(reader);
+    auto offset = (gpu::Size)reader.read<uint64_t>();
+    auto size = (gpu::Size)reader.read<uint64_t>();
+    auto stride = reader.read<uint16_t>();
+    auto buffer = readBuffer(reader);
+    return gpu::BufferView(buffer, offset, size, stride, element);
+}
+
+static void writeGraphicsMesh(CacheWriter& writer, const graphics::MeshPointer& mesh) {
+    writer.writeBool((bool)mesh);
+    if (!mesh) {
+        return;
+    }
+    writer.writeString(mesh->displayName);
+    writer.writeString(mesh->modelName);
+
+    const auto& format = mesh->getVertexFormat();
+    writer.write<uint32_t>(format ? (uint32_t)format->getAttributes().size() : 0);
+    if (format) {
+        for (const auto& slotAndAttribute : format->getAttributes()) {
+            const auto& attribute = slotAndAttribute.second;
+            writer.write<uint8_t>(attribute._slot);
+            writer.write<uint8_t>(attribute._channel);
+            writeElement(writer, attribute._element);
+            writer.write<uint64_t>(attribute._offset);
+            writer.write<uint32_t>(attribute._frequency);
+        }
+    }
+
+    const auto& stream = mesh->getVertexStream();
+    writer.write<uint32_t>((uint32_t)stream.getBuffers().size());
+    for (size_t i = 0; i < stream.getBuffers().size(); i++) {
+        writer.write<uint64_t>(stream.getOffsets()[i]);
+        writer.write<uint64_t>(stream.getStrides()[i]);
+        writeBuffer(writer, stream.getBuffers()[i]);
+    }
+
+    writeBufferView(writer, mesh->getIndexBuffer());
+    writeBufferView(writer, mesh->getPartBuffer());
+}
+
+static graphics::MeshPointer readGraphicsMesh(CacheReader& reader) {
+    if (!reader.readBool()) {
+        return nullptr;
+    }
+    auto mesh = std::make_shared<graphics::Mesh>();
+    mesh->displayName = reader.readStdString();
+    mesh->modelName = reader.readStdString();
+
+    auto format = std::make_shared<gpu::Stream::Format>();
+    uint32_t numAttributes = reader.readCount();
+    for (uint32_t i = 0; i < numAttributes; i++) {
+        auto slot = reader.read<uint8_t>();
+        auto channel = reader.read<uint8_t>();
+        auto element = readElement(reader);
+        auto offset = (gpu::Offset)reader.read<uint64_t>();
+        auto frequency = (gpu::Stream::Frequency)reader.read<uint32_t>();
+        format->setAttribute(slot, channel, element, offset, frequency);
+    }
+
+    auto stream = std::make_shared<gpu::BufferStream>();
+    uint32_t numBuffers = reader.readCount();
+    for (uint32_t i = 0; i < numBuffers; i++) {
+        auto offset = (gpu::Offset)reader.read<uint64_t>();
+        auto stride = (gpu::Offset)reader.read<uint64_t>();
+        stream->addBuffer(readBuffer(reader), offset, stride);
+    }
+    mesh->setVertexFormatAndStream(format, stream);
+
+    mesh->setIndexBuffer(readBufferView(reader));
+    mesh->setPartBuffer(readBufferView(reader));
+    return mesh;
+}
+
+static void writeMesh(CacheWriter& writer, const hfm::Mesh& mesh) {
+    writer.write<uint32_t>((uint32_t)mesh.parts.size());
+    for (const auto& part : mesh.parts) {
+        writer.writeArray(part.quadIndices);
+        writer.writeArray(part.quadTrianglesIndices);
+        writer.writeArray(part.triangleIndices);
+        writer.writeString(part.materialID);
+    }
+
+    writer.writeArray(mesh.vertices);
+    writer.writeArray(mesh.normals);
+    writer.writeArray(mesh.tangents);
+    writer.writeArray(mesh.colors);
+    writer.writeArray(mesh.texCoords);
+    writer.writeArray(mesh.texCoords1);
+    writer.writeArray(mesh.clusterIndices);
+    writer.writeArray(mesh.clusterWeights);
+    writer.writeArray(mesh.originalIndices);
+
+    writer.write<uint32_t>((uint32_t)mesh.clusters.size());
+    for (const auto& cluster : mesh.clusters) {
+        writer.write<int32_t>(cluster.jointIndex);
+        writer.write(cluster.inverseBindMatrix);
+        writeTransform(writer, cluster.inverseBindTransform);
+    }
+
+    writeExtents(writer, mesh.meshExtents);
+    writer.write(mesh.modelTransform);
+
+    writer.write<uint32_t>((uint32_t)mesh.blendshapes.size());
+    for (const auto& blendshape : mesh.blendshapes) {
+        writer.writeArray(blendshape.indices);
+        writer.writeArray(blendshape.vertices);
+        writer.writeArray(blendshape.normals);
+        writer.writeArray(blendshape.tangents);
+    }
+
+    writer.write<uint32_t>(mesh.meshIndex);
+    writeGraphicsMesh(writer, mesh._mesh);
+    writer.writeBool(mesh.wasCompressed);
+}
+
+static void readMesh(CacheReader& reader, hfm::Mesh& mesh) {
+    mesh.parts.resize((int)reader.readCount());
+    for (auto& part : mesh.parts) {
+        reader.readArray(part.quadIndices);
+        reader.readArray(part.quadTrianglesIndices);
+        reader.readArray(part.triangleIndices);
+        part.materialID = reader.readString();
+    }
+
+    reader.readArray(mesh.vertices);
+    reader.readArray(mesh.normals);
+    reader.readArray(mesh.tangents);
+    reader.readArray(mesh.colors);
+    reader.readArray(mesh.texCoords);
+    reader.readArray(mesh.texCoords1);
+    reader.readArray(mesh.clusterIndices);
+    reader.readArray(mesh.clusterWeights);
+    reader.readArray(mesh.originalIndices);
+
+    mesh.clusters.resize((int)reader.readCount());
+    for (auto& cluster : mesh.clusters) {
+        cluster.jointIndex = reader.read<int32_t>();
+        cluster.inverseBindMatrix = reader.read<glm::mat4>();
+        cluster.inverseBindTransform = readTransform(reader);
+    }
+
+    mesh.meshExtents = readExtents(reader);
+    mesh.modelTransform = reader.read<glm::mat4>();
+
+    mesh.blendshapes.resize((int)reader.readCount());
+    for (auto& blendshape : mesh.blendshapes) {
+        reader.readArray(blendshape.indices);
+        reader.readArray(blendshape.vertices);
+        reader.readArray(blendshape.normals);
+        reader.readArray(blendshape.tangents);
+    }
+
+    mesh.meshIndex = reader.read<uint32_t>();
+    mesh._mesh = readGraphicsMesh(reader);
+    mesh.wasCompressed = reader.readBool();
+}
+
+static void writeJoint(CacheWriter& writer, const hfm::Joint& joint) {
+    writer.write(joint.shapeInfo.avgPoint);
+    writer.writeArray(joint.shapeInfo.dots);
+    writer.writeArray(joint.shapeInfo.points);
+    writer.writeArray(joint.shapeInfo.debugLines);
+
+    writer.write<int32_t>(joint.parentIndex);
+    writer.write(joint.distanceToParent);
+    writer.write(joint.translation);
+    writer.write(joint.preTransform);
+    writer.write(joint.preRotation);
+    writer.write(joint.rotation);
+    writer.write(joint.postRotation);
+    writer.write(joint.postTransform);
+    writer.write(joint.transform);
+    writer.write(joint.rotationMin);
+    writer.write(joint.rotationMax);
+    writer.write(joint.inverseDefaultRotation);
+    writer.write(joint.inverseBindRotation);
+    writer.write(joint.bindTransform);
+    writer.writeString(joint.name);
+    writer.writeBool(joint.isSkeletonJoint);
+    writer.writeBool(joint.bindTransformFoundInCluster);
+
+    writer.writeBool(joint.hasGeometricOffset);
+    writer.write(joint.geometricTranslation);
+    writer.write(joint.geometricRotation);
+    writer.write(joint.geometricScaling);
+}
+
+static void readJoint(CacheReader& reader, hfm::Joint& joint) {
+    joint.shapeInfo.avgPoint = reader.read<glm::vec3>();
+    reader.readArray(joint.shapeInfo.dots);
+    reader.readArray(joint.shapeInfo.points);
+    reader.readArray(joint.shapeInfo.debugLines);
+
+    joint.parentIndex = reader.read<int32_t>();
+    joint.distanceToParent = reader.read<float>();
+    joint.translation = reader.read<glm::vec3>();
+    joint.preTransform = reader.read<glm::mat4>();
+    joint.preRotation = reader.read<glm::quat>();
+    joint.rotation = reader.read<glm::quat>();
+    joint.postRotation = reader.read<glm::quat>();
+    joint.postTransform = reader.read<glm::mat4>();
+    joint.transform = reader.read<glm::mat4>();
+    joint.rotationMin = reader.read<glm::vec3>();
+    joint.rotationMax = reader.read<glm::vec3>();
+    joint.inverseDefaultRotation = reader.read<glm::quat>();
+    joint.inverseBindRotation = reader.read<glm::quat>();
+    joint.bindTransform = reader.read<glm::mat4>();
+    joint.name = reader.readString();
+    joint.isSkeletonJoint = reader.readBool();
+    joint.bindTransformFoundInCluster = reader.readBool();
+
+    joint.hasGeometricOffset = reader.readBool();
+    joint.geometricTranslation = reader.read<glm::vec3>();
+    joint.geometricRotation = reader.read<glm::quat>();
+    joint.geometricScaling = reader.read<glm::vec3>();
+}
+
+static void writeModel(CacheWriter& writer, const hfm::Model& hfmModel) {
+    writer.writeString(hfmModel.originalURL);
+    writer.writeString(hfmModel.author);
+    writer.writeString(hfmModel.applicationName);
+
+    writer.write<uint32_t>((uint32_t)hfmModel.joints.size());
+    for (const auto& joint : hfmModel.joints) {
+        writeJoint(writer, joint);
+    }
+    writer.write<uint32_t>((uint32_t)hfmModel.jointIndices.size());
+    for (auto it = hfmModel.jointIndices.cbegin(); it != hfmModel.jointIndices.cend(); ++it) {
+        writer.writeString(it.key());
+        writer.write<int32_t>(it.value());
+    }
+    writer.writeBool(hfmModel.hasSkeletonJoints);
+
+    writer.write<uint32_t>((uint32_t)hfmModel.meshes.size());
+    for (const auto& mesh : hfmModel.meshes) {
+        writeMesh(writer, mesh);
+    }
+
+    writer.write<uint32_t>((uint32_t)hfmModel.scripts.size());
+    for (const auto& script : hfmModel.scripts) {
+        writer.writeString(script);
+    }
+
+    writer.write<uint32_t>((uint32_t)hfmModel.materials.size());
+    for (auto it = hfmModel.materials.cbegin(); it != hfmModel.materials.cend(); ++it) {
+        writer.writeString(it.key());
+        writeMaterial(writer, it.value());
+    }
+
+    writer.write(hfmModel.offset);
+    writer.write(hfmModel.neckPivot);
+    writeExtents(writer, hfmModel.bindExtents);
+    writeExtents(writer, hfmModel.meshExtents);
+
+    writer.write<uint32_t>((uint32_t)hfmModel.animationFrames.size());
+    for (const auto& frame : hfmModel.animationFrames) {
+        writer.writeArray(frame.rotations);
+        writer.writeArray(frame.translations);
+    }
+
+    writer.write<uint32_t>((uint32_t)hfmModel.meshIndicesToModelNames.size());
+    for (auto it = hfmModel.meshIndicesToModelNames.cbegin(); it != hfmModel.meshIndicesToModelNames.cend(); ++it) {
+        writer.write<int32_t>(it.key());
+        writer.writeString(it.value());
+    }
+
+    writer.write<uint32_t>((uint32_t)hfmModel.blendshapeChannelNames.size());
+    for (const auto& name : hfmModel.blendshapeChannelNames) {
+        writer.writeString(name);
+    }
+
+    writer.write<uint32_t>((uint32_t)hfmModel.jointRotationOffsets.size());
+    for (auto it = hfmModel.jointRotationOffsets.cbegin(); it != hfmModel.jointRotationOffsets.cend(); ++it) {
+        writer.write<int32_t>(it.key());
+        writer.write(it.value());
+    }
+
+    writer.write<uint32_t>((uint32_t)hfmModel.shapeVertices.size());
+    for (const auto& shapeVertices : hfmModel.shapeVertices) {
+        writer.writeArray(shapeVertices);
+    }
+
+    hifi::ByteArray flowData;
+    {
+        QDataStream stream(&flowData, QIODevice::WriteOnly);
+        stream << hfmModel.flowData._physicsConfig << hfmModel.flowData._collisionsConfig;
+    }
+    writer.writeBytes(flowData);
+}
+
+static void readModel(CacheReader& reader, hfm::Model& hfmModel) {
+    hfmModel.originalURL = reader.readString();
+    hfmModel.author = reader.readString();
+    hfmModel.applicationName = reader.readString();
+
+    hfmModel.joints.resize((int)reader.readCount());
+    for (auto& joint : hfmModel.joints) {
+        readJoint(reader, joint);
+    }
+    uint32_t numJointIndices = reader.readCount();
+    for (uint32_t i = 0; i < numJointIndices; i++) {
+        QString name = reader.readString();
+        hfmModel.jointIndices.insert(name, reader.read<int32_t>());
+    }
+    hfmModel.hasSkeletonJoints = reader.readBool();
+
+    hfmModel.meshes.resize((int)reader.readCount());
+    for (auto& mesh : hfmModel.meshes) {
+        readMesh(reader, mesh);
+    }
+
+    hfmModel.scripts.resize((int)reader.readCount());
+    for (auto& script : hfmModel.scripts) {
+        script = reader.readString();
+    }
+
+    uint32_t numMaterials = reader.readCount();
+    for (uint32_t i = 0; i < numMaterials; i++) {
+        QString materialID = reader.readString();
+        readMaterial(reader, hfmModel.materials[materialID]);
+    }
+
+    hfmModel.offset = reader.read<glm::mat4>();
+    hfmModel.neckPivot = reader.read<glm::vec3>();
+    hfmModel.bindExtents = readExtents(reader);
+    hfmModel.meshExtents = readExtents(reader);
+
+    hfmModel.animationFrames.resize((int)reader.readCount());
+    for (auto& frame : hfmModel.animationFrames) {
+        reader.readArray(frame.rotations);
+        reader.readArray(frame.translations);
+    }
+
+    uint32_t numModelNames = reader.readCount();
+    for (uint32_t i = 0; i < numModelNames; i++) {
+        int meshIndex = reader.read<int32_t>();
+        hfmModel.meshIndicesToModelNames.insert(meshIndex, reader.readString());
+    }
+
+    uint32_t numChannelNames = reader.readCount();
+    for (uint32_t i = 0; i < numChannelNames; i++) {
+        hfmModel.blendshapeChannelNames.push_back(reader.readString());
+    }
+
+    uint32_t numRotationOffsets = reader.readCount();
+    for (uint32_t i = 0; i < numRotationOffsets; i++) {
+        int jointIndex = reader.read<int32_t>();
+        hfmModel.jointRotationOffsets.insert(jointIndex, reader.read<glm::quat>());
+    }
+
+    hfmModel.shapeVertices.resize(reader.readCount());
+    for (auto& shapeVertices : hfmModel.shapeVertices) {
+        reader.readArray(shapeVertices);
+    }
+
+    hifi::ByteArray flowData = reader.readBytes();
+    QDataStream stream(flowData);
+    stream >> hfmModel.flowData._physicsConfig >> hfmModel.flowData._collisionsConfig;
+}
+
+HFMModelCache::HFMModelCache(const std::string& dirname) : FileCache(dirname, EXT) {
+}
+
+HFMModelCache::Key HFMModelCache::computeKey(const hifi::ByteArray& data, const hifi::URL& url, const hifi::VariantHash& mapping) {
+    QCryptographicHash hasher(QCryptographicHash::Md5);
+    hasher.addData(data);
+    hasher.addData(url.toEncoded());
+    hashVariant(hasher, QVariant(mapping));
+    uint32_t versions[] = { CURRENT_VERSION, baker::Baker::VERSION };
+    hasher.addData((const char*)versions, sizeof(versions));
+    return hasher.result().toHex().toStdString();
+}
+
+hfm::Model::Pointer HFMModelCache::load(const Key& key) {
+    auto file = getFile(key);
+    if (file) {
+        QFile input(QString::fromStdString(file->getFilepath()));
+        if (input.open(QIODevice::ReadOnly)) {
+            hfm::Model::Pointer hfmModel;
+            uchar* mapped = input.map(0, input.size());
+            if (mapped) {
+                hfmModel = deserialize((const char*)mapped, (size_t)input.size());
+                input.unmap(mapped);
+            } else {
+                hifi::ByteArray data = input.readAll();
+                hfmModel = deserialize(data.constData(), (size_t)data.size());
+            }
+            if (hfmModel) {
+                ++_numHits;
+                return hfmModel;
+            }
+        }
+    }
+    ++_numMisses;
+    return nullptr;
+}
+
+void HFMModelCache::store(const Key& key, const hfm::Model& hfmModel) {
+    hifi::ByteArray data = serialize(hfmModel);
+    // overwrite entries that failed to load, they were written by another version
+    writeFile(data.data(), Metadata(key, (size_t)data.size()), true);
+}
+
+hifi::ByteArray HFMModelCache::serialize(const hfm::Model& hfmModel) {
+    hifi::ByteArray data;
+    CacheWriter writer(data);
+    HFMCacheHeader header { HFM_CACHE_MAGIC, CURRENT_VERSION, baker::Baker::VERSION, HFM_CACHE_ALIGNMENT, 0 };
+    writer.write(header);
+    writeModel(writer, hfmModel);
+
+    header.size = (uint64_t)data.size();
+    memcpy(data.data(), &header, sizeof(header));
+    return data;
+}
+
+hfm::Model::Pointer HFMModelCache::deserialize(const char* data, size_t size) {
+    CacheReader reader(data, size);
+    auto header = reader.read<HFMCacheHeader>();
+    if (!reader.isValid() || header.magic != HFM_CACHE_MAGIC || header.version != CURRENT_VERSION ||
+            header.bakerVersion != baker::Baker::VERSION || header.alignment != HFM_CACHE_ALIGNMENT) {
+        return nullptr;
+    }
+    if (header.size != (uint64_t)size) {
+        qCWarning(model_baker) << "HFMModelCache: ignoring truncated entry of" << size << "bytes";
+        return nullptr;
+    }
+
+    auto hfmModel = std::make_shared<hfm::Model>();
+    readModel(reader, *hfmModel);
+    if (!reader.isValid() || !reader.atEnd()) {
+        qCWarning(model_baker) << "HFMModelCache: ignoring corrupt entry of" << size << "bytes";
+        return nullptr;
+    }
+    return hfmModel;
+}
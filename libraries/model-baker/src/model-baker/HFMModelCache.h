@@ -0,0 +1,53 @@
+//
+//  HFMModelCache.h
+//  model-baker/src/model-baker
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_HFMModelCache_h
+#define hifi_HFMModelCache_h
+
+#include <atomic>
+
+#include <shared/FileCache.h>
+#include <shared/HifiTypes.h>
+#include <hfm/HFM.h>
+
+// Persists the models that come out of the serializers and the baker, graphics meshes included, so loading the
+// same model again reads them back instead of parsing and processing the source file.
+// Entries are keyed by a hash of the source file, of the url and mapping it was loaded with and of Baker::VERSION.
+// The bulk arrays of an entry are stored 16 byte aligned, so they are copied straight out of the mapped file.
+class HFMModelCache : public cache::FileCache {
+    Q_OBJECT
+
+public:
+    // Whenever a change is made to the serialized format that isn't backward compatible,
+    // this value should be incremented.  Entries with another version are processed again and overwritten.
+    static const uint32_t CURRENT_VERSION;
+    static const std::string DIRNAME;
+    static const std::string EXT;
+
+    HFMModelCache(const std::string& dirname = DIRNAME);
+
+    static Key computeKey(const hifi::ByteArray& data, const hifi::URL& url, const hifi::VariantHash& mapping);
+
+    /// \return the cached model, or nullptr if there is no valid entry for key
+    hfm::Model::Pointer load(const Key& key);
+    void store(const Key& key, const hfm::Model& hfmModel);
+
+    static hifi::ByteArray serialize(const hfm::Model& hfmModel);
+    static hfm::Model::Pointer deserialize(const char* data, size_t size);
+
+    uint32_t getNumHits() const { return _numHits; }
+    uint32_t getNumMisses() const { return _numMisses; }
+
+private:
+    std::atomic_uint _numHits { 0 };
+    std::atomic_uint _numMisses { 0 };
+};
+
+#endif // hifi_HFMModelCache_h
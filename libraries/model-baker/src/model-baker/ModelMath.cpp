@@ -39,6 +39,16 @@ namespace baker {
         return vector[i];
     }
 
+    BlendshapeIndices listBlendshapes(const BlendshapesPerMesh& blendshapesPerMesh) {
+        BlendshapeIndices blendshapeIndices;
+        for (size_t i = 0; i < blendshapesPerMesh.size(); i++) {
+            for (size_t j = 0; j < blendshapesPerMesh[i].size(); j++) {
+                blendshapeIndices.emplace_back(i, j);
+            }
+        }
+        return blendshapeIndices;
+    }
+
     void setTangent(const HFMMesh& mesh, const IndexAccessor& vertexAccessor, int firstIndex, int secondIndex) {
         glm::vec3 vertex[2];
         glm::vec2 texCoords[2];
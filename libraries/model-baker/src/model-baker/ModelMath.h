@@ -36,6 +36,10 @@ namespace baker {
         }
     }
 
+    // The blendshapes of all meshes as (mesh index, blendshape index) pairs, so work on them can be split evenly
+    using BlendshapeIndices = std::vector<std::pair<size_t, size_t>>;
+    BlendshapeIndices listBlendshapes(const BlendshapesPerMesh& blendshapesPerMesh);
+
     // Returns a reference to the normal at the specified index, or nullptr if it cannot be accessed
     using NormalAccessor = std::function<glm::vec3*(int index)>;
 
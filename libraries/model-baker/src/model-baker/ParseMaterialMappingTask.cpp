@@ -66,9 +66,7 @@ void processMaterialMapping(MaterialMapping& materialMapping, const QJsonObject&
     }
 }
 
-void ParseMaterialMappingTask::run(const baker::BakeContextPointer& context, const Input& input, Output& output) {
-    const auto& mapping = input.get0();
-    const auto& url = input.get1();
+MaterialMapping ParseMaterialMappingTask::parseMaterialMapping(const hifi::VariantHash& mapping, const hifi::URL& url) {
     MaterialMapping materialMapping;
 
     auto mappingIter = mapping.find("materialMap");
@@ -91,5 +89,9 @@ void ParseMaterialMappingTask::run(const baker::BakeContextPointer& context, con
         }
     }
 
-    output = materialMapping;
+    return materialMapping;
+}
+
+void ParseMaterialMappingTask::run(const baker::BakeContextPointer& context, const Input& input, Output& output) {
+    output = parseMaterialMapping(input.get0(), input.get1());
 }
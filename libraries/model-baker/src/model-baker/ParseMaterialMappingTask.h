@@ -26,6 +26,9 @@ public:
     using Output = MaterialMapping;
     using JobModel = baker::Job::ModelIO<ParseMaterialMappingTask, Input, Output>;
 
+    // Also used on its own when the rest of the model comes out of HFMModelCache
+    static MaterialMapping parseMaterialMapping(const hifi::VariantHash& mapping, const hifi::URL& url);
+
     void run(const baker::BakeContextPointer& context, const Input& input, Output& output);
 };
 
@@ -106,6 +106,15 @@ private:
     QString _webMediaType;
 };
 
+// OBJ and glTF files can load materials and buffers from other files next to them, which the cache key doesn't cover
+static bool isSelfContained(const QUrl& url) {
+    QString path = url.path().toLower();
+    if (path.endsWith(".gz")) {
+        path.chop(3);
+    }
+    return !path.endsWith(".obj") && !path.endsWith(".gltf");
+}
+
 void GeometryReader::run() {
     DependencyManager::get<StatTracker>()->decrementStat("PendingProcessing");
     CounterStat counter("Processing");
@@ -139,47 +148,67 @@ void GeometryReader::run() {
             throw QString("url is invalid");
         }
 
-        HFMModel::Pointer hfmModel;
         QVariantHash serializerMapping = _mapping.second;
         serializerMapping["combineParts"] = _combineParts;
         serializerMapping["deduplicateIndices"] = true;
 
-        if (_url.path().toLower().endsWith(".gz")) {
-            QByteArray uncompressedData;
-            if (!gunzip(_data, uncompressedData)) {
-                throw QString("failed to decompress .gz model");
-            }
-            // Strip the compression extension from the path, so the loader can infer the file type from what remains.
-            // This is okay because we don't expect the serializer to be able to read the contents of a compressed model file.
-            auto strippedUrl = _url;
-            strippedUrl.setPath(_url.path().left(_url.path().size() - 3));
-            hfmModel = _modelLoader.load(uncompressedData, serializerMapping, strippedUrl, "");
-        } else {
-            hfmModel = _modelLoader.load(_data, serializerMapping, _url, _webMediaType.toStdString());
+        // Look for the processed model in the cache first
+        auto hfmModelCache = DependencyManager::get<ModelCache>()->getHFMModelCache();
+        bool isCacheable = hfmModelCache && isSelfContained(_url);
+        HFMModelCache::Key cacheKey;
+        HFMModel::Pointer processedHFMModel;
+        MaterialMapping materialMapping;
+        if (isCacheable) {
+            cacheKey = HFMModelCache::computeKey(_data, _url, serializerMapping);
+            processedHFMModel = hfmModelCache->load(cacheKey);
         }
 
-        if (!hfmModel) {
-            throw QString("unsupported format");
-        }
+        if (processedHFMModel) {
+            // The material mapping holds network resources, it is parsed again rather than cached
+            materialMapping = ParseMaterialMappingTask::parseMaterialMapping(_mapping.second, _mapping.first);
+        } else {
+            HFMModel::Pointer hfmModel;
+            if (_url.path().toLower().endsWith(".gz")) {
+                QByteArray uncompressedData;
+                if (!gunzip(_data, uncompressedData)) {
+                    throw QString("failed to decompress .gz model");
+                }
+                // Strip the compression extension from the path, so the loader can infer the file type from what remains.
+                // This is okay because we don't expect the serializer to be able to read the contents of a compressed model file.
+                auto strippedUrl = _url;
+                strippedUrl.setPath(_url.path().left(_url.path().size() - 3));
+                hfmModel = _modelLoader.load(uncompressedData, serializerMapping, strippedUrl, "");
+            } else {
+                hfmModel = _modelLoader.load(_data, serializerMapping, _url, _webMediaType.toStdString());
+            }
 
-        if (hfmModel->meshes.empty() || hfmModel->joints.empty()) {
-            throw QString("empty geometry, possibly due to an unsupported model version");
-        }
+            if (!hfmModel) {
+                throw QString("unsupported format");
+            }
 
-        // Add scripts to hfmModel
-        if (!serializerMapping.value(SCRIPT_FIELD).isNull()) {
-            QVariantList scripts = serializerMapping.values(SCRIPT_FIELD);
-            for (auto &script : scripts) {
-                hfmModel->scripts.push_back(script.toString());
+            if (hfmModel->meshes.empty() || hfmModel->joints.empty()) {
+                throw QString("empty geometry, possibly due to an unsupported model version");
             }
-        }
 
-        // Do processing on the model
-        baker::Baker modelBaker(hfmModel, _mapping.second, _mapping.first);
-        modelBaker.run();
+            // Add scripts to hfmModel
+            if (!serializerMapping.value(SCRIPT_FIELD).isNull()) {
+                QVariantList scripts = serializerMapping.values(SCRIPT_FIELD);
+                for (auto &script : scripts) {
+                    hfmModel->scripts.push_back(script.toString());
+                }
+            }
 
-        auto processedHFMModel = modelBaker.getHFMModel();
-        auto materialMapping = modelBaker.getMaterialMapping();
+            // Do processing on the model
+            baker::Baker modelBaker(hfmModel, _mapping.second, _mapping.first);
+            modelBaker.run();
+
+            processedHFMModel = modelBaker.getHFMModel();
+            materialMapping = modelBaker.getMaterialMapping();
+
+            if (isCacheable) {
+                hfmModelCache->store(cacheKey, *processedHFMModel);
+            }
+        }
 
         QMetaObject::invokeMethod(resource.data(), "setGeometryDefinition",
                 Q_ARG(HFMModel::Pointer, processedHFMModel), Q_ARG(MaterialMapping, materialMapping));
@@ -369,6 +398,7 @@ ModelCache::ModelCache() {
     const qint64 GEOMETRY_DEFAULT_UNUSED_MAX_SIZE = DEFAULT_UNUSED_MAX_SIZE;
     setUnusedResourceCacheSize(GEOMETRY_DEFAULT_UNUSED_MAX_SIZE);
     setObjectName("ModelCache");
+    _hfmModelCache->initialize();
 
     auto modelFormatRegistry = DependencyManager::get<ModelFormatRegistry>();
     modelFormatRegistry->addFormat(FBXSerializer());
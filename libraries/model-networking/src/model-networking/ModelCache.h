@@ -16,6 +16,7 @@
 #include <ResourceCache.h>
 
 #include <graphics/Asset.h>
+#include <model-baker/HFMModelCache.h>
 
 #include "FBXSerializer.h"
 #include <material-networking/MaterialCache.h>
@@ -168,6 +169,9 @@ public:
                                                                  GeometryMappingPair(QUrl(), QVariantHash()),
                                                            const QUrl& textureBaseUrl = QUrl());
 
+    /// processed models are read from and written to this cache, so loading a model again skips the serializer and baker
+    const std::shared_ptr<HFMModelCache>& getHFMModelCache() const { return _hfmModelCache; }
+
 protected:
     friend class GeometryResource;
 
@@ -178,6 +182,7 @@ private:
     ModelCache();
     virtual ~ModelCache() = default;
     ModelLoader _modelLoader;
+    std::shared_ptr<HFMModelCache> _hfmModelCache { std::make_shared<HFMModelCache>() };
 };
 
 class MeshPart {
@@ -206,8 +206,6 @@ void PacketReceiver::handleVerifiedPacket(std::unique_ptr<udt::Packet> packet) {
         return;
     }
     
-    auto nodeList = DependencyManager::get<LimitedNodeList>();
-    
     // setup an NLPacket from the packet we were passed
     auto nlPacket = NLPacket::fromBase(std::move(packet));
     auto receivedMessage = QSharedPointer<ReceivedMessage>::create(*nlPacket);
@@ -251,7 +249,12 @@ void PacketReceiver::handleMessageFailure(HifiSockAddr from, udt::Packet::Messag
 }
 
 void PacketReceiver::handleVerifiedMessage(QSharedPointer<ReceivedMessage> receivedMessage, bool justReceived) {
-    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    // look the source up in the node list that owns this receiver, which is not always the singleton
+    // (tools like the crowd-client run several node lists in one process)
+    auto nodeList = qobject_cast<LimitedNodeList*>(parent());
+    if (!nodeList) {
+        nodeList = DependencyManager::get<LimitedNodeList>().data();
+    }
     
     SharedNodePointer matchingNode;
     
@@ -265,13 +265,13 @@ ResourceCache::~ResourceCache() {
 }
 
 void ResourceCache::clearATPAssets() {
-    {
-        QWriteLocker locker(&_resourcesLock);
-        QList<QUrl> urls = _resources.keys();
+    for (auto& shard : _resourceShards) {
+        QWriteLocker locker(&shard.lock);
+        QList<QUrl> urls = shard.resources.keys();
         for (auto& url : urls) {
             // If this is an ATP resource
             if (url.scheme() == URL_SCHEME_ATP) {
-                auto resourcesWithExtraHash = _resources.take(url);
+                auto resourcesWithExtraHash = shard.resources.take(url);
                 for (auto& resource : resourcesWithExtraHash) {
                     if (auto strongRef = resource.lock()) {
                         // Make sure the resource won't reinsert itself
@@ -282,29 +282,46 @@ void ResourceCache::clearATPAssets() {
             }
         }
     }
+
+    // released outside of the lock, since destroying a resource can re-enter the cache
+    UnusedResources removed;
     {
-        QWriteLocker locker(&_unusedResourcesLock);
-        for (auto& resource : _unusedResources.values()) {
-            if (resource->getURL().scheme() == URL_SCHEME_ATP) {
-                _unusedResources.remove(resource->getLRUKey());
-                _unusedResourcesSize -= resource->getBytes();
+        std::lock_guard<std::mutex> lock(_unusedResourcesLock);
+        auto it = _unusedResources.begin();
+        while (it != _unusedResources.end()) {
+            auto next = std::next(it);
+            if ((*it)->getURL().scheme() == URL_SCHEME_ATP) {
+                (*it)->_isUnused = false;
+                _unusedResourcesSize -= (*it)->getBytes();
+                removed.splice(removed.end(), _unusedResources, it);
             }
+            it = next;
         }
     }
+    removed.clear();
 
     resetResourceCounters();
 }
 
+QHash<QUrl, ResourceCache::ResourcesWithExtraHash> ResourceCache::getAllResources() {
+    QHash<QUrl, ResourcesWithExtraHash> allResources;
+    for (auto& shard : _resourceShards) {
+        QReadLocker locker(&shard.lock);
+        if (allResources.isEmpty()) {
+            allResources = shard.resources;
+        } else {
+            allResources.unite(shard.resources);
+        }
+    }
+    return allResources;
+}
+
 void ResourceCache::refreshAll() {
     // Clear all unused resources so we don't have to reload them
     clearUnusedResources();
     resetUnusedResourceCounter();
 
-    QHash<QUrl, QHash<size_t, QWeakPointer<Resource>>> allResources;
-    {
-        QReadLocker locker(&_resourcesLock);
-        allResources = _resources;
-    }
+    auto allResources = getAllResources();
 
     // Refresh all remaining resources in use
     // FIXME: this will trigger multiple refreshes for the same resource if they have different hashes
@@ -325,14 +342,12 @@ QVariantList ResourceCache::getResourceList() {
         BLOCKING_INVOKE_METHOD(this, "getResourceList",
             Q_RETURN_ARG(QVariantList, list));
     } else {
-        QList<QUrl> resources;
-        {
-            QReadLocker locker(&_resourcesLock);
-            resources = _resources.uniqueKeys();
-        }
-        list.reserve(resources.size());
-        for (auto& resource : resources) {
-            list << resource;
+        for (auto& shard : _resourceShards) {
+            QReadLocker locker(&shard.lock);
+            list.reserve(list.size() + shard.resources.size());
+            for (auto it = shard.resources.cbegin(); it != shard.resources.cend(); ++it) {
+                list << it.key();
+            }
         }
     }
 
@@ -351,9 +366,10 @@ void ResourceCache::setRequestLimit(uint32_t limit) {
 
 QSharedPointer<Resource> ResourceCache::getResource(const QUrl& url, const QUrl& fallback, void* extra, size_t extraHash) {
     QSharedPointer<Resource> resource;
+    auto& shard = getShard(url);
     {
-        QWriteLocker locker(&_resourcesLock);
-        auto& resourcesWithExtraHash = _resources[url];
+        QWriteLocker locker(&shard.lock);
+        auto& resourcesWithExtraHash = shard.resources[url];
         auto resourcesWithExtraHashIter = resourcesWithExtraHash.find(extraHash);
         if (resourcesWithExtraHashIter != resourcesWithExtraHash.end()) {
             // We've seen this extra info before
@@ -375,6 +391,7 @@ QSharedPointer<Resource> ResourceCache::getResource(const QUrl& url, const QUrl&
         }
     }
     if (resource) {
+        ++_numHits;
         removeUnusedResource(resource);
     }
 
@@ -383,6 +400,7 @@ QSharedPointer<Resource> ResourceCache::getResource(const QUrl& url, const QUrl&
     }
 
     if (!resource) {
+        ++_numMisses;
         resource = createResource(url);
         resource->setExtra(extra);
         resource->setExtraHash(extraHash);
@@ -391,8 +409,8 @@ QSharedPointer<Resource> ResourceCache::getResource(const QUrl& url, const QUrl&
         resource->moveToThread(qApp->thread());
         connect(resource.data(), &Resource::updateSize, this, &ResourceCache::updateTotalSize);
         {
-            QWriteLocker locker(&_resourcesLock);
-            _resources[url].insert(extraHash, resource);
+            QWriteLocker locker(&shard.lock);
+            shard.resources[url].insert(extraHash, resource);
         }
         removeUnusedResource(resource);
         resource->ensureLoading();
@@ -417,73 +435,97 @@ void ResourceCache::addUnusedResource(const QSharedPointer<Resource>& resource)
         return;
     }
     reserveUnusedResource(resource->getBytes());
-    
-    resource->setLRUKey(++_lastLRUKey);
 
     {
-        QWriteLocker locker(&_unusedResourcesLock);
-        _unusedResources.insert(resource->getLRUKey(), resource);
-        _unusedResourcesSize += resource->getBytes();
+        // most recently used resources live at the back of the list
+        std::lock_guard<std::mutex> lock(_unusedResourcesLock);
+        if (resource->_isUnused) {
+            _unusedResources.splice(_unusedResources.end(), _unusedResources, resource->_unusedIterator);
+        } else {
+            resource->_unusedIterator = _unusedResources.insert(_unusedResources.end(), resource);
+            resource->_isUnused = true;
+            _unusedResourcesSize += resource->getBytes();
+        }
     }
 
     resetUnusedResourceCounter();
 }
 
 void ResourceCache::removeUnusedResource(const QSharedPointer<Resource>& resource) {
-    QWriteLocker locker(&_unusedResourcesLock);
-    if (_unusedResources.contains(resource->getLRUKey())) {
-        _unusedResources.remove(resource->getLRUKey());
+    // the list holds a reference of its own, so release it outside of the lock
+    QSharedPointer<Resource> removed;
+    {
+        std::lock_guard<std::mutex> lock(_unusedResourcesLock);
+        if (!resource->_isUnused) {
+            return;
+        }
+        removed = std::move(*resource->_unusedIterator);
+        _unusedResources.erase(resource->_unusedIterator);
+        resource->_isUnused = false;
         _unusedResourcesSize -= resource->getBytes();
-
-        locker.unlock();
-        resetUnusedResourceCounter();
     }
+
+    resetUnusedResourceCounter();
 }
 
 void ResourceCache::reserveUnusedResource(qint64 resourceSize) {
-    QWriteLocker locker(&_unusedResourcesLock);
-    while (!_unusedResources.empty() &&
-           _unusedResourcesSize + resourceSize > _unusedResourcesMaxSize) {
-        // unload the oldest resource
-        QMap<int, QSharedPointer<Resource> >::iterator it = _unusedResources.begin();
-        
-        it.value()->setCache(nullptr);
-        auto size = it.value()->getBytes();
-
-        locker.unlock();
-        removeResource(it.value()->getURL(), it.value()->getExtraHash(), size);
-        locker.relock();
+    while (true) {
+        QSharedPointer<Resource> oldest;
+        {
+            std::lock_guard<std::mutex> lock(_unusedResourcesLock);
+            if (_unusedResources.empty() || _unusedResourcesSize + resourceSize <= _unusedResourcesMaxSize) {
+                return;
+            }
+            // unload the oldest resource
+            oldest = std::move(_unusedResources.front());
+            _unusedResources.pop_front();
+            oldest->_isUnused = false;
+            _unusedResourcesSize -= oldest->getBytes();
+        }
 
-        _unusedResourcesSize -= size;
-        _unusedResources.erase(it);
+        ++_numEvictions;
+        oldest->setCache(nullptr);
+        removeResource(oldest->getURL(), oldest->getExtraHash(), oldest->getBytes());
     }
 }
 
 void ResourceCache::clearUnusedResources() {
     // the unused resources may themselves reference resources that will be added to the unused
     // list on destruction, so keep clearing until there are no references left
-    QWriteLocker locker(&_unusedResourcesLock);
-    while (!_unusedResources.isEmpty()) {
-        foreach (const QSharedPointer<Resource>& resource, _unusedResources) {
+    while (true) {
+        UnusedResources unusedResources;
+        {
+            std::lock_guard<std::mutex> lock(_unusedResourcesLock);
+            if (_unusedResources.empty()) {
+                break;
+            }
+            unusedResources.swap(_unusedResources);
+            _unusedResourcesSize = 0;
+            // addUnusedResource and removeUnusedResource read the flags under the lock, so they are cleared under it too
+            for (auto& resource : unusedResources) {
+                resource->_isUnused = false;
+            }
+        }
+        for (auto& resource : unusedResources) {
             resource->setCache(nullptr);
         }
-        _unusedResources.clear();
     }
-    _unusedResourcesSize = 0;
 }
 
 void ResourceCache::resetTotalResourceCounter() {
-    {
-        QReadLocker locker(&_resourcesLock);
-        _numTotalResources = _resources.size();
+    size_t numTotalResources = 0;
+    for (auto& shard : _resourceShards) {
+        QReadLocker locker(&shard.lock);
+        numTotalResources += shard.resources.size();
     }
+    _numTotalResources = numTotalResources;
 
     emit dirty();
 }
 
 void ResourceCache::resetUnusedResourceCounter() {
     {
-        QReadLocker locker(&_unusedResourcesLock);
+        std::lock_guard<std::mutex> lock(_unusedResourcesLock);
         _numUnusedResources = _unusedResources.size();
     }
 
@@ -498,11 +540,12 @@ void ResourceCache::resetResourceCounters() {
 }
 
 void ResourceCache::removeResource(const QUrl& url, size_t extraHash, qint64 size) {
-    QWriteLocker locker(&_resourcesLock);
-    auto& resources = _resources[url];
+    auto& shard = getShard(url);
+    QWriteLocker locker(&shard.lock);
+    auto& resources = shard.resources[url];
     resources.remove(extraHash);
     if (resources.size() == 0) {
-        _resources.remove(url);
+        shard.resources.remove(url);
     }
     _totalResourcesSize -= size;
 }
@@ -731,8 +774,9 @@ void Resource::setSize(const qint64& bytes) {
 }
 
 void Resource::reinsert() {
-    QWriteLocker locker(&_cache->_resourcesLock);
-    _cache->_resources[_url].insert(_extraHash, _self);
+    auto& shard = _cache->getShard(_url);
+    QWriteLocker locker(&shard.lock);
+    shard.resources[_url].insert(_extraHash, _self);
 }
 
 
@@ -13,6 +13,7 @@
 #define hifi_ResourceCache_h
 
 #include <atomic>
+#include <list>
 #include <mutex>
 
 #include <QtCore/QHash>
@@ -199,6 +200,9 @@ class ResourceCache : public QObject {
     Q_PROPERTY(size_t numCached READ getNumCachedResources NOTIFY dirty)
     Q_PROPERTY(size_t sizeTotal READ getSizeTotalResources NOTIFY dirty)
     Q_PROPERTY(size_t sizeCached READ getSizeCachedResources NOTIFY dirty)
+    Q_PROPERTY(size_t numHits READ getNumHits NOTIFY dirty)
+    Q_PROPERTY(size_t numMisses READ getNumMisses NOTIFY dirty)
+    Q_PROPERTY(size_t numEvictions READ getNumEvictions NOTIFY dirty)
 
 public:
 
@@ -206,6 +210,9 @@ public:
     size_t getSizeTotalResources() const { return _totalResourcesSize; }
     size_t getNumCachedResources() const { return _numUnusedResources; }
     size_t getSizeCachedResources() const { return _unusedResourcesSize; }
+    size_t getNumHits() const { return _numHits; }
+    size_t getNumMisses() const { return _numMisses; }
+    size_t getNumEvictions() const { return _numEvictions; }
 
     Q_INVOKABLE QVariantList getResourceList();
 
@@ -282,21 +289,37 @@ private:
     void resetUnusedResourceCounter();
     void resetResourceCounters();
 
-    // Resources
-    QHash<QUrl, QHash<size_t, QWeakPointer<Resource>>> _resources;
-    QReadWriteLock _resourcesLock { QReadWriteLock::Recursive };
-    int _lastLRUKey = 0;
+    using ResourcesWithExtraHash = QHash<size_t, QWeakPointer<Resource>>;
+    using UnusedResources = std::list<QSharedPointer<Resource>>;
+
+    // Resources, striped by URL hash so that lookups of different URLs don't contend on a single lock
+    class ResourceShard {
+    public:
+        QHash<QUrl, ResourcesWithExtraHash> resources;
+        QReadWriteLock lock { QReadWriteLock::Recursive };
+    };
+    static const int NUM_RESOURCE_SHARDS = 16;
+    ResourceShard& getShard(const QUrl& url) { return _resourceShards[qHash(url) % NUM_RESOURCE_SHARDS]; }
+    QHash<QUrl, ResourcesWithExtraHash> getAllResources();
+
+    ResourceShard _resourceShards[NUM_RESOURCE_SHARDS];
 
     std::atomic<size_t> _numTotalResources { 0 };
     std::atomic<qint64> _totalResourcesSize { 0 };
 
-    // Cached resources
-    QMap<int, QSharedPointer<Resource>> _unusedResources;
-    QReadWriteLock _unusedResourcesLock { QReadWriteLock::Recursive };
+    // Cached resources, least recently used first.
+    // Each resource remembers its position in the list, so that touching and evicting it are O(1).
+    // Resources must not be released while holding _unusedResourcesLock, their destruction can re-enter the cache.
+    UnusedResources _unusedResources;
+    std::mutex _unusedResourcesLock;
     qint64 _unusedResourcesMaxSize = DEFAULT_UNUSED_MAX_SIZE;
 
     std::atomic<size_t> _numUnusedResources { 0 };
     std::atomic<qint64> _unusedResourcesSize { 0 };
+
+    std::atomic<size_t> _numHits { 0 };
+    std::atomic<size_t> _numMisses { 0 };
+    std::atomic<size_t> _numEvictions { 0 };
 };
 
 /// Wrapper to expose resource caches to JS/QML
@@ -311,11 +334,17 @@ class ScriptableResourceCache : public QObject {
      * @property {number} numCached - Total number of cached resource. <em>Read-only.</em>
      * @property {number} sizeTotal - Size in bytes of all resources. <em>Read-only.</em>
      * @property {number} sizeCached - Size in bytes of all cached resources. <em>Read-only.</em>
+     * @property {number} numHits - Number of requests served by a resource already known to the cache. <em>Read-only.</em>
+     * @property {number} numMisses - Number of requests that created a new resource. <em>Read-only.</em>
+     * @property {number} numEvictions - Number of cached resources evicted to make room. <em>Read-only.</em>
      */
     Q_PROPERTY(size_t numTotal READ getNumTotalResources NOTIFY dirty)
     Q_PROPERTY(size_t numCached READ getNumCachedResources NOTIFY dirty)
     Q_PROPERTY(size_t sizeTotal READ getSizeTotalResources NOTIFY dirty)
     Q_PROPERTY(size_t sizeCached READ getSizeCachedResources NOTIFY dirty)
+    Q_PROPERTY(size_t numHits READ getNumHits NOTIFY dirty)
+    Q_PROPERTY(size_t numMisses READ getNumMisses NOTIFY dirty)
+    Q_PROPERTY(size_t numEvictions READ getNumEvictions NOTIFY dirty)
 
     /**jsdoc
     * @property {number} numGlobalQueriesPending - Total number of global queries pending (across all resource managers). <em>Read-only.</em>
@@ -397,6 +426,9 @@ private:
     size_t getSizeTotalResources() const { return _resourceCache->getSizeTotalResources(); }
     size_t getNumCachedResources() const { return _resourceCache->getNumCachedResources(); }
     size_t getSizeCachedResources() const { return _resourceCache->getSizeCachedResources(); }
+    size_t getNumHits() const { return _resourceCache->getNumHits(); }
+    size_t getNumMisses() const { return _resourceCache->getNumMisses(); }
+    size_t getNumEvictions() const { return _resourceCache->getNumEvictions(); }
 
     size_t getNumGlobalQueriesPending() const { return ResourceCache::getPendingRequestCount(); }
     size_t getNumGlobalQueriesLoading() const { return ResourceCache::getLoadingRequestCount(); }
@@ -414,9 +446,6 @@ public:
 
     virtual QString getType() const { return "Resource"; }
 
-    /// Returns the key last used to identify this resource in the unused map.
-    int getLRUKey() const { return _lruKey; }
-
     /// Makes sure that the resource has started loading.
     void ensureLoading();
 
@@ -555,15 +584,15 @@ private:
     friend class ResourceCache;
     friend class ScriptableResource;
     
-    void setLRUKey(int lruKey) { _lruKey = lruKey; }
-    
     void retry();
     void reinsert();
 
     bool isInScript() const { return _isInScript; }
     void setInScript(bool isInScript) { _isInScript = isInScript; }
     
-    int _lruKey{ 0 };
+    // position in ResourceCache::_unusedResources, valid while _isUnused
+    std::list<QSharedPointer<Resource>>::iterator _unusedIterator;
+    bool _isUnused { false };
     QTimer* _replyTimer{ nullptr };
     unsigned int _attempts{ 0 };
     static const int MAX_ATTEMPTS = 8;
@@ -0,0 +1,161 @@
+//
+//  HullCache.cpp
+//  libraries/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HullCache.h"
+
+#include <cstring>
+
+#include <QFile>
+
+#include <HashKey.h>
+
+#include "PhysicsLogging.h"
+
+const uint32_t HullCache::CURRENT_VERSION = 1;
+const std::string HullCache::DIRNAME { "hull_cache" };
+const std::string HullCache::EXT { "hulls" };
+
+static const uint32_t HULL_CACHE_MAGIC = 0x4c4c5548; // "HULL"
+
+struct HullCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t fingerprint;
+    uint32_t numHulls;
+    uint32_t numPoints;
+};
+
+struct HullCacheEntry {
+    uint32_t numPoints;
+    float margin;
+};
+
+HullCache::HullCache(const std::string& dirname) : FileCache(dirname, EXT) {
+}
+
+bool HullCache::canCache(const ShapeInfo& info) {
+    ShapeType type = info.getType();
+    return type == SHAPE_TYPE_SIMPLE_HULL || type == SHAPE_TYPE_COMPOUND || type == SHAPE_TYPE_SIMPLE_COMPOUND;
+}
+
+uint64_t HullCache::computeFingerprint(const ShapeInfo& info) {
+    HashKey::Hasher hasher;
+    hasher.hashUint64((uint64_t)info.getType());
+    for (const auto& points : info.getPointCollection()) {
+        hasher.hashUint64((uint64_t)points.size());
+        for (const auto& point : points) {
+            hasher.hashVec3(point);
+        }
+    }
+    for (const auto& index : info.getTriangleIndices()) {
+        hasher.hashUint64((uint64_t)(int64_t)index);
+    }
+    return hasher.getHash64();
+}
+
+cache::FileCache::Key HullCache::toKey(uint64_t key) {
+    return QString::number(key, 16).rightJustified(16, '0').toStdString();
+}
+
+bool HullCache::load(uint64_t key, uint64_t fingerprint, Hulls& hulls) {
+    auto file = getFile(toKey(key));
+    if (file) {
+        QFile input(QString::fromStdString(file->getFilepath()));
+        if (input.open(QIODevice::ReadOnly) && deserialize(input.readAll(), fingerprint, hulls)) {
+            ++_numHits;
+            return true;
+        }
+    }
+    ++_numMisses;
+    return false;
+}
+
+void HullCache::store(uint64_t key, uint64_t fingerprint, const Hulls& hulls) {
+    QByteArray data = serialize(fingerprint, hulls);
+    // overwrite stale entries, load() only misses on a present key when the content changed
+    writeFile(data.data(), Metadata(toKey(key), (size_t)data.size()), true);
+}
+
+QByteArray HullCache::serialize(uint64_t fingerprint, const Hulls& hulls) {
+    uint32_t numPoints = 0;
+    for (auto hull : hulls) {
+        numPoints += (uint32_t)hull->getNumPoints();
+    }
+
+    QByteArray data;
+    data.resize((int)(sizeof(HullCacheHeader) + hulls.size() * sizeof(HullCacheEntry) + numPoints * 3 * sizeof(float)));
+    char* cursor = data.data();
+
+    HullCacheHeader header { HULL_CACHE_MAGIC, CURRENT_VERSION, fingerprint, (uint32_t)hulls.size(), numPoints };
+    memcpy(cursor, &header, sizeof(header));
+    cursor += sizeof(header);
+
+    for (auto hull : hulls) {
+        HullCacheEntry entry { (uint32_t)hull->getNumPoints(), (float)hull->getMargin() };
+        memcpy(cursor, &entry, sizeof(entry));
+        cursor += sizeof(entry);
+    }
+    for (auto hull : hulls) {
+        const btVector3* points = hull->getUnscaledPoints();
+        for (int i = 0; i < hull->getNumPoints(); ++i) {
+            float point[3] = { (float)points[i].getX(), (float)points[i].getY(), (float)points[i].getZ() };
+            memcpy(cursor, point, sizeof(point));
+            cursor += sizeof(point);
+        }
+    }
+    return data;
+}
+
+bool HullCache::deserialize(const QByteArray& data, uint64_t fingerprint, Hulls& hulls) {
+    if ((size_t)data.size() < sizeof(HullCacheHeader)) {
+        return false;
+    }
+    const char* cursor = data.constData();
+    HullCacheHeader header;
+    memcpy(&header, cursor, sizeof(header));
+    cursor += sizeof(header);
+    if (header.magic != HULL_CACHE_MAGIC || header.version != CURRENT_VERSION || header.fingerprint != fingerprint) {
+        return false;
+    }
+    size_t expectedSize = sizeof(HullCacheHeader) + (size_t)header.numHulls * sizeof(HullCacheEntry) +
+        (size_t)header.numPoints * 3 * sizeof(float);
+    if ((size_t)data.size() != expectedSize) {
+        qCWarning(physics) << "HullCache: ignoring truncated entry of" << data.size() << "bytes";
+        return false;
+    }
+
+    std::vector<HullCacheEntry> entries(header.numHulls);
+    memcpy(entries.data(), cursor, entries.size() * sizeof(HullCacheEntry));
+    cursor += entries.size() * sizeof(HullCacheEntry);
+
+    uint32_t pointsSeen = 0;
+    for (const auto& entry : entries) {
+        pointsSeen += entry.numPoints;
+    }
+    if (pointsSeen != header.numPoints) {
+        return false;
+    }
+
+    hulls.reserve(hulls.size() + entries.size());
+    for (const auto& entry : entries) {
+        // same steps as createConvexHull() after it has picked its points
+        btConvexHullShape* hull = new btConvexHullShape();
+        hull->setMargin(entry.margin);
+        for (uint32_t i = 0; i < entry.numPoints; ++i) {
+            float point[3];
+            memcpy(point, cursor, sizeof(point));
+            cursor += sizeof(point);
+            hull->addPoint(btVector3(point[0], point[1], point[2]), false);
+        }
+        hull->recalcLocalAabb();
+        hulls.push_back(hull);
+    }
+    return true;
+}
@@ -0,0 +1,61 @@
+//
+//  HullCache.h
+//  libraries/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_HullCache_h
+#define hifi_HullCache_h
+
+#include <atomic>
+#include <vector>
+
+#include <QByteArray>
+#include <btBulletDynamicsCommon.h>
+
+#include <ShapeInfo.h>
+#include <shared/FileCache.h>
+
+// Persists the convex hulls that ShapeFactory builds for hull based shapes (SIMPLE_HULL, COMPOUND and
+// SIMPLE_COMPOUND) so later sessions can load them instead of recomputing them from the mesh points.
+// Entries are keyed by ShapeInfo::getHash() and carry a fingerprint of the input points, because that hash
+// only covers the url and dimensions of a model and would not notice the model changing under the same url.
+class HullCache : public cache::FileCache {
+    Q_OBJECT
+
+public:
+    // Whenever a change is made to the serialized format that isn't backward compatible,
+    // this value should be incremented.  Entries with another version are rebuilt and overwritten.
+    static const uint32_t CURRENT_VERSION;
+    static const std::string DIRNAME;
+    static const std::string EXT;
+
+    using Hulls = std::vector<btConvexHullShape*>;
+
+    HullCache(const std::string& dirname = DIRNAME);
+
+    static bool canCache(const ShapeInfo& info);
+    static uint64_t computeFingerprint(const ShapeInfo& info);
+
+    /// \return true if a matching entry was found, in which case hulls holds new shapes owned by the caller
+    bool load(uint64_t key, uint64_t fingerprint, Hulls& hulls);
+    void store(uint64_t key, uint64_t fingerprint, const Hulls& hulls);
+
+    static QByteArray serialize(uint64_t fingerprint, const Hulls& hulls);
+    static bool deserialize(const QByteArray& data, uint64_t fingerprint, Hulls& hulls);
+
+    uint32_t getNumHits() const { return _numHits; }
+    uint32_t getNumMisses() const { return _numMisses; }
+
+private:
+    static cache::FileCache::Key toKey(uint64_t key);
+
+    std::atomic_uint _numHits { 0 };
+    std::atomic_uint _numMisses { 0 };
+};
+
+#endif // hifi_HullCache_h
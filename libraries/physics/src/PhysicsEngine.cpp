@@ -18,15 +18,23 @@
 #include <PerfStat.h>
 #include <PhysicsCollisionGroups.h>
 #include <Profile.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
 #include <BulletCollision/CollisionShapes/btTriangleShape.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
 
 #include "CharacterController.h"
 #include "ObjectMotionState.h"
 #include "PhysicsHelpers.h"
 #include "PhysicsDebugDraw.h"
+#include "PhysicsTaskScheduler.h"
 #include "ThreadSafeDynamicsWorld.h"
 #include "PhysicsLogging.h"
 
+static PhysicsTaskScheduler* getTaskScheduler() {
+    static PhysicsTaskScheduler scheduler;
+    return &scheduler;
+}
+
 PhysicsEngine::PhysicsEngine(const glm::vec3& offset) :
         _originOffset(offset),
         _myAvatarController(nullptr) {
@@ -37,18 +45,39 @@ PhysicsEngine::~PhysicsEngine() {
     delete _collisionConfig;
     delete _collisionDispatcher;
     delete _broadphaseFilter;
-    delete _constraintSolver;
     delete _dynamicsWorld;
+    delete _solverPool;
+    delete _constraintSolverMt;
     delete _ghostPairCallback;
 }
 
-void PhysicsEngine::init() {
+void PhysicsEngine::init(int numThreads, bool deterministic) {
     if (!_dynamicsWorld) {
+        if (numThreads > 1) {
+            PhysicsTaskScheduler* scheduler = getTaskScheduler();
+            scheduler->setNumThreads(numThreads);
+            btSetTaskScheduler(scheduler);
+            _numThreads = scheduler->getNumActiveThreads();
+        } else {
+            btSetTaskScheduler(btGetSequentialTaskScheduler());
+            _numThreads = 1;
+        }
+
         _collisionConfig = new btDefaultCollisionConfiguration();
-        _collisionDispatcher = new btCollisionDispatcher(_collisionConfig);
         _broadphaseFilter = new btDbvtBroadphase();
-        _constraintSolver = new btSequentialImpulseConstraintSolver;
-        _dynamicsWorld = new ThreadSafeDynamicsWorld(_collisionDispatcher, _broadphaseFilter, _constraintSolver, _collisionConfig);
+        if (_numThreads > 1 && !deterministic) {
+            // narrowphase workers create contact manifolds in whatever order they finish,
+            // and one large island (e.g. a pile of blocks) is split into constraint batches
+            _collisionDispatcher = new btCollisionDispatcherMt(_collisionConfig);
+            _constraintSolverMt = new btSequentialImpulseConstraintSolverMt();
+        } else {
+            _collisionDispatcher = new btCollisionDispatcher(_collisionConfig);
+        }
+        // each worker solves whole islands with a solver of its own
+        _solverPool = new btConstraintSolverPoolMt(_numThreads);
+        _dynamicsWorld = new ThreadSafeDynamicsWorld(_collisionDispatcher, _broadphaseFilter, _solverPool, _constraintSolverMt, _collisionConfig);
+        _dynamicsWorld->setDeterministic(deterministic);
+        qCDebug(physics) << "PhysicsEngine::init() numThreads =" << _numThreads << "deterministic =" << deterministic;
         _physicsDebugDraw.reset(new PhysicsDebugDraw());
 
         // hook up debug draw renderer
@@ -415,6 +444,12 @@ void PhysicsEngine::harvestPerformanceStats() {
             itr->Next();
         }
     }
+
+    // CProfile sums the substeps together, report each one so a slow catch-up step stands out
+    const std::vector<uint64_t>& substepTimes = _dynamicsWorld->getLastSubstepTimes();
+    for (size_t i = 0; i < substepTimes.size(); ++i) {
+        PerformanceTimer::addTimerRecord("physics/substep" + QString::number(i), substepTimes[i]);
+    }
 }
 
 void PhysicsEngine::printPerformanceStatsToFile(const QString& filename) {
@@ -94,7 +94,12 @@ public:
 
     PhysicsEngine(const glm::vec3& offset);
     ~PhysicsEngine();
-    void init();
+
+    /// \param numThreads when greater than one collision detection and island solving run on that many worker threads
+    /// \param deterministic keeps the multithreaded results independent of thread scheduling, for tests
+    /// \brief Bullet's task scheduler is global so the last engine to init() decides how it is threaded
+    void init(int numThreads = 1, bool deterministic = false);
+    int getNumThreads() const { return _numThreads; }
 
     uint32_t getNumSubsteps() const;
     int32_t getNumCollisionObjects() const;
@@ -172,7 +177,8 @@ private:
     btDefaultCollisionConfiguration* _collisionConfig = NULL;
     btCollisionDispatcher* _collisionDispatcher = NULL;
     btBroadphaseInterface* _broadphaseFilter = NULL;
-    btSequentialImpulseConstraintSolver* _constraintSolver = NULL;
+    btConstraintSolverPoolMt* _solverPool = NULL;
+    btConstraintSolver* _constraintSolverMt = NULL;
     ThreadSafeDynamicsWorld* _dynamicsWorld = NULL;
     btGhostPairCallback* _ghostPairCallback = NULL;
     std::unique_ptr<PhysicsDebugDraw> _physicsDebugDraw;
@@ -189,6 +195,7 @@ private:
     CharacterController* _myAvatarController;
 
     uint32_t _numContactFrames { 0 };
+    int _numThreads { 1 };
 
     bool _dumpNextStats { false };
     bool _saveNextStats { false };
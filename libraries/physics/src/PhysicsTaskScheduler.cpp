@@ -0,0 +1,187 @@
+//
+//  PhysicsTaskScheduler.cpp
+//  libraries/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PhysicsTaskScheduler.h"
+
+#include <algorithm>
+
+#include "PhysicsLogging.h"
+
+static const int NO_THREAD_INDEX = -1;
+
+void PhysicsTaskScheduler::Job::run() {
+    int grain;
+    while ((grain = nextGrain++) < numGrains) {
+        int rangeBegin = begin + grain * grainSize;
+        int rangeEnd = std::min(end, rangeBegin + grainSize);
+        if (forBody) {
+            forBody->forLoop(rangeBegin, rangeEnd);
+        } else {
+            grainSums[grain] = sumBody->sumLoop(rangeBegin, rangeEnd);
+        }
+    }
+}
+
+PhysicsTaskScheduler::PhysicsTaskScheduler() : btITaskScheduler("hifi") {
+}
+
+PhysicsTaskScheduler::~PhysicsTaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isShuttingDown = true;
+    }
+    _jobPosted.notify_all();
+    for (auto& worker : _workers) {
+        worker.join();
+    }
+}
+
+int PhysicsTaskScheduler::getMaxNumThreads() const {
+    int numCores = (int)std::thread::hardware_concurrency();
+    return std::max(1, std::min(numCores, (int)BT_MAX_THREAD_COUNT));
+}
+
+void PhysicsTaskScheduler::setNumThreads(int numThreads) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    numThreads = std::max(1, std::min(numThreads, getMaxNumThreads()));
+
+    int callerIndex = (int)btGetCurrentThreadIndex();
+    bool callerRunsBodies = callerIndex < (int)BT_MAX_THREAD_COUNT;
+    if (!callerRunsBodies) {
+        qCWarning(physics) << "PhysicsTaskScheduler: the stepping thread's Bullet thread index" << callerIndex
+            << "is past BT_MAX_THREAD_COUNT, it will leave the loops to the workers";
+    }
+    int numWorkersWanted = callerRunsBodies ? numThreads - 1 : numThreads;
+
+    // indices are handed out in increasing order, once a worker misses the limit every later one would too
+    auto countUsableWorkers = [&] {
+        return (int)std::count_if(_workerThreadIndices.begin(), _workerThreadIndices.end(),
+            [](int index) { return index < (int)BT_MAX_THREAD_COUNT; });
+    };
+    while (countUsableWorkers() < numWorkersWanted &&
+           (_workerThreadIndices.empty() || _workerThreadIndices.back() < (int)BT_MAX_THREAD_COUNT)) {
+        startWorker(lock);
+    }
+
+    // hand the loops to the first usable workers, the rest sleep
+    _numActiveWorkers = 0;
+    int numSlots = callerRunsBodies ? callerIndex + 1 : 1;
+    for (size_t i = 0; i < _workers.size(); ++i) {
+        int index = _workerThreadIndices[i];
+        bool isActive = index < (int)BT_MAX_THREAD_COUNT && _numActiveWorkers < numWorkersWanted;
+        _isWorkerActive[i] = isActive;
+        if (isActive) {
+            ++_numActiveWorkers;
+            numSlots = std::max(numSlots, index + 1);
+        }
+    }
+    _numThreads = std::max(1, _numActiveWorkers + (callerRunsBodies ? 1 : 0));
+    _numThreadSlots = numSlots;
+}
+
+void PhysicsTaskScheduler::startWorker(std::unique_lock<std::mutex>& lock) {
+    size_t worker = _workers.size();
+    _workerThreadIndices.push_back(NO_THREAD_INDEX);
+    _isWorkerActive.push_back(false);
+    _workers.emplace_back(&PhysicsTaskScheduler::workerLoop, this, worker);
+    // start them one at a time so each takes its index before the next asks for one
+    _workerStarted.wait(lock, [&] { return _workerThreadIndices[worker] != NO_THREAD_INDEX; });
+}
+
+void PhysicsTaskScheduler::workerLoop(size_t worker) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _workerThreadIndices[worker] = (int)btGetCurrentThreadIndex();
+    _workerStarted.notify_all();
+
+    uint64_t jobCount = _jobCount;
+    while (true) {
+        _jobPosted.wait(lock, [&] { return _isShuttingDown || _jobCount != jobCount; });
+        if (_isShuttingDown) {
+            return;
+        }
+        jobCount = _jobCount;
+        if (!_isWorkerActive[worker]) {
+            continue;
+        }
+
+        Job* job = _job;
+        lock.unlock();
+        job->run();
+        lock.lock();
+        if (--_numPendingWorkers == 0) {
+            _workerFinished.notify_one();
+        }
+    }
+}
+
+void PhysicsTaskScheduler::execute(Job& job) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _job = &job;
+        ++_jobCount;
+        _numPendingWorkers = _numActiveWorkers;
+    }
+    _jobPosted.notify_all();
+
+    if (canRunBodies((int)btGetCurrentThreadIndex()) || _numActiveWorkers == 0) {
+        job.run();
+    }
+
+    // the job lives on our stack, wait until no worker can touch it
+    std::unique_lock<std::mutex> lock(_mutex);
+    _workerFinished.wait(lock, [&] { return _numPendingWorkers == 0; });
+    _job = nullptr;
+}
+
+void PhysicsTaskScheduler::parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) {
+    BT_PROFILE("parallelFor_hifi");
+    grainSize = std::max(1, grainSize);
+    bool callerRunsBodies = canRunBodies((int)btGetCurrentThreadIndex());
+    if (_numActiveWorkers == 0 || (callerRunsBodies && iEnd - iBegin <= grainSize)) {
+        body.forLoop(iBegin, iEnd);
+        return;
+    }
+
+    Job job;
+    job.begin = iBegin;
+    job.end = iEnd;
+    job.grainSize = grainSize;
+    job.numGrains = (iEnd - iBegin + grainSize - 1) / grainSize;
+    job.forBody = &body;
+    job.sumBody = nullptr;
+    job.grainSums = nullptr;
+    execute(job);
+}
+
+btScalar PhysicsTaskScheduler::parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) {
+    BT_PROFILE("parallelSum_hifi");
+    grainSize = std::max(1, grainSize);
+    bool callerRunsBodies = canRunBodies((int)btGetCurrentThreadIndex());
+    if (_numActiveWorkers == 0 || (callerRunsBodies && iEnd - iBegin <= grainSize)) {
+        return body.sumLoop(iBegin, iEnd);
+    }
+
+    Job job;
+    job.begin = iBegin;
+    job.end = iEnd;
+    job.grainSize = grainSize;
+    job.numGrains = (iEnd - iBegin + grainSize - 1) / grainSize;
+    job.forBody = nullptr;
+    job.sumBody = &body;
+    _grainSums.assign(job.numGrains, btScalar(0));
+    job.grainSums = _grainSums.data();
+    execute(job);
+
+    btScalar sum = btScalar(0);
+    for (btScalar grainSum : _grainSums) {
+        sum += grainSum;
+    }
+    return sum;
+}
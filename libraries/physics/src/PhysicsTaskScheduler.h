@@ -0,0 +1,83 @@
+//
+//  PhysicsTaskScheduler.h
+//  libraries/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PhysicsTaskScheduler_h
+#define hifi_PhysicsTaskScheduler_h
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <LinearMath/btThreads.h>
+
+// Runs Bullet's parallel loops on a fixed pool of threads owned by the scheduler.
+// Bullet indexes its per thread state (e.g. btCollisionDispatcherMt's manifold batches) with btGetCurrentThreadIndex(),
+// which hands every thread that ever asks a new index, and sizes that state by getNumThreads(). A shared pool like
+// TBB's can run a loop body on any of its workers, so the indices grow past both. Our workers are started once
+// and never replaced, so their indices stay put, and getNumThreads() reports the slots covering every thread
+// allowed to run a body. Threads whose index is past BT_MAX_THREAD_COUNT never run one.
+// Reductions are summed per grain in order so the result doesn't depend on which thread ran which range.
+class PhysicsTaskScheduler : public btITaskScheduler {
+public:
+    PhysicsTaskScheduler();
+    ~PhysicsTaskScheduler();
+
+    int getMaxNumThreads() const override;
+    // the number of per thread slots, one past the highest Bullet thread index that may run a loop body
+    int getNumThreads() const override { return _numThreadSlots; }
+    // call from the thread that steps the world, it runs loop bodies too as long as its index fits in the slots
+    void setNumThreads(int numThreads) override;
+    // the number of threads a loop is split across
+    int getNumActiveThreads() const { return _numThreads; }
+
+    void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) override;
+    btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) override;
+
+private:
+    struct Job {
+        int begin;
+        int end;
+        int grainSize;
+        int numGrains;
+        const btIParallelForBody* forBody;
+        const btIParallelSumBody* sumBody;
+        btScalar* grainSums;
+        std::atomic<int> nextGrain { 0 };
+
+        void run();
+    };
+
+    void startWorker(std::unique_lock<std::mutex>& lock);
+    void workerLoop(size_t worker);
+    bool canRunBodies(int threadIndex) const { return threadIndex < _numThreadSlots; }
+    void execute(Job& job);
+
+    std::vector<std::thread> _workers;
+    std::vector<int> _workerThreadIndices;
+    std::vector<bool> _isWorkerActive;
+    int _numActiveWorkers { 0 };
+
+    std::mutex _mutex;
+    std::condition_variable _workerStarted;
+    std::condition_variable _jobPosted;
+    std::condition_variable _workerFinished;
+    Job* _job { nullptr };
+    uint64_t _jobCount { 0 };
+    int _numPendingWorkers { 0 };
+    bool _isShuttingDown { false };
+
+    std::vector<btScalar> _grainSums;
+    int _numThreads { 1 };
+    int _numThreadSlots { 1 };
+};
+
+#endif // hifi_PhysicsTaskScheduler_h
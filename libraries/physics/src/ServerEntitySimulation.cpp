@@ -0,0 +1,447 @@
+//
+//  ServerEntitySimulation.cpp
+//  libraries/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ServerEntitySimulation.h"
+
+#include <limits>
+
+#include <BulletUtil.h>
+#include <EntityItem.h>
+#include <EntityTree.h>
+#include <ObjectMotionState.h>
+#include <PhysicsHelpers.h>
+#include <PickFilter.h>
+
+// Idle clients bid VOLUNTEER whenever it is at least the current priority, and the EntityTree promotes an
+// equal VOLUNTEER bid to RECRUIT, so anything lower would be taken away again at once.  A participant who
+// touches the entity bids above this and wins it.
+const uint8_t SERVER_SIMULATION_PRIORITY = RECRUIT_SIMULATION_PRIORITY;
+
+// clients extrapolate between updates, so the server doesn't need to send every step
+const uint64_t MIN_SERVER_UPDATE_PERIOD = USECS_PER_SECOND / 10;
+
+const uint64_t ENVIRONMENT_UPDATE_PERIOD = USECS_PER_SECOND / 2;
+const float ENVIRONMENT_HORIZON = 2.0f * (float)ENVIRONMENT_UPDATE_PERIOD / (float)USECS_PER_SECOND; // seconds
+const float MIN_ENVIRONMENT_RADIUS = 2.0f; // meters
+
+// these are the shapes ShapeFactory can build from the entity's own properties, without loading a model
+static bool isPrimitiveShape(ShapeType type) {
+    switch (type) {
+        case SHAPE_TYPE_BOX:
+        case SHAPE_TYPE_SPHERE:
+        case SHAPE_TYPE_ELLIPSOID:
+        case SHAPE_TYPE_CAPSULE_X:
+        case SHAPE_TYPE_CAPSULE_Y:
+        case SHAPE_TYPE_CAPSULE_Z:
+        case SHAPE_TYPE_CYLINDER_X:
+        case SHAPE_TYPE_CYLINDER_Y:
+        case SHAPE_TYPE_CYLINDER_Z:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Reads straight from and writes straight to the EntityItem.  Unlike EntityMotionState it never sends anything:
+// the entity-server is the authority it would be sending to.  Adopted entities are dynamic, the entities
+// around them are static or kinematic.
+class ServerMotionState : public ObjectMotionState {
+public:
+    ServerMotionState(const btCollisionShape* shape, const EntityItemPointer& entity, bool adopted) :
+        ObjectMotionState(shape),
+        _entity(entity),
+        _adopted(adopted)
+    {
+        _type = MOTIONSTATE_TYPE_ENTITY;
+        setMass(_entity->computeMass());
+    }
+
+    ~ServerMotionState() {
+        if (_adopted) {
+            _entity->setPhysicsInfo(nullptr);
+        }
+    }
+
+    const EntityItemPointer& getEntity() const { return _entity; }
+    bool isAdopted() const { return _adopted; }
+
+    // incoming changes are pushed by ServerEntitySimulation::processChangedEntity()
+    uint32_t getIncomingDirtyFlags() const override { return 0; }
+    void clearIncomingDirtyFlags(uint32_t mask) override {}
+
+    PhysicsMotionType computePhysicsMotionType() const override {
+        if (_adopted) {
+            return MOTION_TYPE_DYNAMIC;
+        }
+        return _entity->isMovingRelativeToParent() ? MOTION_TYPE_KINEMATIC : MOTION_TYPE_STATIC;
+    }
+    bool isMoving() const override { return _entity->isMovingRelativeToParent(); }
+
+    void getWorldTransform(btTransform& worldTrans) const override {
+        worldTrans.setOrigin(glmToBullet(getObjectPosition()));
+        worldTrans.setRotation(glmToBullet(getObjectRotation()));
+    }
+
+    void setWorldTransform(const btTransform& worldTrans) override {
+        // don't stomp on a network edit that arrived after the last processChangedEntities()
+        uint32_t pendingFlags = _entity->getDirtyFlags() & OUTGOING_DIRTY_PHYSICS_FLAGS;
+        if (!(pendingFlags & Simulation::DIRTY_TRANSFORM)) {
+            _entity->setWorldTransform(bulletToGLM(worldTrans.getOrigin()), bulletToGLM(worldTrans.getRotation()));
+        }
+        if (!(pendingFlags & Simulation::DIRTY_LINEAR_VELOCITY)) {
+            _entity->setWorldVelocity(getBodyLinearVelocity());
+        }
+        if (!(pendingFlags & Simulation::DIRTY_ANGULAR_VELOCITY)) {
+            _entity->setWorldAngularVelocity(getBodyAngularVelocity());
+        }
+        _entity->setLastSimulated(usecTimestampNow());
+        _entity->clearDirtyFlags(OUTGOING_DIRTY_PHYSICS_FLAGS & ~pendingFlags);
+    }
+
+    float getObjectRestitution() const override { return _entity->getRestitution(); }
+    float getObjectFriction() const override { return _entity->getFriction(); }
+    float getObjectLinearDamping() const override { return _entity->getDamping(); }
+    float getObjectAngularDamping() const override { return _entity->getAngularDamping(); }
+
+    glm::vec3 getObjectPosition() const override { return _entity->getWorldPosition() - ObjectMotionState::getWorldOffset(); }
+    glm::quat getObjectRotation() const override { return _entity->getWorldOrientation(); }
+    glm::vec3 getObjectLinearVelocity() const override { return _entity->getWorldVelocity(); }
+    glm::vec3 getObjectAngularVelocity() const override { return _entity->getWorldAngularVelocity(); }
+    glm::vec3 getObjectGravity() const override { return _entity->getGravity(); }
+
+    const QUuid getObjectID() const override { return _entity->getID(); }
+    uint8_t getSimulationPriority() const override { return _entity->getSimulationPriority(); }
+    QUuid getSimulatorID() const override { return _entity->getSimulatorID(); }
+    QString getName() const override { return _entity->getName(); }
+    ShapeType getShapeType() const override { return _entity->getShapeType(); }
+    bool isLocallyOwned() const override { return _adopted; }
+
+    void computeCollisionGroupAndMask(int32_t& group, int32_t& mask) const override {
+        _entity->computeCollisionGroupAndFinalMask(group, mask);
+    }
+
+    uint64_t nextUpdate { 0 };
+
+private:
+    EntityItemPointer _entity;
+    bool _adopted;
+};
+
+ServerEntitySimulation::ServerEntitySimulation() :
+    SimpleEntitySimulation(),
+    _physicsEngine(std::make_shared<PhysicsEngine>(Vectors::ZERO))
+{
+    ObjectMotionState::setShapeManager(&_shapeManager);
+    _physicsEngine->init();
+}
+
+ServerEntitySimulation::~ServerEntitySimulation() {
+    // the base destructor can't reach our clearEntitiesInternal() and the bodies must go before the ShapeManager
+    removeMotionStates(_adoptedStates);
+    removeMotionStates(_environmentStates);
+}
+
+void ServerEntitySimulation::setSessionID(const QUuid& sessionID) {
+    QMutexLocker lock(&_mutex);
+    if (sessionID == _sessionID) {
+        return;
+    }
+    _sessionID = sessionID;
+    Physics::setSessionUUID(sessionID);
+
+    // what we adopted under the old ID is up for grabs
+    uint64_t now = usecTimestampNow();
+    QList<EntityItemPointer> adoptedEntities = _adoptedStates.keys();
+    for (const auto& entity : adoptedEntities) {
+        releaseEntity(entity, Release::Orphaned, now);
+    }
+}
+
+void ServerEntitySimulation::updateEntitiesInternal(uint64_t now) {
+    expireStaleOwnerships(now);
+    if (!_sessionID.isNull()) {
+        adoptOwnerlessEntities(now);
+    }
+    stopOwnerlessEntities(now);
+    updateEnvironment(now);
+    stepSimulation(now);
+}
+
+void ServerEntitySimulation::removeEntityInternal(EntityItemPointer entity) {
+    SimpleEntitySimulation::removeEntityInternal(entity);
+    releaseEntity(entity, Release::HandedOver, 0);
+    auto itr = _environmentStates.find(entity);
+    if (itr != _environmentStates.end()) {
+        ServerMotionState* motionState = itr.value();
+        _environmentStates.erase(itr);
+        removeMotionState(motionState);
+    }
+}
+
+void ServerEntitySimulation::processChangedEntity(const EntityItemPointer& entity) {
+    uint32_t flags = entity->getDirtyFlags();
+    auto adoptedItr = _adoptedStates.find(entity);
+    if (adoptedItr != _adoptedStates.end()) {
+        if (entity->getSimulatorID() != _sessionID) {
+            // a participant won a bid
+            releaseEntity(entity, Release::HandedOver, 0);
+        } else if (flags & HARD_DIRTY_PHYSICS_FLAGS) {
+            // reshaped or made static: let adoptOwnerlessEntities() decide again
+            releaseEntity(entity, Release::Orphaned, usecTimestampNow());
+        } else if (flags & EASY_DIRTY_PHYSICS_FLAGS) {
+            ServerMotionState* motionState = adoptedItr.value();
+            motionState->handleEasyChanges(flags);
+            if (flags & Simulation::DIRTY_PHYSICS_ACTIVATION) {
+                motionState->getRigidBody()->activate();
+            }
+        }
+    } else if (flags & DIRTY_PHYSICS_FLAGS) {
+        auto environmentItr = _environmentStates.find(entity);
+        if (environmentItr != _environmentStates.end()) {
+            // rebuilt from the entity's new state at the next updateEnvironment()
+            ServerMotionState* motionState = environmentItr.value();
+            _environmentStates.erase(environmentItr);
+            removeMotionState(motionState);
+            _nextEnvironmentUpdate = 0;
+        }
+    }
+    SimpleEntitySimulation::processChangedEntity(entity);
+}
+
+void ServerEntitySimulation::clearEntitiesInternal() {
+    QMutexLocker lock(&_mutex);
+    removeMotionStates(_adoptedStates);
+    removeMotionStates(_environmentStates);
+    SimpleEntitySimulation::clearEntitiesInternal();
+}
+
+ServerMotionState* ServerEntitySimulation::createMotionState(const EntityItemPointer& entity, bool adopted) const {
+    if (!entity->shouldBePhysical() || !isPrimitiveShape(entity->getShapeType()) || !entity->isReadyToComputeShape()) {
+        return nullptr;
+    }
+    ShapeInfo shapeInfo;
+    entity->computeShapeInfo(shapeInfo);
+    const btCollisionShape* shape = ObjectMotionState::getShapeManager()->getShape(shapeInfo);
+    if (!shape) {
+        return nullptr;
+    }
+    return new ServerMotionState(shape, entity, adopted);
+}
+
+bool ServerEntitySimulation::findEnvironment(const EntityItemPointer& entity, SetOfEntities& environment) {
+    float radius = glm::max(entity->getBoundingRadius(), MIN_ENVIRONMENT_RADIUS) +
+        glm::length(entity->getWorldVelocity()) * ENVIRONMENT_HORIZON;
+    unsigned int searchFilter = PickFilter::getBitMask(PickFilter::FlagBit::DOMAIN_ENTITIES);
+
+    QVector<QUuid> foundIDs;
+    EntityTreePointer tree = getEntityTree();
+    tree->evalEntitiesInSphere(entity->getWorldPosition(), radius, PickFilter(searchFilter), foundIDs);
+    for (const auto& id : foundIDs) {
+        EntityItemPointer other = tree->findEntityByID(id);
+        if (!other || other == entity || _adoptedStates.contains(other) ||
+                !other->shouldBePhysical() || other->getCollisionless()) {
+            continue;
+        }
+        if (!isPrimitiveShape(other->getShapeType())) {
+            // we can't see the collision hull of a model, so we would simulate straight through it
+            return false;
+        }
+        environment.insert(other);
+    }
+    return true;
+}
+
+void ServerEntitySimulation::adoptOwnerlessEntities(uint64_t now) {
+    PhysicsEngine::Transaction transaction;
+    SetOfEntities environment;
+    SetOfEntities::iterator itemItr = _entitiesThatNeedSimulationOwner.begin();
+    while (itemItr != _entitiesThatNeedSimulationOwner.end()) {
+        EntityItemPointer entity = *itemItr;
+        bool canAdopt = entity->getSimulatorID().isNull() && entity->getDynamic() && entity->hasLocalVelocity() &&
+            entity->getParentID().isNull() && !entity->hasActions() && findEnvironment(entity, environment);
+        ServerMotionState* motionState = canAdopt ? createMotionState(entity, true) : nullptr;
+        if (!motionState) {
+            // left for stopOwnerlessEntities()
+            ++itemItr;
+            continue;
+        }
+        itemItr = _entitiesThatNeedSimulationOwner.erase(itemItr);
+
+        auto environmentItr = _environmentStates.find(entity);
+        if (environmentItr != _environmentStates.end()) {
+            ServerMotionState* oldState = environmentItr.value();
+            _environmentStates.erase(environmentItr);
+            removeMotionState(oldState);
+        }
+
+        entity->setSimulationOwner(_sessionID, SERVER_SIMULATION_PRIORITY);
+        // the entity-server doesn't send itself updates so its own ownership must never go stale
+        entity->setSimulationOwnershipExpiry(std::numeric_limits<uint64_t>::max());
+        entity->setPhysicsInfo(motionState);
+        _adoptedStates.insert(entity, motionState);
+        transaction.objectsToAdd.push_back(motionState);
+        broadcastChange(entity, now);
+        motionState->nextUpdate = now + MIN_SERVER_UPDATE_PERIOD;
+    }
+
+    if (!transaction.objectsToAdd.empty()) {
+        // give the new arrivals something to land on before their first step
+        addEnvironment(environment, transaction);
+        _physicsEngine->processTransaction(transaction);
+    }
+}
+
+void ServerEntitySimulation::addEnvironment(const SetOfEntities& environment, PhysicsEngine::Transaction& transaction) {
+    for (const auto& entity : environment) {
+        // an entity found around one orphan may have been adopted later in the same pass
+        if (_adoptedStates.contains(entity) || _environmentStates.contains(entity)) {
+            continue;
+        }
+        ServerMotionState* motionState = createMotionState(entity, false);
+        if (motionState) {
+            _environmentStates.insert(entity, motionState);
+            transaction.objectsToAdd.push_back(motionState);
+        }
+    }
+}
+
+void ServerEntitySimulation::releaseEntity(const EntityItemPointer& entity, Release release, uint64_t now) {
+    auto itr = _adoptedStates.find(entity);
+    if (itr == _adoptedStates.end()) {
+        return;
+    }
+    ServerMotionState* motionState = itr.value();
+    _adoptedStates.erase(itr);
+    removeMotionState(motionState);
+
+    if (release == Release::HandedOver) {
+        return;
+    }
+
+    if (release == Release::AtRest) {
+        entity->setVelocity(Vectors::ZERO);
+        entity->setAngularVelocity(Vectors::ZERO);
+        entity->setAcceleration(Vectors::ZERO);
+    } else if (entity->getDynamic() && entity->hasLocalVelocity()) {
+        // participants get the usual ownerless period to volunteer before stopOwnerlessEntities() stops it
+        _entitiesThatNeedSimulationOwner.insert(entity);
+        _nextOwnerlessExpiry = glm::min(_nextOwnerlessExpiry, now);
+    }
+    entity->clearSimulationOwnership();
+    _entitiesWithSimulationOwner.remove(entity);
+    broadcastChange(entity, now);
+}
+
+void ServerEntitySimulation::updateEnvironment(uint64_t now) {
+    if (now < _nextEnvironmentUpdate) {
+        return;
+    }
+    _nextEnvironmentUpdate = now + ENVIRONMENT_UPDATE_PERIOD;
+
+    SetOfEntities environment;
+    std::vector<EntityItemPointer> orphans;
+    for (auto itr = _adoptedStates.begin(); itr != _adoptedStates.end(); ++itr) {
+        if (!findEnvironment(itr.key(), environment)) {
+            orphans.push_back(itr.key());
+        }
+    }
+    for (const auto& entity : orphans) {
+        releaseEntity(entity, Release::Orphaned, now);
+    }
+
+    // only the entities near something we simulate are kept in the PhysicsEngine
+    PhysicsEngine::Transaction transaction;
+    std::vector<ServerMotionState*> statesToDelete;
+    auto itr = _environmentStates.begin();
+    while (itr != _environmentStates.end()) {
+        if (environment.remove(itr.key())) {
+            ++itr;
+        } else {
+            transaction.objectsToRemove.push_back(itr.value());
+            statesToDelete.push_back(itr.value());
+            itr = _environmentStates.erase(itr);
+        }
+    }
+    addEnvironment(environment, transaction);
+    _physicsEngine->processTransaction(transaction);
+    for (auto motionState : statesToDelete) {
+        delete motionState;
+    }
+}
+
+void ServerEntitySimulation::stepSimulation(uint64_t now) {
+    if (_adoptedStates.empty()) {
+        return;
+    }
+
+    _physicsEngine->stepSimulation();
+    if (!_physicsEngine->hasOutgoingChanges()) {
+        return;
+    }
+
+    // nobody here listens for collision events, but harvesting them is what prunes the contact map
+    _physicsEngine->getCollisionEvents();
+
+    // every body in this PhysicsEngine is a ServerMotionState
+    const VectorOfMotionStates& changes = _physicsEngine->getChangedMotionStates();
+    for (auto state : changes) {
+        ServerMotionState* motionState = static_cast<ServerMotionState*>(state);
+        if (motionState->isAdopted()) {
+            const EntityItemPointer& entity = motionState->getEntity();
+            _entitiesToSort.insert(entity);
+            if (now > motionState->nextUpdate) {
+                broadcastChange(entity, now);
+                motionState->nextUpdate = now + MIN_SERVER_UPDATE_PERIOD;
+            }
+        }
+    }
+
+    std::vector<EntityItemPointer> restingEntities;
+    for (auto state : _physicsEngine->getDeactivatedMotionStates()) {
+        ServerMotionState* motionState = static_cast<ServerMotionState*>(state);
+        if (motionState->isAdopted()) {
+            restingEntities.push_back(motionState->getEntity());
+        }
+    }
+    for (const auto& entity : restingEntities) {
+        releaseEntity(entity, Release::AtRest, now);
+    }
+}
+
+void ServerEntitySimulation::broadcastChange(const EntityItemPointer& entity, uint64_t now) {
+    entity->setLastEdited(now);
+    entity->markAsChangedOnServer();
+    if (auto element = entity->getElement()) {
+        DirtyOctreeElementOperator op(element);
+        getEntityTree()->recurseTreeWithOperator(&op);
+    }
+}
+
+void ServerEntitySimulation::removeMotionState(ServerMotionState* motionState) {
+    PhysicsEngine::Transaction transaction;
+    transaction.objectsToRemove.push_back(motionState);
+    _physicsEngine->processTransaction(transaction);
+    delete motionState;
+}
+
+void ServerEntitySimulation::removeMotionStates(QHash<EntityItemPointer, ServerMotionState*>& states) {
+    if (states.empty()) {
+        return;
+    }
+    PhysicsEngine::Transaction transaction;
+    for (auto motionState : states) {
+        transaction.objectsToRemove.push_back(motionState);
+    }
+    _physicsEngine->processTransaction(transaction);
+    for (auto motionState : states) {
+        delete motionState;
+    }
+    states.clear();
+}
@@ -0,0 +1,79 @@
+//
+//  ServerEntitySimulation.h
+//  libraries/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ServerEntitySimulation_h
+#define hifi_ServerEntitySimulation_h
+
+#include <QtCore/QHash>
+
+#include <PhysicsEngine.h>
+#include <ShapeManager.h>
+#include <SimpleEntitySimulation.h>
+
+class ServerMotionState;
+
+class ServerEntitySimulation;
+using ServerEntitySimulationPointer = std::shared_ptr<ServerEntitySimulation>;
+
+/// steps unowned dynamic EntityItems in a headless PhysicsEngine on the entity-server
+///
+/// SimpleEntitySimulation freezes a dynamic entity when its simulation owner leaves and nobody volunteers.
+/// This simulation adopts such orphans instead: the entity-server becomes their owner at RECRUIT priority,
+/// steps them against the entities around them and writes the results straight into the tree.  Clients only
+/// bid at or above the current priority and an idle client bids VOLUNTEER, so they leave it alone.  A participant
+/// that interacts with it (an avatar touch, a grab, a collision with something it owns above RECRUIT) bids
+/// higher and takes it over.  When an adopted entity comes to rest its ownership is cleared.
+///
+/// The entity-server doesn't load models, so an orphan is only adopted when it and every collidable entity
+/// around it have primitive shapes.  The others are stopped as before.
+class ServerEntitySimulation : public SimpleEntitySimulation {
+public:
+    ServerEntitySimulation();
+    ~ServerEntitySimulation();
+
+    void setSessionID(const QUuid& sessionID);
+
+    int getNumAdoptedEntities() const { return _adoptedStates.size(); }
+    int getNumEnvironmentEntities() const { return _environmentStates.size(); }
+
+protected:
+    void updateEntitiesInternal(uint64_t now) override;
+    void removeEntityInternal(EntityItemPointer entity) override;
+    void processChangedEntity(const EntityItemPointer& entity) override;
+    void clearEntitiesInternal() override;
+
+private:
+    enum class Release {
+        HandedOver,     // someone else owns it now, leave the entity alone
+        Orphaned,       // clear ownership but keep it moving, so participants may volunteer
+        AtRest          // clear ownership and zero its velocities
+    };
+
+    ServerMotionState* createMotionState(const EntityItemPointer& entity, bool adopted) const;
+    bool findEnvironment(const EntityItemPointer& entity, SetOfEntities& environment);
+    void adoptOwnerlessEntities(uint64_t now);
+    void addEnvironment(const SetOfEntities& environment, PhysicsEngine::Transaction& transaction);
+    void releaseEntity(const EntityItemPointer& entity, Release release, uint64_t now);
+    void updateEnvironment(uint64_t now);
+    void stepSimulation(uint64_t now);
+    void broadcastChange(const EntityItemPointer& entity, uint64_t now);
+    void removeMotionState(ServerMotionState* motionState);
+    void removeMotionStates(QHash<EntityItemPointer, ServerMotionState*>& states);
+
+    ShapeManager _shapeManager;
+    PhysicsEnginePointer _physicsEngine;
+    QUuid _sessionID;
+
+    QHash<EntityItemPointer, ServerMotionState*> _adoptedStates;
+    QHash<EntityItemPointer, ServerMotionState*> _environmentStates;
+    uint64_t _nextEnvironmentUpdate { 0 };
+};
+
+#endif // hifi_ServerEntitySimulation_h
@@ -11,6 +11,8 @@
 
 #include "ShapeFactory.h"
 
+#include <algorithm>
+
 #include <glm/gtx/norm.hpp>
 
 #include <SharedUtil.h> // for MILLIMETERS_PER_METER
@@ -270,7 +272,90 @@ btTriangleIndexVertexArray* createStaticMeshArray(const ShapeInfo& info) {
     return dataArray;
 }
 
-const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info) {
+// util method
+HullCache::Hulls createHulls(const ShapeInfo& info) {
+    HullCache::Hulls hulls;
+    const ShapeInfo::PointCollection& pointCollection = info.getPointCollection();
+    if (info.getType() != SHAPE_TYPE_SIMPLE_COMPOUND) {
+        // SIMPLE_HULL and COMPOUND have one hull per point list
+        uint32_t numSubShapes = info.getNumSubShapes();
+        int32_t numHulls = numSubShapes == 1 ? std::min(pointCollection.size(), 1) : pointCollection.size();
+        for (int32_t i = 0; i < numHulls; ++i) {
+            btConvexHullShape* hull = createConvexHull(pointCollection[i]);
+            if (hull) {
+                hulls.push_back(hull);
+            }
+        }
+        return hulls;
+    }
+
+    const ShapeInfo::TriangleIndices& triangleIndices = info.getTriangleIndices();
+    uint32_t numIndices = triangleIndices.size();
+    uint32_t numMeshes = info.getNumSubShapes();
+    const uint32_t MIN_NUM_SIMPLE_COMPOUND_INDICES = 2; // END_OF_MESH_PART + END_OF_MESH
+    if (numMeshes > 0 && numIndices > MIN_NUM_SIMPLE_COMPOUND_INDICES) {
+        uint32_t i = 0;
+        for (auto& points : pointCollection) {
+            // build a hull around each part
+            while (i < numIndices) {
+                ShapeInfo::PointList hullPoints;
+                hullPoints.reserve(points.size());
+                while (i < numIndices) {
+                    int32_t j = triangleIndices[i];
+                    ++i;
+                    if (j == END_OF_MESH_PART) {
+                        // end of part
+                        break;
+                    }
+                    hullPoints.push_back(points[j]);
+                }
+                if (hullPoints.size() > 0) {
+                    btConvexHullShape* hull = createConvexHull(hullPoints);
+                    if (hull) {
+                        hulls.push_back(hull);
+                    }
+                }
+
+                assert(i < numIndices);
+                if (triangleIndices[i] == END_OF_MESH) {
+                    // end of mesh
+                    ++i;
+                    break;
+                }
+            }
+        }
+    }
+    return hulls;
+}
+
+// util method
+btCollisionShape* assembleHulls(const ShapeInfo& info, const HullCache::Hulls& hulls) {
+    bool single = false;
+    if (info.getType() == SHAPE_TYPE_SIMPLE_COMPOUND) {
+        if (info.getNumSubShapes() == 0 || info.getTriangleIndices().size() <= 2) {
+            // not enough data to build anything
+            return nullptr;
+        }
+        single = hulls.size() == 1;
+    } else {
+        single = info.getNumSubShapes() == 1;
+        if (single && hulls.empty()) {
+            return nullptr;
+        }
+    }
+    if (single) {
+        return hulls[0];
+    }
+    auto compound = new btCompoundShape();
+    btTransform trans;
+    trans.setIdentity();
+    for (auto hull : hulls) {
+        compound->addChildShape(trans, hull);
+    }
+    return compound;
+}
+
+const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info, HullCache* hullCache) {
     btCollisionShape* shape = nullptr;
     int type = info.getType();
     switch(type) {
@@ -358,74 +443,22 @@ const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info)
         }
         break;
         case SHAPE_TYPE_COMPOUND:
-        case SHAPE_TYPE_SIMPLE_HULL: {
-            const ShapeInfo::PointCollection& pointCollection = info.getPointCollection();
-            uint32_t numSubShapes = info.getNumSubShapes();
-            if (numSubShapes == 1) {
-                if (!pointCollection.isEmpty()) {
-                    shape = createConvexHull(pointCollection[0]);
-                }
-            } else {
-                auto compound = new btCompoundShape();
-                btTransform trans;
-                trans.setIdentity();
-                foreach (const ShapeInfo::PointList& hullPoints, pointCollection) {
-                    btConvexHullShape* hull = createConvexHull(hullPoints);
-                    compound->addChildShape(trans, hull);
-                }
-                shape = compound;
-            }
-        }
-        break;
+        case SHAPE_TYPE_SIMPLE_HULL:
         case SHAPE_TYPE_SIMPLE_COMPOUND: {
-            const ShapeInfo::PointCollection& pointCollection = info.getPointCollection();
-            const ShapeInfo::TriangleIndices& triangleIndices = info.getTriangleIndices();
-            uint32_t numIndices = triangleIndices.size();
-            uint32_t numMeshes = info.getNumSubShapes();
-            const uint32_t MIN_NUM_SIMPLE_COMPOUND_INDICES = 2; // END_OF_MESH_PART + END_OF_MESH
-            if (numMeshes > 0 && numIndices > MIN_NUM_SIMPLE_COMPOUND_INDICES) {
-                uint32_t i = 0;
-                std::vector<btConvexHullShape*> hulls;
-                for (auto& points : pointCollection) {
-                    // build a hull around each part
-                    while (i < numIndices) {
-                        ShapeInfo::PointList hullPoints;
-                        hullPoints.reserve(points.size());
-                        while (i < numIndices) {
-                            int32_t j = triangleIndices[i];
-                            ++i;
-                            if (j == END_OF_MESH_PART) {
-                                // end of part
-                                break;
-                            }
-                            hullPoints.push_back(points[j]);
-                        }
-                        if (hullPoints.size() > 0) {
-                            btConvexHullShape* hull = createConvexHull(hullPoints);
-                            hulls.push_back(hull);
-                        }
-
-                        assert(i < numIndices);
-                        if (triangleIndices[i] == END_OF_MESH) {
-                            // end of mesh
-                            ++i;
-                            break;
-                        }
-                    }
-                }
-                uint32_t numHulls = (uint32_t)hulls.size();
-                if (numHulls == 1) {
-                    shape = hulls[0];
-                } else {
-                    auto compound = new btCompoundShape();
-                    btTransform trans;
-                    trans.setIdentity();
-                    for (auto hull : hulls) {
-                        compound->addChildShape(trans, hull);
-                    }
-                    shape = compound;
+            HullCache::Hulls hulls;
+            uint64_t fingerprint = 0;
+            bool loaded = false;
+            if (hullCache) {
+                fingerprint = HullCache::computeFingerprint(info);
+                loaded = hullCache->load(info.getHash(), fingerprint, hulls);
+            }
+            if (!loaded) {
+                hulls = createHulls(info);
+                if (hullCache && !hulls.empty()) {
+                    hullCache->store(info.getHash(), fingerprint, hulls);
                 }
             }
+            shape = assembleHulls(info, hulls);
         }
         break;
         case SHAPE_TYPE_STATIC_MESH: {
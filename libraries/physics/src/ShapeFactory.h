@@ -19,10 +19,13 @@
 
 #include <ShapeInfo.h>
 
+#include "HullCache.h"
+
 // The ShapeFactory assembles and correctly disassembles btCollisionShapes.
 
 namespace ShapeFactory {
-    const btCollisionShape* createShapeFromInfo(const ShapeInfo& info);
+    // hull based shapes are loaded from and saved to hullCache when one is supplied
+    const btCollisionShape* createShapeFromInfo(const ShapeInfo& info, HullCache* hullCache = nullptr);
     void deleteShape(const btCollisionShape* shape);
 
     class Worker : public QObject, public QRunnable {
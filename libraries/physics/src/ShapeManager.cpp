@@ -73,7 +73,7 @@ const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
         }
         // else we're still waiting for the shape to be created on another thread
     } else {
-        shape = ShapeFactory::createShapeFromInfo(info);
+        shape = ShapeFactory::createShapeFromInfo(info, _hullCache.get());
         if (shape) {
             ShapeReference newRef;
             newRef.refCount = 1;
@@ -175,6 +175,12 @@ void ShapeManager::collectGarbage() {
     _garbageRing.clear();
 }
 
+float ShapeManager::getHullCacheHitRate() const {
+    uint32_t numHits = getNumHullCacheHits();
+    uint32_t numLookups = numHits + getNumHullCacheMisses();
+    return numLookups > 0 ? (float)numHits / (float)numLookups : 0.0f;
+}
+
 int ShapeManager::getNumReferences(const ShapeInfo& info) const {
     HashKey hashKey(info.getHash());
     const ShapeReference* shapeRef = _shapeMap.find(hashKey);
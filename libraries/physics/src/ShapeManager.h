@@ -14,6 +14,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <memory>
 #include <vector>
 
 #include <QObject>
@@ -22,8 +23,9 @@
 
 #include <ShapeInfo.h>
 
-#include "ShapeFactory.h"
 #include "HashKey.h"
+#include "HullCache.h"
+#include "ShapeFactory.h"
 
 // The ShapeManager handles the ref-counting on shared shapes:
 //
@@ -74,6 +76,12 @@ public:
     uint32_t getWorkRequestCount() const { return _workRequestCount; }
     uint32_t getWorkDeliveryCount() const { return _workDeliveryCount; }
 
+    /// hull based shapes are read from and written to this cache when it is set
+    void setHullCache(const std::shared_ptr<HullCache>& hullCache) { _hullCache = hullCache; }
+    uint32_t getNumHullCacheHits() const { return _hullCache ? _hullCache->getNumHits() : 0; }
+    uint32_t getNumHullCacheMisses() const { return _hullCache ? _hullCache->getNumMisses() : 0; }
+    float getHullCacheHitRate() const;
+
 protected slots:
     void acceptWork(ShapeFactory::Worker* worker);
 
@@ -107,6 +115,7 @@ private:
     uint32_t _ringIndex { 0 };
     std::atomic_uint _workRequestCount { 0 };
     std::atomic_uint _workDeliveryCount { 0 };
+    std::shared_ptr<HullCache> _hullCache;
 };
 
 #endif // hifi_ShapeManager_h
@@ -19,14 +19,17 @@
 
 #include <LinearMath/btQuickprof.h>
 
+#include <SharedUtil.h>
+
 #include "Profile.h"
 
 ThreadSafeDynamicsWorld::ThreadSafeDynamicsWorld(
         btDispatcher* dispatcher,
         btBroadphaseInterface* pairCache,
-        btConstraintSolver* constraintSolver,
+        btConstraintSolverPoolMt* solverPool,
+        btConstraintSolver* constraintSolverMt,
         btCollisionConfiguration* collisionConfiguration)
-    :   btDiscreteDynamicsWorld(dispatcher, pairCache, constraintSolver, collisionConfiguration) {
+    :   btDiscreteDynamicsWorldMt(dispatcher, pairCache, solverPool, constraintSolverMt, collisionConfiguration) {
 }
 
 int ThreadSafeDynamicsWorld::stepSimulationWithSubstepCallback(btScalar timeStep, int maxSubSteps,
@@ -34,6 +37,7 @@ int ThreadSafeDynamicsWorld::stepSimulationWithSubstepCallback(btScalar timeStep
     DETAILED_PROFILE_RANGE(simulation_physics, "stepWithCB");
     BT_PROFILE("stepSimulationWithSubstepCallback");
     int subSteps = 0;
+    _lastSubstepTimes.clear();
     if (maxSubSteps) {
         //fixed timestep with interpolation
         m_fixedTimeStep = fixedTimeStep;
@@ -75,8 +79,10 @@ int ThreadSafeDynamicsWorld::stepSimulationWithSubstepCallback(btScalar timeStep
 
         for (int i=0;i<clampedSimulationSteps;i++) {
             DETAILED_PROFILE_RANGE(simulation_physics, "substep");
+            uint64_t start = usecTimestampNow();
             internalSingleStepSimulation(fixedTimeStep);
             onSubStep();
+            _lastSubstepTimes.push_back(usecTimestampNow() - start);
         }
     }
 
@@ -89,9 +95,22 @@ int ThreadSafeDynamicsWorld::stepSimulationWithSubstepCallback(btScalar timeStep
 
     clearForces();
 
+    if (btITaskScheduler* scheduler = btGetTaskScheduler()) {
+        // let the scheduler park its workers until the next step
+        scheduler->sleepWorkerThreadsHint();
+    }
+
     return subSteps;
 }
 
+void ThreadSafeDynamicsWorld::createPredictiveContacts(btScalar timeStep) {
+    if (_deterministic) {
+        btDiscreteDynamicsWorld::createPredictiveContacts(timeStep);
+    } else {
+        btDiscreteDynamicsWorldMt::createPredictiveContacts(timeStep);
+    }
+}
+
 // call this instead of non-virtual btDiscreteDynamicsWorld::synchronizeSingleMotionState()
 void ThreadSafeDynamicsWorld::synchronizeMotionState(btRigidBody* body) {
     btAssert(body);
@@ -19,22 +19,26 @@
 #define hifi_ThreadSafeDynamicsWorld_h
 
 #include <BulletDynamics/Dynamics/btRigidBody.h>
-#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
 
 #include "ObjectMotionState.h"
 
 #include <functional>
+#include <vector>
 
 using SubStepCallback = std::function<void()>;
 
-ATTRIBUTE_ALIGNED16(class) ThreadSafeDynamicsWorld : public btDiscreteDynamicsWorld {
+// Derives from the multithreaded world so islands can be solved in parallel.  With a single solver in the pool
+// and Bullet's sequential task scheduler it steps on the calling thread like btDiscreteDynamicsWorld.
+ATTRIBUTE_ALIGNED16(class) ThreadSafeDynamicsWorld : public btDiscreteDynamicsWorldMt {
 public:
     BT_DECLARE_ALIGNED_ALLOCATOR();
 
     ThreadSafeDynamicsWorld(
             btDispatcher* dispatcher,
             btBroadphaseInterface* pairCache,
-            btConstraintSolver* constraintSolver,
+            btConstraintSolverPoolMt* solverPool,
+            btConstraintSolver* constraintSolverMt,
             btCollisionConfiguration* collisionConfiguration);
 
     int getNumSubsteps() const { return _numSubsteps; }
@@ -49,12 +53,23 @@ public:
     // smoother rendering of objects when the physics simulation loop is ansynchronous to the render loop).
     float getLocalTimeAccumulation() const { return m_localTime; }
 
+    /// \return duration in usec of each substep taken by the last call to stepSimulationWithSubstepCallback()
+    const std::vector<uint64_t>& getLastSubstepTimes() const { return _lastSubstepTimes; }
+
+    // when deterministic the steps that append contacts from worker threads run on the calling thread instead,
+    // so the solver sees them in the same order no matter how the work was scheduled
+    void setDeterministic(bool deterministic) { _deterministic = deterministic; }
+    bool isDeterministic() const { return _deterministic; }
+
     const VectorOfMotionStates& getChangedMotionStates() const { return _changedMotionStates; }
     const VectorOfMotionStates& getDeactivatedMotionStates() const { return _deactivatedStates; }
 
     void addChangedMotionState(ObjectMotionState* motionState) { _changedMotionStates.push_back(motionState); }
     virtual void debugDrawObject(const btTransform& worldTransform, const btCollisionShape* shape, const btVector3& color) override;
 
+protected:
+    virtual void createPredictiveContacts(btScalar timeStep) override;
+
 private:
     // call this instead of non-virtual btDiscreteDynamicsWorld::synchronizeSingleMotionState()
     void synchronizeMotionState(btRigidBody* body);
@@ -65,7 +80,9 @@ private:
     VectorOfMotionStates _deactivatedStates;
     SetOfMotionStates _activeStates;
     SetOfMotionStates _lastActiveStates;
+    std::vector<uint64_t> _lastSubstepTimes;
     int _numSubsteps { 0 };
+    bool _deterministic { false };
 };
 
 #endif // hifi_ThreadSafeDynamicsWorld_h
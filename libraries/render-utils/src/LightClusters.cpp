@@ -13,6 +13,7 @@
 #include <gpu/Context.h>
 #include <shaders/Shaders.h>
 #include <graphics/ShaderConstants.h>
+#include <TBBHelpers.h>
 
 #include "RenderUtilsLogging.h"
 #include "render-utils/ShaderConstants.h"
@@ -41,6 +42,12 @@ FrustumGrid::FrustumGrid(const FrustumGrid& source) :
     eyeToWorldMat(source.eyeToWorldMat)
 {}
 
+bool FrustumGrid::operator==(const FrustumGrid& other) const {
+    return frustumNear == other.frustumNear && rangeNear == other.rangeNear && rangeFar == other.rangeFar &&
+        frustumFar == other.frustumFar && dims == other.dims && eyeToGridProj == other.eyeToGridProj &&
+        worldToEyeMat == other.worldToEyeMat && eyeToWorldMat == other.eyeToWorldMat;
+}
+
 void FrustumGrid::generateGridPlanes(Planes& xPlanes, Planes& yPlanes, Planes& zPlanes) {
     xPlanes.resize(dims.x + 1);
     yPlanes.resize(dims.y + 1);
@@ -220,15 +227,15 @@ bool reduceSphereToPlane(const glm::vec4& sphere, const glm::vec4& plane, glm::v
 }
 
 
-uint32_t scanLightVolumeBoxSlice(FrustumGrid& grid, const FrustumGrid::Planes planes[3], int zSlice, int yMin, int yMax, int xMin, int xMax, LightClusters::LightID lightId, const glm::vec4& eyePosRadius,
-    std::vector< std::vector<LightClusters::LightIndex>>& clusterGrid) {
+static uint32_t scanLightVolumeBoxSlice(FrustumGrid& grid, const FrustumGrid::Planes planes[3], int zSlice, int yMin, int yMax, int xMin, int xMax, LightClusters::LightIndex lightId, bool isSpot, const glm::vec4& eyePosRadius,
+    LightClusters::ClusterReferences& references) {
     glm::ivec3 gridPosToOffset(1, grid.dims.x, grid.dims.x * grid.dims.y);
     uint32_t numClustersTouched = 0;
 
     for (auto y = yMin; (y <= yMax); y++) {
         for (auto x = xMin; (x <= xMax); x++) {
             auto index = x + gridPosToOffset.y * y + gridPosToOffset.z * zSlice;
-            clusterGrid[index].emplace_back(lightId);
+            references.push_back({ (uint32_t)index, lightId, (uint8_t)isSpot });
             numClustersTouched++;
         }
     }
@@ -236,31 +243,13 @@ uint32_t scanLightVolumeBoxSlice(FrustumGrid& grid, const FrustumGrid::Planes pl
     return numClustersTouched;
 }
 
-uint32_t scanLightVolumeBox(FrustumGrid& grid, const FrustumGrid::Planes planes[3], int zMin, int zMax, int yMin, int yMax, int xMin, int xMax, LightClusters::LightID lightId, const glm::vec4& eyePosRadius,
-    std::vector< std::vector<LightClusters::LightIndex>>& clusterGrid) {
-    glm::ivec3 gridPosToOffset(1, grid.dims.x, grid.dims.x * grid.dims.y);
-    uint32_t numClustersTouched = 0;
-
-    for (auto z = zMin; (z <= zMax); z++) {
-        for (auto y = yMin; (y <= yMax); y++) {
-            for (auto x = xMin; (x <= xMax); x++) {
-                auto index = x + gridPosToOffset.y * y + gridPosToOffset.z * z;
-                clusterGrid[index].emplace_back(lightId);
-                numClustersTouched++;
-            }
-        }
-    }
-
-    return numClustersTouched;
-}
-
-uint32_t scanLightVolumeSphere(FrustumGrid& grid, const FrustumGrid::Planes planes[3], int zMin, int zMax, int yMin, int yMax, int xMin, int xMax, LightClusters::LightID lightId, const glm::vec4& eyePosRadius,
-    std::vector< std::vector<LightClusters::LightIndex>>& clusterGrid) {
-    glm::ivec3 gridPosToOffset(1, grid.dims.x, grid.dims.x * grid.dims.y);
+static uint32_t scanLightVolumeSphere(FrustumGrid& grid, const FrustumGrid::Planes planes[3], int zMin, int zMax, int yMin, int yMax, int xMin, int xMax, LightClusters::LightIndex lightId, bool isSpot, const glm::vec4& eyePosRadius,
+    LightClusters::ClusterReferences& references) {
     uint32_t numClustersTouched = 0;
     const auto& xPlanes = planes[0];
     const auto& yPlanes = planes[1];
     const auto& zPlanes = planes[2];
+    const int numClusters = grid.frustumGrid_numClusters();
 
     // FInd the light origin cluster
     auto centerCluster = grid.frustumGrid_eyeToClusterPos(glm::vec3(eyePosRadius));
@@ -308,11 +297,11 @@ uint32_t scanLightVolumeSphere(FrustumGrid& grid, const FrustumGrid::Planes plan
 
             for (; (x <= xs); x++) {
                 auto index = grid.frustumGrid_clusterToIndex(ivec3(x, y, z));
-                if (index < (int)clusterGrid.size()) {
-                    clusterGrid[index].emplace_back(lightId);
+                if (index < numClusters) {
+                    references.push_back({ (uint32_t)index, lightId, (uint8_t)isSpot });
                     numClustersTouched++;
                 } else {
-                    qCDebug(renderutils) << "WARNING: LightClusters::scanLightVolumeSphere invalid index found ? numClusters = " << clusterGrid.size() << " index = " << index << " found from cluster xyz = " << x << " " << y << " " << z;
+                    qCDebug(renderutils) << "WARNING: LightClusters::scanLightVolumeSphere invalid index found ? numClusters = " << numClusters << " index = " << index << " found from cluster xyz = " << x << " " << y << " " << z;
                 }
             }
         }
@@ -321,181 +310,232 @@ uint32_t scanLightVolumeSphere(FrustumGrid& grid, const FrustumGrid::Planes plan
     return numClustersTouched;
 }
 
-glm::ivec3 LightClusters::updateClusters() {
-    // Make sure resource are in good shape
-    updateClusterResource();
-
-    // Clean up last info
-    uint32_t numClusters = (uint32_t)_clusterGrid.size();
+// Finds the clusters touched by a light that is in front of the near range and not outside the sides of the grid.
+// Returns false if the light ends up not being clustered.
+static bool clusterLight(FrustumGrid& theFrustumGrid, const FrustumGrid::Planes gridPlanes[3], const glm::vec3& eyeOri, float radius,
+    LightClusters::LightIndex lightId, bool isSpot, LightClusters::ClusterReferences& references) {
+    float eyeZMax = eyeOri.z - radius;
+    float eyeZMin = eyeOri.z + radius;
+    bool beyondFar = false;
+    if (eyeZMin < -theFrustumGrid.rangeFar) {
+        beyondFar = true;
+    }
 
-    std::vector< std::vector< LightIndex > > clusterGridPoint(numClusters);
-    std::vector< std::vector< LightIndex > > clusterGridSpot(numClusters);
+    // Get z slices
+    int zMin = theFrustumGrid.frustumGrid_eyeDepthToClusterLayer(eyeZMin);
+    int zMax = theFrustumGrid.frustumGrid_eyeDepthToClusterLayer(eyeZMax);
+    // That should never happen
+    if (zMin == -2 && zMax == -2) {
+        return false;
+    }
 
-    _clusterGrid.clear();
-    _clusterGrid.resize(numClusters, EMPTY_CLUSTER);
+    // Before Range NEar just apss, range neatr == true near for now
+    if ((zMin == -1) && (zMax == -1)) {
+        return false;
+    }
 
-    uint32_t maxNumIndices = (uint32_t)_clusterContent.size();
-    _clusterContent.clear();
-    _clusterContent.resize(maxNumIndices, INVALID_LIGHT);
+    // CLamp the z range 
+    zMin = std::max(0, zMin);
 
+    // find 2D corners of the sphere in grid
+    int xMin { 0 };
+    int xMax { theFrustumGrid.dims.x - 1 };
+    int yMin { 0 };
+    int yMax { theFrustumGrid.dims.y - 1 };
 
-    auto theFrustumGrid(_frustumGridBuffer.get());
+    float radius2 = radius * radius;
 
-    glm::ivec3 gridPosToOffset(1, theFrustumGrid.dims.x, theFrustumGrid.dims.x * theFrustumGrid.dims.y);
+    auto eyeOriH = glm::vec3(eyeOri);
+    auto eyeOriV = glm::vec3(eyeOri);
 
-    uint32_t numClusterTouched = 0;
-    uint32_t numLightsIn = _visibleLightIndices[0];
-    uint32_t numClusteredLights = 0;
-    for (size_t lightNum = 1; lightNum < _visibleLightIndices.size(); ++lightNum) {
-        auto lightId = _visibleLightIndices[lightNum];
-        auto light = _lightStage->getLight(lightId);
-        if (!light) {
-            continue;
-        }
+    eyeOriH.y = 0.0f;
+    eyeOriV.x = 0.0f;
 
-        auto worldOri = light->getPosition();
-        auto radius = light->getMaximumRadius();
-        bool isSpot = light->isSpot();
+    float eyeOriLen2H = glm::length2(eyeOriH);
+    float eyeOriLen2V = glm::length2(eyeOriV);
 
-        // Bring into frustum eye space
-        auto eyeOri = theFrustumGrid.frustumGrid_worldToEye(glm::vec4(worldOri, 1.0f));
+    if ((eyeOriLen2H > radius2)) {
+        float eyeOriLenH = sqrt(eyeOriLen2H);
 
-        // Remove light that slipped through and is not in the z range
-        float eyeZMax = eyeOri.z - radius;
-        if (eyeZMax > -theFrustumGrid.rangeNear) {
-            continue;
-        }
-        float eyeZMin = eyeOri.z + radius;
-        bool beyondFar = false;
-        if (eyeZMin < -theFrustumGrid.rangeFar) {
-            beyondFar = true;
-        }
+        auto eyeOriDirH = glm::vec3(eyeOriH) / eyeOriLenH;
 
-        // Get z slices
-        int zMin = theFrustumGrid.frustumGrid_eyeDepthToClusterLayer(eyeZMin);
-        int zMax = theFrustumGrid.frustumGrid_eyeDepthToClusterLayer(eyeZMax);
-        // That should never happen
-        if (zMin == -2 && zMax == -2) {
-            continue;
-        }
+        float eyeToTangentCircleLenH = sqrt(eyeOriLen2H - radius2);
 
-        // Before Range NEar just apss, range neatr == true near for now
-        if ((zMin == -1) && (zMax == -1)) {
-            continue;
-        }
+        float eyeToTangentCircleCosH = eyeToTangentCircleLenH / eyeOriLenH;
 
-        // CLamp the z range 
-        zMin = std::max(0, zMin);
+        float eyeToTangentCircleSinH = radius / eyeOriLenH;
 
-        auto xLeftDistance = radius - distanceToPlane(eyeOri, _gridPlanes[0][0]);
-        auto xRightDistance = radius + distanceToPlane(eyeOri, _gridPlanes[0].back());
 
-        auto yBottomDistance = radius - distanceToPlane(eyeOri, _gridPlanes[1][0]);
-        auto yTopDistance = radius + distanceToPlane(eyeOri, _gridPlanes[1].back());
+        // rotate the eyeToOriDir (H & V) in both directions
+        glm::vec3 leftDir(eyeOriDirH.x * eyeToTangentCircleCosH + eyeOriDirH.z * eyeToTangentCircleSinH, 0.0f, eyeOriDirH.x * -eyeToTangentCircleSinH + eyeOriDirH.z * eyeToTangentCircleCosH);
+        glm::vec3 rightDir(eyeOriDirH.x * eyeToTangentCircleCosH - eyeOriDirH.z * eyeToTangentCircleSinH, 0.0f, eyeOriDirH.x * eyeToTangentCircleSinH + eyeOriDirH.z * eyeToTangentCircleCosH);
 
-        if ((xLeftDistance < 0.f) || (xRightDistance < 0.f) || (yBottomDistance < 0.f) || (yTopDistance < 0.f)) {
-            continue;
+        auto lc = theFrustumGrid.frustumGrid_eyeToClusterDirH(leftDir);
+        if (lc > xMax) {
+            lc = xMin;
         }
+        auto rc = theFrustumGrid.frustumGrid_eyeToClusterDirH(rightDir);
+        if (rc < 0) {
+            rc = xMax;
+        }
+        xMin = std::max(xMin, lc);
+        xMax = std::min(rc, xMax);
+        assert(xMin <= xMax);
+    }
 
-        // find 2D corners of the sphere in grid
-        int xMin { 0 };
-        int xMax { theFrustumGrid.dims.x - 1 };
-        int yMin { 0 };
-        int yMax { theFrustumGrid.dims.y - 1 };
-
-        float radius2 = radius * radius;
-
-        auto eyeOriH = glm::vec3(eyeOri);
-        auto eyeOriV = glm::vec3(eyeOri);
-
-        eyeOriH.y = 0.0f;
-        eyeOriV.x = 0.0f;
+    if ((eyeOriLen2V > radius2)) {
+        float eyeOriLenV = sqrt(eyeOriLen2V);
 
-        float eyeOriLen2H = glm::length2(eyeOriH);
-        float eyeOriLen2V = glm::length2(eyeOriV);
+        auto eyeOriDirV = glm::vec3(eyeOriV) / eyeOriLenV;
 
-        if ((eyeOriLen2H > radius2)) {
-            float eyeOriLenH = sqrt(eyeOriLen2H);
+        float eyeToTangentCircleLenV = sqrt(eyeOriLen2V - radius2);
 
-            auto eyeOriDirH = glm::vec3(eyeOriH) / eyeOriLenH;
+        float eyeToTangentCircleCosV = eyeToTangentCircleLenV / eyeOriLenV;
 
-            float eyeToTangentCircleLenH = sqrt(eyeOriLen2H - radius2);
+        float eyeToTangentCircleSinV = radius / eyeOriLenV;
 
-            float eyeToTangentCircleCosH = eyeToTangentCircleLenH / eyeOriLenH;
 
-            float eyeToTangentCircleSinH = radius / eyeOriLenH;
+        // rotate the eyeToOriDir (H & V) in both directions
+        glm::vec3 bottomDir(0.0f, eyeOriDirV.y * eyeToTangentCircleCosV + eyeOriDirV.z * eyeToTangentCircleSinV, eyeOriDirV.y * -eyeToTangentCircleSinV + eyeOriDirV.z * eyeToTangentCircleCosV);
+        glm::vec3 topDir(0.0f, eyeOriDirV.y * eyeToTangentCircleCosV - eyeOriDirV.z * eyeToTangentCircleSinV, eyeOriDirV.y * eyeToTangentCircleSinV + eyeOriDirV.z * eyeToTangentCircleCosV);
 
+        auto bc = theFrustumGrid.frustumGrid_eyeToClusterDirV(bottomDir);
+        auto tc = theFrustumGrid.frustumGrid_eyeToClusterDirV(topDir);
+        if (bc > yMax) {
+            bc = yMin;
+        }
+        if (tc < 0) {
+            tc = yMax;
+        }
+        yMin = std::max(yMin, bc);
+        yMax =std::min(tc, yMax);
+        assert(yMin <= yMax);
+    }
 
-            // rotate the eyeToOriDir (H & V) in both directions
-            glm::vec3 leftDir(eyeOriDirH.x * eyeToTangentCircleCosH + eyeOriDirH.z * eyeToTangentCircleSinH, 0.0f, eyeOriDirH.x * -eyeToTangentCircleSinH + eyeOriDirH.z * eyeToTangentCircleCosH);
-            glm::vec3 rightDir(eyeOriDirH.x * eyeToTangentCircleCosH - eyeOriDirH.z * eyeToTangentCircleSinH, 0.0f, eyeOriDirH.x * eyeToTangentCircleSinH + eyeOriDirH.z * eyeToTangentCircleCosH);
+    // now voxelize
+    if (beyondFar) {
+        scanLightVolumeBoxSlice(theFrustumGrid, gridPlanes, zMin, yMin, yMax, xMin, xMax, lightId, isSpot, glm::vec4(eyeOri, radius), references);
+    } else {
+        scanLightVolumeSphere(theFrustumGrid, gridPlanes, zMin, zMax, yMin, yMax, xMin, xMax, lightId, isSpot, glm::vec4(eyeOri, radius), references);
+    }
+    return true;
+}
 
-            auto lc = theFrustumGrid.frustumGrid_eyeToClusterDirH(leftDir);
-            if (lc > xMax) {
-                lc = xMin;
-            }
-            auto rc = theFrustumGrid.frustumGrid_eyeToClusterDirH(rightDir);
-            if (rc < 0) {
-                rc = xMax;
-            }
-            xMin = std::max(xMin, lc);
-            xMax = std::min(rc, xMax);
-            assert(xMin <= xMax);
-        }
+void LightClusters::LightVolumes::clear() {
+    ids.clear();
+    isSpot.clear();
+    spheres.clear();
+}
 
-        if ((eyeOriLen2V > radius2)) {
-            float eyeOriLenV = sqrt(eyeOriLen2V);
+bool LightClusters::LightVolumes::operator==(const LightVolumes& other) const {
+    return ids == other.ids && isSpot == other.isSpot &&
+        spheres.x == other.spheres.x && spheres.y == other.spheres.y && spheres.z == other.spheres.z &&
+        spheres.radius == other.spheres.radius;
+}
 
-            auto eyeOriDirV = glm::vec3(eyeOriV) / eyeOriLenV;
+// A few lights per task, the cost of a light grows with the number of clusters it covers
+const size_t LIGHT_CLUSTERING_GRAIN_SIZE = 8;
 
-            float eyeToTangentCircleLenV = sqrt(eyeOriLen2V - radius2);
+glm::ivec3 LightClusters::updateClusters() {
+    // Make sure resource are in good shape
+    bool resourcesChanged = _clusterResourcesInvalid;
+    updateClusterResource();
 
-            float eyeToTangentCircleCosV = eyeToTangentCircleLenV / eyeOriLenV;
+    auto theFrustumGrid(_frustumGridBuffer.get());
 
-            float eyeToTangentCircleSinV = radius / eyeOriLenV;
+    // Gather the volumes of the visible lights
+    uint32_t numLightsIn = _visibleLightIndices[0];
+    _lightVolumes.clear();
+    for (size_t lightNum = 1; lightNum < _visibleLightIndices.size(); ++lightNum) {
+        auto lightId = _visibleLightIndices[lightNum];
+        auto light = _lightStage->getLight(lightId);
+        if (!light) {
+            continue;
+        }
+        _lightVolumes.ids.push_back(lightId);
+        _lightVolumes.isSpot.push_back((uint8_t)light->isSpot());
+        _lightVolumes.spheres.push_back(light->getPosition(), light->getMaximumRadius());
+    }
 
+    // Nothing moved, the clusters from last time are still good
+    if (!resourcesChanged && theFrustumGrid == _clusteredFrustumGrid && _lightVolumes == _clusteredLightVolumes) {
+        return glm::ivec3(numLightsIn, _clusteredStats.x, _clusteredStats.y);
+    }
 
-            // rotate the eyeToOriDir (H & V) in both directions
-            glm::vec3 bottomDir(0.0f, eyeOriDirV.y * eyeToTangentCircleCosV + eyeOriDirV.z * eyeToTangentCircleSinV, eyeOriDirV.y * -eyeToTangentCircleSinV + eyeOriDirV.z * eyeToTangentCircleCosV);
-            glm::vec3 topDir(0.0f, eyeOriDirV.y * eyeToTangentCircleCosV - eyeOriDirV.z * eyeToTangentCircleSinV, eyeOriDirV.y * eyeToTangentCircleSinV + eyeOriDirV.z * eyeToTangentCircleCosV);
+    // Bring the lights into frustum eye space, and remove the lights that slipped through and are not in front of
+    // the near range or are outside the sides of the grid
+    SphereCuller culler;
+    culler.setTransform(theFrustumGrid.worldToEyeMat);
+    culler.addPlane(glm::vec4(0.0f, 0.0f, -1.0f, -theFrustumGrid.rangeNear));
+    culler.addPlane(-_gridPlanes[0].front());
+    culler.addPlane(_gridPlanes[0].back());
+    culler.addPlane(-_gridPlanes[1].front());
+    culler.addPlane(_gridPlanes[1].back());
+
+    size_t numLights = _lightVolumes.ids.size();
+    _eyeLightSpheres.resize(numLights);
+    _lightInGrid.resize(numLights);
+    culler.cull(_lightVolumes.spheres, 0, numLights, _eyeLightSpheres, _lightInGrid.data());
+
+    _lightsInGrid.clear();
+    for (size_t i = 0; i < numLights; i++) {
+        if (_lightInGrid[i]) {
+            _lightsInGrid.push_back((uint32_t)i);
+        }
+    }
 
-            auto bc = theFrustumGrid.frustumGrid_eyeToClusterDirV(bottomDir);
-            auto tc = theFrustumGrid.frustumGrid_eyeToClusterDirV(topDir);
-            if (bc > yMax) {
-                bc = yMin;
-            }
-            if (tc < 0) {
-                tc = yMax;
+    // Voxelize the lights in parallel, every task collects the clusters touched by its range of lights
+    size_t numTasks = (_lightsInGrid.size() + LIGHT_CLUSTERING_GRAIN_SIZE - 1) / LIGHT_CLUSTERING_GRAIN_SIZE;
+    _clusteringTasks.resize(std::max(_clusteringTasks.size(), numTasks));
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numTasks), [&](const tbb::blocked_range<size_t>& range) {
+        auto grid = theFrustumGrid;
+        for (size_t t = range.begin(); t != range.end(); ++t) {
+            auto& task = _clusteringTasks[t];
+            task.references.clear();
+            task.numClusteredLights = 0;
+
+            size_t end = std::min(_lightsInGrid.size(), (t + 1) * LIGHT_CLUSTERING_GRAIN_SIZE);
+            for (size_t l = t * LIGHT_CLUSTERING_GRAIN_SIZE; l < end; l++) {
+                auto i = _lightsInGrid[l];
+                glm::vec3 eyeOri(_eyeLightSpheres.x[i], _eyeLightSpheres.y[i], _eyeLightSpheres.z[i]);
+                if (clusterLight(grid, _gridPlanes, eyeOri, _eyeLightSpheres.radius[i], (LightIndex)_lightVolumes.ids[i],
+                        _lightVolumes.isSpot[i] != 0, task.references)) {
+                    task.numClusteredLights++;
+                }
             }
-            yMin = std::max(yMin, bc);
-            yMax =std::min(tc, yMax);
-            assert(yMin <= yMax);
         }
+    });
 
-        // now voxelize
-        auto& clusterGrid = (isSpot ? clusterGridSpot : clusterGridPoint);
-        if (beyondFar) {
-            numClusterTouched += scanLightVolumeBoxSlice(theFrustumGrid, _gridPlanes, zMin, yMin, yMax, xMin, xMax, lightId, glm::vec4(glm::vec3(eyeOri), radius), clusterGrid);
-        } else {
-            numClusterTouched += scanLightVolumeSphere(theFrustumGrid, _gridPlanes, zMin, zMax, yMin, yMax, xMin, xMax, lightId, glm::vec4(glm::vec3(eyeOri), radius), clusterGrid);
+    // Count the point and spot lights of every cluster
+    uint32_t numClusters = (uint32_t)_clusterGrid.size();
+    _clusterLightCounts.assign(2 * numClusters, 0);
+    uint32_t numClusterTouched = 0;
+    uint32_t numClusteredLights = 0;
+    for (size_t t = 0; t < numTasks; t++) {
+        const auto& task = _clusteringTasks[t];
+        for (const auto& reference : task.references) {
+            _clusterLightCounts[2 * reference.cluster + reference.isSpot]++;
         }
-
-        numClusteredLights++;
+        numClusterTouched += (uint32_t)task.references.size();
+        numClusteredLights += task.numClusteredLights;
     }
 
     // Lights have been gathered now reexpress in terms of 2 sequential buffers
     // Start filling from near to far and stops if it overflows
+    _clusterGrid.assign(numClusters, EMPTY_CLUSTER);
+
+    uint32_t maxNumIndices = (uint32_t)_clusterContent.size();
+    _clusterContent.assign(maxNumIndices, INVALID_LIGHT);
+
     bool checkBudget = false;
     if (numClusterTouched > maxNumIndices) {
         checkBudget = true;
     }
     uint16_t indexOffset = 0;
-    for (int i = 0; i < (int) clusterGridPoint.size(); i++) {
-        auto& clusterPoint = clusterGridPoint[i];
-        auto& clusterSpot = clusterGridSpot[i];
-
-        uint8_t numLightsPoint = ((uint8_t)clusterPoint.size());
-        uint8_t numLightsSpot = ((uint8_t)clusterSpot.size());
+    for (uint32_t i = 0; i < numClusters; i++) {
+        // A cluster can't reference more than 255 lights of each kind
+        uint8_t numLightsPoint = (uint8_t)std::min<uint16_t>(_clusterLightCounts[2 * i], 0xFF);
+        uint8_t numLightsSpot = (uint8_t)std::min<uint16_t>(_clusterLightCounts[2 * i + 1], 0xFF);
         uint16_t numLights = numLightsPoint + numLightsSpot;
         uint16_t offset = indexOffset;
 
@@ -508,22 +548,36 @@ glm::ivec3 LightClusters::updateClusters() {
 
         // Encode the cluster grid: [ ContentOffset - 16bits, Num Point LIghts - 8bits, Num Spot Lights - 8bits] 
         _clusterGrid[i] = (uint32_t)((0xFF000000 & (numLightsSpot << 24)) | (0x00FF0000 & (numLightsPoint << 16)) | (0x0000FFFF & offset));
+        indexOffset += numLights;
+    }
 
-
-        if (numLightsPoint) {
-            memcpy(_clusterContent.data() + indexOffset, clusterPoint.data(), numLightsPoint * sizeof(LightIndex));
-            indexOffset += numLightsPoint;
-        }
-        if (numLightsSpot) {
-            memcpy(_clusterContent.data() + indexOffset, clusterSpot.data(), numLightsSpot * sizeof(LightIndex));
-            indexOffset += numLightsSpot;
+    // Then write the lights of every cluster in the order they were gathered, points first
+    std::fill(_clusterLightCounts.begin(), _clusterLightCounts.end(), 0);
+    for (size_t t = 0; t < numTasks; t++) {
+        for (const auto& reference : _clusteringTasks[t].references) {
+            uint32_t cluster = _clusterGrid[reference.cluster];
+            if (cluster == EMPTY_CLUSTER) {
+                continue;
+            }
+            uint16_t numLightsPoint = (cluster >> 16) & 0xFF;
+            uint16_t numLightsSpot = (cluster >> 24) & 0xFF;
+            uint16_t& numWritten = _clusterLightCounts[2 * reference.cluster + reference.isSpot];
+            if (numWritten < (reference.isSpot ? numLightsSpot : numLightsPoint)) {
+                uint16_t offset = (cluster & 0xFFFF) + (reference.isSpot ? numLightsPoint : 0) + numWritten;
+                _clusterContent[offset] = reference.light;
+                numWritten++;
+            }
         }
     }
 
     // update the buffers
     _clusterGridBuffer._buffer->setData(_clusterGridBuffer._size, (gpu::Byte*) _clusterGrid.data());
     _clusterContentBuffer._buffer->setSubData(0, indexOffset * sizeof(LightIndex), (gpu::Byte*) _clusterContent.data());
-    
+
+    _clusteredFrustumGrid = theFrustumGrid;
+    std::swap(_clusteredLightVolumes, _lightVolumes);
+    _clusteredStats = glm::ivec2(numClusteredLights, numClusterTouched);
+
     return glm::ivec3(numLightsIn, numClusteredLights, numClusterTouched);
 }
 
@@ -11,6 +11,7 @@
 #ifndef hifi_render_utils_LightClusters_h
 #define hifi_render_utils_LightClusters_h
 
+#include <SphereCuller.h>
 #include <ViewFrustum.h>
 #include <gpu/Buffer.h>
 #include <render/Engine.h>
@@ -36,6 +37,9 @@ public:
     FrustumGrid() = default;
     FrustumGrid(const FrustumGrid& source);
 
+    // Same grid in the same place, the spare is ignored
+    bool operator==(const FrustumGrid& other) const;
+
     void updateFrustum(const ViewFrustum& frustum) {
         frustumNear = frustum.getNearClip();
         frustumFar = frustum.getFarClip();
@@ -111,6 +115,42 @@ public:
 
     bool _clusterResourcesInvalid { true };
     void updateClusterResource();
+
+    // The volumes of the visible lights, in world space
+    struct LightVolumes {
+        void clear();
+        bool operator==(const LightVolumes& other) const;
+
+        std::vector<LightID> ids;
+        std::vector<uint8_t> isSpot;
+        SphereCuller::Spheres spheres;
+    };
+
+    // A light touching a cluster, as found by the cluster assignment
+    struct ClusterReference {
+        uint32_t cluster;
+        LightIndex light;
+        uint8_t isSpot;
+    };
+    using ClusterReferences = std::vector<ClusterReference>;
+
+    // The lights are assigned to the clusters by several tasks, each one collecting the references of a range of lights
+    struct ClusteringTask {
+        ClusterReferences references;
+        uint32_t numClusteredLights { 0 };
+    };
+
+    LightVolumes _lightVolumes;
+    SphereCuller::Spheres _eyeLightSpheres;
+    std::vector<uint8_t> _lightInGrid;
+    std::vector<uint32_t> _lightsInGrid;
+    std::vector<ClusteringTask> _clusteringTasks;
+    std::vector<uint16_t> _clusterLightCounts;
+
+    // The assignment is only redone when the lights or the grid differ from the ones it was last done with
+    LightVolumes _clusteredLightVolumes;
+    FrustumGrid _clusteredFrustumGrid;
+    glm::ivec2 _clusteredStats { 0, 0 };
 };
 
 using LightClustersPointer = std::shared_ptr<LightClusters>;
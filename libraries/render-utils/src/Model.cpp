@@ -13,6 +13,7 @@
 
 #include <QMetaType>
 #include <QRunnable>
+#include <QThread>
 #include <QThreadPool>
 
 #include <glm/gtx/transform.hpp>
@@ -40,6 +41,7 @@
 #include <Trace.h>
 
 #include <BlendshapeConstants.h>
+#include <SparseBlendshapes.h>
 
 using namespace std;
 
@@ -239,8 +241,8 @@ void Model::updateRenderItems() {
             bool invalidatePayloadShapeKey = self->shouldInvalidatePayloadShapeKey(meshIndex);
             bool useDualQuaternionSkinning = self->getUseDualQuaternionSkinning();
 
-            transaction.updateItem<ModelMeshPartPayload>(itemID, [modelTransform, meshState, useDualQuaternionSkinning,
-                                                                  invalidatePayloadShapeKey, primitiveMode, renderItemKeyGlobalFlags, cauterized](ModelMeshPartPayload& data) {
+            transaction.updateItemConcurrently<ModelMeshPartPayload>(itemID, [modelTransform, meshState, useDualQuaternionSkinning,
+                                                                  cauterized](ModelMeshPartPayload& data) {
                 if (useDualQuaternionSkinning) {
                     data.updateClusterBuffer(meshState.clusterDualQuaternions);
                     data.computeAdjustedLocalBound(meshState.clusterDualQuaternions);
@@ -267,6 +269,11 @@ void Model::updateRenderItems() {
                 data.updateTransformForSkinnedMesh(renderTransform, modelTransform);
 
                 data.setCauterized(cauterized);
+            });
+
+            // Updating the keys may update the materials, which are shared between payloads
+            transaction.updateItem<ModelMeshPartPayload>(itemID, [invalidatePayloadShapeKey, primitiveMode,
+                                                                  renderItemKeyGlobalFlags, useDualQuaternionSkinning](ModelMeshPartPayload& data) {
                 data.updateKey(renderItemKeyGlobalFlags);
                 data.setShapeKey(invalidatePayloadShapeKey, primitiveMode, useDualQuaternionSkinning);
             });
@@ -319,12 +326,20 @@ bool Model::updateGeometry() {
             i++;
         }
         needFullUpdate = true;
-        emit rigReady();
+        emitRigReady();
     }
 
     return needFullUpdate;
 }
 
+void Model::emitRigReady() {
+    if (QThread::currentThread() != thread()) {
+        QMetaObject::invokeMethod(this, "rigReady", Qt::QueuedConnection);
+        return;
+    }
+    emit rigReady();
+}
+
 // virtual
 void Model::initJointStates() {
     const HFMModel& hfmModel = getHFMModel();
@@ -1741,18 +1756,48 @@ static void packBlendshapeOffsets(BlendshapeOffsetUnpacked* unpacked, Blendshape
 static auto& packBlendshapeOffsets = packBlendshapeOffsets_ref;
 #endif
 
-class Blender : public QRunnable {
-public:
+static const BlendshapeOffsetPacked& getPackedZeroOffset() {
+    static const BlendshapeOffsetPacked packedZero = [] {
+        BlendshapeOffsetUnpacked unpacked { glm::vec3(0.0f), glm::vec3(0.0f), glm::vec3(0.0f) };
+        BlendshapeOffsetPacked packed;
+        packBlendshapeOffsets_ref(&unpacked, &packed, 1);
+        return packed;
+    }();
+    return packedZero;
+}
+
+static std::shared_ptr<const SparseModelBlendshapes> buildSparseBlendshapes(const HFMModel& hfmModel) {
+    const float NORMAL_COEFFICIENT_SCALE = 0.01f;
+    auto result = std::make_shared<SparseModelBlendshapes>();
+    result->reserve(hfmModel.meshes.size());
+    for (const auto& mesh : hfmModel.meshes) {
+        SparseBlendshapes sparse(mesh.vertices.size());
+        for (const auto& blendshape : mesh.blendshapes) {
+            sparse.addBlendshape(blendshape.indices.constData(), blendshape.vertices.constData(), blendshape.normals.constData(),
+                                 blendshape.tangents.constData(), blendshape.tangents.size(), blendshape.indices.size(),
+                                 NORMAL_COEFFICIENT_SCALE);
+        }
+        sparse.finish();
+        result->push_back(std::move(sparse));
+    }
+    return result;
+}
 
+// One model's blend, evaluated as part of a ModelBlender pass
+class Blender {
+public:
     Blender(ModelPointer model, HFMModel::ConstPointer hfmModel, int blendNumber, const QVector<float>& blendshapeCoefficients);
 
-    virtual void run() override;
+    void run();
 
-private:
     ModelPointer _model;
     HFMModel::ConstPointer _hfmModel;
+    std::shared_ptr<const SparseModelBlendshapes> _sparseBlendshapes;
     int _blendNumber;
     QVector<float> _blendshapeCoefficients;
+
+    QVector<BlendshapeOffset> _packedBlendshapeOffsets;
+    QVector<int> _blendedMeshSizes;
 };
 
 Blender::Blender(ModelPointer model, HFMModel::ConstPointer hfmModel, int blendNumber, const QVector<float>& blendshapeCoefficients) :
@@ -1765,90 +1810,112 @@ Blender::Blender(ModelPointer model, HFMModel::ConstPointer hfmModel, int blendN
 void Blender::run() {
     DETAILED_PROFILE_RANGE_EX(simulation_animation, __FUNCTION__, 0xFFFF0000, 0, { { "url", _model->getURL().toString() } });
     int numBlendshapeOffsets = 0;  // number of offsets required for all meshes.
-    int maxBlendshapeOffsets = 0;  // number of offsets in the largest mesh.
+    int maxActiveVertices = 0;  // number of vertices moved by blendshapes in the largest mesh.
     int numMeshes = 0;  // number of meshes in this model.
-    for (auto meshIter = _hfmModel->meshes.cbegin(); meshIter != _hfmModel->meshes.cend(); ++meshIter) {
+    for (const auto& sparse : *_sparseBlendshapes) {
         numMeshes++;
-        if (meshIter->blendshapes.isEmpty()) {
+        if (sparse.getNumBlendshapes() == 0) {
             continue;
         }
-        int numVertsInMesh = meshIter->vertices.size();
-        numBlendshapeOffsets += numVertsInMesh;
-        maxBlendshapeOffsets = std::max(maxBlendshapeOffsets, numVertsInMesh);
+        numBlendshapeOffsets += sparse.getNumVertices();
+        maxActiveVertices = std::max(maxActiveVertices, (int)sparse.getActiveVertices().size());
     }
 
     // allocate the required sizes
-    QVector<int> blendedMeshSizes;
-    blendedMeshSizes.reserve(numMeshes);
-
-    QVector<BlendshapeOffset> packedBlendshapeOffsets;
-    packedBlendshapeOffsets.resize(numBlendshapeOffsets);
+    _blendedMeshSizes.reserve(numMeshes);
+    _packedBlendshapeOffsets.resize(numBlendshapeOffsets);
 
-    QVector<BlendshapeOffsetUnpacked> unpackedBlendshapeOffsets;
-    unpackedBlendshapeOffsets.resize(maxBlendshapeOffsets);    // reuse for all meshes
+    // reuse for all meshes
+    std::vector<BlendshapeOffsetUnpacked> unpackedBlendshapeOffsets(maxActiveVertices);
+    std::vector<BlendshapeOffsetPacked> packedActiveOffsets(maxActiveVertices);
 
     int offset = 0;
-    for (auto meshIter = _hfmModel->meshes.cbegin(); meshIter != _hfmModel->meshes.cend(); ++meshIter) {
-        if (meshIter->blendshapes.isEmpty()) {
-            blendedMeshSizes.push_back(0);
+    for (const auto& sparse : *_sparseBlendshapes) {
+        if (sparse.getNumBlendshapes() == 0) {
+            _blendedMeshSizes.push_back(0);
             continue;
         }
-        int numVertsInMesh = meshIter->vertices.size();
-        blendedMeshSizes.push_back(numVertsInMesh);
-
-        // initialize offsets to zero
-        memset(unpackedBlendshapeOffsets.data(), 0, numVertsInMesh * sizeof(BlendshapeOffsetUnpacked));
-
-        // for each blendshape in this mesh, accumulate the offsets into unpackedBlendshapeOffsets.
-        const float NORMAL_COEFFICIENT_SCALE = 0.01f;
-        for (int i = 0, n = qMin(_blendshapeCoefficients.size(), meshIter->blendshapes.size()); i < n; i++) {
-            float vertexCoefficient = _blendshapeCoefficients.at(i);
-            const float EPSILON = 0.0001f;
-            if (vertexCoefficient < EPSILON) {
-                continue;
-            }
-
-            float normalCoefficient = vertexCoefficient * NORMAL_COEFFICIENT_SCALE;
-            const HFMBlendshape& blendshape = meshIter->blendshapes.at(i);
-            for (int j = 0; j < blendshape.indices.size(); ++j) {
-                int index = blendshape.indices.at(j);
+        int numVertsInMesh = sparse.getNumVertices();
+        _blendedMeshSizes.push_back(numVertsInMesh);
 
-                auto& currentBlendshapeOffset = unpackedBlendshapeOffsets[index];
-                currentBlendshapeOffset.positionOffset += blendshape.vertices.at(j) * vertexCoefficient;
-                currentBlendshapeOffset.normalOffset += blendshape.normals.at(j) * normalCoefficient;
-                if (j < blendshape.tangents.size()) {
-                    currentBlendshapeOffset.tangentOffset += blendshape.tangents.at(j) * normalCoefficient;
-                }
-            }
-        }
+        // only the vertices some blendshape moves are blended and packed, the rest keep a zero offset
+        const auto& activeVertices = sparse.getActiveVertices();
+        int numActiveVertices = (int)activeVertices.size();
+        memset(unpackedBlendshapeOffsets.data(), 0, numActiveVertices * sizeof(BlendshapeOffsetUnpacked));
+        sparse.blend(_blendshapeCoefficients.constData(), _blendshapeCoefficients.size(),
+                     (float(*)[SparseBlendshapes::OFFSET_SIZE])unpackedBlendshapeOffsets.data());
 
         // convert unpackedBlendshapeOffsets into packedBlendshapeOffsets for the gpu.
-        auto unpacked = unpackedBlendshapeOffsets.data();
-        auto packed = packedBlendshapeOffsets.data() + offset;
-        packBlendshapeOffsets(unpacked, packed, numVertsInMesh);
+        packBlendshapeOffsets(unpackedBlendshapeOffsets.data(), packedActiveOffsets.data(), numActiveVertices);
+
+        sparse.scatter((const uint32_t(*)[4])packedActiveOffsets.data(), (const uint32_t(&)[4])getPackedZeroOffset(),
+                       (uint32_t(*)[4])(_packedBlendshapeOffsets.data() + offset));
 
         offset += numVertsInMesh;
     }
     Q_ASSERT(offset == numBlendshapeOffsets);
+}
+
+// Evaluates a batch of blends on the TBB workers, then posts each result and the end of the pass to the ModelBlender
+class BlendPass : public QRunnable {
+public:
+    BlendPass(std::vector<std::shared_ptr<Blender>> blenders) : _blenders(std::move(blenders)) {}
+
+    virtual void run() override;
+
+private:
+    std::vector<std::shared_ptr<Blender>> _blenders;
+};
+
+void BlendPass::run() {
+    PROFILE_RANGE_EX(simulation_animation, "BlendPass", 0xFFFF0000, (uint64_t)_blenders.size());
+    auto modelBlender = DependencyManager::get<ModelBlender>();
+
+    // build the sparse layout of any model seen for the first time, once per HFMModel
+    std::vector<std::shared_ptr<Blender>> unbuilt;
+    for (const auto& blender : _blenders) {
+        if (!blender->_sparseBlendshapes && std::none_of(unbuilt.begin(), unbuilt.end(), [&](const std::shared_ptr<Blender>& other) {
+            return other->_hfmModel == blender->_hfmModel;
+        })) {
+            unbuilt.push_back(blender);
+        }
+    }
+    tbb::parallel_for(size_t(0), unbuilt.size(), [&](size_t i) {
+        unbuilt[i]->_sparseBlendshapes = buildSparseBlendshapes(*unbuilt[i]->_hfmModel);
+    });
+    for (const auto& built : unbuilt) {
+        modelBlender->cacheSparseBlendshapes(built->_hfmModel, built->_sparseBlendshapes);
+        for (auto& blender : _blenders) {
+            if (blender->_hfmModel == built->_hfmModel) {
+                blender->_sparseBlendshapes = built->_sparseBlendshapes;
+            }
+        }
+    }
 
-    // post the result to the ModelBlender, which will dispatch to the model if still alive
-    QMetaObject::invokeMethod(DependencyManager::get<ModelBlender>().data(), "setBlendedVertices",
-                              Q_ARG(ModelPointer, _model), Q_ARG(int, _blendNumber),
-                              Q_ARG(QVector<BlendshapeOffset>, packedBlendshapeOffsets),
-                              Q_ARG(QVector<int>, blendedMeshSizes));
+    // big and small models are mixed in a pass, let the workers steal from each other
+    tbb::parallel_for(size_t(0), _blenders.size(), [&](size_t i) {
+        _blenders[i]->run();
+    });
+
+    // post the results to the ModelBlender, which will dispatch to the models if still alive
+    for (const auto& blender : _blenders) {
+        QMetaObject::invokeMethod(modelBlender.data(), "setBlendedVertices",
+                                  Q_ARG(ModelPointer, blender->_model), Q_ARG(int, blender->_blendNumber),
+                                  Q_ARG(QVector<BlendshapeOffset>, blender->_packedBlendshapeOffsets),
+                                  Q_ARG(QVector<int>, blender->_blendedMeshSizes));
+    }
+    QMetaObject::invokeMethod(modelBlender.data(), "finishBlendPass");
 }
 
-bool Model::maybeStartBlender() {
+std::shared_ptr<Blender> Model::maybeCreateBlender() {
     if (isLoaded()) {
-        QThreadPool::globalInstance()->start(new Blender(getThisPointer(), getGeometry()->getConstHFMModelPointer(),
-                                                         ++_blendNumber, _blendshapeCoefficients));
-        return true;
+        return std::make_shared<Blender>(getThisPointer(), getGeometry()->getConstHFMModelPointer(),
+                                         ++_blendNumber, _blendshapeCoefficients);
     }
-    return false;
+    return nullptr;
 }
 
-ModelBlender::ModelBlender() :
-    _pendingBlenders(0) {
+ModelBlender::ModelBlender() {
 }
 
 ModelBlender::~ModelBlender() {
@@ -1861,18 +1928,60 @@ void ModelBlender::noteRequiresBlend(ModelPointer model) {
         _modelsRequiringBlendsSet.insert(model);
     }
 
-    if (_pendingBlenders < QThread::idealThreadCount()) {
-        while (!_modelsRequiringBlendsQueue.empty()) {
-            auto weakPtr = _modelsRequiringBlendsQueue.front();
-            _modelsRequiringBlendsQueue.pop();
-            _modelsRequiringBlendsSet.erase(weakPtr);
-            ModelPointer nextModel = weakPtr.lock();
-            if (nextModel && nextModel->maybeStartBlender()) {
-                _pendingBlenders++;
-                return;
+    // Creating a Blender copies the blendshape coefficients of every queued model, which the avatar jobs write from
+    // the worker threads (the main thread runs some of those jobs too).  So this only records the model, the blenders
+    // are created by blendPendingModels() and finishBlendPass(), on the main thread with no avatar job running.
+}
+
+void ModelBlender::blendPendingModels() {
+    Lock lock(_mutex);
+    if (!_blendPassPending) {
+        startBlendPass();
+    }
+}
+
+void ModelBlender::startBlendPass() {
+    // Every model that needs a blend is evaluated in one pass rather than one thread pool job each.  The pass
+    // is bounded so a crowd of faces can't hold up the results for long, whatever is left waits for the next one.
+    const size_t MAX_BLENDS_PER_PASS = 32;
+
+    std::vector<std::shared_ptr<Blender>> blenders;
+    while (!_modelsRequiringBlendsQueue.empty() && blenders.size() < MAX_BLENDS_PER_PASS) {
+        auto weakPtr = _modelsRequiringBlendsQueue.front();
+        _modelsRequiringBlendsQueue.pop();
+        _modelsRequiringBlendsSet.erase(weakPtr);
+        ModelPointer nextModel = weakPtr.lock();
+        if (!nextModel) {
+            continue;
+        }
+        auto blender = nextModel->maybeCreateBlender();
+        if (blender) {
+            auto cached = _sparseBlendshapesCache.find(blender->_hfmModel.get());
+            if (cached != _sparseBlendshapesCache.end() && cached->second.first.lock() == blender->_hfmModel) {
+                blender->_sparseBlendshapes = cached->second.second;
             }
+            blenders.push_back(blender);
         }
     }
+
+    // forget the layouts of models that have been unloaded
+    for (auto iter = _sparseBlendshapesCache.begin(); iter != _sparseBlendshapesCache.end();) {
+        if (iter->second.first.expired()) {
+            iter = _sparseBlendshapesCache.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+
+    if (!blenders.empty()) {
+        _blendPassPending = true;
+        QThreadPool::globalInstance()->start(new BlendPass(std::move(blenders)));
+    }
+}
+
+void ModelBlender::cacheSparseBlendshapes(const HFMModel::ConstPointer& hfmModel, const std::shared_ptr<const SparseModelBlendshapes>& sparseBlendshapes) {
+    Lock lock(_mutex);
+    _sparseBlendshapesCache[hfmModel.get()] = { hfmModel, sparseBlendshapes };
 }
 
 void ModelBlender::setBlendedVertices(ModelPointer model, int blendNumber, QVector<BlendshapeOffset> blendshapeOffsets, QVector<int> blendedMeshSizes) {
@@ -1882,19 +1991,10 @@ void ModelBlender::setBlendedVertices(ModelPointer model, int blendNumber, QVect
             blendshapeOperator(blendNumber, blendshapeOffsets, blendedMeshSizes, model->fetchRenderItemIDs());
         }
     }
+}
 
-    {
-        Lock lock(_mutex);
-        _pendingBlenders--;
-        while (!_modelsRequiringBlendsQueue.empty()) {
-            auto weakPtr = _modelsRequiringBlendsQueue.front();
-            _modelsRequiringBlendsQueue.pop();
-            _modelsRequiringBlendsSet.erase(weakPtr);
-            ModelPointer nextModel = weakPtr.lock();
-            if (nextModel && nextModel->maybeStartBlender()) {
-                _pendingBlenders++;
-                break;
-            }
-        }
-    }
+void ModelBlender::finishBlendPass() {
+    Lock lock(_mutex);
+    _blendPassPending = false;
+    startBlendPass();
 }
@@ -20,6 +20,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <functional>
+#include <map>
 
 #include <AABox.h>
 #include <DependencyManager.h>
@@ -54,6 +55,8 @@ namespace render {
     typedef unsigned int ItemID;
 }
 class MeshPartPayload;
+class Blender;
+class SparseBlendshapes;
 class ModelMeshPartPayload;
 class ModelRenderLocations;
 
@@ -155,13 +158,13 @@ public:
 
     void updateRenderItemsKey(const render::ScenePointer& scene);
 
-    virtual void updateRenderItems();
+    Q_INVOKABLE virtual void updateRenderItems();
     void setRenderItemsNeedUpdate();
     bool getRenderItemsNeedUpdate() { return _renderItemsNeedUpdate; }
     AABox getRenderableMeshBound() const;
     const render::ItemIDs& fetchRenderItemIDs() const;
 
-    bool maybeStartBlender();
+    std::shared_ptr<Blender> maybeCreateBlender();
 
     bool isLoaded() const { return (bool)_renderGeometry && _renderGeometry->isHFMModelLoaded(); }
     bool isAddedToScene() const { return _addedToScene; }
@@ -436,6 +439,9 @@ protected:
     // hook for derived classes to be notified when setUrl invalidates the current model.
     virtual void onInvalidate() {};
 
+    // simulate() can run on a worker thread, this emits rigReady() from the thread of the model
+    void emitRigReady();
+
     virtual void deleteGeometry();
 
     QUrl _url;
@@ -518,6 +524,8 @@ Q_DECLARE_METATYPE(ModelPointer)
 Q_DECLARE_METATYPE(Geometry::WeakPointer)
 Q_DECLARE_METATYPE(BlendshapeOffset)
 
+using SparseModelBlendshapes = std::vector<SparseBlendshapes>;
+
 /// Handle management of pending models that need blending
 class ModelBlender : public QObject, public Dependency {
     Q_OBJECT
@@ -525,13 +533,21 @@ class ModelBlender : public QObject, public Dependency {
 
 public:
 
-    /// Adds the specified model to the list requiring vertex blends.
+    /// Adds the specified model to the list requiring vertex blends.  Safe to call from any thread, the blend starts
+    /// with the next blendPendingModels() or at the end of the running pass.
     void noteRequiresBlend(ModelPointer model);
 
+    /// Starts blending the models noted so far, unless a pass is already running.  Called once per frame from the
+    /// main thread, where nothing is changing the blendshape coefficients of the models.
+    void blendPendingModels();
+
     bool shouldComputeBlendshapes() { return _computeBlendshapes; }
 
+    void cacheSparseBlendshapes(const HFMModel::ConstPointer& hfmModel, const std::shared_ptr<const SparseModelBlendshapes>& sparseBlendshapes);
+
 public slots:
     void setBlendedVertices(ModelPointer model, int blendNumber, QVector<BlendshapeOffset> blendshapeOffsets, QVector<int> blendedMeshSizes);
+    void finishBlendPass();
     void setComputeBlendshapes(bool computeBlendshapes) { _computeBlendshapes = computeBlendshapes; }
 
 private:
@@ -541,11 +557,16 @@ private:
     ModelBlender();
     virtual ~ModelBlender();
 
+    void startBlendPass();
+
     std::queue<ModelWeakPointer> _modelsRequiringBlendsQueue;
     std::set<ModelWeakPointer, std::owner_less<ModelWeakPointer>> _modelsRequiringBlendsSet;
-    int _pendingBlenders;
+    bool _blendPassPending { false };
     Mutex _mutex;
 
+    // the sparse blendshape layout of each loaded HFMModel, shared by every model instance using it
+    std::map<const HFMModel*, std::pair<std::weak_ptr<const HFMModel>, std::shared_ptr<const SparseModelBlendshapes>>> _sparseBlendshapesCache;
+
     bool _computeBlendshapes { true };
 };
 
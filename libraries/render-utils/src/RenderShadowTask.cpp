@@ -78,14 +78,11 @@ void RenderShadowTask::build(JobModel& task, const render::Varying& input, rende
     const auto sortedPipelines = task.addJob<PipelineSortShapes>("PipelineSortShadow", culledShadowItems);
     const auto sortedShapes = task.addJob<DepthSortShapes>("DepthSortShadow", sortedPipelines, true);
 
-    render::Varying cascadeFrustums[SHADOW_CASCADE_MAX_COUNT] = {
-        ViewFrustumPointer()
-#if SHADOW_CASCADE_MAX_COUNT>1
-        ,ViewFrustumPointer(),
-        ViewFrustumPointer(),
-        ViewFrustumPointer()
-#endif
-    };
+    // Frustum cull against every cascade at once, each cascade then only applies its own mask.
+    // The frustum culling CPU time of all the cascades is reported by this one job; the CullShadowCascade%d
+    // jobs below only time their mask and size tests.
+    const auto cascadesCullInputs = CullShadowCascades::Inputs(sortedShapes, shadowFrame).asVarying();
+    const auto cascadesVisibility = task.addJob<CullShadowCascades>("CullShadowCascades", cascadesCullInputs);
 
     CascadeBoxes cascadeSceneBBoxes;
 
@@ -94,15 +91,10 @@ void RenderShadowTask::build(JobModel& task, const render::Varying& input, rende
         sprintf(jobName, "ShadowCascadeSetup%d", i);
         const auto cascadeSetupOutput = task.addJob<RenderShadowCascadeSetup>(jobName, shadowFrame, i, shadowCasterReceiverFilter);
         const auto shadowFilter = cascadeSetupOutput.getN<RenderShadowCascadeSetup::Outputs>(0);
-        auto antiFrustum = render::Varying(ViewFrustumPointer());
-        cascadeFrustums[i] = cascadeSetupOutput.getN<RenderShadowCascadeSetup::Outputs>(1);
-        if (i > 1) {
-            antiFrustum = cascadeFrustums[i - 2];
-        }
 
-        const auto cullInputs = CullShadowBounds::Inputs(sortedShapes, shadowFilter, antiFrustum, currentKeyLight, cascadeSetupOutput.getN<RenderShadowCascadeSetup::Outputs>(2)).asVarying();
+        const auto cullInputs = CullShadowBounds::Inputs(sortedShapes, shadowFilter, cascadesVisibility, currentKeyLight, cascadeSetupOutput.getN<RenderShadowCascadeSetup::Outputs>(2)).asVarying();
         sprintf(jobName, "CullShadowCascade%d", i);
-        const auto culledShadowItemsAndBounds = task.addJob<CullShadowBounds>(jobName, cullInputs);
+        const auto culledShadowItemsAndBounds = task.addJob<CullShadowBounds>(jobName, cullInputs, i);
 
         // GPU jobs: Render to shadow map
         sprintf(jobName, "RenderShadowMap%d", i);
@@ -546,6 +538,29 @@ static AABox& merge(AABox& box, const AABox& otherBox, const glm::vec3& dir) {
     return box;
 }
 
+void CullShadowCascades::run(const render::RenderContextPointer& renderContext, const Inputs& inputs, Outputs& outputs) {
+    const auto& inShapes = inputs.get0();
+    const auto& shadowFrame = inputs.get1();
+
+    outputs.clear();
+    if (!shadowFrame || shadowFrame->_objects.empty() || !shadowFrame->_objects[0]) {
+        return;
+    }
+
+    const auto globalShadow = shadowFrame->_objects[0];
+    FrustumCuller culler;
+    for (unsigned int i = 0; i < globalShadow->getCascadeCount(); i++) {
+        // Items completely inside the cascade before the previous one are already covered there
+        const auto& cascadeFrustum = globalShadow->getCascade(i).getFrustum();
+        if (i > 1) {
+            culler.addView(*cascadeFrustum, globalShadow->getCascade(i - 2).getFrustum().get());
+        } else {
+            culler.addView(*cascadeFrustum);
+        }
+    }
+    render::cullShapesInViews(culler, inShapes, outputs);
+}
+
 void CullShadowBounds::run(const render::RenderContextPointer& renderContext, const Inputs& inputs, Outputs& outputs) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
@@ -553,13 +568,10 @@ void CullShadowBounds::run(const render::RenderContextPointer& renderContext, co
 
     const auto& inShapes = inputs.get0();
     const auto& filter = inputs.get1();
-    ViewFrustumPointer antiFrustum;
+    const auto& visibility = inputs.get2();
     auto& outShapes = outputs.edit0();
     auto& outBounds = outputs.edit1();
 
-    if (!inputs[3].isNull()) {
-        antiFrustum = inputs.get2();
-    }
     outShapes.clear();
     outBounds = AABox();
 
@@ -572,12 +584,13 @@ void CullShadowBounds::run(const render::RenderContextPointer& renderContext, co
 
     if (!filter.selectsNothing() && currentKeyLight) {
         auto& details = args->_details.edit(RenderDetails::SHADOW);
-        render::CullTest test(shadowCullFunctor, args, details, antiFrustum);
+        render::CullTest test(shadowCullFunctor, args, details);
         auto scene = args->_scene;
         auto lightStage = renderContext->_scene->getStage<LightStage>();
         assert(lightStage);
         const auto globalLightDir = currentKeyLight->getDirection();
         auto castersFilter = render::ItemFilter::Builder(filter).withShadowCaster().build();
+        const FrustumCuller::ViewMask cascadeBit = (FrustumCuller::ViewMask)(1 << _cascadeIndex);
 
         for (auto& inItems : inShapes) {
             auto key = inItems.first;
@@ -589,35 +602,30 @@ void CullShadowBounds::run(const render::RenderContextPointer& renderContext, co
 
             details._considered += (int)inItems.second.size();
 
-            if (antiFrustum == nullptr) {
-                for (auto& item : inItems.second) {
-                    if (test.solidAngleTest(item.bound) && test.frustumTest(item.bound)) {
-                        const auto shapeKey = scene->getItem(item.id).getKey();
-                        if (castersFilter.test(shapeKey)) {
-                            outItems->second.emplace_back(item);
-                            outBounds += item.bound;
-                        } else {
-                            // Receivers are not rendered but they still increase the bounds of the shadow scene
-                            // although only in the direction of the light direction so as to have a correct far
-                            // distance without decreasing the near distance.
-                            merge(outBounds, item.bound, globalLightDir);
-                        }
-                    }
+            auto masks = visibility.find(key);
+            if (masks == visibility.end()) {
+                details._outOfView += (int)inItems.second.size();
+                continue;
+            }
+
+            for (size_t i = 0; i < inItems.second.size(); i++) {
+                const auto& item = inItems.second[i];
+                if (!test.solidAngleTest(item.bound)) {
+                    continue;
                 }
-            } else {
-                for (auto& item : inItems.second) {
-                    if (test.solidAngleTest(item.bound) && test.frustumTest(item.bound) && test.antiFrustumTest(item.bound)) {
-                        const auto shapeKey = scene->getItem(item.id).getKey();
-                        if (castersFilter.test(shapeKey)) {
-                            outItems->second.emplace_back(item);
-                            outBounds += item.bound;
-                        } else {
-                            // Receivers are not rendered but they still increase the bounds of the shadow scene
-                            // although only in the direction of the light direction so as to have a correct far
-                            // distance without decreasing the near distance.
-                            merge(outBounds, item.bound, globalLightDir);
-                        }
-                    }
+                if (!(masks->second[i] & cascadeBit)) {
+                    details._outOfView++;
+                    continue;
+                }
+                const auto shapeKey = scene->getItem(item.id).getKey();
+                if (castersFilter.test(shapeKey)) {
+                    outItems->second.emplace_back(item);
+                    outBounds += item.bound;
+                } else {
+                    // Receivers are not rendered but they still increase the bounds of the shadow scene
+                    // although only in the direction of the light direction so as to have a correct far
+                    // distance without decreasing the near distance.
+                    merge(outBounds, item.bound, globalLightDir);
                 }
             }
             details._rendered += (int)outItems->second.size();
@@ -173,13 +173,30 @@ public:
     void run(const render::RenderContextPointer& renderContext, const Input& input);
 };
 
+// Frustum cull the shadow items against all the cascades in one pass, bit i of a mask is cascade i
+class CullShadowCascades {
+public:
+    using Inputs = render::VaryingSet2<render::ShapeBounds, LightStage::ShadowFramePointer>;
+    using Outputs = render::ShapeVisibility;
+    using JobModel = render::Job::ModelIO<CullShadowCascades, Inputs, Outputs>;
+
+    void run(const render::RenderContextPointer& renderContext, const Inputs& inputs, Outputs& outputs);
+};
+
+// Keeps one cascade's items, from its bit in the CullShadowCascades masks and the cull functor's size test.
+// Its timing doesn't include the frustum tests, those are all counted in CullShadowCascades.
 class CullShadowBounds {
 public:
-    using Inputs = render::VaryingSet5<render::ShapeBounds, render::ItemFilter, ViewFrustumPointer, graphics::LightPointer, RenderShadowTask::CullFunctor>;
+    using Inputs = render::VaryingSet5<render::ShapeBounds, render::ItemFilter, render::ShapeVisibility, graphics::LightPointer, RenderShadowTask::CullFunctor>;
     using Outputs = render::VaryingSet2<render::ShapeBounds, AABox>;
     using JobModel = render::Job::ModelIO<CullShadowBounds, Inputs, Outputs>;
 
+    CullShadowBounds(unsigned int cascadeIndex) : _cascadeIndex(cascadeIndex) {}
+
     void run(const render::RenderContextPointer& renderContext, const Inputs& inputs, Outputs& outputs);
+
+private:
+    unsigned int _cascadeIndex;
 };
 
 #endif // hifi_RenderShadowTask_h
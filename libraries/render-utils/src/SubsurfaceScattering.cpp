@@ -96,16 +96,30 @@ bool SubsurfaceScatteringResource::isShowDiffusedNormal() const {
     return (bool)_parametersBuffer.get<Parameters>().showDiffusedNormal;
 }
 
+static gpu::TexturePointer createScatteringProfile();
+static gpu::TexturePointer createPreIntegratedScattering();
+static gpu::TexturePointer createScatteringSpecularBeckmann();
+std::function<void(gpu::Batch&)> diffuseProfileGPU(const gpu::TexturePointer& profileMap);
+std::function<void(gpu::Batch&)> diffuseScatterGPU(const gpu::TexturePointer& profileMap, const gpu::TexturePointer& lut);
+std::function<void(gpu::Batch&)> computeSpecularBeckmannGPU(const gpu::TexturePointer& beckmannMap);
+
 void SubsurfaceScatteringResource::generateScatteringTable(RenderArgs* args) {
+    // The table reads the profile on the GPU only, which runs the batches in the order they are listed,
+    // so the batches are recorded in parallel
+    std::vector<std::function<void(gpu::Batch&)>> batches;
     if (!_scatteringProfile) {
-        _scatteringProfile = generateScatteringProfile(args);
+        _scatteringProfile = createScatteringProfile();
+        batches.push_back(diffuseProfileGPU(_scatteringProfile));
     }
     if (!_scatteringTable) {
-        _scatteringTable = generatePreIntegratedScattering(_scatteringProfile, args);
+        _scatteringTable = createPreIntegratedScattering();
+        batches.push_back(diffuseScatterGPU(_scatteringProfile, _scatteringTable));
     }
     if (!_scatteringSpecular) {
-        _scatteringSpecular = generateScatteringSpecularBeckmann(args);
+        _scatteringSpecular = createScatteringSpecularBeckmann();
+        batches.push_back(computeSpecularBeckmannGPU(_scatteringSpecular));
     }
+    gpu::doInBatches("SubsurfaceScattering::generateScatteringTable", args->_context, batches);
 }
 
 SubsurfaceScattering::SubsurfaceScattering() {
@@ -293,7 +307,8 @@ void diffuseProfile(gpu::TexturePointer& profile) {
 
 #endif
 
-void diffuseProfileGPU(gpu::TexturePointer& profileMap, RenderArgs* args) {
+// The pipelines and framebuffers are built by these functions, the returned functions only record the batch
+std::function<void(gpu::Batch&)> diffuseProfileGPU(const gpu::TexturePointer& profileMap) {
     int width = profileMap->getWidth();
     int height = profileMap->getHeight();
 
@@ -309,7 +324,7 @@ void diffuseProfileGPU(gpu::TexturePointer& profileMap, RenderArgs* args) {
     auto makeFramebuffer = gpu::FramebufferPointer(gpu::Framebuffer::create("diffuseProfile"));
     makeFramebuffer->setRenderBuffer(0, profileMap);
 
-    gpu::doInBatch("SubsurfaceScattering::diffuseProfileGPU", args->_context, [=](gpu::Batch& batch) {
+    return [=](gpu::Batch& batch) {
         batch.enableStereo(false);
 
         batch.setViewportTransform(glm::ivec4(0, 0, width, height));
@@ -320,11 +335,11 @@ void diffuseProfileGPU(gpu::TexturePointer& profileMap, RenderArgs* args) {
         batch.setResourceTexture(0, nullptr);
         batch.setPipeline(nullptr);
         batch.setFramebuffer(nullptr);
-    });
+    };
 }
 
 
-void diffuseScatterGPU(const gpu::TexturePointer& profileMap, gpu::TexturePointer& lut, RenderArgs* args) {
+std::function<void(gpu::Batch&)> diffuseScatterGPU(const gpu::TexturePointer& profileMap, const gpu::TexturePointer& lut) {
     int width = lut->getWidth();
     int height = lut->getHeight();
 
@@ -337,7 +352,7 @@ void diffuseScatterGPU(const gpu::TexturePointer& profileMap, gpu::TexturePointe
     auto makeFramebuffer = gpu::FramebufferPointer(gpu::Framebuffer::create("diffuseScatter"));
     makeFramebuffer->setRenderBuffer(0, lut);
 
-    gpu::doInBatch("SubsurfaceScattering::diffuseScatterGPU", args->_context, [=](gpu::Batch& batch) {
+    return [=](gpu::Batch& batch) {
         batch.enableStereo(false);
         batch.setViewportTransform(glm::ivec4(0, 0, width, height));
         batch.setFramebuffer(makeFramebuffer);
@@ -348,10 +363,10 @@ void diffuseScatterGPU(const gpu::TexturePointer& profileMap, gpu::TexturePointe
         batch.setPipeline(nullptr);
         batch.setFramebuffer(nullptr);
 
-    });
+    };
 }
 
-void computeSpecularBeckmannGPU(gpu::TexturePointer& beckmannMap, RenderArgs* args) {
+std::function<void(gpu::Batch&)> computeSpecularBeckmannGPU(const gpu::TexturePointer& beckmannMap) {
     int width = beckmannMap->getWidth();
     int height = beckmannMap->getHeight();
 
@@ -367,7 +382,7 @@ void computeSpecularBeckmannGPU(gpu::TexturePointer& beckmannMap, RenderArgs* ar
     auto makeFramebuffer = gpu::FramebufferPointer(gpu::Framebuffer::create("computeSpecularBeckmann"));
     makeFramebuffer->setRenderBuffer(0, beckmannMap);
 
-    gpu::doInBatch("SubsurfaceScattering::computeSpecularBeckmannGPU", args->_context, [=](gpu::Batch& batch) {
+    return [=](gpu::Batch& batch) {
         batch.enableStereo(false);
 
         batch.setViewportTransform(glm::ivec4(0, 0, width, height));
@@ -378,36 +393,50 @@ void computeSpecularBeckmannGPU(gpu::TexturePointer& beckmannMap, RenderArgs* ar
         batch.setResourceTexture(0, nullptr);
         batch.setPipeline(nullptr);
         batch.setFramebuffer(nullptr);
-    });
+    };
 }
 
-gpu::TexturePointer SubsurfaceScatteringResource::generateScatteringProfile(RenderArgs* args) {
+static gpu::TexturePointer createScatteringProfile() {
     const int PROFILE_RESOLUTION = 512;
     //  const auto pixelFormat = gpu::Element::COLOR_SRGBA_32;
     const auto pixelFormat = gpu::Element::COLOR_R11G11B10;
     auto profileMap = gpu::Texture::createRenderBuffer(pixelFormat, PROFILE_RESOLUTION, 1, gpu::Texture::SINGLE_MIP, gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_MIP_LINEAR, gpu::Sampler::WRAP_CLAMP));
     profileMap->setSource("Generated Scattering Profile");
-    diffuseProfileGPU(profileMap, args);
     return profileMap;
 }
 
-gpu::TexturePointer SubsurfaceScatteringResource::generatePreIntegratedScattering(const gpu::TexturePointer& profile, RenderArgs* args) {
-
+static gpu::TexturePointer createPreIntegratedScattering() {
     const int TABLE_RESOLUTION = 512;
   //  const auto pixelFormat = gpu::Element::COLOR_SRGBA_32;
     const auto pixelFormat = gpu::Element::COLOR_R11G11B10;
     auto scatteringLUT = gpu::Texture::createRenderBuffer(pixelFormat, TABLE_RESOLUTION, TABLE_RESOLUTION, gpu::Texture::SINGLE_MIP, gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_MIP_LINEAR, gpu::Sampler::WRAP_CLAMP));
     //diffuseScatter(scatteringLUT);
     scatteringLUT->setSource("Generated pre-integrated scattering");
-    diffuseScatterGPU(profile, scatteringLUT, args);
     return scatteringLUT;
 }
 
-gpu::TexturePointer SubsurfaceScatteringResource::generateScatteringSpecularBeckmann(RenderArgs* args) {
+static gpu::TexturePointer createScatteringSpecularBeckmann() {
     const int SPECULAR_RESOLUTION = 256;
     auto beckmannMap = gpu::Texture::createRenderBuffer(gpu::Element::COLOR_RGBA_32, SPECULAR_RESOLUTION, SPECULAR_RESOLUTION, gpu::Texture::SINGLE_MIP, gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_MIP_LINEAR, gpu::Sampler::WRAP_CLAMP));
     beckmannMap->setSource("Generated beckmannMap");
-    computeSpecularBeckmannGPU(beckmannMap, args);
+    return beckmannMap;
+}
+
+gpu::TexturePointer SubsurfaceScatteringResource::generateScatteringProfile(RenderArgs* args) {
+    auto profileMap = createScatteringProfile();
+    gpu::doInBatch("SubsurfaceScattering::diffuseProfileGPU", args->_context, diffuseProfileGPU(profileMap));
+    return profileMap;
+}
+
+gpu::TexturePointer SubsurfaceScatteringResource::generatePreIntegratedScattering(const gpu::TexturePointer& profile, RenderArgs* args) {
+    auto scatteringLUT = createPreIntegratedScattering();
+    gpu::doInBatch("SubsurfaceScattering::diffuseScatterGPU", args->_context, diffuseScatterGPU(profile, scatteringLUT));
+    return scatteringLUT;
+}
+
+gpu::TexturePointer SubsurfaceScatteringResource::generateScatteringSpecularBeckmann(RenderArgs* args) {
+    auto beckmannMap = createScatteringSpecularBeckmann();
+    gpu::doInBatch("SubsurfaceScattering::computeSpecularBeckmannGPU", args->_context, computeSpecularBeckmannGPU(beckmannMap));
     return beckmannMap;
 }
 
@@ -16,6 +16,7 @@
 
 #include <PerfStat.h>
 #include <OctreeUtils.h>
+#include <TBBHelpers.h>
 
 using namespace render;
 
@@ -106,6 +107,33 @@ void render::cullItems(const RenderContextPointer& renderContext, const CullFunc
     details._rendered += (int)outItems.size();
 }
 
+// Small enough for a chunk of boxes and masks to stay in L1
+const size_t CULL_GRAIN_SIZE = 1024;
+
+void render::cullItemBounds(const FrustumCuller& culler, const ItemBounds& items, ViewMasks& masks) {
+    masks.resize(items.size());
+    if (items.empty()) {
+        return;
+    }
+
+    FrustumCuller::Boxes boxes;
+    boxes.reserve(items.size());
+    for (const auto& item : items) {
+        boxes.push_back(item.bound);
+    }
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, items.size(), CULL_GRAIN_SIZE), [&](const tbb::blocked_range<size_t>& range) {
+        culler.cull(boxes, range.begin(), range.end(), masks.data() + range.begin());
+    });
+}
+
+void render::cullShapesInViews(const FrustumCuller& culler, const ShapeBounds& shapes, ShapeVisibility& visibility) {
+    visibility.clear();
+    for (const auto& shape : shapes) {
+        cullItemBounds(culler, shape.second, visibility[shape.first]);
+    }
+}
+
 void FetchNonspatialItems::run(const RenderContextPointer& renderContext, const ItemFilter& filter, ItemBounds& outItems) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
@@ -304,40 +332,44 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
                 }
             }
 
-            // partial & fit items: filter & frustum cull
-            {
-                PerformanceTimer perfTimer("partialFitItems");
-                for (auto id : inSelection.partialItems) {
+            // partial items: filter, then frustum cull all the candidates in one batch
+            FrustumCuller culler;
+            culler.addView(args->getViewFrustum());
+            ItemBounds candidates;
+            ViewMasks masks;
+            auto cullPartialItems = [&](const ItemIDs& ids, bool testSolidAngle) {
+                candidates.clear();
+                for (auto id : ids) {
                     auto& item = scene->getItem(id);
                     if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        if (test.frustumTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene));
-                            }
+                        candidates.emplace_back(id, item.getBound());
+                    }
+                }
+                cullItemBounds(culler, candidates, masks);
+                for (size_t i = 0; i < candidates.size(); i++) {
+                    const auto& itemBound = candidates[i];
+                    if (!masks[i]) {
+                        details._outOfView++;
+                    } else if (!testSolidAngle || test.solidAngleTest(itemBound.bound)) {
+                        outItems.emplace_back(itemBound);
+                        auto& item = scene->getItem(itemBound.id);
+                        if (item.getKey().isMetaCullGroup()) {
+                            item.fetchMetaSubItemBounds(outItems, (*scene));
                         }
                     }
                 }
+            };
+
+            // partial & fit items: filter & frustum cull
+            {
+                PerformanceTimer perfTimer("partialFitItems");
+                cullPartialItems(inSelection.partialItems, false);
             }
 
             // partial & subcell items:: filter & frutum cull & solidangle cull
             {
                 PerformanceTimer perfTimer("partialSmallItems");
-                for (auto id : inSelection.partialSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        if (test.frustumTest(itemBound.bound)) {
-                            if (test.solidAngleTest(itemBound.bound)) {
-                                outItems.emplace_back(itemBound);
-                                if (item.getKey().isMetaCullGroup()) {
-                                    item.fetchMetaSubItemBounds(outItems, (*scene));
-                                }
-                            }
-                        }
-                    }
-                }
+                cullPartialItems(inSelection.partialSubcellItems, true);
             }
         }
     }
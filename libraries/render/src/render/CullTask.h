@@ -12,6 +12,8 @@
 #ifndef hifi_render_CullTask_h
 #define hifi_render_CullTask_h
 
+#include <FrustumCuller.h>
+
 #include "Engine.h"
 #include "ViewFrustum.h"
 
@@ -22,6 +24,15 @@ namespace render {
     void cullItems(const RenderContextPointer& renderContext, const CullFunctor& cullFunctor, RenderDetails::Item& details,
         const ItemBounds& inItems, ItemBounds& outItems);
 
+    // Per item view masks of several views culled in one pass, see FrustumCuller
+    using ViewMasks = std::vector<FrustumCuller::ViewMask>;
+    using ShapeVisibility = std::unordered_map<ShapeKey, ViewMasks, ShapeKey::Hash, ShapeKey::KeyEqual>;
+
+    // Test the items against every view of the culler on worker threads, masks[i] is the visibility of items[i].
+    // Null bounds are tested like any other, as the frustum tests of CullSpatialSelection and the shadow cascades did
+    void cullItemBounds(const FrustumCuller& culler, const ItemBounds& items, ViewMasks& masks);
+    void cullShapesInViews(const FrustumCuller& culler, const ShapeBounds& shapes, ShapeVisibility& visibility);
+
     // Culling Frustum / solidAngle test helper class
     struct CullTest {
         CullFunctor _functor;
@@ -64,5 +64,15 @@ void EngineStats::run(const RenderContextPointer& renderContext) {
     config->frameSetPipelineCount = _gpuStats._PSNumSetPipelines;
     config->frameSetInputFormatCount = _gpuStats._ISNumFormatChanges;
 
+    config->frameBatchAllocationCount = gpu::Context::getFrameBatchAllocationCount();
+    config->frameBatchAllocationSize = gpu::Context::getFrameBatchAllocationSize();
+    config->batchArenaMemSize = gpu::Context::getBatchArenaMemSize();
+
+    const auto& transactionStats = renderContext->_scene->getTransactionStats();
+    config->frameItemResetCount = transactionStats.numResets;
+    config->frameItemRemoveCount = transactionStats.numRemoves;
+    config->frameItemUpdateCount = transactionStats.numUpdates;
+    config->frameConcurrentItemUpdateCount = transactionStats.numConcurrentUpdates;
+
     // These new stat values are notified with the "newStats" signal triggered by the timer
 }
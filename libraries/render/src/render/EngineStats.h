@@ -61,6 +61,15 @@ namespace render {
         Q_PROPERTY(quint32 frameSetPipelineCount MEMBER frameSetPipelineCount NOTIFY newStats)
         Q_PROPERTY(quint32 frameSetInputFormatCount MEMBER frameSetInputFormatCount NOTIFY newStats)
 
+        Q_PROPERTY(quint32 frameBatchAllocationCount MEMBER frameBatchAllocationCount NOTIFY newStats)
+        Q_PROPERTY(qint64 frameBatchAllocationSize MEMBER frameBatchAllocationSize NOTIFY newStats)
+        Q_PROPERTY(qint64 batchArenaMemSize MEMBER batchArenaMemSize NOTIFY newStats)
+
+        Q_PROPERTY(quint32 frameItemResetCount MEMBER frameItemResetCount NOTIFY newStats)
+        Q_PROPERTY(quint32 frameItemRemoveCount MEMBER frameItemRemoveCount NOTIFY newStats)
+        Q_PROPERTY(quint32 frameItemUpdateCount MEMBER frameItemUpdateCount NOTIFY newStats)
+        Q_PROPERTY(quint32 frameConcurrentItemUpdateCount MEMBER frameConcurrentItemUpdateCount NOTIFY newStats)
+
 
     public:
         EngineStatsConfig() : Job::Config(true) {}
@@ -101,6 +110,15 @@ namespace render {
         quint32 frameSetPipelineCount{ 0 };
 
         quint32 frameSetInputFormatCount{ 0 };
+
+        quint32 frameBatchAllocationCount{ 0 };
+        qint64 frameBatchAllocationSize{ 0 };
+        qint64 batchArenaMemSize{ 0 };
+
+        quint32 frameItemResetCount{ 0 };
+        quint32 frameItemRemoveCount{ 0 };
+        quint32 frameItemUpdateCount{ 0 };
+        quint32 frameConcurrentItemUpdateCount{ 0 };
     };
 
     class EngineStats {
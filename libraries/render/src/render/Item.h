@@ -421,7 +421,14 @@ public:
     // Update Functor
     class UpdateFunctorInterface {
     public:
+        UpdateFunctorInterface(bool concurrent = false) : _concurrent(concurrent) {}
         virtual ~UpdateFunctorInterface() {}
+
+        // A concurrent functor only touches the payload it is applied to, so the scene may run it on a worker thread
+        bool isConcurrent() const { return _concurrent; }
+
+    private:
+        bool _concurrent;
     };
     typedef std::shared_ptr<UpdateFunctorInterface> UpdateFunctorPointer;
 
@@ -512,7 +519,7 @@ public:
     typedef std::function<void(T&)> Func;
     Func _func;
 
-    UpdateFunctor(Func func): _func(func) {}
+    UpdateFunctor(Func func, bool concurrent = false) : Item::UpdateFunctorInterface(concurrent), _func(func) {}
     ~UpdateFunctor() {}
 };
 
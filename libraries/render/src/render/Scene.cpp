@@ -10,8 +10,13 @@
 //
 #include "Scene.h"
 
+#include <algorithm>
+#include <bitset>
 #include <numeric>
+
 #include <gpu/Batch.h>
+#include <TBBHelpers.h>
+
 #include "Logging.h"
 #include "TransitionStage.h"
 #include "HighlightStage.h"
@@ -202,22 +207,17 @@ bool Scene::isAllocatedID(const ItemID& id) const {
 
 /// Enqueue change batch to the scene
 void Scene::enqueueTransaction(const Transaction& transaction) {
-    std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-    _transactionQueue.emplace_back(transaction);
+    _transactionQueue.push(transaction);
 }
 
 void Scene::enqueueTransaction(Transaction&& transaction) {
-    std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-    _transactionQueue.emplace_back(std::move(transaction));
+    _transactionQueue.push(std::move(transaction));
 }
 
 uint32_t Scene::enqueueFrame() {
     PROFILE_RANGE(render, __FUNCTION__);
     TransactionQueue localTransactionQueue;
-    {
-        std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-        localTransactionQueue.swap(_transactionQueue);
-    }
+    _transactionQueue.popAll(localTransactionQueue);
 
     Transaction consolidatedTransaction;
     consolidatedTransaction.merge(std::move(localTransactionQueue));
@@ -240,6 +240,9 @@ void Scene::processTransactionQueue() {
         queuedFrames.swap(_transactionFrames);
     }
 
+    _transactionStats = TransactionStats();
+    _transactionStats.numFrames = (uint32_t)queuedFrames.size();
+
     // go through the queue of frames and process them
     for (auto& frame : queuedFrames) {
         processTransactionFrame(frame);
@@ -291,6 +294,7 @@ void Scene::processTransactionFrame(const Transaction& transaction) {
 }
 
 void Scene::resetItems(const Transaction::Resets& transactions) {
+    _transactionStats.numResets += (uint32_t)transactions.size();
     for (auto& reset : transactions) {
         // Access the true item
         auto itemId = std::get<0>(reset);
@@ -314,6 +318,7 @@ void Scene::resetItems(const Transaction::Resets& transactions) {
 }
 
 void Scene::removeItems(const Transaction::Removes& transactions) {
+    _transactionStats.numRemoves += (uint32_t)transactions.size();
     for (auto removedID : transactions) {
         // Access the true item
         auto& item = _items[removedID];
@@ -335,49 +340,165 @@ void Scene::removeItems(const Transaction::Removes& transactions) {
     }
 }
 
+// Below that many concurrent updates the serial loop is faster than spreading them over threads
+static const size_t MIN_CONCURRENT_UPDATES = 256;
+
+// The concurrent updates are bucketed by ranges of item IDs, one task per range
+static const int ITEM_ID_RANGE_SHIFT = 10;
+static const size_t ITEM_ID_RANGE_SIZE = 1 << ITEM_ID_RANGE_SHIFT;
+
 void Scene::updateItems(const Transaction::Updates& transactions) {
+    _transactionStats.numUpdates += (uint32_t)transactions.size();
+
+    size_t numConcurrentUpdates = std::count_if(transactions.begin(), transactions.end(), [](const Transaction::Update& update) {
+        const auto& functor = std::get<1>(update);
+        return functor && functor->isConcurrent();
+    });
+    if (numConcurrentUpdates >= MIN_CONCURRENT_UPDATES) {
+        updateItemsConcurrently(transactions);
+        return;
+    }
+
     for (auto& update : transactions) {
-        auto updateID = std::get<0>(update);
-        if (updateID == Item::INVALID_ITEM_ID) {
-            continue;
+        updateItem(update);
+    }
+}
+
+void Scene::updateItem(const Transaction::Update& update) {
+    auto updateID = std::get<0>(update);
+    if (updateID == Item::INVALID_ITEM_ID) {
+        return;
+    }
+
+    // Access the true item
+    auto& item = _items[updateID];
+
+    // If item doesn't exist it cannot be updated
+    if (!item.exist()) {
+        return;
+    }
+
+    // Good to go, deal with the update
+    auto oldKey = item.getKey();
+
+    // Update the item
+    item.update(std::get<1>(update));
+
+    updateItemContainers(updateID, oldKey);
+}
+
+void Scene::updateItemContainers(ItemID updateID, const ItemKey& oldKey) {
+    auto& item = _items[updateID];
+    auto oldCell = item.getCell();
+    auto newKey = item.getKey();
+
+    // Update the item's container
+    if (oldKey.isSpatial() == newKey.isSpatial()) {
+        if (newKey.isSpatial()) {
+            auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(), updateID, newKey);
+            item.resetCell(newCell, newKey.isSmall());
         }
+    } else {
+        if (newKey.isSpatial()) {
+            _masterNonspatialSet.erase(updateID);
 
-        // Access the true item
-        auto& item = _items[updateID];
+            auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(), updateID, newKey);
+            item.resetCell(newCell, newKey.isSmall());
+        } else {
+            _masterSpatialTree.removeItem(oldCell, oldKey, updateID);
+            item.resetCell();
 
-        // If item doesn't exist it cannot be updated
-        if (!item.exist()) {
-            continue;
+            _masterNonspatialSet.insert(updateID);
         }
+    }
+}
 
-        // Good to go, deal with the update
-        auto oldCell = item.getCell();
-        auto oldKey = item.getKey();
+// The concurrent functors run in parallel, one task per range of item IDs, so an item is only ever touched by one task
+// and its updates are applied in order.  The other functors may have side effects and run afterwards on this thread:
+// once an item gets one of those, the rest of its updates wait for the serial pass too.
+// The spatial tree isn't thread safe, so the containers of the items updated in parallel are fixed up serially,
+// before the serial updates.
+void Scene::updateItemsConcurrently(const Transaction::Updates& transactions) {
+    PROFILE_RANGE(render, __FUNCTION__);
 
-        // Update the item
-        item.update(std::get<1>(update));
-        auto newKey = item.getKey();
+    // Bucket the updates by item ID range, keeping their order within a bucket
+    size_t numBuckets = (_items.size() >> ITEM_ID_RANGE_SHIFT) + 1;
+    std::vector<uint32_t> bucketOffsets(numBuckets + 1, 0);
+    for (const auto& update : transactions) {
+        auto updateID = std::get<0>(update);
+        if (updateID != Item::INVALID_ITEM_ID && updateID < _items.size()) {
+            bucketOffsets[(updateID >> ITEM_ID_RANGE_SHIFT) + 1]++;
+        }
+    }
+    std::partial_sum(bucketOffsets.begin(), bucketOffsets.end(), bucketOffsets.begin());
 
-        // Update the item's container
-        if (oldKey.isSpatial() == newKey.isSpatial()) {
-            if (newKey.isSpatial()) {
-                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(), updateID, newKey);
-                item.resetCell(newCell, newKey.isSmall());
+    std::vector<uint32_t> bucketedUpdates(bucketOffsets.back());
+    {
+        std::vector<uint32_t> cursors(bucketOffsets.begin(), bucketOffsets.end() - 1);
+        for (uint32_t i = 0; i < (uint32_t)transactions.size(); i++) {
+            auto updateID = std::get<0>(transactions[i]);
+            if (updateID != Item::INVALID_ITEM_ID && updateID < _items.size()) {
+                bucketedUpdates[cursors[updateID >> ITEM_ID_RANGE_SHIFT]++] = i;
             }
-        } else {
-            if (newKey.isSpatial()) {
-                _masterNonspatialSet.erase(updateID);
+        }
+    }
 
-                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(), updateID, newKey);
-                item.resetCell(newCell, newKey.isSmall());
-            } else {
-                _masterSpatialTree.removeItem(oldCell, oldKey, updateID);
-                item.resetCell();
+    struct BucketResult {
+        std::vector<std::pair<ItemID, ItemKey>> updatedItems; // the items updated in parallel and their key before that
+        std::vector<uint32_t> serialUpdates;
+        uint32_t numConcurrentUpdates { 0 };
+    };
+    std::vector<BucketResult> results(numBuckets);
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numBuckets), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t bucket = range.begin(); bucket != range.end(); ++bucket) {
+            auto& result = results[bucket];
+            std::bitset<ITEM_ID_RANGE_SIZE> updated;
+            std::bitset<ITEM_ID_RANGE_SIZE> serial;
+            for (uint32_t i = bucketOffsets[bucket]; i < bucketOffsets[bucket + 1]; i++) {
+                const auto& update = transactions[bucketedUpdates[i]];
+                auto updateID = std::get<0>(update);
+                const auto& functor = std::get<1>(update);
+                size_t bit = updateID & (ITEM_ID_RANGE_SIZE - 1);
+
+                if (serial[bit] || !functor || !functor->isConcurrent()) {
+                    serial.set(bit);
+                    result.serialUpdates.push_back(bucketedUpdates[i]);
+                    continue;
+                }
 
-                _masterNonspatialSet.insert(updateID);
+                auto& item = _items[updateID];
+                if (!item.exist()) {
+                    continue;
+                }
+                if (!updated[bit]) {
+                    updated.set(bit);
+                    result.updatedItems.emplace_back(updateID, item.getKey());
+                }
+                item.update(functor);
+                result.numConcurrentUpdates++;
             }
         }
+    });
+
+    std::vector<uint32_t> serialUpdates;
+    uint32_t numConcurrentUpdates = 0;
+    for (const auto& result : results) {
+        numConcurrentUpdates += result.numConcurrentUpdates;
+        for (const auto& updatedItem : result.updatedItems) {
+            updateItemContainers(updatedItem.first, updatedItem.second);
+        }
+        serialUpdates.insert(serialUpdates.end(), result.serialUpdates.begin(), result.serialUpdates.end());
     }
+
+    // Back to the order of the transaction
+    std::sort(serialUpdates.begin(), serialUpdates.end());
+    for (auto index : serialUpdates) {
+        updateItem(transactions[index]);
+    }
+
+    // Updates of items that no longer exist aren't counted
+    _transactionStats.numConcurrentUpdates += numConcurrentUpdates;
 }
 
 void Scene::resetTransitionItems(const Transaction::TransitionResets& transactions) {
@@ -12,6 +12,8 @@
 #ifndef hifi_render_Scene_h
 #define hifi_render_Scene_h
 
+#include <shared/MPSCQueue.h>
+
 #include "Item.h"
 #include "SpatialTree.h"
 #include "Stage.h"
@@ -56,6 +58,12 @@ public:
     void updateItem(ItemID id, const UpdateFunctorPointer& functor);
     void updateItem(ItemID id) { updateItem(id, nullptr); }
 
+    // Same as updateItem, for a func that only touches the payload data it is given.
+    // The scene may apply it on a worker thread, concurrently with the updates of other items.
+    template <class T> void updateItemConcurrently(ItemID id, std::function<void(T&)> func) {
+        updateItem(id, std::make_shared<UpdateFunctor<T>>(func, true));
+    }
+
     // Transition (applied to an item) transactions
     void resetTransitionOnItem(ItemID id, Transition::Type transition, ItemID boundId = render::Item::INVALID_ITEM_ID);
     void removeTransitionFromItem(ItemID id);
@@ -146,10 +154,10 @@ public:
     // THis is the total number of allocated items, this a threadsafe call
     size_t getNumItems() const { return _numAllocatedItems.load(); }
 
-    // Enqueue transaction to the scene
+    // Enqueue transaction to the scene, this is a lock-free and threadsafe call
     void enqueueTransaction(const Transaction& transaction);
 
-    // Enqueue transaction to the scene
+    // Enqueue transaction to the scene, this is a lock-free and threadsafe call
     void enqueueTransaction(Transaction&& transaction);
 
     // Enqueue end of frame transactions boundary
@@ -168,6 +176,16 @@ public:
 
     // This next call are  NOT threadsafe, you have to call them from the correct thread to avoid any potential issues
 
+    // The operations applied by the last processTransactionQueue()
+    struct TransactionStats {
+        uint32_t numFrames { 0 };
+        uint32_t numResets { 0 };
+        uint32_t numRemoves { 0 };
+        uint32_t numUpdates { 0 };
+        uint32_t numConcurrentUpdates { 0 };
+    };
+    const TransactionStats& getTransactionStats() const { return _transactionStats; }
+
     // Access a particular item from its ID
     // WARNING, There is No check on the validity of the ID, so this could return a bad Item
     const Item& getItem(const ItemID& id) const { return _items[id]; }
@@ -199,8 +217,7 @@ protected:
     // Thread safe elements that can be accessed from anywhere
     std::atomic<unsigned int> _IDAllocator{ 1 }; // first valid itemID will be One
     std::atomic<unsigned int> _numAllocatedItems{ 1 }; // num of allocated items, matching the _items.size()
-    std::mutex _transactionQueueMutex;
-    TransactionQueue _transactionQueue;
+    MPSCQueue<Transaction> _transactionQueue;
 
     
     std::mutex _transactionFramesMutex;
@@ -222,6 +239,9 @@ protected:
     void resetTransitionFinishedOperator(const Transaction::TransitionFinishedOperators& transactions);
     void removeItems(const Transaction::Removes& transactions);
     void updateItems(const Transaction::Updates& transactions);
+    void updateItem(const Transaction::Update& update);
+    void updateItemContainers(ItemID id, const ItemKey& oldKey);
+    void updateItemsConcurrently(const Transaction::Updates& transactions);
 
     void resetTransitionItems(const Transaction::TransitionResets& transactions);
     void removeTransitionItems(const Transaction::TransitionRemoves& transactions);
@@ -233,6 +253,8 @@ protected:
 
     void collectSubItems(ItemID parentId, ItemIDs& subItems) const;
 
+    TransactionStats _transactionStats;
+
     // The Selection map
     mutable std::mutex _selectionsMutex; // mutable so it can be used in the thread safe getSelection const method
     SelectionMap _selections;
@@ -10,89 +10,145 @@
 //
 
 #include "SortTask.h"
-#include "ShapePipeline.h"
 
 #include <assert.h>
+#include <string.h>
+
+#include <algorithm>
+#include <array>
+
+#include <TBBHelpers.h>
 #include <ViewFrustum.h>
 
 using namespace render;
 
-struct ItemBoundSort {
-    float _centerDepth = 0.0f;
-    float _nearDepth = 0.0f;
-    float _farDepth = 0.0f;
-    ItemID _id = 0;
-    AABox _bounds;
+uint32_t render::packSortDepth(float distanceSquared, bool frontToBack) {
+    uint32_t depth = 0;
+    if (distanceSquared > 0.0f) {
+        memcpy(&depth, &distanceSquared, sizeof(depth));
+    }
+    return frontToBack ? depth : ~depth;
+}
+
+uint64_t render::packSortKey(const ShapeKey& shapeKey, uint32_t depth) {
+    return ((uint64_t)shapeKey._flags.to_ulong() << SORT_KEY_DEPTH_BITS) | depth;
+}
 
-    ItemBoundSort() {}
-    ItemBoundSort(float centerDepth, float nearDepth, float farDepth, ItemID id, const AABox& bounds) : _centerDepth(centerDepth), _nearDepth(nearDepth), _farDepth(farDepth), _id(id), _bounds(bounds) {}
-};
+// 8 bit digits, sorted least significant first
+const int RADIX_DIGIT_BITS = 8;
+const int RADIX_DIGIT_COUNT = 1 << RADIX_DIGIT_BITS;
+const uint64_t RADIX_DIGIT_MASK = RADIX_DIGIT_COUNT - 1;
+// Each worker counts and scatters its own chunk of keys
+const size_t RADIX_SORT_CHUNK_SIZE = 8192;
 
-struct FrontToBackSort {
-    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) {
-        return (left._centerDepth < right._centerDepth);
+void render::radixSortKeys(ItemSortKeys& keys, int lowBit) {
+    if (keys.size() < 2) {
+        return;
     }
-};
 
-struct BackToFrontSort {
-    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) {
-        return (left._centerDepth > right._centerDepth);
+    // Digits that are the same in every key don't change the order, skip them
+    const uint64_t firstKey = keys.front().key;
+    uint64_t differentBits = 0;
+    for (const auto& key : keys) {
+        differentBits |= key.key ^ firstKey;
     }
-};
+    differentBits = (differentBits >> lowBit) << lowBit;
+    if (differentBits == 0) {
+        return;
+    }
+
+    using Histogram = std::array<uint32_t, RADIX_DIGIT_COUNT>;
+    const size_t numKeys = keys.size();
+    const size_t numChunks = (numKeys + RADIX_SORT_CHUNK_SIZE - 1) / RADIX_SORT_CHUNK_SIZE;
+    std::vector<Histogram> histograms(numChunks);
+    ItemSortKeys buffer(numKeys);
+    ItemSortKeys* source = &keys;
+    ItemSortKeys* destination = &buffer;
+
+    for (int shift = lowBit; shift < 64; shift += RADIX_DIGIT_BITS) {
+        if (((differentBits >> shift) & RADIX_DIGIT_MASK) == 0) {
+            continue;
+        }
+
+        tbb::parallel_for((size_t)0, numChunks, [&](size_t chunk) {
+            auto& histogram = histograms[chunk];
+            histogram.fill(0);
+            const size_t end = std::min(numKeys, (chunk + 1) * RADIX_SORT_CHUNK_SIZE);
+            for (size_t i = chunk * RADIX_SORT_CHUNK_SIZE; i < end; i++) {
+                histogram[((*source)[i].key >> shift) & RADIX_DIGIT_MASK]++;
+            }
+        });
+
+        // Turn the counts into the first slot of every digit of every chunk, chunks in order so the sort is stable
+        uint32_t offset = 0;
+        for (int digit = 0; digit < RADIX_DIGIT_COUNT; digit++) {
+            for (auto& histogram : histograms) {
+                uint32_t count = histogram[digit];
+                histogram[digit] = offset;
+                offset += count;
+            }
+        }
+
+        tbb::parallel_for((size_t)0, numChunks, [&](size_t chunk) {
+            auto& offsets = histograms[chunk];
+            const size_t end = std::min(numKeys, (chunk + 1) * RADIX_SORT_CHUNK_SIZE);
+            for (size_t i = chunk * RADIX_SORT_CHUNK_SIZE; i < end; i++) {
+                const auto& key = (*source)[i];
+                (*destination)[offsets[(key.key >> shift) & RADIX_DIGIT_MASK]++] = key;
+            }
+        });
+
+        std::swap(source, destination);
+    }
+
+    if (source != &keys) {
+        keys.swap(buffer);
+    }
+}
 
 void render::depthSortItems(const RenderContextPointer& renderContext, bool frontToBack, 
                             const ItemBounds& inItems, ItemBounds& outItems, AABox* bounds) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
 
-    auto& scene = renderContext->_scene;
     RenderArgs* args = renderContext->args;
-
+    const ViewFrustum& frustum = args->getViewFrustum();
 
     // Allocate and simply copy
     outItems.clear();
     outItems.reserve(inItems.size());
 
-
-    // Make a local dataset of the center distance and closest point distance
-    std::vector<ItemBoundSort> itemBoundSorts;
-    itemBoundSorts.reserve(outItems.size());
-
-    for (auto itemDetails : inItems) {
-        auto item = scene->getItem(itemDetails.id);
-        auto bound = itemDetails.bound; // item.getBound();
-        float distanceSquared = args->getViewFrustum().distanceToCameraSquared(bound.calcCenter());
-
-        itemBoundSorts.emplace_back(ItemBoundSort(distanceSquared, distanceSquared, distanceSquared, itemDetails.id, bound));
+    // Make a local dataset of the center distance keys
+    ItemSortKeys keys;
+    keys.resize(inItems.size());
+    for (size_t i = 0; i < inItems.size(); i++) {
+        float distanceSquared = frustum.distanceToCameraSquared(inItems[i].bound.calcCenter());
+        keys[i] = { packSortDepth(distanceSquared, frontToBack), (uint32_t)i };
     }
 
     // sort against Z
-    if (frontToBack) {
-        FrontToBackSort frontToBackSort;
-        std::sort(itemBoundSorts.begin(), itemBoundSorts.end(), frontToBackSort);
-    } else {
-        BackToFrontSort  backToFrontSort;
-        std::sort(itemBoundSorts.begin(), itemBoundSorts.end(), backToFrontSort);
-    }
+    radixSortKeys(keys);
 
     // Finally once sorted result to a list of itemID and keep uniques
     render::ItemID previousID = Item::INVALID_ITEM_ID;
     if (!bounds) {
-        for (auto& item : itemBoundSorts) {
-            if (item._id != previousID) {
-                outItems.emplace_back(ItemBound(item._id, item._bounds));
-                previousID = item._id;
+        for (const auto& key : keys) {
+            const auto& item = inItems[key.index];
+            if (item.id != previousID) {
+                outItems.emplace_back(item);
+                previousID = item.id;
             }
         }
-    } else if (!itemBoundSorts.empty()) {
+    } else if (!keys.empty()) {
         if (bounds->isNull()) {
-            *bounds = itemBoundSorts.front()._bounds;
+            *bounds = inItems[keys.front().index].bound;
         }
-        for (auto& item : itemBoundSorts) {
-            if (item._id != previousID) {
-                outItems.emplace_back(ItemBound(item._id, item._bounds));
-                previousID = item._id;
-                *bounds += item._bounds;
+        for (const auto& key : keys) {
+            const auto& item = inItems[key.index];
+            if (item.id != previousID) {
+                outItems.emplace_back(item);
+                previousID = item.id;
+                *bounds += item.bound;
             }
         }
     }
@@ -102,55 +158,67 @@ void PipelineSortShapes::run(const RenderContextPointer& renderContext, const It
     auto& scene = renderContext->_scene;
     outShapes.clear();
 
-    for (const auto& item : inItems) {
-        auto key = scene->getItem(item.id).getShapeKey();
-        auto outItems = outShapes.find(key);
-        if (outItems == outShapes.end()) {
-            outItems = outShapes.insert(std::make_pair(key, ItemBounds{})).first;
-            outItems->second.reserve(inItems.size());
-        }
-
-        outItems->second.push_back(item);
+    // The sort is stable, so the items of a pipeline keep their incoming order
+    ItemSortKeys keys;
+    keys.resize(inItems.size());
+    for (size_t i = 0; i < inItems.size(); i++) {
+        keys[i] = { packSortKey(scene->getItem(inItems[i].id).getShapeKey(), 0), (uint32_t)i };
     }
+    radixSortKeys(keys, SORT_KEY_DEPTH_BITS);
+
+    // Each run of equal pipelines becomes one bucket
+    size_t begin = 0;
+    while (begin < keys.size()) {
+        const uint64_t pipeline = keys[begin].key >> SORT_KEY_DEPTH_BITS;
+        size_t end = begin + 1;
+        while (end < keys.size() && (keys[end].key >> SORT_KEY_DEPTH_BITS) == pipeline) {
+            end++;
+        }
 
-    for (auto& items : outShapes) {
-        items.second.shrink_to_fit();
+        auto& outItems = outShapes[ShapeKey(ShapeKey::Flags(pipeline))];
+        outItems.reserve(outItems.size() + (end - begin));
+        for (size_t i = begin; i < end; i++) {
+            outItems.push_back(inItems[keys[i].index]);
+        }
+        begin = end;
     }
 }
 
-void DepthSortShapes::run(const RenderContextPointer& renderContext, const ShapeBounds& inShapes, ShapeBounds& outShapes) {
+// Sorts every pipeline of the shapes on its own worker
+static void depthSortShapes(const RenderContextPointer& renderContext, bool frontToBack,
+                            const ShapeBounds& inShapes, ShapeBounds& outShapes, std::vector<AABox>* bounds) {
     outShapes.clear();
     outShapes.reserve(inShapes.size());
 
+    // Create the buckets first, the map can't be modified from the workers
+    std::vector<std::pair<const ItemBounds*, ItemBounds*>> pipelines;
+    pipelines.reserve(inShapes.size());
     for (auto& pipeline : inShapes) {
-        auto& inItems = pipeline.second;
-        auto outItems = outShapes.find(pipeline.first);
-        if (outItems == outShapes.end()) {
-            outItems = outShapes.insert(std::make_pair(pipeline.first, ItemBounds{})).first;
-        }
-
-        depthSortItems(renderContext, _frontToBack, inItems, outItems->second);
+        pipelines.emplace_back(&pipeline.second, &outShapes[pipeline.first]);
+    }
+    if (bounds) {
+        bounds->assign(pipelines.size(), AABox());
     }
+
+    tbb::parallel_for((size_t)0, pipelines.size(), [&](size_t i) {
+        depthSortItems(renderContext, frontToBack, *pipelines[i].first, *pipelines[i].second, bounds ? &(*bounds)[i] : nullptr);
+    });
+}
+
+void DepthSortShapes::run(const RenderContextPointer& renderContext, const ShapeBounds& inShapes, ShapeBounds& outShapes) {
+    depthSortShapes(renderContext, _frontToBack, inShapes, outShapes, nullptr);
 }
 
 void DepthSortShapesAndComputeBounds::run(const RenderContextPointer& renderContext, const ShapeBounds& inShapes, Outputs& outputs) {
     auto& outShapes = outputs.edit0();
     auto& outBounds = outputs.edit1();
 
-    outShapes.clear();
-    outShapes.reserve(inShapes.size());
-    outBounds = AABox();
+    std::vector<AABox> bounds;
+    depthSortShapes(renderContext, _frontToBack, inShapes, outShapes, &bounds);
 
-    for (auto& pipeline : inShapes) {
-        auto& inItems = pipeline.second;
-        auto outItems = outShapes.find(pipeline.first);
-        if (outItems == outShapes.end()) {
-            outItems = outShapes.insert(std::make_pair(pipeline.first, ItemBounds{})).first;
-        }
-        AABox bounds;
-
-        depthSortItems(renderContext, _frontToBack, inItems, outItems->second, &bounds);
-        outBounds += bounds;
+    outBounds = AABox();
+    for (const auto& shapeBounds : bounds) {
+        outBounds += shapeBounds;
     }
 }
 
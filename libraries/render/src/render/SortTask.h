@@ -13,8 +13,27 @@
 #define hifi_render_SortTask_h
 
 #include "Engine.h"
+#include "ShapePipeline.h"
 
 namespace render {
+    // Packed sort key: the ShapeKey flags in the high word and the depth (or any other 32 bit order) in the low word,
+    // next to the index of the item it sorts
+    struct ItemSortKey {
+        uint64_t key;
+        uint32_t index;
+    };
+    using ItemSortKeys = std::vector<ItemSortKey>;
+
+    const int SORT_KEY_DEPTH_BITS = 32;
+
+    // The bits of a positive float order like the float, so the squared distance is turned into a key without
+    // any conversion.  Back to front simply inverts them.
+    uint32_t packSortDepth(float distanceSquared, bool frontToBack);
+    uint64_t packSortKey(const ShapeKey& shapeKey, uint32_t depth);
+
+    // Stable sort of the keys on bits [lowBit, 63] with a radix sort, the chunks of every pass run on worker threads
+    void radixSortKeys(ItemSortKeys& keys, int lowBit = 0);
+
     void depthSortItems(const RenderContextPointer& renderContext, bool frontToBack, const ItemBounds& inItems, ItemBounds& outItems, AABox* bounds = nullptr);
 
     class PipelineSortShapes {
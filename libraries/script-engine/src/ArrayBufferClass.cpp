@@ -174,6 +174,12 @@ void ArrayBufferClass::fromScriptValue(const QScriptValue& object, QByteArray& b
         // ArrayBuffer instance (or any JS class that supports coercion into QByteArray*)
         if (QByteArray* buffer = qscriptvalue_cast<QByteArray*>(object.data())) {
             byteArray = *buffer;
+        } else if (QByteArray* viewBuffer = qscriptvalue_cast<QByteArray*>(object.property(BUFFER_PROPERTY_NAME).data())) {
+            // TypedArray or DataView, only the viewed range of its buffer
+            quint32 byteOffset = object.property(BYTE_OFFSET_PROPERTY_NAME).toUInt32();
+            quint32 byteLength = object.property(BYTE_LENGTH_PROPERTY_NAME).toUInt32();
+            byteArray = (byteOffset == 0 && byteLength == (quint32)viewBuffer->size()) ?
+                *viewBuffer : viewBuffer->mid(byteOffset, byteLength);
         }
     }
 }
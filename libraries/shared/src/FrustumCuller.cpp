@@ -0,0 +1,151 @@
+//
+//  FrustumCuller.cpp
+//  libraries/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FrustumCuller.h"
+
+#include <algorithm>
+
+static void testFrustumPlanes_ref(const float* const* x, const float* const* y, const float* const* z,
+                                  const float (*planes)[4], uint8_t* inside, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+        bool isInside = true;
+        for (int p = 0; p < NUM_FRUSTUM_PLANES; p++) {
+            float distance = planes[p][0] * x[p][i] + planes[p][1] * y[p][i] + planes[p][2] * z[p][i] + planes[p][3];
+            isInside &= !(distance < 0.0f);
+        }
+        inside[i] = (uint8_t)isInside;
+    }
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+//
+// Runtime CPU dispatch
+//
+// The AVX2 kernel processes blocks of 8 boxes and returns how many it processed.
+// The reference code finishes the tail.
+//
+#include "CPUDetect.h"
+
+int testFrustumPlanes_AVX2(const float* const* x, const float* const* y, const float* const* z,
+                           const float (*planes)[4], uint8_t* inside, int size);
+
+static void testFrustumPlanes(const float* const* x, const float* const* y, const float* const* z,
+                              const float (*planes)[4], uint8_t* inside, size_t size) {
+    static bool _cpuSupportsAVX2 = cpuSupportsAVX2();
+    size_t i = 0;
+    if (_cpuSupportsAVX2) {
+        i = testFrustumPlanes_AVX2(x, y, z, planes, inside, (int)size);
+    }
+    testFrustumPlanes_ref(x, y, z, planes, inside, i, size);
+}
+
+#else   // portable reference code
+
+static void testFrustumPlanes(const float* const* x, const float* const* y, const float* const* z,
+                              const float (*planes)[4], uint8_t* inside, size_t size) {
+    testFrustumPlanes_ref(x, y, z, planes, inside, 0, size);
+}
+
+#endif
+
+void FrustumCuller::Boxes::clear() {
+    minX.clear();
+    minY.clear();
+    minZ.clear();
+    maxX.clear();
+    maxY.clear();
+    maxZ.clear();
+}
+
+void FrustumCuller::Boxes::reserve(size_t size) {
+    minX.reserve(size);
+    minY.reserve(size);
+    minZ.reserve(size);
+    maxX.reserve(size);
+    maxY.reserve(size);
+    maxZ.reserve(size);
+}
+
+void FrustumCuller::Boxes::push_back(const AABox& box) {
+    const glm::vec3& corner = box.getCorner();
+    const glm::vec3& scale = box.getScale();
+    minX.push_back(corner.x);
+    minY.push_back(corner.y);
+    minZ.push_back(corner.z);
+    maxX.push_back(corner.x + scale.x);
+    maxY.push_back(corner.y + scale.y);
+    maxZ.push_back(corner.z + scale.z);
+}
+
+static void copyPlanes(const ViewFrustum& frustum, float (*planes)[4]) {
+    const ::Plane* frustumPlanes = frustum.getPlanes();
+    for (int p = 0; p < NUM_FRUSTUM_PLANES; p++) {
+        const glm::vec3& normal = frustumPlanes[p].getNormal();
+        planes[p][0] = normal.x;
+        planes[p][1] = normal.y;
+        planes[p][2] = normal.z;
+        planes[p][3] = frustumPlanes[p].getDCoefficient();
+    }
+}
+
+FrustumCuller::ViewMask FrustumCuller::addView(const ViewFrustum& frustum, const ViewFrustum* antiFrustum) {
+    if (_views.size() >= MAX_VIEWS) {
+        return 0;
+    }
+    View view;
+    copyPlanes(frustum, view.planes);
+    if (antiFrustum) {
+        copyPlanes(*antiFrustum, view.antiPlanes);
+        view.hasAntiFrustum = true;
+    }
+    _views.push_back(view);
+    return (ViewMask)(1 << (_views.size() - 1));
+}
+
+// Same as ViewFrustum::boxIntersectsFrustum() (farthest vertex) and ViewFrustum::boxInsideFrustum() (nearest vertex)
+static void testBoxes(const FrustumCuller::Boxes& boxes, size_t begin, size_t size, const float (*planes)[4],
+                      bool farthest, uint8_t* inside) {
+    const float* x[NUM_FRUSTUM_PLANES];
+    const float* y[NUM_FRUSTUM_PLANES];
+    const float* z[NUM_FRUSTUM_PLANES];
+    for (int p = 0; p < NUM_FRUSTUM_PLANES; p++) {
+        x[p] = &((planes[p][0] > 0.0f) == farthest ? boxes.maxX : boxes.minX)[begin];
+        y[p] = &((planes[p][1] > 0.0f) == farthest ? boxes.maxY : boxes.minY)[begin];
+        z[p] = &((planes[p][2] > 0.0f) == farthest ? boxes.maxZ : boxes.minZ)[begin];
+    }
+    testFrustumPlanes(x, y, z, planes, inside, size);
+}
+
+void FrustumCuller::cull(const Boxes& boxes, size_t begin, size_t end, ViewMask* masks) const {
+    size_t size = end - begin;
+    std::fill(masks, masks + size, 0);
+    if (size == 0) {
+        return;
+    }
+
+    std::vector<uint8_t> intersects(size);
+    std::vector<uint8_t> antiInside;
+    for (size_t v = 0; v < _views.size(); v++) {
+        const View& view = _views[v];
+        ViewMask bit = (ViewMask)(1 << v);
+        testBoxes(boxes, begin, size, view.planes, true, intersects.data());
+        if (view.hasAntiFrustum) {
+            antiInside.resize(size);
+            testBoxes(boxes, begin, size, view.antiPlanes, false, antiInside.data());
+            for (size_t i = 0; i < size; i++) {
+                masks[i] |= (intersects[i] & ~antiInside[i] & 1) * bit;
+            }
+        } else {
+            for (size_t i = 0; i < size; i++) {
+                masks[i] |= intersects[i] * bit;
+            }
+        }
+    }
+}
@@ -0,0 +1,58 @@
+//
+//  FrustumCuller.h
+//  libraries/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FrustumCuller_h
+#define hifi_FrustumCuller_h
+
+#include <stdint.h>
+#include <vector>
+
+#include "AABox.h"
+#include "ViewFrustum.h"
+
+// Tests many boxes against several view frustums in one pass.  The boxes are stored as a structure of arrays,
+// so each plane test runs as a straight SIMD loop.  Every box gets a mask with one bit per view.
+class FrustumCuller {
+public:
+    using ViewMask = uint8_t;
+    static const int MAX_VIEWS = 8 * sizeof(ViewMask);
+
+    class Boxes {
+    public:
+        size_t size() const { return minX.size(); }
+        void clear();
+        void reserve(size_t size);
+        void push_back(const AABox& box);
+
+        std::vector<float> minX, minY, minZ;
+        std::vector<float> maxX, maxY, maxZ;
+    };
+
+    void clear() { _views.clear(); }
+    int getNumViews() const { return (int)_views.size(); }
+
+    // A box is visible in a view when it intersects the view frustum and, if there is an anti frustum,
+    // isn't completely inside the anti frustum.  Returns the bit of the view, or 0 when MAX_VIEWS are in use.
+    ViewMask addView(const ViewFrustum& frustum, const ViewFrustum* antiFrustum = nullptr);
+
+    // Writes the masks of boxes [begin, end) to masks[0, end - begin)
+    void cull(const Boxes& boxes, size_t begin, size_t end, ViewMask* masks) const;
+
+private:
+    struct View {
+        float planes[NUM_FRUSTUM_PLANES][4];
+        float antiPlanes[NUM_FRUSTUM_PLANES][4];
+        bool hasAntiFrustum { false };
+    };
+
+    std::vector<View> _views;
+};
+
+#endif // hifi_FrustumCuller_h
@@ -0,0 +1,173 @@
+//
+//  ParticleSimulation.cpp
+//  libraries/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ParticleSimulation.h"
+
+#include <algorithm>
+
+static void integrateAxis_ref(float* position, float* velocity, const float* acceleration, float deltaTime, size_t size) {
+    const float halfDeltaTimeSquared = 0.5f * deltaTime * deltaTime;
+    for (size_t i = 0; i < size; ++i) {
+        position[i] += velocity[i] * deltaTime + acceleration[i] * halfDeltaTimeSquared;
+        velocity[i] += acceleration[i] * deltaTime;
+    }
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+//
+// Runtime CPU dispatch
+//
+// The AVX2 kernel processes blocks of 8 particles and returns how many it processed.
+// The reference code finishes the tail.
+//
+#include "CPUDetect.h"
+
+int integrateParticles_AVX2(float* position, float* velocity, const float* acceleration, float deltaTime, int size);
+
+static void integrateAxis(float* position, float* velocity, const float* acceleration, float deltaTime, size_t size) {
+    static bool _cpuSupportsAVX2 = cpuSupportsAVX2();
+    size_t i = 0;
+    if (_cpuSupportsAVX2) {
+        i = integrateParticles_AVX2(position, velocity, acceleration, deltaTime, (int)size);
+    }
+    integrateAxis_ref(position + i, velocity + i, acceleration + i, deltaTime, size - i);
+}
+
+#else   // portable reference code
+
+static void integrateAxis(float* position, float* velocity, const float* acceleration, float deltaTime, size_t size) {
+    integrateAxis_ref(position, velocity, acceleration, deltaTime, size);
+}
+
+#endif
+
+void ParticleSimulation::Vec3Array::erase(size_t count) {
+    x.erase(x.begin(), x.begin() + count);
+    y.erase(y.begin(), y.begin() + count);
+    z.erase(z.begin(), z.begin() + count);
+}
+
+void ParticleSimulation::clear() {
+    _begin = 0;
+    _seed.clear();
+    _expiration.clear();
+    _lifetime.clear();
+    _basePosition.clear();
+    _relativePosition.clear();
+    _velocity.clear();
+    _acceleration.clear();
+}
+
+void ParticleSimulation::add(const Particle& particle) {
+    _seed.push_back(particle.seed);
+    _expiration.push_back(particle.expiration);
+    _lifetime.push_back(particle.lifetime);
+    _basePosition.push_back(particle.basePosition);
+    _relativePosition.push_back(particle.relativePosition);
+    _velocity.push_back(particle.velocity);
+    _acceleration.push_back(particle.acceleration);
+}
+
+ParticleSimulation::Particle ParticleSimulation::get(size_t index) const {
+    size_t i = _begin + index;
+    Particle particle;
+    particle.seed = _seed[i];
+    particle.expiration = _expiration[i];
+    particle.lifetime = _lifetime[i];
+    particle.basePosition = _basePosition.at(i);
+    particle.relativePosition = _relativePosition.at(i);
+    particle.velocity = _velocity.at(i);
+    particle.acceleration = _acceleration.at(i);
+    return particle;
+}
+
+void ParticleSimulation::expire(uint64_t now, size_t maxParticles) {
+    size_t end = _seed.size();
+    if (size() > maxParticles) {
+        _begin = end - maxParticles;
+    }
+    while (_begin < end && _expiration[_begin] <= now) {
+        ++_begin;
+    }
+    compact();
+}
+
+void ParticleSimulation::compact() {
+    if (_begin == 0) {
+        return;
+    }
+    if (_begin == _seed.size()) {
+        clear();
+        return;
+    }
+    // erasing shifts every array, so only do it once the dead front outweighs the live particles
+    if (_begin < size()) {
+        return;
+    }
+    _seed.erase(_seed.begin(), _seed.begin() + _begin);
+    _expiration.erase(_expiration.begin(), _expiration.begin() + _begin);
+    _lifetime.erase(_lifetime.begin(), _lifetime.begin() + _begin);
+    _basePosition.erase(_begin);
+    _relativePosition.erase(_begin);
+    _velocity.erase(_begin);
+    _acceleration.erase(_begin);
+    _begin = 0;
+}
+
+void ParticleSimulation::rebase(const glm::vec3& basePosition, bool wasTrailing) {
+    size_t end = _seed.size();
+    if (wasTrailing) {
+        for (size_t i = _begin; i < end; ++i) {
+            _relativePosition.x[i] += _basePosition.x[i] - basePosition.x;
+            _relativePosition.y[i] += _basePosition.y[i] - basePosition.y;
+            _relativePosition.z[i] += _basePosition.z[i] - basePosition.z;
+        }
+    }
+    std::fill(_basePosition.x.begin() + _begin, _basePosition.x.end(), basePosition.x);
+    std::fill(_basePosition.y.begin() + _begin, _basePosition.y.end(), basePosition.y);
+    std::fill(_basePosition.z.begin() + _begin, _basePosition.z.end(), basePosition.z);
+}
+
+void ParticleSimulation::integrate(float deltaTime) {
+    size_t count = size();
+    if (count == 0) {
+        return;
+    }
+    integrateAxis(&_relativePosition.x[_begin], &_velocity.x[_begin], &_acceleration.x[_begin], deltaTime, count);
+    integrateAxis(&_relativePosition.y[_begin], &_velocity.y[_begin], &_acceleration.y[_begin], deltaTime, count);
+    integrateAxis(&_relativePosition.z[_begin], &_velocity.z[_begin], &_acceleration.z[_begin], deltaTime, count);
+
+    float* lifetime = &_lifetime[_begin];
+    for (size_t i = 0; i < count; ++i) {
+        lifetime[i] += deltaTime;
+    }
+}
+
+void ParticleSimulation::writeInstances(const glm::vec3& emitterPosition, bool trailing, Instances& instances) const {
+    size_t count = size();
+    instances.resize(count);
+    Instance* out = instances.data();
+    size_t end = _seed.size();
+    if (trailing) {
+        for (size_t i = _begin; i < end; ++i, ++out) {
+            out->xyz = glm::vec3(_relativePosition.x[i] + _basePosition.x[i],
+                                 _relativePosition.y[i] + _basePosition.y[i],
+                                 _relativePosition.z[i] + _basePosition.z[i]);
+            out->uv = glm::vec2(_lifetime[i], _seed[i]);
+        }
+    } else {
+        for (size_t i = _begin; i < end; ++i, ++out) {
+            out->xyz = glm::vec3(_relativePosition.x[i] + emitterPosition.x,
+                                 _relativePosition.y[i] + emitterPosition.y,
+                                 _relativePosition.z[i] + emitterPosition.z);
+            out->uv = glm::vec2(_lifetime[i], _seed[i]);
+        }
+    }
+}
@@ -0,0 +1,89 @@
+//
+//  ParticleSimulation.h
+//  libraries/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ParticleSimulation_h
+#define hifi_ParticleSimulation_h
+
+#include <stdint.h>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// The CPU side of a particle emitter, stored as a structure of arrays so the per frame integration
+// runs as straight SIMD loops over each component.  Particles are kept in emission order: the oldest
+// particle is always at index 0, which is what lets expire() only look at the front.
+// Color, alpha, radius and spin are interpolated by the particle shader from the lifetime and seed,
+// so the simulation only needs to advance positions.
+class ParticleSimulation {
+public:
+    struct Particle {
+        float seed { 0.0f };
+        uint64_t expiration { 0 };
+        float lifetime { 0.0f };
+        glm::vec3 basePosition;
+        glm::vec3 relativePosition;
+        glm::vec3 velocity;
+        glm::vec3 acceleration;
+    };
+
+    // Per instance vertex data consumed by the particle shader
+    struct Instance {
+        Instance() {}
+        Instance(const glm::vec3& xyzIn, const glm::vec2& uvIn) : xyz(xyzIn), uv(uvIn) {}
+        glm::vec3 xyz; // Position
+        glm::vec2 uv; // Lifetime + seed
+    };
+    using Instances = std::vector<Instance>;
+
+    size_t size() const { return _seed.size() - _begin; }
+    bool empty() const { return size() == 0; }
+    void clear();
+
+    void add(const Particle& particle);
+    Particle get(size_t index) const;
+
+    // Drop the oldest particles past maxParticles, then every particle at the front that has expired by now
+    void expire(uint64_t now, size_t maxParticles);
+
+    // Move every particle onto a new base position, when the emitter switches its shouldTrail mode.
+    // Particles that were trailing keep their world position.
+    void rebase(const glm::vec3& basePosition, bool wasTrailing);
+
+    void integrate(float deltaTime);
+
+    // Trailing particles are positioned relative to where they were emitted, others relative to the emitter
+    void writeInstances(const glm::vec3& emitterPosition, bool trailing, Instances& instances) const;
+
+private:
+    void compact();
+
+    struct Vec3Array {
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> z;
+
+        void push_back(const glm::vec3& v) { x.push_back(v.x); y.push_back(v.y); z.push_back(v.z); }
+        glm::vec3 at(size_t i) const { return glm::vec3(x[i], y[i], z[i]); }
+        void erase(size_t count);
+        void clear() { x.clear(); y.clear(); z.clear(); }
+    };
+
+    // Expired particles are skipped by advancing _begin and only erased once they make up half the arrays
+    size_t _begin { 0 };
+    std::vector<float> _seed;
+    std::vector<uint64_t> _expiration;
+    std::vector<float> _lifetime;
+    Vec3Array _basePosition;
+    Vec3Array _relativePosition;
+    Vec3Array _velocity;
+    Vec3Array _acceleration;
+};
+
+#endif // hifi_ParticleSimulation_h
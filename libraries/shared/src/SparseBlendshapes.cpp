@@ -0,0 +1,107 @@
+//
+//  SparseBlendshapes.cpp
+//  libraries/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SparseBlendshapes.h"
+
+#include <algorithm>
+
+using Offset = float[SparseBlendshapes::OFFSET_SIZE];
+
+static void accumulateBlendshapeOffsets_ref(Offset* offsets, const int* slots, const Offset* deltas, float coefficient, int size) {
+    for (int i = 0; i < size; ++i) {
+        float* offset = offsets[slots[i]];
+        for (int j = 0; j < SparseBlendshapes::OFFSET_SIZE; ++j) {
+            offset[j] += deltas[i][j] * coefficient;
+        }
+    }
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+//
+// Runtime CPU dispatch
+//
+#include "CPUDetect.h"
+
+int accumulateBlendshapeOffsets_AVX2(float (*offsets)[9], const int* slots, const float (*deltas)[9], float coefficient, int size);
+
+static void accumulateBlendshapeOffsets(Offset* offsets, const int* slots, const Offset* deltas, float coefficient, int size) {
+    static bool _cpuSupportsAVX2 = cpuSupportsAVX2();
+    int i = 0;
+    if (_cpuSupportsAVX2) {
+        i = accumulateBlendshapeOffsets_AVX2(offsets, slots, deltas, coefficient, size);
+    }
+    accumulateBlendshapeOffsets_ref(offsets, slots + i, deltas + i, coefficient, size - i);
+}
+
+#else   // portable reference code
+static auto& accumulateBlendshapeOffsets = accumulateBlendshapeOffsets_ref;
+#endif
+
+void SparseBlendshapes::addBlendshape(const int* indices, const glm::vec3* positions, const glm::vec3* normals,
+                                      const glm::vec3* tangents, int numTangents, int size, float normalScale) {
+    Blendshape blendshape;
+    blendshape.slots.reserve(size);
+    blendshape.deltas.reserve(size * OFFSET_SIZE);
+    for (int i = 0; i < size; ++i) {
+        if (indices[i] < 0 || indices[i] >= _numVertices) {
+            continue;
+        }
+        glm::vec3 normal = normals[i] * normalScale;
+        glm::vec3 tangent = (i < numTangents) ? tangents[i] * normalScale : glm::vec3(0.0f);
+        blendshape.slots.push_back(indices[i]);
+        blendshape.deltas.insert(blendshape.deltas.end(), {
+            positions[i].x, positions[i].y, positions[i].z,
+            normal.x, normal.y, normal.z,
+            tangent.x, tangent.y, tangent.z
+        });
+    }
+    _blendshapes.push_back(std::move(blendshape));
+}
+
+void SparseBlendshapes::finish() {
+    _activeVertices.clear();
+    for (const auto& blendshape : _blendshapes) {
+        _activeVertices.insert(_activeVertices.end(), blendshape.slots.begin(), blendshape.slots.end());
+    }
+    std::sort(_activeVertices.begin(), _activeVertices.end());
+    _activeVertices.erase(std::unique(_activeVertices.begin(), _activeVertices.end()), _activeVertices.end());
+
+    std::vector<int> vertexToSlot(_numVertices, -1);
+    for (int slot = 0; slot < (int)_activeVertices.size(); ++slot) {
+        vertexToSlot[_activeVertices[slot]] = slot;
+    }
+    for (auto& blendshape : _blendshapes) {
+        for (auto& slot : blendshape.slots) {
+            slot = vertexToSlot[slot];
+        }
+    }
+}
+
+void SparseBlendshapes::blend(const float* coefficients, int numCoefficients, float (*offsets)[OFFSET_SIZE]) const {
+    for (int i = 0, n = std::min(numCoefficients, (int)_blendshapes.size()); i < n; ++i) {
+        float coefficient = coefficients[i];
+        const float EPSILON = 0.0001f;
+        if (coefficient < EPSILON) {
+            continue;
+        }
+        const auto& blendshape = _blendshapes[i];
+        accumulateBlendshapeOffsets(offsets, blendshape.slots.data(), (const Offset*)blendshape.deltas.data(),
+                                    coefficient, (int)blendshape.slots.size());
+    }
+}
+
+void SparseBlendshapes::scatter(const uint32_t (*packedActive)[4], const uint32_t (&packedZero)[4], uint32_t (*packed)[4]) const {
+    for (int i = 0; i < _numVertices; ++i) {
+        std::copy(packedZero, packedZero + 4, packed[i]);
+    }
+    for (int slot = 0; slot < (int)_activeVertices.size(); ++slot) {
+        std::copy(packedActive[slot], packedActive[slot] + 4, packed[_activeVertices[slot]]);
+    }
+}
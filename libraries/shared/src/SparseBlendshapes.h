@@ -0,0 +1,61 @@
+//
+//  SparseBlendshapes.h
+//  libraries/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SparseBlendshapes_h
+#define hifi_SparseBlendshapes_h
+
+#include <stdint.h>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// The blendshapes of one mesh, laid out to be evaluated over only the vertices some blendshape moves.
+// Those vertices are numbered by compact slots, and each blendshape keeps a slot and a float[9] delta
+// (position, normal and tangent offsets, the layout of BlendshapeOffsetUnpacked) per vertex it moves,
+// so a blend is a run of multiply-adds into a slot sized buffer that can then be packed in one go.
+class SparseBlendshapes {
+public:
+    static const int OFFSET_SIZE = 9;
+
+    SparseBlendshapes(int numVertices = 0) : _numVertices(numVertices) {}
+
+    // normalScale is folded into the normal and tangent deltas, only the first numTangents entries have a tangent
+    void addBlendshape(const int* indices, const glm::vec3* positions, const glm::vec3* normals,
+                       const glm::vec3* tangents, int numTangents, int size, float normalScale);
+
+    // assigns the slots, call once after the last addBlendshape
+    void finish();
+
+    int getNumVertices() const { return _numVertices; }
+    int getNumBlendshapes() const { return (int)_blendshapes.size(); }
+
+    // the mesh vertex of each slot, in increasing order
+    const std::vector<int>& getActiveVertices() const { return _activeVertices; }
+
+    // Sums the weighted offsets of the blendshapes into offsets, which must hold getActiveVertices().size()
+    // zeroed entries.  Coefficients too small to matter are skipped.
+    void blend(const float* coefficients, int numCoefficients, float (*offsets)[OFFSET_SIZE]) const;
+
+    // Writes the packed offset of each slot to the mesh vertex of that slot and packedZero to every other vertex,
+    // so packed ends up with getNumVertices() entries laid out as if every vertex had been blended
+    void scatter(const uint32_t (*packedActive)[4], const uint32_t (&packedZero)[4], uint32_t (*packed)[4]) const;
+
+private:
+    struct Blendshape {
+        std::vector<int> slots; // mesh vertex indices until finish()
+        std::vector<float> deltas; // OFFSET_SIZE per slot
+    };
+
+    int _numVertices;
+    std::vector<int> _activeVertices;
+    std::vector<Blendshape> _blendshapes;
+};
+
+#endif // hifi_SparseBlendshapes_h
@@ -511,6 +511,7 @@ void SpatiallyNestable::setWorldTransform(const glm::vec3& position, const glm::
             }
             if (changed) {
                 Transform::inverseMult(_transform, parentTransform, myWorldTransform);
+                publishLocalTransform();
                 _translationChanged = usecTimestampNow();
             }
         });
@@ -555,6 +556,7 @@ void SpatiallyNestable::setWorldPosition(const glm::vec3& position, bool& succes
             changed = true;
             myWorldTransform.setTranslation(position);
             Transform::inverseMult(_transform, parentTransform, myWorldTransform);
+            publishLocalTransform();
             _translationChanged = usecTimestampNow();
         }
     });
@@ -608,6 +610,7 @@ void SpatiallyNestable::setWorldOrientation(const glm::quat& orientation, bool&
             changed = true;
             myWorldTransform.setRotation(orientation);
             Transform::inverseMult(_transform, parentTransform, myWorldTransform);
+            publishLocalTransform();
             _rotationChanged = usecTimestampNow();
         }
     });
@@ -636,10 +639,8 @@ glm::vec3 SpatiallyNestable::getWorldVelocity(bool& success) const {
     if (!success) {
         return result;
     }
-    _velocityLock.withReadLock([&] {
-        // TODO: take parent angularVelocity into account.
-        result = parentVelocity + parentTransform.getRotation() * _velocity;
-    });
+    // TODO: take parent angularVelocity into account.
+    result = parentVelocity + parentTransform.getRotation() * _localState.get().velocity;
     return result;
 }
 
@@ -655,19 +656,19 @@ glm::vec3 SpatiallyNestable::getWorldVelocity() const {
 void SpatiallyNestable::setWorldVelocity(const glm::vec3& velocity, bool& success) {
     glm::vec3 parentVelocity = getParentVelocity(success);
     Transform parentTransform = getParentTransform(success);
-    _velocityLock.withWriteLock([&] {
-        // HACK: until we are treating _velocity the same way we treat _position (meaning,
-        // _velocity is a vs parent value and any request for a world-frame velocity must
-        // be computed), do this to avoid equipped (parenting-grabbed) things from drifting.
-        // turning a zero velocity into a non-zero _velocity (because the avatar is moving)
-        // causes EntityItem::stepKinematicMotion to have an effect on the equipped entity,
-        // which causes it to drift from the hand.
-        if (hasAncestorOfType(NestableType::Avatar)) {
-            _velocity = velocity;
-        } else {
-            // TODO: take parent angularVelocity into account.
-            _velocity = glm::inverse(parentTransform.getRotation()) * (velocity - parentVelocity);
-        }
+    // HACK: until we are treating velocity the same way we treat position (meaning,
+    // velocity is a vs parent value and any request for a world-frame velocity must
+    // be computed), do this to avoid equipped (parenting-grabbed) things from drifting.
+    // turning a zero velocity into a non-zero local velocity (because the avatar is moving)
+    // causes EntityItem::stepKinematicMotion to have an effect on the equipped entity,
+    // which causes it to drift from the hand.
+    glm::vec3 localVelocity = velocity;
+    if (!hasAncestorOfType(NestableType::Avatar)) {
+        // TODO: take parent angularVelocity into account.
+        localVelocity = glm::inverse(parentTransform.getRotation()) * (velocity - parentVelocity);
+    }
+    _localState.update([&](LocalSpatialState& state) {
+        state.velocity = localVelocity;
     });
 }
 
@@ -701,9 +702,7 @@ glm::vec3 SpatiallyNestable::getWorldAngularVelocity(bool& success) const {
     if (!success) {
         return result;
     }
-    _angularVelocityLock.withReadLock([&] {
-        result = parentAngularVelocity + parentTransform.getRotation() * _angularVelocity;
-    });
+    result = parentAngularVelocity + parentTransform.getRotation() * _localState.get().angularVelocity;
     return result;
 }
 
@@ -719,8 +718,9 @@ glm::vec3 SpatiallyNestable::getWorldAngularVelocity() const {
 void SpatiallyNestable::setWorldAngularVelocity(const glm::vec3& angularVelocity, bool& success) {
     glm::vec3 parentAngularVelocity = getParentAngularVelocity(success);
     Transform parentTransform = getParentTransform(success);
-    _angularVelocityLock.withWriteLock([&] {
-        _angularVelocity = glm::inverse(parentTransform.getRotation()) * (angularVelocity - parentAngularVelocity);
+    glm::vec3 localAngularVelocity = glm::inverse(parentTransform.getRotation()) * (angularVelocity - parentAngularVelocity);
+    _localState.update([&](LocalSpatialState& state) {
+        state.angularVelocity = localAngularVelocity;
     });
 }
 
@@ -767,6 +767,14 @@ const Transform SpatiallyNestable::getTransform() const {
     return result;
 }
 
+void SpatiallyNestable::publishLocalTransform() {
+    _localState.update([&](LocalSpatialState& state) {
+        state.rotation = _transform.getRotation();
+        state.translation = _transform.getTranslation();
+        state.scale = _transform.getScale();
+    });
+}
+
 void SpatiallyNestable::breakParentingLoop() const {
     // someone created a loop.  break it...
     qCDebug(shared) << "Parenting loop detected: " << getID();
@@ -814,6 +822,7 @@ void SpatiallyNestable::setTransform(const Transform& transform, bool& success)
             Transform beforeTransform = _transform;
             Transform::inverseMult(_transform, parentTransform, transform);
             if (_transform != beforeTransform) {
+                publishLocalTransform();
                 changed = true;
                 _translationChanged = usecTimestampNow();
                 _rotationChanged = usecTimestampNow();
@@ -871,6 +880,7 @@ void SpatiallyNestable::setSNScale(const glm::vec3& scale, bool& success) {
             changed = true;
             myWorldTransform.setScale(scale);
             Transform::inverseMult(_transform, parentTransform, myWorldTransform);
+            publishLocalTransform();
             _scaleChanged = usecTimestampNow();
         }
     });
@@ -898,6 +908,7 @@ void SpatiallyNestable::setLocalTransform(const Transform& transform) {
     _transformLock.withWriteLock([&] {
         if (_transform != transform) {
             _transform = transform;
+            publishLocalTransform();
             changed = true;
             _scaleChanged = usecTimestampNow();
             _translationChanged = usecTimestampNow();
@@ -911,11 +922,7 @@ void SpatiallyNestable::setLocalTransform(const Transform& transform) {
 }
 
 glm::vec3 SpatiallyNestable::getLocalPosition() const {
-    glm::vec3 result;
-    _transformLock.withReadLock([&] {
-        result = _transform.getTranslation();
-    });
-    return result;
+    return _localState.get().translation;
 }
 
 void SpatiallyNestable::setLocalPosition(const glm::vec3& position, bool tellPhysics) {
@@ -928,6 +935,7 @@ void SpatiallyNestable::setLocalPosition(const glm::vec3& position, bool tellPhy
     _transformLock.withWriteLock([&] {
         if (_transform.getTranslation() != position) {
             _transform.setTranslation(position);
+            publishLocalTransform();
             changed = true;
             _translationChanged = usecTimestampNow();
         }
@@ -938,11 +946,7 @@ void SpatiallyNestable::setLocalPosition(const glm::vec3& position, bool tellPhy
 }
 
 glm::quat SpatiallyNestable::getLocalOrientation() const {
-    glm::quat result;
-    _transformLock.withReadLock([&] {
-        result = _transform.getRotation();
-    });
-    return result;
+    return _localState.get().rotation;
 }
 
 void SpatiallyNestable::setLocalOrientation(const glm::quat& orientation) {
@@ -955,6 +959,7 @@ void SpatiallyNestable::setLocalOrientation(const glm::quat& orientation) {
     _transformLock.withWriteLock([&] {
         if (_transform.getRotation() != orientation) {
             _transform.setRotation(orientation);
+            publishLocalTransform();
             changed = true;
             _rotationChanged = usecTimestampNow();
         }
@@ -965,39 +970,27 @@ void SpatiallyNestable::setLocalOrientation(const glm::quat& orientation) {
 }
 
 glm::vec3 SpatiallyNestable::getLocalVelocity() const {
-    glm::vec3 result;
-    _velocityLock.withReadLock([&] {
-        result = _velocity;
-    });
-    return result;
+    return _localState.get().velocity;
 }
 
 void SpatiallyNestable::setLocalVelocity(const glm::vec3& velocity) {
-    _velocityLock.withWriteLock([&] {
-        _velocity = velocity;
+    _localState.update([&](LocalSpatialState& state) {
+        state.velocity = velocity;
     });
 }
 
 glm::vec3 SpatiallyNestable::getLocalAngularVelocity() const {
-    glm::vec3 result;
-    _angularVelocityLock.withReadLock([&] {
-        result = _angularVelocity;
-    });
-    return result;
+    return _localState.get().angularVelocity;
 }
 
 void SpatiallyNestable::setLocalAngularVelocity(const glm::vec3& angularVelocity) {
-    _angularVelocityLock.withWriteLock([&] {
-        _angularVelocity = angularVelocity;
+    _localState.update([&](LocalSpatialState& state) {
+        state.angularVelocity = angularVelocity;
     });
 }
 
 glm::vec3 SpatiallyNestable::getLocalSNScale() const {
-    glm::vec3 result;
-    _transformLock.withReadLock([&] {
-        result = _transform.getScale();
-    });
-    return result;
+    return _localState.get().scale;
 }
 
 void SpatiallyNestable::setLocalSNScale(const glm::vec3& scale) {
@@ -1011,6 +1004,7 @@ void SpatiallyNestable::setLocalSNScale(const glm::vec3& scale) {
     _transformLock.withWriteLock([&] {
         if (_transform.getScale() != scale) {
             _transform.setScale(scale);
+            publishLocalTransform();
             changed = true;
             _scaleChanged = usecTimestampNow();
         }
@@ -1295,14 +1289,10 @@ void SpatiallyNestable::getLocalTransformAndVelocities(
     _transformLock.withReadLock([&] {
         transform = _transform;
     });
-    // linear velocity
-    _velocityLock.withReadLock([&] {
-        velocity = _velocity;
-    });
-    // angular velocity
-    _angularVelocityLock.withReadLock([&] {
-        angularVelocity = _angularVelocity;
-    });
+    // velocities
+    auto state = _localState.get();
+    velocity = state.velocity;
+    angularVelocity = state.angularVelocity;
 }
 
 void SpatiallyNestable::setLocalTransformAndVelocities(
@@ -1316,19 +1306,17 @@ void SpatiallyNestable::setLocalTransformAndVelocities(
     _transformLock.withWriteLock([&] {
         if (_transform != localTransform) {
             _transform = localTransform;
+            publishLocalTransform();
             changed = true;
             _scaleChanged = usecTimestampNow();
             _translationChanged = usecTimestampNow();
             _rotationChanged = usecTimestampNow();
         }
     });
-    // linear velocity
-    _velocityLock.withWriteLock([&] {
-        _velocity = localVelocity;
-    });
-    // angular velocity
-    _angularVelocityLock.withWriteLock([&] {
-        _angularVelocity = localAngularVelocity;
+    // velocities
+    _localState.update([&](LocalSpatialState& state) {
+        state.velocity = localVelocity;
+        state.angularVelocity = localAngularVelocity;
     });
 
     if (changed) {
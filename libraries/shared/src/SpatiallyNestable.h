@@ -18,6 +18,7 @@
 #include "AACube.h"
 #include "SpatialParentFinder.h"
 #include "shared/ReadWriteLockable.h"
+#include "shared/SeqLock.h"
 #include "Grab.h"
 
 class SpatiallyNestable;
@@ -152,6 +153,16 @@ public:
     virtual glm::vec3 getLocalSNScale() const;
     virtual void setLocalSNScale(const glm::vec3& scale);
 
+    // consistent copy of the parent frame transform parts and velocities, read without taking a lock
+    struct LocalSpatialState {
+        glm::quat rotation;
+        glm::vec3 translation;
+        glm::vec3 scale { 1.0f };
+        glm::vec3 velocity;
+        glm::vec3 angularVelocity;
+    };
+    LocalSpatialState getLocalSpatialState() const { return _localState.get(); }
+
     virtual bool getScalesWithParent() const { return false; }
     virtual glm::vec3 scaleForChildren() const { return glm::vec3(1.0f); }
 
@@ -255,16 +266,15 @@ private:
 
     mutable ReadWriteLockable _transformLock;
     mutable ReadWriteLockable _idLock;
-    mutable ReadWriteLockable _velocityLock;
-    mutable ReadWriteLockable _angularVelocityLock;
     Transform _transform; // this is to be combined with parent's world-transform to produce this' world-transform.
-    glm::vec3 _velocity;
-    glm::vec3 _angularVelocity;
+    // _transform's parts are mirrored here on every change, the velocities only live here
+    SeqLocked<LocalSpatialState> _localState;
     mutable bool _parentKnowsMe { false };
     bool _isDead { false };
     bool _queryAACubeIsPuffed { false };
 
     void breakParentingLoop() const;
+    void publishLocalTransform(); // call with _transformLock held for writing
 };
 
 
@@ -0,0 +1,124 @@
+//
+//  SphereCuller.cpp
+//  libraries/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SphereCuller.h"
+
+#include <algorithm>
+
+static void transformCullSpheres_ref(const float* x, const float* y, const float* z, const float* r,
+                                     const float (*transform)[4], const float (*planes)[4], int numPlanes,
+                                     float* vx, float* vy, float* vz, uint8_t* inside, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+        float px = transform[0][0] * x[i] + transform[0][1] * y[i] + transform[0][2] * z[i] + transform[0][3];
+        float py = transform[1][0] * x[i] + transform[1][1] * y[i] + transform[1][2] * z[i] + transform[1][3];
+        float pz = transform[2][0] * x[i] + transform[2][1] * y[i] + transform[2][2] * z[i] + transform[2][3];
+        vx[i] = px;
+        vy[i] = py;
+        vz[i] = pz;
+
+        bool isInside = true;
+        for (int p = 0; p < numPlanes; p++) {
+            float distance = planes[p][0] * px + planes[p][1] * py + planes[p][2] * pz + planes[p][3];
+            isInside &= !(distance + r[i] < 0.0f);
+        }
+        inside[i] = (uint8_t)isInside;
+    }
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+//
+// Runtime CPU dispatch
+//
+// The AVX2 kernel processes blocks of 8 spheres and returns how many it processed.
+// The reference code finishes the tail.
+//
+#include "CPUDetect.h"
+
+int transformCullSpheres_AVX2(const float* x, const float* y, const float* z, const float* r,
+                              const float (*transform)[4], const float (*planes)[4], int numPlanes,
+                              float* vx, float* vy, float* vz, uint8_t* inside, int size);
+
+static void transformCullSpheres(const float* x, const float* y, const float* z, const float* r,
+                                 const float (*transform)[4], const float (*planes)[4], int numPlanes,
+                                 float* vx, float* vy, float* vz, uint8_t* inside, size_t size) {
+    static bool _cpuSupportsAVX2 = cpuSupportsAVX2();
+    size_t i = 0;
+    if (_cpuSupportsAVX2) {
+        i = transformCullSpheres_AVX2(x, y, z, r, transform, planes, numPlanes, vx, vy, vz, inside, (int)size);
+    }
+    transformCullSpheres_ref(x, y, z, r, transform, planes, numPlanes, vx, vy, vz, inside, i, size);
+}
+
+#else   // portable reference code
+
+static void transformCullSpheres(const float* x, const float* y, const float* z, const float* r,
+                                 const float (*transform)[4], const float (*planes)[4], int numPlanes,
+                                 float* vx, float* vy, float* vz, uint8_t* inside, size_t size) {
+    transformCullSpheres_ref(x, y, z, r, transform, planes, numPlanes, vx, vy, vz, inside, 0, size);
+}
+
+#endif
+
+void SphereCuller::Spheres::clear() {
+    x.clear();
+    y.clear();
+    z.clear();
+    radius.clear();
+}
+
+void SphereCuller::Spheres::reserve(size_t size) {
+    x.reserve(size);
+    y.reserve(size);
+    z.reserve(size);
+    radius.reserve(size);
+}
+
+void SphereCuller::Spheres::resize(size_t size) {
+    x.resize(size);
+    y.resize(size);
+    z.resize(size);
+    radius.resize(size);
+}
+
+void SphereCuller::Spheres::push_back(const glm::vec3& center, float sphereRadius) {
+    x.push_back(center.x);
+    y.push_back(center.y);
+    z.push_back(center.z);
+    radius.push_back(sphereRadius);
+}
+
+void SphereCuller::setTransform(const glm::mat4& transform) {
+    for (int row = 0; row < 3; row++) {
+        for (int column = 0; column < 4; column++) {
+            _transform[row][column] = transform[column][row];
+        }
+    }
+}
+
+bool SphereCuller::addPlane(const glm::vec4& plane) {
+    if (_numPlanes >= MAX_PLANES) {
+        return false;
+    }
+    _planes[_numPlanes][0] = plane.x;
+    _planes[_numPlanes][1] = plane.y;
+    _planes[_numPlanes][2] = plane.z;
+    _planes[_numPlanes][3] = plane.w;
+    _numPlanes++;
+    return true;
+}
+
+void SphereCuller::cull(const Spheres& spheres, size_t begin, size_t end, Spheres& viewSpheres, uint8_t* inside) const {
+    if (end <= begin) {
+        return;
+    }
+    std::copy(spheres.radius.begin() + begin, spheres.radius.begin() + end, viewSpheres.radius.begin() + begin);
+    transformCullSpheres(&spheres.x[begin], &spheres.y[begin], &spheres.z[begin], &spheres.radius[begin], _transform, _planes,
+        _numPlanes, &viewSpheres.x[begin], &viewSpheres.y[begin], &viewSpheres.z[begin], inside, end - begin);
+}
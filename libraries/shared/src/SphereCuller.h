@@ -0,0 +1,58 @@
+//
+//  SphereCuller.h
+//  libraries/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SphereCuller_h
+#define hifi_SphereCuller_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// Moves many spheres into a view space and tests them against a few planes of that space in one pass.
+// The spheres are stored as a structure of arrays, so the transform and the plane tests run as straight SIMD loops.
+class SphereCuller {
+public:
+    static const int MAX_PLANES = 8;
+
+    class Spheres {
+    public:
+        size_t size() const { return x.size(); }
+        void clear();
+        void reserve(size_t size);
+        void resize(size_t size);
+        void push_back(const glm::vec3& center, float radius);
+
+        std::vector<float> x, y, z;
+        std::vector<float> radius;
+    };
+
+    // The affine transform from the space of the spheres to the space of the planes
+    void setTransform(const glm::mat4& transform);
+
+    void clearPlanes() { _numPlanes = 0; }
+    int getNumPlanes() const { return _numPlanes; }
+
+    // A sphere is culled when it is entirely on the negative side of one of the planes.
+    // Returns false when MAX_PLANES are in use.
+    bool addPlane(const glm::vec4& plane);
+
+    // Writes the transformed spheres [begin, end) to the same range of viewSpheres, which must be as large as spheres,
+    // and sets inside[0, end - begin) to 1 for the spheres touching the positive side of every plane, 0 otherwise
+    void cull(const Spheres& spheres, size_t begin, size_t end, Spheres& viewSpheres, uint8_t* inside) const;
+
+private:
+    float _transform[3][4] { { 1.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f, 0.0f } };
+    float _planes[MAX_PLANES][4];
+    int _numPlanes { 0 };
+};
+
+#endif // hifi_SphereCuller_h
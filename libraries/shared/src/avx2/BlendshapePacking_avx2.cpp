@@ -282,4 +282,25 @@ void packBlendshapeOffsets_AVX2(float (*unpacked)[9], uint32_t (*packed)[4], int
     _mm256_zeroupper();
 }
 
+//
+// Sparse accumulation for SparseBlendshapes: offsets[slots[i]] += deltas[i] * coefficient
+// The slots of one blendshape are unique, so the read-modify-writes never alias.
+//
+int accumulateBlendshapeOffsets_AVX2(float (*offsets)[9], const int* slots, const float (*deltas)[9], float coefficient, int size) {
+    const __m256 c = _mm256_set1_ps(coefficient);
+
+    for (int i = 0; i < size; ++i) {
+        float* offset = offsets[slots[i]];
+
+        // pos.xyz, nor.xyz, tan.xy in one register, tan.z on its own
+        __m256 d = _mm256_loadu_ps(&deltas[i][0]);
+        __m256 o = _mm256_loadu_ps(&offset[0]);
+        _mm256_storeu_ps(&offset[0], _mm256_fmadd_ps(d, c, o));
+        offset[8] += deltas[i][8] * coefficient;
+    }
+
+    _mm256_zeroupper();
+    return size;
+}
+
 #endif
@@ -0,0 +1,53 @@
+//
+//  FrustumCuller_avx2.cpp
+//  libraries/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <stdint.h>
+#include <immintrin.h>
+
+//
+// Six plane tests, 8 boxes at a time.  For each plane the caller picks the box corner to test by handing
+// over the min or max array of each axis, so there is no per box select:
+//   inside[i] = (planes[p].xyz . vertex[p][i] + planes[p].w >= 0) for every plane p
+// Returns the number of boxes processed, the caller finishes the tail.
+//
+int testFrustumPlanes_AVX2(const float* const* x, const float* const* y, const float* const* z,
+                           const float (*planes)[4], uint8_t* inside, int size) {
+    const int NUM_PLANES = 6;
+    __m256 nx[NUM_PLANES], ny[NUM_PLANES], nz[NUM_PLANES], d[NUM_PLANES];
+    for (int p = 0; p < NUM_PLANES; p++) {
+        nx[p] = _mm256_set1_ps(planes[p][0]);
+        ny[p] = _mm256_set1_ps(planes[p][1]);
+        nz[p] = _mm256_set1_ps(planes[p][2]);
+        d[p] = _mm256_set1_ps(planes[p][3]);
+    }
+    const __m256 zero = _mm256_setzero_ps();
+
+    int i = 0;
+    for (; i < size - 7; i += 8) {
+        __m256 outside = zero;
+        for (int p = 0; p < NUM_PLANES; p++) {
+            __m256 distance = _mm256_fmadd_ps(nx[p], _mm256_loadu_ps(&x[p][i]), d[p]);
+            distance = _mm256_fmadd_ps(ny[p], _mm256_loadu_ps(&y[p][i]), distance);
+            distance = _mm256_fmadd_ps(nz[p], _mm256_loadu_ps(&z[p][i]), distance);
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, zero, _CMP_LT_OQ));
+        }
+        int mask = ~_mm256_movemask_ps(outside);
+        for (int j = 0; j < 8; j++) {
+            inside[i + j] = (uint8_t)((mask >> j) & 1);
+        }
+    }
+
+    _mm256_zeroupper();
+    return i;
+}
+
+#endif
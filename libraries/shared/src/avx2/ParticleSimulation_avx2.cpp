@@ -0,0 +1,43 @@
+//
+//  ParticleSimulation_avx2.cpp
+//  libraries/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <immintrin.h>
+
+//
+// One axis of constant acceleration integration, 8 particles at a time:
+//   position += velocity * dt + acceleration * (0.5 * dt * dt)
+//   velocity += acceleration * dt
+// Returns the number of particles processed, the caller finishes the tail.
+//
+int integrateParticles_AVX2(float* position, float* velocity, const float* acceleration, float deltaTime, int size) {
+    const __m256 dt = _mm256_set1_ps(deltaTime);
+    const __m256 halfDtSquared = _mm256_set1_ps(0.5f * deltaTime * deltaTime);
+
+    int i = 0;
+    for (; i < size - 7; i += 8) {
+        __m256 p = _mm256_loadu_ps(&position[i]);
+        __m256 v = _mm256_loadu_ps(&velocity[i]);
+        __m256 a = _mm256_loadu_ps(&acceleration[i]);
+
+        p = _mm256_fmadd_ps(v, dt, p);
+        p = _mm256_fmadd_ps(a, halfDtSquared, p);
+        v = _mm256_fmadd_ps(a, dt, v);
+
+        _mm256_storeu_ps(&position[i], p);
+        _mm256_storeu_ps(&velocity[i], v);
+    }
+
+    _mm256_zeroupper();
+    return i;
+}
+
+#endif
@@ -0,0 +1,67 @@
+//
+//  SphereCuller_avx2.cpp
+//  libraries/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <stdint.h>
+#include <immintrin.h>
+
+//
+// Affine transform and plane tests, 8 spheres at a time:
+//   v[i] = transform * (x[i], y[i], z[i], 1)
+//   inside[i] = (planes[p].xyz . v[i] + planes[p].w + r[i] >= 0) for every plane p
+// Returns the number of spheres processed, the caller finishes the tail.
+//
+int transformCullSpheres_AVX2(const float* x, const float* y, const float* z, const float* r,
+                              const float (*transform)[4], const float (*planes)[4], int numPlanes,
+                              float* vx, float* vy, float* vz, uint8_t* inside, int size) {
+    __m256 m[3][4];
+    for (int row = 0; row < 3; row++) {
+        for (int column = 0; column < 4; column++) {
+            m[row][column] = _mm256_set1_ps(transform[row][column]);
+        }
+    }
+    const __m256 zero = _mm256_setzero_ps();
+
+    int i = 0;
+    for (; i < size - 7; i += 8) {
+        __m256 px = _mm256_loadu_ps(&x[i]);
+        __m256 py = _mm256_loadu_ps(&y[i]);
+        __m256 pz = _mm256_loadu_ps(&z[i]);
+        __m256 pr = _mm256_loadu_ps(&r[i]);
+
+        __m256 v[3];
+        for (int row = 0; row < 3; row++) {
+            v[row] = _mm256_fmadd_ps(m[row][0], px, m[row][3]);
+            v[row] = _mm256_fmadd_ps(m[row][1], py, v[row]);
+            v[row] = _mm256_fmadd_ps(m[row][2], pz, v[row]);
+        }
+        _mm256_storeu_ps(&vx[i], v[0]);
+        _mm256_storeu_ps(&vy[i], v[1]);
+        _mm256_storeu_ps(&vz[i], v[2]);
+
+        __m256 outside = zero;
+        for (int p = 0; p < numPlanes; p++) {
+            __m256 distance = _mm256_fmadd_ps(_mm256_set1_ps(planes[p][0]), v[0], _mm256_add_ps(_mm256_set1_ps(planes[p][3]), pr));
+            distance = _mm256_fmadd_ps(_mm256_set1_ps(planes[p][1]), v[1], distance);
+            distance = _mm256_fmadd_ps(_mm256_set1_ps(planes[p][2]), v[2], distance);
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, zero, _CMP_LT_OQ));
+        }
+        int mask = ~_mm256_movemask_ps(outside);
+        for (int j = 0; j < 8; j++) {
+            inside[i + j] = (uint8_t)((mask >> j) & 1);
+        }
+    }
+
+    _mm256_zeroupper();
+    return i;
+}
+
+#endif
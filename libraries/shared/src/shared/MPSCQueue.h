@@ -0,0 +1,96 @@
+//
+//  MPSCQueue.h
+//  libraries/shared/src/shared
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_MPSCQueue_h
+#define hifi_MPSCQueue_h
+
+#include <stddef.h>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+// A lock-free queue any number of threads can push to, drained all at once by a consumer.
+// Producers link their node in front of the list with a single compare and swap, the consumer swaps the
+// whole list out and reverses it, so values come out in the order they were pushed.  There is no single
+// value pop, which keeps it clear of the ABA problem.
+template <typename T>
+class MPSCQueue {
+public:
+    MPSCQueue() = default;
+    MPSCQueue(const MPSCQueue& other) = delete;
+    MPSCQueue& operator=(const MPSCQueue& other) = delete;
+    ~MPSCQueue() { deleteNodes(_head.exchange(nullptr)); }
+
+    void push(const T& value) { pushNode(new Node(value)); }
+    void push(T&& value) { pushNode(new Node(std::move(value))); }
+
+    bool empty() const { return _head.load(std::memory_order_relaxed) == nullptr; }
+
+    // Moves every queued value to the back of values, oldest first, and returns how many there were
+    size_t popAll(std::vector<T>& values);
+
+private:
+    struct Node {
+        explicit Node(const T& value) : value(value) {}
+        explicit Node(T&& value) : value(std::move(value)) {}
+        T value;
+        Node* next { nullptr };
+    };
+
+    void pushNode(Node* node);
+    static void deleteNodes(Node* node);
+
+    std::atomic<Node*> _head { nullptr };
+};
+
+template <typename T>
+inline void MPSCQueue<T>::pushNode(Node* node) {
+    Node* head = _head.load(std::memory_order_relaxed);
+    do {
+        node->next = head;
+    } while (!_head.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+}
+
+template <typename T>
+inline size_t MPSCQueue<T>::popAll(std::vector<T>& values) {
+    Node* node = _head.exchange(nullptr, std::memory_order_acquire);
+
+    // The list is newest first, reverse it
+    Node* reversed = nullptr;
+    size_t count = 0;
+    while (node) {
+        Node* next = node->next;
+        node->next = reversed;
+        reversed = node;
+        node = next;
+        count++;
+    }
+
+    values.reserve(values.size() + count);
+    while (reversed) {
+        Node* next = reversed->next;
+        values.push_back(std::move(reversed->value));
+        delete reversed;
+        reversed = next;
+    }
+    return count;
+}
+
+template <typename T>
+inline void MPSCQueue<T>::deleteNodes(Node* node) {
+    while (node) {
+        Node* next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
+#endif // hifi_MPSCQueue_h
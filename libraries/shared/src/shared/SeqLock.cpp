@@ -0,0 +1,19 @@
+//
+//  SeqLock.cpp
+//  libraries/shared/src/shared
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SeqLock.h"
+
+std::atomic<uint64_t> SeqLockStats::_readRetries { 0 };
+std::atomic<uint64_t> SeqLockStats::_writeWaits { 0 };
+
+void SeqLockStats::reset() {
+    _readRetries.store(0, std::memory_order_relaxed);
+    _writeWaits.store(0, std::memory_order_relaxed);
+}
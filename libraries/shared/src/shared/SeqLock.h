@@ -0,0 +1,92 @@
+//
+//  SeqLock.h
+//  libraries/shared/src/shared
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_SeqLock_h
+#define hifi_SeqLock_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <type_traits>
+
+// Process wide contention counters for every SeqLocked value.  They are only touched when a reader
+// has to retry or a writer has to wait, so the uncontended paths stay free of shared writes.
+class SeqLockStats {
+public:
+    static uint64_t getReadRetries() { return _readRetries.load(std::memory_order_relaxed); }
+    static uint64_t getWriteWaits() { return _writeWaits.load(std::memory_order_relaxed); }
+    static void reset();
+
+    static std::atomic<uint64_t> _readRetries;
+    static std::atomic<uint64_t> _writeWaits;
+};
+
+// A small block of plain data guarded by a sequence counter.  Readers never block and never write shared
+// memory: they copy the value and retry if a writer was active in the meantime, so they always see a
+// consistent snapshot.  Writers are serialized against each other by the counter itself.
+// The block is padded out to whole cache lines to limit false sharing with neighbouring members.  It is not
+// alignas() aligned because the owners are heap allocated and C++14 new doesn't honor over-alignment.
+template <typename T>
+class SeqLocked {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLocked values are copied while they may be written");
+public:
+    SeqLocked() = default;
+    explicit SeqLocked(const T& value) : _value(value) {}
+    SeqLocked(const SeqLocked& other) = delete;
+    SeqLocked& operator=(const SeqLocked& other) = delete;
+
+    T get() const;
+    void set(const T& value) { update([&](T& current) { current = value; }); }
+
+    // f is called with a reference to the value and must not block or call back into this SeqLocked
+    template <typename F>
+    void update(F&& f);
+
+private:
+    static const size_t CACHE_LINE_SIZE = 64;
+    static const size_t PADDING_SIZE = CACHE_LINE_SIZE - (sizeof(std::atomic<uint32_t>) + sizeof(T)) % CACHE_LINE_SIZE;
+
+    std::atomic<uint32_t> _sequence { 0 };
+    T _value {};
+    char _padding[PADDING_SIZE];
+};
+
+template <typename T>
+inline T SeqLocked<T>::get() const {
+    T result;
+    while (true) {
+        uint32_t before = _sequence.load(std::memory_order_acquire);
+        if ((before & 1) == 0) {
+            result = _value;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (_sequence.load(std::memory_order_relaxed) == before) {
+                return result;
+            }
+        }
+        SeqLockStats::_readRetries.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+template <typename F>
+inline void SeqLocked<T>::update(F&& f) {
+    uint32_t sequence = _sequence.load(std::memory_order_relaxed);
+    while ((sequence & 1) != 0 ||
+           !_sequence.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+        SeqLockStats::_writeWaits.fetch_add(1, std::memory_order_relaxed);
+        sequence = _sequence.load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    f(_value);
+    _sequence.store(sequence + 2, std::memory_order_release);
+}
+
+#endif // hifi_SeqLock_h
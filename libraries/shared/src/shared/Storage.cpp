@@ -12,6 +12,12 @@
 #include <QtCore/QDebug>
 #include "StorageLogging.h"
 
+#if defined(Q_OS_UNIX)
+#include <cerrno>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 Q_LOGGING_CATEGORY(storagelogging, "hifi.core.storage")
 
 using namespace storage;
@@ -19,6 +25,26 @@ using namespace storage;
 ViewStorage::ViewStorage(const storage::StoragePointer& owner, size_t size, const uint8_t* data)
     : _owner(owner), _size(size), _data(data) {}
 
+// A zero size means up to the end of the view, ranges running past the end are clamped to it
+static size_t clampViewRange(size_t viewSize, size_t size, size_t offset) {
+    size_t available = viewSize - offset;
+    return (size == 0 || size > available) ? available : size;
+}
+
+void ViewStorage::requestResidency(size_t size, size_t offset) const {
+    if (offset >= _size) {
+        return;
+    }
+    _owner->requestResidency(clampViewRange(_size, size, offset), offset + (_data - _owner->data()));
+}
+
+void ViewStorage::releaseResidency(size_t size, size_t offset) const {
+    if (offset >= _size) {
+        return;
+    }
+    _owner->releaseResidency(clampViewRange(_size, size, offset), offset + (_data - _owner->data()));
+}
+
 StoragePointer Storage::createView(size_t viewSize, size_t offset) const {
     auto selfSize = size();
     if (0 == viewSize) {
@@ -103,3 +129,47 @@ FileStorage::~FileStorage() {
         _file.close();
     }
 }
+
+// Requested ranges are widened to whole pages, released ranges are shrunk to the pages they fully cover
+// so that neighbouring data sharing a page stays resident.
+static void adviseMappedRange(const uint8_t* mapped, size_t mappedSize, size_t size, size_t offset, bool resident) {
+    if (offset >= mappedSize) {
+        return;
+    }
+    if (0 == size || (offset + size) > mappedSize) {
+        size = mappedSize - offset;
+    }
+#if defined(Q_OS_UNIX)
+    static const uintptr_t pageSize = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t start = (uintptr_t)(mapped + offset);
+    uintptr_t end = start + size;
+    if (resident) {
+        start &= ~(pageSize - 1);
+    } else {
+        start = (start + pageSize - 1) & ~(pageSize - 1);
+        end &= ~(pageSize - 1);
+    }
+    if (end <= start) {
+        return;
+    }
+    if (0 != madvise((void*)start, end - start, resident ? MADV_WILLNEED : MADV_DONTNEED)) {
+        qCDebug(storagelogging) << "Failed to advise mapped range residency" << errno;
+    }
+#else
+    // FIXME add support for PrefetchVirtualMemory / OfferVirtualMemory on Windows
+    Q_UNUSED(mapped);
+    Q_UNUSED(resident);
+#endif
+}
+
+void FileStorage::requestResidency(size_t size, size_t offset) const {
+    if (isMapped()) {
+        adviseMappedRange(_mapped, _size, size, offset, true);
+    }
+}
+
+void FileStorage::releaseResidency(size_t size, size_t offset) const {
+    if (isMapped()) {
+        adviseMappedRange(_mapped, _size, size, offset, false);
+    }
+}
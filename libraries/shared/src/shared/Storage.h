@@ -40,6 +40,13 @@ namespace storage {
         StoragePointer toFileStorage(const QString& filename) const;
         StoragePointer toMemoryStorage() const;
 
+        // Paging hints for storage backed by a memory mapped file, the pages of a range are only read
+        // from disk once touched or requested, and released pages are handed back to the OS.
+        // Storage held in memory is always resident, so these are no-ops.
+        virtual bool isMapped() const { return false; }
+        virtual void requestResidency(size_t size = 0, size_t offset = 0) const {}
+        virtual void releaseResidency(size_t size = 0, size_t offset = 0) const {}
+
         // Aliases to prevent having to re-write a ton of code
         inline size_t getSize() const { return size(); }
         inline const uint8_t* readData() const { return data(); }
@@ -70,6 +77,10 @@ namespace storage {
         uint8_t* mutableData() override { return _hasWriteAccess ? _mapped : nullptr; }
         size_t size() const override { return _size; }
         operator bool() const override { return _valid; }
+
+        bool isMapped() const override { return _valid && _fallback.isEmpty(); }
+        void requestResidency(size_t size = 0, size_t offset = 0) const override;
+        void releaseResidency(size_t size = 0, size_t offset = 0) const override;
     private:
         // For compressed QRC files we can't map the file object, so we need to read it into memory
         QByteArray _fallback;
@@ -87,6 +98,10 @@ namespace storage {
         uint8_t* mutableData() override { throw std::runtime_error("Cannot modify ViewStorage");  }
         size_t size() const override { return _size; }
         operator bool() const override { return *_owner; }
+
+        bool isMapped() const override { return _owner->isMapped(); }
+        void requestResidency(size_t size = 0, size_t offset = 0) const override;
+        void releaseResidency(size_t size = 0, size_t offset = 0) const override;
     private:
         const storage::StoragePointer _owner;
         const size_t _size;
@@ -0,0 +1,80 @@
+"use strict";
+/*jslint nomen: true, plusplus: true, vars: true*/
+/*global Entities, Script, print, Vec3, MyAvatar */
+//
+//  bulkTransformEdits.js
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+//  Creates a grid of boxes in front of you and animates them every frame, alternating every few seconds between
+//  Entities.editEntity per box and a single Entities.editEntityTransforms call.
+//  Prints the average ms per frame spent on the edits for each method.
+//
+var COUNT = 1000;
+var ROW_LENGTH = 40;
+var SEPARATION = 0.5;
+var LIFETIME = 120;
+var SWITCH_INTERVAL_MS = 5000;
+
+var origin = Vec3.sum(MyAvatar.position, Vec3.multiplyQbyV(MyAvatar.orientation, { x: -ROW_LENGTH * SEPARATION / 2, y: 0, z: -5 }));
+var ids = [];
+var i;
+for (i = 0; i < COUNT; i++) {
+    ids.push(Entities.addEntity({
+        type: "Box",
+        name: "bulkTransformEdits",
+        position: Vec3.sum(origin, { x: (i % ROW_LENGTH) * SEPARATION, y: 0, z: -Math.floor(i / ROW_LENGTH) * SEPARATION }),
+        dimensions: { x: 0.2, y: 0.2, z: 0.2 },
+        collisionless: true,
+        lifetime: LIFETIME
+    }));
+}
+
+var basePositions = new Float32Array(Entities.getEntityPositions(ids));
+var positions = new Float32Array(basePositions.length);
+var useBulk = true;
+var totalMs = 0;
+var frames = 0;
+var lastSwitch = Date.now();
+
+function update() {
+    var time = Date.now() / 1000;
+    var start = Date.now();
+    if (useBulk) {
+        for (i = 0; i < COUNT; i++) {
+            positions[3 * i] = basePositions[3 * i];
+            positions[3 * i + 1] = basePositions[3 * i + 1] + 0.25 * Math.sin(time + i * 0.1);
+            positions[3 * i + 2] = basePositions[3 * i + 2];
+        }
+        Entities.editEntityTransforms(ids, positions);
+    } else {
+        for (i = 0; i < COUNT; i++) {
+            Entities.editEntity(ids[i], { position: {
+                x: basePositions[3 * i],
+                y: basePositions[3 * i + 1] + 0.25 * Math.sin(time + i * 0.1),
+                z: basePositions[3 * i + 2]
+            }});
+        }
+    }
+    totalMs += Date.now() - start;
+    frames++;
+
+    if (start - lastSwitch > SWITCH_INTERVAL_MS) {
+        print((useBulk ? "editEntityTransforms" : "editEntity") + ": " + (totalMs / frames).toFixed(2) +
+            " ms per frame for " + COUNT + " entities");
+        useBulk = !useBulk;
+        totalMs = 0;
+        frames = 0;
+        lastSwitch = start;
+    }
+}
+
+Script.update.connect(update);
+Script.scriptEnding.connect(function () {
+    ids.forEach(function (id) {
+        Entities.deleteEntity(id);
+    });
+});
@@ -97,6 +97,54 @@ Item {
             ]
         }
 
+        PlotPerf {
+            title: "Batch Allocations"
+            height: parent.evalEvenHeight()
+            object: stats.config
+            plots: [
+                {
+                    prop: "frameBatchAllocationCount",
+                    label: "Allocations",
+                    color: "#00B4EF"
+                },
+                {
+                    prop: "frameBatchAllocationSize",
+                    label: "Size",
+                    color: "#1AC567",
+                    scale: 1 / 1024,
+                    unit: "KB"
+                }
+            ]
+        }
+
+        PlotPerf {
+            title: "Item Transactions"
+            height: parent.evalEvenHeight()
+            object: stats.config
+            plots: [
+                {
+                    prop: "frameItemResetCount",
+                    label: "Resets",
+                    color: "#1AC567"
+                },
+                {
+                    prop: "frameItemRemoveCount",
+                    label: "Removes",
+                    color: "#E2334D"
+                },
+                {
+                    prop: "frameItemUpdateCount",
+                    label: "Updates",
+                    color: "#00B4EF"
+                },
+                {
+                    prop: "frameConcurrentItemUpdateCount",
+                    label: "Concurrent",
+                    color: "#FED959"
+                }
+            ]
+        }
+
         property var drawOpaqueConfig: Render.getConfig("RenderMainView.DrawOpaqueDeferred")
         property var drawTransparentConfig: Render.getConfig("RenderMainView.DrawTransparentDeferred")
         property var drawLightConfig: Render.getConfig("RenderMainView.DrawLight")
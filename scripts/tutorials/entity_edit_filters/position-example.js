@@ -42,4 +42,5 @@ function filter(properties, type, originalProperties) {
     return properties;
 }
 filter.wantsOriginalProperties = "position";
+filter.wantsProperties = "position";
 filter;
\ No newline at end of file
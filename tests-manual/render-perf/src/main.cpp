@@ -852,6 +852,11 @@ private:
             _postUpdateLambdas.clear();
         }
 
+        {
+            PerformanceTimer perfTimer("blendPendingModels");
+            DependencyManager::get<ModelBlender>()->blendPendingModels();
+        }
+
         last = now;
 
         getEntities()->update(false);
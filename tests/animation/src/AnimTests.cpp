@@ -22,6 +22,8 @@
 #include <ResourceRequestObserver.h>
 #include <StatTracker.h>
 #include <test-utils/QTestExtensions.h>
+#include <NumericalConstants.h>
+#include <glm/gtc/random.hpp>
 
 QTEST_MAIN(AnimTests)
 
@@ -467,6 +469,185 @@ void AnimTests::testAnimPose() {
     QCOMPARE_WITH_ABS_ERROR(p.scale(), resultScale, TEST_EPSILON2);
 }
 
+static AnimPoseVec randomPoses(size_t numPoses) {
+    AnimPoseVec poses;
+    poses.reserve(numPoses);
+    for (size_t i = 0; i < numPoses; i++) {
+        glm::vec3 scale = glm::linearRand(glm::vec3(0.5f), glm::vec3(2.0f));
+        glm::quat rot = glm::normalize(glm::quat(glm::linearRand(glm::vec4(-1.0f), glm::vec4(1.0f))));
+        glm::vec3 trans = glm::linearRand(glm::vec3(-10.0f), glm::vec3(10.0f));
+        poses.push_back(AnimPose(scale, rot, trans));
+    }
+    return poses;
+}
+
+static void comparePoses(const AnimPoseVec& ref, const AnimPoseVec& tst) {
+    const float TEST_EPSILON = 0.0001f;
+    QCOMPARE(tst.size(), ref.size());
+    for (size_t i = 0; i < ref.size(); i++) {
+        QCOMPARE_WITH_ABS_ERROR(tst[i].scale(), ref[i].scale(), TEST_EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(tst[i].rot(), ref[i].rot(), TEST_EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(tst[i].trans(), ref[i].trans(), TEST_EPSILON);
+    }
+}
+
+void AnimTests::testPoseBlending() {
+
+    // odd sizes exercise both the SIMD blocks and the reference tail
+    for (size_t numPoses = 0; numPoses < 70; numPoses++) {
+        AnimPoseVec a = randomPoses(numPoses);
+        AnimPoseVec b = randomPoses(numPoses);
+        AnimPoseVec c = randomPoses(numPoses);
+        AnimPoseVec d = randomPoses(numPoses);
+        AnimPoseVec ref(numPoses);
+        AnimPoseVec tst(numPoses);
+        float alpha = glm::linearRand(0.0f, 1.0f);
+        float alphas[4] = { 0.1f, 0.2f, 0.3f, 0.4f };
+
+        blend_ref(numPoses, a.data(), b.data(), alpha, ref.data());
+        blend(numPoses, a.data(), b.data(), alpha, tst.data());
+        comparePoses(ref, tst);
+
+        blend4_ref(numPoses, a.data(), b.data(), c.data(), d.data(), alphas, ref.data());
+        blend4(numPoses, a.data(), b.data(), c.data(), d.data(), alphas, tst.data());
+        comparePoses(ref, tst);
+
+        blendAdd_ref(numPoses, a.data(), b.data(), alpha, ref.data());
+        blendAdd(numPoses, a.data(), b.data(), alpha, tst.data());
+        comparePoses(ref, tst);
+
+        std::vector<float> weights(numPoses);
+        for (size_t i = 0; i < numPoses; i++) {
+            weights[i] = glm::linearRand(0.0f, 1.0f);
+            blend_ref(1, &a[i], &b[i], alpha * weights[i], &ref[i]);
+        }
+        blendWeighted(numPoses, a.data(), b.data(), alpha, weights.data(), tst.data());
+        comparePoses(ref, tst);
+    }
+
+    // one level of a skeleton: joints [numJoints, 2 * numJoints) are children of joints [0, numJoints)
+    for (int numJoints = 0; numJoints < 40; numJoints++) {
+        std::vector<glm::quat> ref;
+        for (const auto& pose : randomPoses(2 * numJoints)) {
+            ref.push_back(pose.rot());
+        }
+        std::vector<glm::quat> tst = ref;
+        std::vector<int> jointIndices, parentIndices;
+        for (int i = 0; i < numJoints; i++) {
+            jointIndices.push_back(numJoints + i);
+            parentIndices.push_back(i);
+        }
+        multiplyByParentRotations_ref(ref.data(), jointIndices.data(), parentIndices.data(), numJoints);
+        multiplyByParentRotations(tst.data(), jointIndices.data(), parentIndices.data(), numJoints);
+        for (size_t i = 0; i < ref.size(); i++) {
+            QCOMPARE_WITH_ABS_ERROR(tst[i], ref[i], 0.0001f);
+        }
+    }
+}
+
+void AnimTests::testPoseBlendingDegenerate() {
+    // opposite and zero rotations blend to zero length quaternions, which the reference code turns into the identity
+    const size_t NUM_POSES = 19;
+    AnimPoseVec a = randomPoses(NUM_POSES);
+    AnimPoseVec b = randomPoses(NUM_POSES);
+    AnimPoseVec c = randomPoses(NUM_POSES);
+    AnimPoseVec d = randomPoses(NUM_POSES);
+    const glm::quat ZERO_ROT(0.0f, 0.0f, 0.0f, 0.0f);
+    for (size_t i = 0; i < NUM_POSES; i += 2) {
+        a[i].rot() = ZERO_ROT;
+        b[i].rot() = ZERO_ROT;
+        c[i].rot() = ZERO_ROT;
+        d[i].rot() = ZERO_ROT;
+    }
+    AnimPoseVec ref(NUM_POSES);
+    AnimPoseVec tst(NUM_POSES);
+    float alphas[4] = { 0.25f, 0.25f, 0.25f, 0.25f };
+
+    auto verifyPoses = [&] {
+        comparePoses(ref, tst);
+        for (size_t i = 0; i < NUM_POSES; i++) {
+            QVERIFY(!glm::any(glm::isnan(glm::vec4(tst[i].rot().x, tst[i].rot().y, tst[i].rot().z, tst[i].rot().w))));
+        }
+    };
+
+    blend_ref(NUM_POSES, a.data(), b.data(), 0.5f, ref.data());
+    blend(NUM_POSES, a.data(), b.data(), 0.5f, tst.data());
+    verifyPoses();
+
+    std::vector<float> weights(NUM_POSES, 1.0f);
+    for (size_t i = 0; i < NUM_POSES; i++) {
+        blend_ref(1, &a[i], &b[i], 0.5f, &ref[i]);
+    }
+    blendWeighted(NUM_POSES, a.data(), b.data(), 0.5f, weights.data(), tst.data());
+    verifyPoses();
+
+    blend4_ref(NUM_POSES, a.data(), b.data(), c.data(), d.data(), alphas, ref.data());
+    blend4(NUM_POSES, a.data(), b.data(), c.data(), d.data(), alphas, tst.data());
+    verifyPoses();
+
+    blendAdd_ref(NUM_POSES, a.data(), b.data(), 0.5f, ref.data());
+    blendAdd(NUM_POSES, a.data(), b.data(), 0.5f, tst.data());
+    verifyPoses();
+
+    // and an empty blend doesn't touch anything
+    blendWeighted(0, nullptr, nullptr, 0.5f, nullptr, nullptr);
+}
+
+void AnimTests::benchmarkPoseBlending() {
+    const size_t NUM_JOINTS = 100;
+    const int LOOPS = 20000;
+
+    AnimPoseVec a = randomPoses(NUM_JOINTS);
+    AnimPoseVec b = randomPoses(NUM_JOINTS);
+    AnimPoseVec c = randomPoses(NUM_JOINTS);
+    AnimPoseVec d = randomPoses(NUM_JOINTS);
+    AnimPoseVec result(NUM_JOINTS);
+    float alphas[4] = { 0.1f, 0.2f, 0.3f, 0.4f };
+
+    auto report = [&](const char* name, qint64 nsecs) {
+        double posesPerSecond = (double)(LOOPS * NUM_JOINTS) / ((double)nsecs / (double)NSECS_PER_SECOND);
+        qDebug() << name << (float)(posesPerSecond / 1.0e6) << "M poses/sec";
+    };
+
+    QElapsedTimer timer;
+
+    timer.start();
+    for (int i = 0; i < LOOPS; i++) {
+        blend_ref(NUM_JOINTS, a.data(), b.data(), 0.5f, result.data());
+    }
+    report("blend (ref)    ", timer.nsecsElapsed());
+
+    timer.start();
+    for (int i = 0; i < LOOPS; i++) {
+        blend(NUM_JOINTS, a.data(), b.data(), 0.5f, result.data());
+    }
+    report("blend          ", timer.nsecsElapsed());
+
+    timer.start();
+    for (int i = 0; i < LOOPS; i++) {
+        blend4_ref(NUM_JOINTS, a.data(), b.data(), c.data(), d.data(), alphas, result.data());
+    }
+    report("blend4 (ref)   ", timer.nsecsElapsed());
+
+    timer.start();
+    for (int i = 0; i < LOOPS; i++) {
+        blend4(NUM_JOINTS, a.data(), b.data(), c.data(), d.data(), alphas, result.data());
+    }
+    report("blend4         ", timer.nsecsElapsed());
+
+    timer.start();
+    for (int i = 0; i < LOOPS; i++) {
+        blendAdd_ref(NUM_JOINTS, a.data(), b.data(), 0.5f, result.data());
+    }
+    report("blendAdd (ref) ", timer.nsecsElapsed());
+
+    timer.start();
+    for (int i = 0; i < LOOPS; i++) {
+        blendAdd(NUM_JOINTS, a.data(), b.data(), 0.5f, result.data());
+    }
+    report("blendAdd       ", timer.nsecsElapsed());
+}
+
 void AnimTests::testExpressionTokenizer() {
     QString str = "(10 +  x) >= 20.1 && (y != !z)";
     AnimExpression e("x");
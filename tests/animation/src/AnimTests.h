@@ -27,6 +27,9 @@ private slots:
     void testVariant();
     void testAccumulateTime();
     void testAnimPose();
+    void testPoseBlending();
+    void testPoseBlendingDegenerate();
+    void benchmarkPoseBlending();
     void testExpressionTokenizer();
     void testExpressionParser();
     void testExpressionEvaluator();
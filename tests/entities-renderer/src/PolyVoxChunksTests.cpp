@@ -0,0 +1,216 @@
+//
+//  PolyVoxChunksTests.cpp
+//  tests/entities-renderer/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PolyVoxChunksTests.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+
+#include <PolyVoxChunks.h>
+
+#include <PolyVoxCore/CubicSurfaceExtractorWithNormals.h>
+#include <PolyVoxCore/MarchingCubesSurfaceExtractor.h>
+#include <PolyVoxCore/SurfaceMesh.h>
+
+QTEST_MAIN(PolyVoxChunksTests)
+
+using Volume = PolyVox::SimpleVolume<uint8_t>;
+using Vertex = PolyVox::PositionMaterialNormal;
+using Triangle = std::array<std::array<int, 3>, 3>;
+using SurfaceStyle = PolyVoxEntityItem::PolyVoxSurfaceStyle;
+
+Q_DECLARE_METATYPE(PolyVoxEntityItem::PolyVoxSurfaceStyle)
+
+// a blob with some noise on it, so that surfaces cross the chunk boundaries at odd angles
+static std::unique_ptr<Volume> makeVolume(const glm::ivec3& highCorner) {
+    std::unique_ptr<Volume> volume(new Volume(PolyVox::Region(PolyVox::Vector3DInt32(0, 0, 0),
+        PolyVox::Vector3DInt32(highCorner.x, highCorner.y, highCorner.z))));
+    volume->setBorderValue(255);
+
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<int> noise(0, 9);
+    glm::vec3 center = glm::vec3(highCorner) * 0.5f;
+    float radius = 0.4f * (float)glm::min(highCorner.x, glm::min(highCorner.y, highCorner.z));
+    for (int z = 0; z <= highCorner.z; ++z) {
+        for (int y = 0; y <= highCorner.y; ++y) {
+            for (int x = 0; x <= highCorner.x; ++x) {
+                bool inside = glm::distance(glm::vec3(x, y, z), center) < radius;
+                volume->setVoxelAt(x, y, z, (inside || noise(generator) == 0) ? 255 : 0);
+            }
+        }
+    }
+    return volume;
+}
+
+// positions snapped to a fine grid, each triangle rotated to start at its smallest corner and the list sorted,
+// so meshes compare equal whatever order the chunks emitted their triangles in
+static std::vector<Triangle> toTriangles(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
+    const float GRID = 1024.0f;
+    std::vector<Triangle> triangles;
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        Triangle triangle;
+        for (int corner = 0; corner < 3; ++corner) {
+            const auto& position = vertices[indices[i + corner]].getPosition();
+            triangle[corner] = { { (int)roundf(position.getX() * GRID), (int)roundf(position.getY() * GRID),
+                                   (int)roundf(position.getZ() * GRID) } };
+        }
+        std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+        triangles.push_back(triangle);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+static std::vector<Triangle> extractWhole(Volume* volume, SurfaceStyle style) {
+    PolyVox::SurfaceMesh<Vertex> mesh;
+    if (style == PolyVoxEntityItem::SURFACE_MARCHING_CUBES || style == PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES) {
+        PolyVox::MarchingCubesSurfaceExtractor<Volume> extractor(volume, volume->getEnclosingRegion(), &mesh);
+        extractor.execute();
+    } else {
+        PolyVox::CubicSurfaceExtractorWithNormals<Volume> extractor(volume, volume->getEnclosingRegion(), &mesh);
+        extractor.execute();
+    }
+    return toTriangles(mesh.getRawVertexData(), mesh.getIndices());
+}
+
+static void extractDirty(PolyVoxChunks& chunks, Volume* volume, SurfaceStyle style) {
+    for (int index : chunks.takeDirtyMeshes()) {
+        chunks.extractMesh(index, volume, style);
+    }
+}
+
+static std::vector<Triangle> stitch(const PolyVoxChunks& chunks) {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    chunks.stitchMeshes(vertices, indices);
+    return toTriangles(vertices, indices);
+}
+
+void PolyVoxChunksTests::testChunkLayout() {
+    PolyVoxChunks chunks(glm::ivec3(37, 20, 16));
+    QCOMPARE(chunks.getNumChunks(), glm::ivec3(3, 2, 1));
+    QCOMPARE((int)chunks.getChunks().size(), 6);
+
+    // the last chunk on each axis is cut short at the volume's corner
+    const auto& last = chunks.getChunk(chunks.getIndex(glm::ivec3(2, 1, 0)));
+    QCOMPARE(last.lowCorner, glm::ivec3(32, 16, 0));
+    QCOMPARE(last.highCorner, glm::ivec3(37, 20, 16));
+
+    // everything starts out needing a mesh, and is only handed out once
+    QCOMPARE((int)chunks.takeDirtyMeshes().size(), 6);
+    QVERIFY(chunks.takeDirtyMeshes().empty());
+
+    // a tiny volume still gets one chunk
+    PolyVoxChunks tiny(glm::ivec3(0));
+    QCOMPARE(tiny.getNumChunks(), glm::ivec3(1));
+}
+
+void PolyVoxChunksTests::testMarkVoxel() {
+    PolyVoxChunks chunks(glm::ivec3(48));
+    chunks.takeDirtyMeshes();
+
+    auto marked = [&](const glm::ivec3& voxel) {
+        chunks.markVoxel(voxel);
+        std::vector<int> dirty = chunks.takeDirtyMeshes();
+        std::vector<int> xs;
+        for (int index : dirty) {
+            xs.push_back(chunks.getChunk(index).lowCorner.x / POLYVOX_CHUNK_SIZE);
+        }
+        return xs;
+    };
+
+    // cell 15 reaches voxel 17 through the gradient at voxel 16, cell 16 reaches back to voxel 15
+    QCOMPARE(marked(glm::ivec3(8)), std::vector<int>({ 0 }));
+    QCOMPARE(marked(glm::ivec3(14, 8, 8)), std::vector<int>({ 0 }));
+    QCOMPARE(marked(glm::ivec3(15, 8, 8)), std::vector<int>({ 0, 1 }));
+    QCOMPARE(marked(glm::ivec3(16, 8, 8)), std::vector<int>({ 0, 1 }));
+    QCOMPARE(marked(glm::ivec3(17, 8, 8)), std::vector<int>({ 0, 1 }));
+    QCOMPARE(marked(glm::ivec3(18, 8, 8)), std::vector<int>({ 1 }));
+
+    // a corner voxel touches all eight chunks around it
+    chunks.markVoxel(glm::ivec3(16));
+    QCOMPARE((int)chunks.takeDirtyMeshes().size(), 8);
+
+    // voxels on the volume's edges stay inside it
+    chunks.markVoxel(glm::ivec3(0));
+    QCOMPARE((int)chunks.takeDirtyMeshes().size(), 1);
+    chunks.markVoxel(glm::ivec3(48));
+    QCOMPARE((int)chunks.takeDirtyMeshes().size(), 1);
+}
+
+void PolyVoxChunksTests::testChunkedMatchesWhole_data() {
+    QTest::addColumn<SurfaceStyle>("style");
+    QTest::newRow("marching cubes") << PolyVoxEntityItem::SURFACE_MARCHING_CUBES;
+    QTest::newRow("cubic") << PolyVoxEntityItem::SURFACE_CUBIC;
+}
+
+void PolyVoxChunksTests::testChunkedMatchesWhole() {
+    QFETCH(SurfaceStyle, style);
+    glm::ivec3 highCorner(37, 20, 33);
+    auto volume = makeVolume(highCorner);
+
+    PolyVoxChunks chunks(highCorner);
+    extractDirty(chunks, volume.get(), style);
+
+    auto expected = extractWhole(volume.get(), style);
+    QVERIFY(!expected.empty());
+    QCOMPARE(stitch(chunks), expected);
+}
+
+void PolyVoxChunksTests::testEditRemeshesTouchedChunks() {
+    const SurfaceStyle style = PolyVoxEntityItem::SURFACE_MARCHING_CUBES;
+    glm::ivec3 highCorner(40);
+    auto volume = makeVolume(highCorner);
+
+    PolyVoxChunks chunks(highCorner);
+    extractDirty(chunks, volume.get(), style);
+
+    // edits near and on the chunk boundaries, where a missed neighbor would show up as a seam
+    std::mt19937 generator(11);
+    std::uniform_int_distribution<int> coordinate(0, highCorner.x);
+    std::uniform_int_distribution<int> nearBoundary(-2, 2);
+    for (int i = 0; i < 30; ++i) {
+        glm::ivec3 voxel(coordinate(generator), coordinate(generator), coordinate(generator));
+        if (i % 2 == 0) {
+            voxel.x = glm::clamp(POLYVOX_CHUNK_SIZE + nearBoundary(generator), 0, highCorner.x);
+        }
+        uint8_t value = volume->getVoxelAt(voxel.x, voxel.y, voxel.z) ? 0 : 255;
+        volume->setVoxelAt(voxel.x, voxel.y, voxel.z, value);
+        chunks.markVoxel(voxel);
+
+        std::vector<int> dirty = chunks.takeDirtyMeshes();
+        QVERIFY((int)dirty.size() < (int)chunks.getChunks().size());
+        for (int index : dirty) {
+            chunks.extractMesh(index, volume.get(), style);
+        }
+        QCOMPARE(stitch(chunks), extractWhole(volume.get(), style));
+    }
+}
+
+void PolyVoxChunksTests::testStyleChangeRemeshesEverything() {
+    glm::ivec3 highCorner(36);
+    auto volume = makeVolume(highCorner);
+
+    PolyVoxChunks chunks(highCorner);
+    extractDirty(chunks, volume.get(), PolyVoxEntityItem::SURFACE_CUBIC);
+    QCOMPARE(stitch(chunks), extractWhole(volume.get(), PolyVoxEntityItem::SURFACE_CUBIC));
+
+    // switching between cubic and marching cubes without changing edged-ness keeps the voxels,
+    // but every cached chunk mesh came from the other extractor
+    chunks.markAll();
+    QCOMPARE(chunks.takeDirtyMeshes().size(), chunks.getChunks().size());
+    for (int i = 0; i < (int)chunks.getChunks().size(); ++i) {
+        chunks.extractMesh(i, volume.get(), PolyVoxEntityItem::SURFACE_MARCHING_CUBES);
+        QVERIFY(chunks.getChunk(i).shapeDirty);
+    }
+    QCOMPARE(stitch(chunks), extractWhole(volume.get(), PolyVoxEntityItem::SURFACE_MARCHING_CUBES));
+}
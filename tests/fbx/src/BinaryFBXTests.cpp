@@ -0,0 +1,265 @@
+//
+//  BinaryFBXTests.cpp
+//  tests/fbx/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BinaryFBXTests.h"
+
+#include <random>
+
+#include <FBX.h>
+#include <FBXSerializer.h>
+#include <FBXWriter.h>
+
+QTEST_MAIN(BinaryFBXTests)
+
+namespace {
+    // prolog, magic bytes and version
+    const int HEADER_SIZE = FBX_HEADER_BYTES_BEFORE_VERSION + sizeof(quint32);
+    // end offset, property count, property list length and name length of a pre-2016 null node
+    const int NULL_NODE_SIZE = 13;
+    // FBXWriter only tries to compress arrays at least this big
+    const int COMPRESSIBLE_COUNT = 4096;
+}
+
+static FBXNode makeNode(const hifi::ByteArray& name, const QVariantList& properties,
+                        const FBXNodeList& children = FBXNodeList()) {
+    FBXNode node;
+    node.name = name;
+    node.properties = properties;
+    node.children = children;
+    return node;
+}
+
+static FBXNode makeRoot(const FBXNodeList& children) {
+    return makeNode(hifi::ByteArray(), QVariantList(), children);
+}
+
+template <class T>
+static QByteArray rawBytes(const QVector<T>& values) {
+    return QByteArray((const char*)values.constData(), values.size() * (int)sizeof(T));
+}
+
+template <class T>
+static QVector<T> makeRepeating(int count) {
+    QVector<T> values(count);
+    for (int i = 0; i < count; i++) {
+        values[i] = (T)(i % 16);
+    }
+    return values;
+}
+
+static bool sameProperty(const QVariant& actual, const QVariant& expected) {
+    int type = expected.userType();
+    if (actual.userType() != type) {
+        return false;
+    }
+    if (type == qMetaTypeId<QVector<float>>()) {
+        return actual.value<QVector<float>>() == expected.value<QVector<float>>();
+    }
+    if (type == qMetaTypeId<QVector<double>>()) {
+        return actual.value<QVector<double>>() == expected.value<QVector<double>>();
+    }
+    if (type == qMetaTypeId<QVector<qint64>>()) {
+        return actual.value<QVector<qint64>>() == expected.value<QVector<qint64>>();
+    }
+    if (type == qMetaTypeId<QVector<qint32>>()) {
+        return actual.value<QVector<qint32>>() == expected.value<QVector<qint32>>();
+    }
+    if (type == qMetaTypeId<QVector<bool>>()) {
+        return actual.value<QVector<bool>>() == expected.value<QVector<bool>>();
+    }
+    return actual == expected;
+}
+
+static bool sameNode(const FBXNode& actual, const FBXNode& expected) {
+    if (actual.name != expected.name || actual.properties.size() != expected.properties.size() ||
+        actual.children.size() != expected.children.size()) {
+        return false;
+    }
+    for (int i = 0; i < expected.properties.size(); i++) {
+        if (!sameProperty(actual.properties[i], expected.properties[i])) {
+            return false;
+        }
+    }
+    for (int i = 0; i < expected.children.size(); i++) {
+        if (!sameNode(actual.children[i], expected.children[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool roundTrips(const FBXNode& root) {
+    return sameNode(FBXSerializer::parseFBX(FBXWriter::encodeFBX(root)), root);
+}
+
+static bool parseFails(const QByteArray& data) {
+    try {
+        FBXSerializer::parseFBX(data);
+    } catch (const QString&) {
+        return true;
+    }
+    return false;
+}
+
+void BinaryFBXTests::testScalarProperties() {
+    FBXNode root = makeRoot({
+        makeNode("Scalars", {
+            QVariant::fromValue((qint16)-12),
+            QVariant::fromValue(true),
+            QVariant::fromValue((qint32)-123456),
+            QVariant::fromValue(1.5f),
+            QVariant::fromValue(-2.25),
+            QVariant::fromValue((qint64)1 << 40),
+            QVariant::fromValue(hifi::ByteArray("Model\0\1Model", 12)),
+            QVariant::fromValue(hifi::ByteArray())
+        })
+    });
+    QVERIFY(roundTrips(root));
+}
+
+void BinaryFBXTests::testUncompressedArrays() {
+    QVector<float> floats { 0.0f, -1.0f, 3.5f };
+    QVector<double> doubles { 1.0, -0.125, 1.0e10 };
+    QVector<qint64> longs { -1, (qint64)1 << 50 };
+    QVector<qint32> ints { 0, -7, 1 << 30 };
+    QVector<bool> bools { true, false, true };
+
+    // big but random, so compressing doesn't pay off
+    std::mt19937 generator(47);
+    QVector<qint32> noise(COMPRESSIBLE_COUNT);
+    for (auto& value : noise) {
+        value = (qint32)generator();
+    }
+
+    FBXNode root = makeRoot({
+        makeNode("Arrays", {
+            QVariant::fromValue(floats),
+            QVariant::fromValue(doubles),
+            QVariant::fromValue(longs),
+            QVariant::fromValue(ints),
+            QVariant::fromValue(bools),
+            QVariant::fromValue(noise),
+            QVariant::fromValue(QVector<double>())
+        })
+    });
+
+    QByteArray data = FBXWriter::encodeFBX(root);
+    QVERIFY(data.contains(rawBytes(doubles)));
+    QVERIFY(data.contains(rawBytes(noise)));
+    QVERIFY(sameNode(FBXSerializer::parseFBX(data), root));
+}
+
+void BinaryFBXTests::testCompressedArrays() {
+    auto floats = makeRepeating<float>(COMPRESSIBLE_COUNT);
+    auto doubles = makeRepeating<double>(COMPRESSIBLE_COUNT);
+    auto longs = makeRepeating<qint64>(COMPRESSIBLE_COUNT);
+    auto ints = makeRepeating<qint32>(COMPRESSIBLE_COUNT);
+    QVector<bool> bools(COMPRESSIBLE_COUNT * 4);
+    for (int i = 0; i < bools.size(); i++) {
+        bools[i] = (i % 3) == 0;
+    }
+
+    FBXNode root = makeRoot({
+        makeNode("Arrays", {
+            QVariant::fromValue(floats),
+            QVariant::fromValue(doubles),
+            QVariant::fromValue(longs),
+            QVariant::fromValue(ints),
+            QVariant::fromValue(bools),
+        }),
+        // mixed with uncompressed arrays of the same type
+        makeNode("Mixed", {
+            QVariant::fromValue(QVector<double> { 1.0, 2.0 }),
+            QVariant::fromValue(doubles),
+            QVariant::fromValue(QVector<double> { 3.0 })
+        })
+    });
+
+    QByteArray data = FBXWriter::encodeFBX(root);
+    QVERIFY(!data.contains(rawBytes(doubles)));
+    QVERIFY(!data.contains(rawBytes(ints)));
+    QVERIFY(data.size() < rawBytes(doubles).size());
+    QVERIFY(sameNode(FBXSerializer::parseFBX(data), root));
+}
+
+void BinaryFBXTests::testNestedNodes() {
+    auto vertices = makeRepeating<double>(COMPRESSIBLE_COUNT * 3);
+    QVector<qint32> indices { 0, 1, -3, 2, 1, -4 };
+
+    FBXNode root = makeRoot({
+        makeNode("FBXHeaderExtension", { }, {
+            makeNode("FBXVersion", { QVariant::fromValue((qint32)7400) })
+        }),
+        makeNode("Objects", { }, {
+            makeNode("Geometry", {
+                QVariant::fromValue((qint64)1234),
+                QVariant::fromValue(hifi::ByteArray("Geometry::")),
+                QVariant::fromValue(hifi::ByteArray("Mesh"))
+            }, {
+                makeNode("Vertices", { QVariant::fromValue(vertices) }),
+                makeNode("PolygonVertexIndex", { QVariant::fromValue(indices) }),
+                makeNode("LayerElementNormal", { QVariant::fromValue((qint32)0) }, {
+                    makeNode("Normals", { QVariant::fromValue(vertices) }),
+                    makeNode("Empty", { })
+                })
+            })
+        }),
+        makeNode("Connections", { }, {
+            makeNode("C", { QVariant::fromValue(hifi::ByteArray("OO")), QVariant::fromValue((qint64)1),
+                            QVariant::fromValue((qint64)0) })
+        })
+    });
+    QVERIFY(roundTrips(root));
+}
+
+void BinaryFBXTests::testTruncated() {
+    FBXNode root = makeRoot({
+        makeNode("Objects", { }, {
+            makeNode("Vertices", { QVariant::fromValue(makeRepeating<double>(COMPRESSIBLE_COUNT)) }),
+            makeNode("PolygonVertexIndex", { QVariant::fromValue(QVector<qint32> { 0, 1, -3 }) }),
+            makeNode("Name", { QVariant::fromValue(hifi::ByteArray("Model::Box")) })
+        })
+    });
+    QByteArray data = FBXWriter::encodeFBX(root);
+
+    // the document may stop between top level nodes
+    QVERIFY(sameNode(FBXSerializer::parseFBX(data.left(HEADER_SIZE)), makeRoot({ })));
+    QVERIFY(sameNode(FBXSerializer::parseFBX(data.left(data.size() - NULL_NODE_SIZE)), root));
+
+    // but anywhere else is an error, never a read past the end
+    for (int size = HEADER_SIZE + 1; size < data.size(); size++) {
+        if (size != data.size() - NULL_NODE_SIZE) {
+            QVERIFY2(parseFails(data.left(size)), qPrintable(QString("truncated to %1 bytes").arg(size)));
+        }
+    }
+}
+
+void BinaryFBXTests::testCorruptCompressedArray() {
+    auto doubles = makeRepeating<double>(COMPRESSIBLE_COUNT);
+    FBXNode root = makeRoot({
+        makeNode("Vertices", { QVariant::fromValue(doubles) })
+    });
+    QByteArray data = FBXWriter::encodeFBX(root);
+
+    // FBXWriter stores the qCompress stream without its length prefix
+    QByteArray compressed = qCompress(rawBytes(doubles)).mid(sizeof(quint32));
+    int offset = data.indexOf(compressed);
+    QVERIFY(offset > HEADER_SIZE);
+
+    // a bad checksum
+    QByteArray badChecksum = data;
+    badChecksum[offset + compressed.size() - 1] = badChecksum[offset + compressed.size() - 1] ^ 0x55;
+    QVERIFY(parseFails(badChecksum));
+
+    // a bad stream header
+    QByteArray badHeader = data;
+    badHeader[offset] = 0;
+    QVERIFY(parseFails(badHeader));
+}
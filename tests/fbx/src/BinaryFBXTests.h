@@ -0,0 +1,28 @@
+//
+//  BinaryFBXTests.h
+//  tests/fbx/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BinaryFBXTests_h
+#define hifi_BinaryFBXTests_h
+
+#include <QtTest/QtTest>
+
+class BinaryFBXTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testScalarProperties();
+    void testUncompressedArrays();
+    void testCompressedArrays();
+    void testNestedNodes();
+    void testTruncated();
+    void testCorruptCompressedArray();
+};
+
+#endif // hifi_BinaryFBXTests_h
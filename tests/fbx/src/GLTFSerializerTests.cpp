@@ -0,0 +1,431 @@
+//
+//  GLTFSerializerTests.cpp
+//  tests/fbx/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "GLTFSerializerTests.h"
+
+#include <functional>
+#include <vector>
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QtEndian>
+
+#include <DependencyManager.h>
+#include <GLTFSerializer.h>
+#include <ResourceManager.h>
+
+QTEST_MAIN(GLTFSerializerTests)
+
+namespace {
+    const QString GLTF_URL = "http://localhost/model.gltf";
+    const QString GLB_URL = "http://localhost/model.glb";
+
+    const quint32 GLB_VERSION = 2;
+    const int GLB_HEADER_SIZE = 12;
+    const int GLB_CHUNK_HEADER_SIZE = 8;
+    const quint32 GLB_JSON_CHUNK = 0x4E4F534A;
+    const quint32 GLB_BIN_CHUNK = 0x004E4942;
+
+    const std::vector<float> POSITIONS { 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f };
+    const std::vector<float> NORMALS { 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f };
+    const std::vector<float> TEXCOORDS { 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f };
+    const std::vector<uint16_t> INDICES { 0, 1, 2 };
+
+    const QVector<glm::vec3> EXPECTED_POSITIONS { { 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f } };
+    const QVector<glm::vec3> EXPECTED_NORMALS { { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, 1.0f } };
+    const QVector<glm::vec2> EXPECTED_TEXCOORDS { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 0.0f, 1.0f } };
+    const QVector<int> EXPECTED_INDICES { 0, 1, 2 };
+}
+
+template <class T>
+static QByteArray toBytes(const std::vector<T>& values) {
+    return QByteArray((const char*)values.data(), (int)(values.size() * sizeof(T)));
+}
+
+static void appendUInt32(QByteArray& data, quint32 value) {
+    value = qToLittleEndian(value);
+    data.append((const char*)&value, sizeof(value));
+}
+
+static QJsonObject makeSparse(int count, int indicesBufferView, int indicesComponentType, int valuesBufferView) {
+    return QJsonObject {
+        { "count", count },
+        { "indices", QJsonObject { { "bufferView", indicesBufferView }, { "componentType", indicesComponentType } } },
+        { "values", QJsonObject { { "bufferView", valuesBufferView } } }
+    };
+}
+
+// A document with a single node holding a mesh of one primitive, all its data in one buffer
+class TestDocument {
+public:
+    QByteArray bin;
+    QJsonArray bufferViews;
+    QJsonArray accessors;
+    QJsonObject attributes;
+    int indices { -1 };
+
+    int addRawBufferView(int byteOffset, int byteLength, int byteStride = 0) {
+        QJsonObject bufferView { { "buffer", 0 }, { "byteOffset", byteOffset }, { "byteLength", byteLength } };
+        if (byteStride > 0) {
+            bufferView.insert("byteStride", byteStride);
+        }
+        bufferViews.append(bufferView);
+        return bufferViews.size() - 1;
+    }
+
+    // Appends the bytes 4 byte aligned, as glTF requires, in a buffer view of their own
+    int addBufferView(const QByteArray& bytes, int byteStride = 0) {
+        while (bin.size() % 4 != 0) {
+            bin.append('\0');
+        }
+        int byteOffset = bin.size();
+        bin.append(bytes);
+        return addRawBufferView(byteOffset, bytes.size(), byteStride);
+    }
+
+    // A negative buffer view leaves it out
+    int addAccessor(int bufferView, int byteOffset, int componentType, int count, const QString& type,
+                    bool normalized = false, const QJsonObject& sparse = QJsonObject()) {
+        QJsonObject accessor { { "componentType", componentType }, { "count", count }, { "type", type } };
+        if (bufferView >= 0) {
+            accessor.insert("bufferView", bufferView);
+            accessor.insert("byteOffset", byteOffset);
+        }
+        if (normalized) {
+            accessor.insert("normalized", true);
+        }
+        if (!sparse.isEmpty()) {
+            accessor.insert("sparse", sparse);
+        }
+        accessors.append(accessor);
+        return accessors.size() - 1;
+    }
+
+    // The buffer is embedded as a data URI, or left to the binary chunk of a GLB
+    QByteArray toJson(bool embedBuffer) const {
+        QJsonObject buffer { { "byteLength", bin.size() } };
+        if (embedBuffer) {
+            buffer.insert("uri", QString("data:application/octet-stream;base64,") + QString::fromLatin1(bin.toBase64()));
+        }
+        QJsonObject primitive { { "attributes", attributes }, { "indices", indices } };
+        QJsonObject document {
+            { "asset", QJsonObject { { "version", "2.0" } } },
+            { "scene", 0 },
+            { "scenes", QJsonArray { QJsonObject { { "nodes", QJsonArray { 0 } } } } },
+            { "nodes", QJsonArray { QJsonObject { { "mesh", 0 } } } },
+            { "meshes", QJsonArray { QJsonObject { { "primitives", QJsonArray { primitive } } } } },
+            { "buffers", QJsonArray { buffer } },
+            { "bufferViews", bufferViews },
+            { "accessors", accessors }
+        };
+        return QJsonDocument(document).toJson(QJsonDocument::Compact);
+    }
+};
+
+// One triangle with tightly packed float positions, normals and texture coordinates, and unsigned short indices
+static TestDocument makeTriangle() {
+    TestDocument document;
+    document.attributes["POSITION"] = document.addAccessor(document.addBufferView(toBytes(POSITIONS)), 0,
+                                                           GLTFAccessorComponentType::FLOAT, 3, "VEC3");
+    document.attributes["NORMAL"] = document.addAccessor(document.addBufferView(toBytes(NORMALS)), 0,
+                                                         GLTFAccessorComponentType::FLOAT, 3, "VEC3");
+    document.attributes["TEXCOORD_0"] = document.addAccessor(document.addBufferView(toBytes(TEXCOORDS)), 0,
+                                                             GLTFAccessorComponentType::FLOAT, 3, "VEC2");
+    document.indices = document.addAccessor(document.addBufferView(toBytes(INDICES)), 0,
+                                            GLTFAccessorComponentType::UNSIGNED_SHORT, 3, "SCALAR");
+    return document;
+}
+
+// Unless aligned, the JSON chunk is given a length that isn't a multiple of 4, so the binary chunk is misaligned
+static QByteArray makeGLB(const QByteArray& json, const QByteArray& bin, bool aligned = true) {
+    QByteArray jsonChunk = json;
+    QByteArray binChunk = bin;
+    if (aligned) {
+        while (jsonChunk.size() % 4 != 0) {
+            jsonChunk.append(' ');
+        }
+        while (binChunk.size() % 4 != 0) {
+            binChunk.append('\0');
+        }
+    } else if (jsonChunk.size() % 4 == 0) {
+        jsonChunk.append(' ');
+    }
+
+    QByteArray glb("glTF");
+    appendUInt32(glb, GLB_VERSION);
+    appendUInt32(glb, (quint32)(GLB_HEADER_SIZE + 2 * GLB_CHUNK_HEADER_SIZE + jsonChunk.size() + binChunk.size()));
+    appendUInt32(glb, (quint32)jsonChunk.size());
+    appendUInt32(glb, GLB_JSON_CHUNK);
+    glb.append(jsonChunk);
+    appendUInt32(glb, (quint32)binChunk.size());
+    appendUInt32(glb, GLB_BIN_CHUNK);
+    glb.append(binChunk);
+    return glb;
+}
+
+static HFMModel::Pointer readGLTF(const TestDocument& document) {
+    GLTFSerializer serializer;
+    return serializer.read(document.toJson(true), hifi::VariantHash(), hifi::URL(GLTF_URL));
+}
+
+static HFMModel::Pointer readGLB(const QByteArray& data) {
+    GLTFSerializer serializer;
+    return serializer.read(data, hifi::VariantHash(), hifi::URL(GLB_URL));
+}
+
+template <class V>
+static bool fuzzyEqual(const QVector<V>& actual, const QVector<V>& expected) {
+    const float EPSILON = 1.0e-6f;
+    if (actual.size() != expected.size()) {
+        return false;
+    }
+    for (int i = 0; i < expected.size(); i++) {
+        if (glm::any(glm::greaterThan(glm::abs(actual[i] - expected[i]), V(EPSILON)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool isTriangle(const HFMModel::Pointer& model) {
+    if (!model || model->meshes.size() != 1 || model->meshes[0].parts.size() != 1) {
+        return false;
+    }
+    const auto& mesh = model->meshes[0];
+    return mesh.parts[0].triangleIndices == EXPECTED_INDICES && mesh.vertices == EXPECTED_POSITIONS &&
+        mesh.normals == EXPECTED_NORMALS && mesh.texCoords == EXPECTED_TEXCOORDS;
+}
+
+// The primitive was dropped, because its positions couldn't be read
+static bool hasNoPart(const HFMModel::Pointer& model) {
+    return model && model->meshes.size() == 1 && model->meshes[0].parts.isEmpty() && model->meshes[0].vertices.isEmpty();
+}
+
+void GLTFSerializerTests::initTestCase() {
+    DependencyManager::set<ResourceManager>(false);
+}
+
+void GLTFSerializerTests::cleanupTestCase() {
+    DependencyManager::destroy<ResourceManager>();
+}
+
+void GLTFSerializerTests::testTightlyPacked() {
+    QVERIFY(isTriangle(readGLTF(makeTriangle())));
+}
+
+void GLTFSerializerTests::testStrided() {
+    // position, normal and texture coordinates of each vertex, one after the other
+    const int STRIDE = 8 * sizeof(float);
+    std::vector<float> interleaved;
+    for (int i = 0; i < 3; i++) {
+        interleaved.insert(interleaved.end(), POSITIONS.begin() + 3 * i, POSITIONS.begin() + 3 * i + 3);
+        interleaved.insert(interleaved.end(), NORMALS.begin() + 3 * i, NORMALS.begin() + 3 * i + 3);
+        interleaved.insert(interleaved.end(), TEXCOORDS.begin() + 2 * i, TEXCOORDS.begin() + 2 * i + 2);
+    }
+
+    TestDocument document;
+    int vertices = document.addBufferView(toBytes(interleaved), STRIDE);
+    document.attributes["POSITION"] = document.addAccessor(vertices, 0, GLTFAccessorComponentType::FLOAT, 3, "VEC3");
+    document.attributes["NORMAL"] = document.addAccessor(vertices, 3 * sizeof(float), GLTFAccessorComponentType::FLOAT, 3, "VEC3");
+    // the last element ends on the last byte of the view
+    document.attributes["TEXCOORD_0"] = document.addAccessor(vertices, 6 * sizeof(float), GLTFAccessorComponentType::FLOAT, 3, "VEC2");
+    document.indices = document.addAccessor(document.addBufferView(toBytes(INDICES)), 0,
+                                            GLTFAccessorComponentType::UNSIGNED_SHORT, 3, "SCALAR");
+    QVERIFY(isTriangle(readGLTF(document)));
+}
+
+void GLTFSerializerTests::testNormalized() {
+    TestDocument document;
+
+    // integer positions aren't normalized, padded to 4 byte vertices
+    std::vector<int16_t> positions { 0, 0, 0, 0, 100, 0, 0, 0, 0, -100, 0, 0 };
+    document.attributes["POSITION"] = document.addAccessor(document.addBufferView(toBytes(positions), 8), 0,
+                                                           GLTFAccessorComponentType::SHORT, 3, "VEC3");
+    // signed values map to [-1, 1], and -128 is clamped to -1
+    std::vector<int8_t> normals { 0, 0, 127, 0, 0, -128, 0, 0, 127, 0, 0, 0 };
+    document.attributes["NORMAL"] = document.addAccessor(document.addBufferView(toBytes(normals), 4), 0,
+                                                         GLTFAccessorComponentType::BYTE, 3, "VEC3", true);
+    // unsigned values map to [0, 1]
+    std::vector<uint8_t> texCoords { 0, 0, 0, 0, 255, 0, 0, 0, 0, 51, 0, 0 };
+    document.attributes["TEXCOORD_0"] = document.addAccessor(document.addBufferView(toBytes(texCoords), 4), 0,
+                                                             GLTFAccessorComponentType::UNSIGNED_BYTE, 3, "VEC2", true);
+    std::vector<uint16_t> colors { 65535, 0, 0, 65535, 0, 65535, 0, 65535, 0, 0, 32768, 65535 };
+    document.attributes["COLOR_0"] = document.addAccessor(document.addBufferView(toBytes(colors)), 0,
+                                                          GLTFAccessorComponentType::UNSIGNED_SHORT, 3, "VEC4", true);
+    std::vector<uint8_t> indices { 0, 1, 2 };
+    document.indices = document.addAccessor(document.addBufferView(toBytes(indices)), 0,
+                                            GLTFAccessorComponentType::UNSIGNED_BYTE, 3, "SCALAR");
+
+    auto model = readGLTF(document);
+    QVERIFY(model);
+    QCOMPARE(model->meshes.size(), 1);
+    const auto& mesh = model->meshes[0];
+    QCOMPARE(mesh.parts.size(), 1);
+    QCOMPARE(mesh.parts[0].triangleIndices, EXPECTED_INDICES);
+    QCOMPARE(mesh.vertices, QVector<glm::vec3>({ { 0.0f, 0.0f, 0.0f }, { 100.0f, 0.0f, 0.0f }, { 0.0f, -100.0f, 0.0f } }));
+    QVERIFY(fuzzyEqual(mesh.normals, QVector<glm::vec3>({ { 0.0f, 0.0f, 1.0f }, { 0.0f, -1.0f, 0.0f }, { 1.0f, 0.0f, 0.0f } })));
+    QVERIFY(fuzzyEqual(mesh.texCoords, QVector<glm::vec2>({ { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 0.0f, 0.2f } })));
+    QVERIFY(fuzzyEqual(mesh.colors, QVector<glm::vec3>({ { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f },
+                                                         { 0.0f, 0.0f, 32768.0f / 65535.0f } })));
+}
+
+void GLTFSerializerTests::testSparse() {
+    TestDocument document = makeTriangle();
+
+    // replace whole vertices of an accessor with a buffer view
+    std::vector<uint8_t> positionIndices { 0, 2 };
+    std::vector<float> positionValues { 5.0f, 5.0f, 5.0f, 6.0f, 6.0f, 6.0f };
+    document.attributes["POSITION"] = document.addAccessor(document.addBufferView(toBytes(POSITIONS)), 0,
+        GLTFAccessorComponentType::FLOAT, 3, "VEC3", false,
+        makeSparse(2, document.addBufferView(toBytes(positionIndices)), GLTFAccessorComponentType::UNSIGNED_BYTE,
+                   document.addBufferView(toBytes(positionValues))));
+
+    // without a buffer view, the rest of the accessor is zeros
+    std::vector<uint16_t> normalIndices { 1 };
+    std::vector<float> normalValues { 0.0f, 0.0f, 1.0f };
+    document.attributes["NORMAL"] = document.addAccessor(-1, 0, GLTFAccessorComponentType::FLOAT, 3, "VEC3", false,
+        makeSparse(1, document.addBufferView(toBytes(normalIndices)), GLTFAccessorComponentType::UNSIGNED_SHORT,
+                   document.addBufferView(toBytes(normalValues))));
+
+    // a two component type replaces two components
+    std::vector<uint32_t> texCoordIndices { 1 };
+    std::vector<float> texCoordValues { 0.5f, 0.25f };
+    document.attributes["TEXCOORD_0"] = document.addAccessor(document.addBufferView(toBytes(TEXCOORDS)), 0,
+        GLTFAccessorComponentType::FLOAT, 3, "VEC2", false,
+        makeSparse(1, document.addBufferView(toBytes(texCoordIndices)), GLTFAccessorComponentType::UNSIGNED_INT,
+                   document.addBufferView(toBytes(texCoordValues))));
+
+    auto model = readGLTF(document);
+    QVERIFY(model);
+    QCOMPARE(model->meshes.size(), 1);
+    const auto& mesh = model->meshes[0];
+    QCOMPARE(mesh.parts.size(), 1);
+    QCOMPARE(mesh.vertices, QVector<glm::vec3>({ { 5.0f, 5.0f, 5.0f }, { 1.0f, 0.0f, 0.0f }, { 6.0f, 6.0f, 6.0f } }));
+    QCOMPARE(mesh.normals, QVector<glm::vec3>({ { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, 0.0f } }));
+    QCOMPARE(mesh.texCoords, QVector<glm::vec2>({ { 0.0f, 0.0f }, { 0.5f, 0.25f }, { 0.0f, 1.0f } }));
+}
+
+void GLTFSerializerTests::testSparseOutOfRange() {
+    std::vector<float> values { 5.0f, 5.0f, 5.0f };
+
+    // past the end of the accessor, the positions are dropped and so is the primitive
+    {
+        TestDocument document = makeTriangle();
+        std::vector<uint8_t> indices { 3 };
+        document.attributes["POSITION"] = document.addAccessor(document.addBufferView(toBytes(POSITIONS)), 0,
+            GLTFAccessorComponentType::FLOAT, 3, "VEC3", false,
+            makeSparse(1, document.addBufferView(toBytes(indices)), GLTFAccessorComponentType::UNSIGNED_BYTE,
+                       document.addBufferView(toBytes(values))));
+        QVERIFY(hasNoPart(readGLTF(document)));
+    }
+
+    // too big for an int, the texture coordinates are dropped and default to zeros
+    {
+        TestDocument document = makeTriangle();
+        std::vector<uint32_t> indices { 0xffffffff };
+        document.attributes["TEXCOORD_0"] = document.addAccessor(document.addBufferView(toBytes(TEXCOORDS)), 0,
+            GLTFAccessorComponentType::FLOAT, 3, "VEC2", false,
+            makeSparse(1, document.addBufferView(toBytes(indices)), GLTFAccessorComponentType::UNSIGNED_INT,
+                       document.addBufferView(toBytes(values))));
+
+        auto model = readGLTF(document);
+        QVERIFY(model);
+        QCOMPARE(model->meshes.size(), 1);
+        QCOMPARE(model->meshes[0].parts.size(), 1);
+        QCOMPARE(model->meshes[0].vertices, EXPECTED_POSITIONS);
+        QCOMPARE(model->meshes[0].texCoords, QVector<glm::vec2>(3, glm::vec2(0.0f)));
+    }
+}
+
+void GLTFSerializerTests::testSparseBadCount() {
+    std::vector<uint8_t> indices { 1 };
+    std::vector<float> values { 0.0f, 0.0f, 1.0f };
+
+    // without a base view the count alone sizes the accessor, so a negative one, or one whose size overflows an
+    // int and would wrap around to a tiny allocation, drops the normals, and they are generated instead
+    for (int count : { -1, 0x55555556 }) {
+        TestDocument document = makeTriangle();
+        document.attributes["NORMAL"] = document.addAccessor(-1, 0, GLTFAccessorComponentType::FLOAT, count, "VEC3", false,
+            makeSparse(1, document.addBufferView(toBytes(indices)), GLTFAccessorComponentType::UNSIGNED_BYTE,
+                       document.addBufferView(toBytes(values))));
+        QVERIFY2(isTriangle(readGLTF(document)), qPrintable(QString("count %1").arg(count)));
+    }
+}
+
+void GLTFSerializerTests::testOutOfBounds() {
+    // each adds a POSITION accessor that can't be read
+    std::vector<std::function<int(TestDocument&)>> badPositions {
+        // more elements than the view holds
+        [](TestDocument& document) {
+            return document.addAccessor(document.addBufferView(toBytes(POSITIONS)), 0,
+                                        GLTFAccessorComponentType::FLOAT, 4, "VEC3");
+        },
+        // inside the buffer but past the end of the view
+        [](TestDocument& document) {
+            int bufferView = document.addBufferView(toBytes(POSITIONS));
+            document.bufferViews[bufferView] = QJsonObject { { "buffer", 0 },
+                { "byteOffset", document.bin.size() - (int)(POSITIONS.size() * sizeof(float)) }, { "byteLength", 24 } };
+            return document.addAccessor(bufferView, 0, GLTFAccessorComponentType::FLOAT, 3, "VEC3");
+        },
+        // a view past the end of the buffer
+        [](TestDocument& document) {
+            int bufferView = document.addBufferView(toBytes(POSITIONS));
+            document.bufferViews[bufferView] = QJsonObject { { "buffer", 0 },
+                { "byteOffset", document.bin.size() - (int)(POSITIONS.size() * sizeof(float)) }, { "byteLength", 48 } };
+            return document.addAccessor(bufferView, 0, GLTFAccessorComponentType::FLOAT, 3, "VEC3");
+        },
+        // a view that doesn't exist
+        [](TestDocument& document) {
+            return document.addAccessor(99, 0, GLTFAccessorComponentType::FLOAT, 3, "VEC3");
+        },
+        // a stride shorter than an element
+        [](TestDocument& document) {
+            return document.addAccessor(document.addBufferView(toBytes(POSITIONS), 8), 0,
+                                        GLTFAccessorComponentType::FLOAT, 3, "VEC3");
+        },
+        // a negative offset
+        [](TestDocument& document) {
+            return document.addAccessor(document.addBufferView(toBytes(POSITIONS)), -4,
+                                        GLTFAccessorComponentType::FLOAT, 3, "VEC3");
+        }
+    };
+
+    for (size_t i = 0; i < badPositions.size(); i++) {
+        TestDocument document = makeTriangle();
+        document.attributes["POSITION"] = badPositions[i](document);
+        QVERIFY2(hasNoPart(readGLTF(document)), qPrintable(QString("bad positions %1").arg(i)));
+    }
+}
+
+void GLTFSerializerTests::testGLB() {
+    TestDocument document = makeTriangle();
+    QVERIFY(isTriangle(readGLB(makeGLB(document.toJson(false), document.bin))));
+}
+
+void GLTFSerializerTests::testMisalignedGLB() {
+    // the chunks aren't aligned and the positions start one byte into their view, neither is allowed by the
+    // spec but both are read correctly
+    TestDocument document = makeTriangle();
+    document.attributes["POSITION"] = document.addAccessor(document.addBufferView(QByteArray(1, '\0') + toBytes(POSITIONS)), 1,
+                                                           GLTFAccessorComponentType::FLOAT, 3, "VEC3");
+    QVERIFY(isTriangle(readGLB(makeGLB(document.toJson(false), document.bin, false))));
+}
+
+void GLTFSerializerTests::testTruncatedGLB() {
+    TestDocument document = makeTriangle();
+    QByteArray glb = makeGLB(document.toJson(false), document.bin);
+    QVERIFY(isTriangle(readGLB(glb)));
+
+    // cut in the header, in the JSON chunk or in the binary chunk, a GLB is never read
+    for (int size = 0; size < glb.size(); size++) {
+        QVERIFY2(!readGLB(glb.left(size)), qPrintable(QString("truncated to %1 bytes").arg(size)));
+    }
+}
@@ -0,0 +1,147 @@
+//
+//  BatchArenaTest.cpp
+//  tests/gpu/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BatchArenaTest.h"
+
+#include <string.h>
+#include <vector>
+
+#include <gpu/BatchArena.h>
+
+QTEST_MAIN(BatchArenaTest)
+
+using namespace gpu;
+
+static bool isAligned(const void* pointer, size_t alignment) {
+    return (reinterpret_cast<uintptr_t>(pointer) & (alignment - 1)) == 0;
+}
+
+void BatchArenaTest::testAlignment() {
+    BatchArena arena;
+    // odd sizes in between push the offset off every boundary
+    for (size_t alignment = 1; alignment <= 64; alignment *= 2) {
+        for (size_t size : { 1, 3, 7, 13 }) {
+            arena.allocate(size, 1);
+            void* pointer = arena.allocate(size, alignment);
+            QVERIFY(isAligned(pointer, alignment));
+        }
+    }
+    QCOMPARE(arena.getStats().blockCount, (uint32_t)1);
+}
+
+void BatchArenaTest::testGrowth() {
+    BatchArena arena;
+
+    uint8_t* first = static_cast<uint8_t*>(arena.allocate(BatchArena::BLOCK_SIZE - 16, 1));
+    QCOMPARE(arena.getStats().blockCount, (uint32_t)1);
+
+    // too big for the tail of the block, which is skipped
+    uint8_t* second = static_cast<uint8_t*>(arena.allocate(64, 16));
+    QCOMPARE(arena.getStats().blockCount, (uint32_t)2);
+    QVERIFY(second < first || second >= first + BatchArena::BLOCK_SIZE);
+
+    // bigger than a block gets a block of its own size
+    const size_t HUGE_SIZE = 3 * BatchArena::BLOCK_SIZE;
+    uint8_t* huge = static_cast<uint8_t*>(arena.allocate(HUGE_SIZE, 16));
+    memset(huge, 0xff, HUGE_SIZE);
+    auto stats = arena.getStats();
+    QCOMPARE(stats.blockCount, (uint32_t)3);
+    QCOMPARE(stats.blockSize, (uint64_t)(2 * BatchArena::BLOCK_SIZE + HUGE_SIZE));
+    QCOMPARE(stats.allocationCount, (uint32_t)3);
+    QCOMPARE(stats.allocatedSize, (uint64_t)(BatchArena::BLOCK_SIZE - 16 + 64 + HUGE_SIZE));
+
+    // many small allocations never overlap
+    std::vector<uint32_t*> values;
+    for (uint32_t i = 0; i < 100000; ++i) {
+        uint32_t* value = static_cast<uint32_t*>(arena.allocate(sizeof(uint32_t) * 4, alignof(uint32_t)));
+        value[0] = value[3] = i;
+        values.push_back(value);
+    }
+    for (uint32_t i = 0; i < values.size(); ++i) {
+        QCOMPARE(values[i][0], i);
+        QCOMPARE(values[i][3], i);
+    }
+    QVERIFY(arena.getStats().blockCount > 3);
+}
+
+void BatchArenaTest::testReset() {
+    BatchArena arena;
+
+    void* first = arena.allocate(100, 8);
+    arena.allocate(BatchArena::BLOCK_SIZE, 8);
+    arena.allocate(2 * BatchArena::BLOCK_SIZE, 8);
+    auto stats = arena.getStats();
+
+    arena.reset();
+    auto resetStats = arena.getStats();
+    QCOMPARE(resetStats.allocationCount, (uint32_t)0);
+    QCOMPARE(resetStats.allocatedSize, (uint64_t)0);
+    // the blocks are kept
+    QCOMPARE(resetStats.blockCount, stats.blockCount);
+    QCOMPARE(resetStats.blockSize, stats.blockSize);
+
+    // the same allocations reuse the same blocks
+    QCOMPARE(arena.allocate(100, 8), first);
+    arena.allocate(BatchArena::BLOCK_SIZE, 8);
+    arena.allocate(2 * BatchArena::BLOCK_SIZE, 8);
+    QCOMPARE(arena.getStats().blockCount, stats.blockCount);
+    QCOMPARE(arena.getStats().blockSize, stats.blockSize);
+}
+
+void BatchArenaTest::testAllocator() {
+    BatchArena arena;
+    ArenaAllocator<uint64_t> allocator(&arena);
+
+    std::vector<uint64_t, ArenaAllocator<uint64_t>> values(allocator);
+    for (uint64_t i = 0; i < 10000; ++i) {
+        values.push_back(i);
+    }
+    for (uint64_t i = 0; i < values.size(); ++i) {
+        QCOMPARE(values[i], i);
+    }
+    QVERIFY(isAligned(values.data(), alignof(uint64_t)));
+    QVERIFY(arena.getStats().allocationCount > 1);
+
+    // rebinding keeps the arena
+    ArenaAllocator<uint8_t> bytes(allocator);
+    QCOMPARE(bytes.getArena(), &arena);
+    QVERIFY(bytes == allocator);
+
+    BatchArena otherArena;
+    QVERIFY(ArenaAllocator<uint64_t>(&otherArena) != allocator);
+    QVERIFY(ArenaAllocator<uint64_t>() != allocator);
+
+    // copies and moves carry the allocator along
+    std::vector<uint64_t, ArenaAllocator<uint64_t>> copy(values);
+    QVERIFY(copy.get_allocator() == allocator);
+    QCOMPARE(copy.back(), (uint64_t)9999);
+    std::vector<uint64_t, ArenaAllocator<uint64_t>> moved { ArenaAllocator<uint64_t>(&otherArena) };
+    moved = std::move(copy);
+    QVERIFY(moved.get_allocator() == allocator);
+    QCOMPARE(moved.size(), (size_t)10000);
+    QCOMPARE(otherArena.getStats().allocationCount, (uint32_t)0);
+}
+
+void BatchArenaTest::testHeapFallback() {
+    ArenaAllocator<uint32_t> allocator;
+    QVERIFY(allocator.getArena() == nullptr);
+    QVERIFY(allocator == ArenaAllocator<uint8_t>());
+
+    std::vector<uint32_t, ArenaAllocator<uint32_t>> values(allocator);
+    for (uint32_t i = 0; i < 10000; ++i) {
+        values.push_back(i);
+    }
+    values.shrink_to_fit();
+    QCOMPARE(values.back(), (uint32_t)9999);
+
+    uint32_t* pointer = allocator.allocate(16);
+    QVERIFY(isAligned(pointer, alignof(uint32_t)));
+    allocator.deallocate(pointer, 16);
+}
@@ -0,0 +1,24 @@
+//
+//  BatchArenaTest.h
+//  tests/gpu/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class BatchArenaTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testAlignment();
+    void testGrowth();
+    void testReset();
+    void testAllocator();
+    void testHeapFallback();
+};
@@ -0,0 +1,77 @@
+//
+//  RecordBatchesTest.cpp
+//  tests/gpu/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "RecordBatchesTest.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gpu/Batch.h>
+#include <gpu/Context.h>
+
+QTEST_MAIN(RecordBatchesTest)
+
+using namespace gpu;
+
+static const char* BATCH_NAME = "RecordBatchesTest";
+static const int NUM_BATCHES = 64;
+
+static int getDrawCount(int index) {
+    return index % 5 + 1;
+}
+
+// Every batch draws its index as a vertex count, the earlier batches take the longest to record
+static std::vector<BatchPointer> recordNumberedBatches(std::atomic<int>& numRecorded) {
+    std::vector<std::function<void(Batch&)>> functions;
+    for (int i = 0; i < NUM_BATCHES; i++) {
+        functions.push_back([i, &numRecorded](Batch& batch) {
+            std::this_thread::sleep_for(std::chrono::microseconds(50 * (NUM_BATCHES - i)));
+            for (int j = 0; j < getDrawCount(i); j++) {
+                batch.draw(gpu::TRIANGLES, (uint32)i);
+            }
+            numRecorded++;
+        });
+    }
+    return recordBatches(BATCH_NAME, functions);
+}
+
+void RecordBatchesTest::testOrder() {
+    // however the recording is scheduled, the batches come back in the order of their functions
+    for (int round = 0; round < 4; round++) {
+        std::atomic<int> numRecorded { 0 };
+        auto batches = recordNumberedBatches(numRecorded);
+        QCOMPARE(numRecorded.load(), NUM_BATCHES);
+        QCOMPARE((int)batches.size(), NUM_BATCHES);
+
+        for (int i = 0; i < NUM_BATCHES; i++) {
+            const auto& batch = *batches[i];
+            QCOMPARE(batch.getName(), std::string(BATCH_NAME));
+            QCOMPARE((int)batch.getCommands().size(), getDrawCount(i));
+            for (auto command : batch.getCommands()) {
+                QCOMPARE(command, Batch::COMMAND_draw);
+            }
+            // start, count and primitive of each draw
+            QCOMPARE((int)batch.getParams().size(), 3 * getDrawCount(i));
+            QCOMPARE(batch.getParams()[1]._uint, (uint32)i);
+        }
+
+        // every batch is its own
+        for (int i = 1; i < NUM_BATCHES; i++) {
+            QVERIFY(batches[i] != batches[i - 1]);
+        }
+    }
+}
+
+void RecordBatchesTest::testEmpty() {
+    auto batches = recordBatches(BATCH_NAME, std::vector<std::function<void(Batch&)>>());
+    QVERIFY(batches.empty());
+}
@@ -142,6 +142,56 @@ void KtxTests::testKtxSerialization() {
     testTexture->setKtxBacking(TEST_IMAGE_KTX.fileName().toStdString());
 }
 
+void KtxTests::testKtxResidency() {
+    const QString TEST_IMAGE = getRootPath() + "/scripts/developer/tests/cube_texture.png";
+    QImage image(TEST_IMAGE);
+    std::atomic<bool> abortSignal;
+    gpu::TexturePointer testTexture =
+        image::TextureUsage::process2DTextureColorFromImage(std::move(image), TEST_IMAGE.toStdString(), true, abortSignal);
+    auto ktxMemory = gpu::Texture::serialize(*testTexture);
+    QVERIFY(ktxMemory.get());
+
+    // A KTX held in memory is always fully resident
+    const auto& memStorage = ktxMemory->getStorage();
+    QVERIFY(!memStorage->isMapped());
+    QVERIFY(ktxMemory->isMipResident(0));
+    QCOMPARE(ktxMemory->evalResidentSize(), memStorage->size());
+
+    QTemporaryFile TEST_IMAGE_KTX;
+    QVERIFY(TEST_IMAGE_KTX.open());
+    TEST_IMAGE_KTX.close();
+    auto fileStorage = memStorage->toFileStorage(TEST_IMAGE_KTX.fileName());
+    auto ktxFile = ktx::KTX::create(fileStorage);
+    QVERIFY(ktxFile.get());
+    QVERIFY(fileStorage->isMapped());
+
+    const size_t baseSize = sizeof(ktx::Header) + ktxFile->getKeyValueDataSize();
+    QCOMPARE(ktxFile->evalResidentSize(), baseSize);
+
+    auto mipCount = (uint16_t)ktxFile->_images.size();
+    QVERIFY(mipCount > 1);
+    auto lastMip = (uint16_t)(mipCount - 1);
+
+    ktxFile->requestMip(lastMip);
+    QVERIFY(ktxFile->isMipResident(lastMip));
+    QVERIFY(!ktxFile->isMipResident(0));
+    QCOMPARE(ktxFile->evalResidentSize(), baseSize + ktxFile->getMipSize(lastMip));
+
+    // requesting twice doesn't count twice
+    ktxFile->requestMip(lastMip);
+    QCOMPARE(ktxFile->evalResidentSize(), baseSize + ktxFile->getMipSize(lastMip));
+
+    ktxFile->requestMip(0);
+    QCOMPARE(ktxFile->evalResidentSize(), baseSize + ktxFile->getMipSize(lastMip) + ktxFile->getMipSize(0));
+
+    ktxFile->releaseMip(0);
+    QVERIFY(!ktxFile->isMipResident(0));
+    QCOMPARE(ktxFile->evalResidentSize(), baseSize + ktxFile->getMipSize(lastMip));
+
+    // released mips fault back in with their content intact
+    QCOMPARE(memcmp(memStorage->data(), fileStorage->data(), memStorage->size()), 0);
+}
+
 #if 0
 
 static const QString TEST_FOLDER { "H:/ktx_cacheold" };
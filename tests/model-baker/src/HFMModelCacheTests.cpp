@@ -0,0 +1,199 @@
+//
+//  HFMModelCacheTests.cpp
+//  tests/model-baker/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HFMModelCacheTests.h"
+
+#include <cstring>
+
+#include <QTemporaryDir>
+
+#include <graphics/Geometry.h>
+#include <model-baker/Baker.h>
+#include <model-baker/HFMModelCache.h>
+
+QTEST_MAIN(HFMModelCacheTests)
+
+namespace {
+    const QString MATERIAL_ID = "material";
+    const hifi::URL MODEL_URL { "http://example.com/quad.fbx" };
+}
+
+// A textured quad with one joint and one material, put through the baker so it has normals, tangents and a graphics mesh
+static hfm::Model::Pointer makeBakedModel() {
+    auto hfmModel = std::make_shared<hfm::Model>();
+    hfmModel->originalURL = MODEL_URL.toString();
+    hfmModel->hasSkeletonJoints = false;
+
+    hfm::Joint joint;
+    joint.name = "root";
+    joint.parentIndex = -1;
+    joint.distanceToParent = 0.0f;
+    joint.isSkeletonJoint = false;
+    joint.bindTransformFoundInCluster = false;
+    joint.hasGeometricOffset = false;
+    joint.geometricScaling = glm::vec3(1.0f);
+    hfmModel->joints.push_back(joint);
+    hfmModel->jointIndices[joint.name] = 1;
+
+    hfm::Mesh mesh;
+    mesh.vertices = { { -1.0f, -1.0f, 0.0f }, { 1.0f, -1.0f, 0.0f }, { 1.0f, 1.0f, 0.0f }, { -1.0f, 1.0f, 0.0f } };
+    mesh.texCoords = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
+    hfm::MeshPart part;
+    part.triangleIndices = { 0, 1, 2, 0, 2, 3 };
+    part.materialID = MATERIAL_ID;
+    mesh.parts.push_back(part);
+    hfm::Cluster cluster;
+    cluster.jointIndex = 0;
+    mesh.clusters.push_back(cluster);
+    mesh.meshIndex = 0;
+    mesh.meshExtents = Extents(glm::vec3(-1.0f, -1.0f, 0.0f), glm::vec3(1.0f, 1.0f, 0.0f));
+    hfmModel->meshes.push_back(mesh);
+    hfmModel->meshExtents = mesh.meshExtents;
+
+    hfm::Material material(glm::vec3(0.8f, 0.2f, 0.2f), glm::vec3(0.1f), glm::vec3(0.0f), 40.0f, 1.0f);
+    material.materialID = MATERIAL_ID;
+    material.name = MATERIAL_ID;
+    material.albedoTexture.filename = "albedo.png";
+    material._material = std::make_shared<graphics::Material>();
+    material._material->setAlbedo(material.diffuseColor);
+    material._material->setRoughness(graphics::Material::shininessToRoughness(material.shininess));
+    hfmModel->materials[MATERIAL_ID] = material;
+
+    baker::Baker baker(hfmModel, hifi::VariantHash(), hifi::URL());
+    baker.run();
+    return baker.getHFMModel();
+}
+
+static bool equalBuffers(const gpu::BufferPointer& a, const gpu::BufferPointer& b) {
+    return a && b && a->getSize() == b->getSize() && memcmp(a->getData(), b->getData(), a->getSize()) == 0;
+}
+
+void HFMModelCacheTests::testRoundTrip() {
+    auto hfmModel = makeBakedModel();
+    QCOMPARE(hfmModel->meshes.size(), 1);
+    QVERIFY((bool)hfmModel->meshes[0]._mesh);
+
+    hifi::ByteArray data = HFMModelCache::serialize(*hfmModel);
+    auto loaded = HFMModelCache::deserialize(data.constData(), (size_t)data.size());
+    QVERIFY((bool)loaded);
+
+    QCOMPARE(loaded->originalURL, hfmModel->originalURL);
+    QCOMPARE(loaded->joints.size(), 1);
+    QCOMPARE(loaded->joints[0].name, hfmModel->joints[0].name);
+    QCOMPARE(loaded->jointIndices, hfmModel->jointIndices);
+    QCOMPARE(loaded->shapeVertices.size(), hfmModel->shapeVertices.size());
+
+    const auto& mesh = hfmModel->meshes[0];
+    const auto& loadedMesh = loaded->meshes[0];
+    QCOMPARE(loadedMesh.vertices, mesh.vertices);
+    QCOMPARE(loadedMesh.normals, mesh.normals);
+    QCOMPARE(loadedMesh.tangents, mesh.tangents);
+    QCOMPARE(loadedMesh.texCoords, mesh.texCoords);
+    QCOMPARE(loadedMesh.parts.size(), 1);
+    QCOMPARE(loadedMesh.parts[0].triangleIndices, mesh.parts[0].triangleIndices);
+    QCOMPARE(loadedMesh.parts[0].materialID, MATERIAL_ID);
+
+    // the graphics mesh comes back with the same layout and contents
+    const auto& graphicsMesh = mesh._mesh;
+    const auto& loadedGraphicsMesh = loadedMesh._mesh;
+    QVERIFY((bool)loadedGraphicsMesh);
+    QCOMPARE(loadedGraphicsMesh->getNumVertices(), graphicsMesh->getNumVertices());
+    QCOMPARE(loadedGraphicsMesh->getNumIndices(), graphicsMesh->getNumIndices());
+    QCOMPARE(loadedGraphicsMesh->getNumParts(), graphicsMesh->getNumParts());
+    QCOMPARE(loadedGraphicsMesh->displayName, graphicsMesh->displayName);
+    const auto& attributes = graphicsMesh->getVertexFormat()->getAttributes();
+    const auto& loadedAttributes = loadedGraphicsMesh->getVertexFormat()->getAttributes();
+    QCOMPARE(loadedAttributes.size(), attributes.size());
+    for (const auto& slotAndAttribute : attributes) {
+        const auto& loadedAttribute = loadedAttributes.at(slotAndAttribute.first);
+        QCOMPARE(loadedAttribute._element.getRaw(), slotAndAttribute.second._element.getRaw());
+        QCOMPARE(loadedAttribute._offset, slotAndAttribute.second._offset);
+    }
+    QCOMPARE(loadedGraphicsMesh->getVertexStream().getStrides(), graphicsMesh->getVertexStream().getStrides());
+    QVERIFY(equalBuffers(loadedGraphicsMesh->getVertexStream().getBuffers()[0], graphicsMesh->getVertexStream().getBuffers()[0]));
+    QVERIFY(equalBuffers(loadedGraphicsMesh->getIndexBuffer()._buffer, graphicsMesh->getIndexBuffer()._buffer));
+    QVERIFY(equalBuffers(loadedGraphicsMesh->getPartBuffer()._buffer, graphicsMesh->getPartBuffer()._buffer));
+
+    // the graphics material keeps its key
+    const auto& material = hfmModel->materials[MATERIAL_ID];
+    const auto& loadedMaterial = loaded->materials[MATERIAL_ID];
+    QCOMPARE(loadedMaterial.albedoTexture.filename, material.albedoTexture.filename);
+    QVERIFY((bool)loadedMaterial._material);
+    QCOMPARE(loadedMaterial._material->getKey()._flags, material._material->getKey()._flags);
+    QCOMPARE(loadedMaterial._material->getRoughness(), material._material->getRoughness());
+
+    // and nothing was left out
+    QCOMPARE(HFMModelCache::serialize(*loaded), data);
+}
+
+void HFMModelCacheTests::testRejectsBadEntries() {
+    hifi::ByteArray data = HFMModelCache::serialize(*makeBakedModel());
+    QVERIFY((bool)HFMModelCache::deserialize(data.constData(), (size_t)data.size()));
+
+    hifi::ByteArray truncated = data.left(data.size() - 1);
+    QVERIFY(!HFMModelCache::deserialize(truncated.constData(), (size_t)truncated.size()));
+
+    hifi::ByteArray badMagic = data;
+    badMagic[0] = 'X';
+    QVERIFY(!HFMModelCache::deserialize(badMagic.constData(), (size_t)badMagic.size()));
+
+    // the baker version follows the magic and the format version
+    hifi::ByteArray oldBaker = data;
+    uint32_t bakerVersion = baker::Baker::VERSION + 1;
+    memcpy(oldBaker.data() + 2 * sizeof(uint32_t), &bakerVersion, sizeof(bakerVersion));
+    QVERIFY(!HFMModelCache::deserialize(oldBaker.constData(), (size_t)oldBaker.size()));
+}
+
+void HFMModelCacheTests::testKey() {
+    hifi::ByteArray data("model contents");
+
+    hifi::VariantHash joints;
+    joints["jointRoot"] = "Hips";
+    joints["jointHead"] = "Head";
+    hifi::VariantHash mapping;
+    mapping["texdir"] = "textures";
+    mapping["scale"] = 2.0;
+    mapping["joint"] = joints;
+
+    // the same mapping built in another order
+    hifi::VariantHash reversedJoints;
+    reversedJoints["jointHead"] = "Head";
+    reversedJoints["jointRoot"] = "Hips";
+    hifi::VariantHash reversedMapping;
+    reversedMapping["joint"] = reversedJoints;
+    reversedMapping["scale"] = 2.0;
+    reversedMapping["texdir"] = "textures";
+
+    auto key = HFMModelCache::computeKey(data, MODEL_URL, mapping);
+    QCOMPARE(HFMModelCache::computeKey(data, MODEL_URL, reversedMapping), key);
+
+    QVERIFY(HFMModelCache::computeKey(data + "!", MODEL_URL, mapping) != key);
+    QVERIFY(HFMModelCache::computeKey(data, hifi::URL("http://example.com/other.fbx"), mapping) != key);
+    mapping["scale"] = 3.0;
+    QVERIFY(HFMModelCache::computeKey(data, MODEL_URL, mapping) != key);
+}
+
+void HFMModelCacheTests::testLoadStore() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    auto hfmModelCache = std::make_shared<HFMModelCache>(dir.path().toStdString());
+    hfmModelCache->initialize();
+
+    auto key = HFMModelCache::computeKey(hifi::ByteArray("model contents"), MODEL_URL, hifi::VariantHash());
+    QVERIFY(!hfmModelCache->load(key));
+    QCOMPARE(hfmModelCache->getNumMisses(), (uint32_t)1);
+
+    auto hfmModel = makeBakedModel();
+    hfmModelCache->store(key, *hfmModel);
+    auto loaded = hfmModelCache->load(key);
+    QVERIFY((bool)loaded);
+    QCOMPARE(hfmModelCache->getNumHits(), (uint32_t)1);
+    QCOMPARE(loaded->meshes[0].vertices, hfmModel->meshes[0].vertices);
+}
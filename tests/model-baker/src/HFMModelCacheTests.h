@@ -0,0 +1,26 @@
+//
+//  HFMModelCacheTests.h
+//  tests/model-baker/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_HFMModelCacheTests_h
+#define hifi_HFMModelCacheTests_h
+
+#include <QtTest/QtTest>
+
+class HFMModelCacheTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testRoundTrip();
+    void testRejectsBadEntries();
+    void testKey();
+    void testLoadStore();
+};
+
+#endif // hifi_HFMModelCacheTests_h
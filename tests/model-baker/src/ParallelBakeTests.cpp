@@ -0,0 +1,156 @@
+//
+//  ParallelBakeTests.cpp
+//  tests/model-baker/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ParallelBakeTests.h"
+
+#include <cstring>
+
+#include <tbb/task_arena.h>
+
+#include <graphics/Geometry.h>
+#include <model-baker/Baker.h>
+
+QTEST_MAIN(ParallelBakeTests)
+
+namespace {
+    const QString MATERIAL_ID = "material";
+    const int NUM_MESHES = 8;
+    const int NUM_BLENDSHAPES = 5;
+    const int GRID_SIZE = 24;
+}
+
+// Wavy textured grids without normals or tangents, each with blendshapes moving a part of its vertices,
+// so the baker calculates all the normals and tangents.  The baker edits the model it is given, so every
+// bake needs a new one.
+static hfm::Model::Pointer makeModel() {
+    auto hfmModel = std::make_shared<hfm::Model>();
+    hfmModel->hasSkeletonJoints = false;
+
+    hfm::Joint joint;
+    joint.name = "root";
+    joint.parentIndex = -1;
+    joint.distanceToParent = 0.0f;
+    joint.isSkeletonJoint = false;
+    joint.bindTransformFoundInCluster = false;
+    joint.hasGeometricOffset = false;
+    joint.geometricScaling = glm::vec3(1.0f);
+    hfmModel->joints.push_back(joint);
+    hfmModel->jointIndices[joint.name] = 1;
+
+    for (int m = 0; m < NUM_MESHES; m++) {
+        hfm::Mesh mesh;
+        for (int y = 0; y < GRID_SIZE; y++) {
+            for (int x = 0; x < GRID_SIZE; x++) {
+                float height = 0.1f * sinf((float)(x * (m + 1)) * 0.3f) * cosf((float)y * 0.2f);
+                mesh.vertices.push_back(glm::vec3((float)x, (float)y, height));
+                mesh.texCoords.push_back(glm::vec2((float)x, (float)y) / (float)(GRID_SIZE - 1));
+            }
+        }
+
+        hfm::MeshPart part;
+        for (int y = 0; y < GRID_SIZE - 1; y++) {
+            for (int x = 0; x < GRID_SIZE - 1; x++) {
+                int corner = y * GRID_SIZE + x;
+                part.triangleIndices << corner << corner + 1 << corner + GRID_SIZE + 1;
+                part.triangleIndices << corner << corner + GRID_SIZE + 1 << corner + GRID_SIZE;
+            }
+        }
+        part.materialID = MATERIAL_ID;
+        mesh.parts.push_back(part);
+
+        for (int b = 0; b < NUM_BLENDSHAPES; b++) {
+            hfm::Blendshape blendshape;
+            for (int i = b; i < mesh.vertices.size(); i += b + 2) {
+                blendshape.indices.push_back(i);
+                blendshape.vertices.push_back(mesh.vertices[i] + glm::vec3(0.0f, 0.0f, 0.05f * (float)(b + 1)));
+            }
+            mesh.blendshapes.push_back(blendshape);
+        }
+
+        hfm::Cluster cluster;
+        cluster.jointIndex = 0;
+        mesh.clusters.push_back(cluster);
+        mesh.meshIndex = m;
+        for (const auto& vertex : mesh.vertices) {
+            mesh.meshExtents.addPoint(vertex);
+        }
+        hfmModel->meshes.push_back(mesh);
+        hfmModel->meshExtents.addExtents(mesh.meshExtents);
+    }
+
+    hfm::Material material(glm::vec3(0.8f, 0.2f, 0.2f), glm::vec3(0.1f), glm::vec3(0.0f), 40.0f, 1.0f);
+    material.materialID = MATERIAL_ID;
+    material.name = MATERIAL_ID;
+    material._material = std::make_shared<graphics::Material>();
+    hfmModel->materials[MATERIAL_ID] = material;
+
+    return hfmModel;
+}
+
+static hfm::Model::Pointer bake(bool serial) {
+    baker::Baker baker(makeModel(), hifi::VariantHash(), hifi::URL());
+    if (serial) {
+        // without worker threads the parallel loops of the baker run in order on this thread
+        tbb::task_arena arena(1);
+        arena.execute([&] { baker.run(); });
+    } else {
+        baker.run();
+    }
+    return baker.getHFMModel();
+}
+
+static bool equalBuffers(const gpu::BufferPointer& a, const gpu::BufferPointer& b) {
+    return a && b && a->getSize() == b->getSize() && memcmp(a->getData(), b->getData(), a->getSize()) == 0;
+}
+
+void ParallelBakeTests::testParallelMatchesSerial() {
+    auto serial = bake(true);
+    auto parallel = bake(false);
+
+    QCOMPARE(parallel->meshes.size(), NUM_MESHES);
+    QCOMPARE(serial->meshes.size(), NUM_MESHES);
+    for (int m = 0; m < NUM_MESHES; m++) {
+        const auto& serialMesh = serial->meshes[m];
+        const auto& parallelMesh = parallel->meshes[m];
+
+        // everything was calculated, not carried over
+        QCOMPARE(serialMesh.normals.size(), serialMesh.vertices.size());
+        QCOMPARE(serialMesh.tangents.size(), serialMesh.vertices.size());
+
+        QCOMPARE(parallelMesh.vertices, serialMesh.vertices);
+        QCOMPARE(parallelMesh.normals, serialMesh.normals);
+        QCOMPARE(parallelMesh.tangents, serialMesh.tangents);
+
+        QCOMPARE(parallelMesh.blendshapes.size(), NUM_BLENDSHAPES);
+        QCOMPARE(serialMesh.blendshapes.size(), NUM_BLENDSHAPES);
+        for (int b = 0; b < NUM_BLENDSHAPES; b++) {
+            const auto& serialBlendshape = serialMesh.blendshapes[b];
+            const auto& parallelBlendshape = parallelMesh.blendshapes[b];
+            QVERIFY(!serialBlendshape.normals.isEmpty());
+            QVERIFY(!serialBlendshape.tangents.isEmpty());
+
+            QCOMPARE(parallelBlendshape.indices, serialBlendshape.indices);
+            QCOMPARE(parallelBlendshape.vertices, serialBlendshape.vertices);
+            QCOMPARE(parallelBlendshape.normals, serialBlendshape.normals);
+            QCOMPARE(parallelBlendshape.tangents, serialBlendshape.tangents);
+        }
+
+        // and the graphics meshes built from them are identical
+        const auto& serialGraphicsMesh = serialMesh._mesh;
+        const auto& parallelGraphicsMesh = parallelMesh._mesh;
+        QVERIFY((bool)serialGraphicsMesh);
+        QVERIFY((bool)parallelGraphicsMesh);
+        QCOMPARE(parallelGraphicsMesh->getNumVertices(), serialGraphicsMesh->getNumVertices());
+        QCOMPARE(parallelGraphicsMesh->getVertexStream().getStrides(), serialGraphicsMesh->getVertexStream().getStrides());
+        QVERIFY(equalBuffers(parallelGraphicsMesh->getVertexStream().getBuffers()[0],
+                             serialGraphicsMesh->getVertexStream().getBuffers()[0]));
+        QVERIFY(equalBuffers(parallelGraphicsMesh->getIndexBuffer()._buffer, serialGraphicsMesh->getIndexBuffer()._buffer));
+    }
+}
@@ -0,0 +1,23 @@
+//
+//  ParallelBakeTests.h
+//  tests/model-baker/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ParallelBakeTests_h
+#define hifi_ParallelBakeTests_h
+
+#include <QtTest/QtTest>
+
+class ParallelBakeTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testParallelMatchesSerial();
+};
+
+#endif // hifi_ParallelBakeTests_h
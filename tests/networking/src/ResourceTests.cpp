@@ -9,6 +9,10 @@
 
 #include "ResourceTests.h"
 
+#include <atomic>
+#include <random>
+#include <thread>
+
 #include <QNetworkDiskCache>
 
 #include <ResourceCache.h>
@@ -93,3 +97,81 @@ void ResourceTests::downloadAgain() {
 
     QVERIFY(resource->isLoaded());
 }
+
+namespace {
+
+class TestResource : public Resource {
+public:
+    TestResource(const QUrl& url) : Resource(url) {}
+    void setBytes(qint64 bytes) { setSize(bytes); }
+};
+
+class TestResourceCache : public ResourceCache {
+public:
+    using ResourceCache::addUnusedResource;
+    using ResourceCache::removeUnusedResource;
+
+protected:
+    QSharedPointer<Resource> createResource(const QUrl& url) override { return QSharedPointer<TestResource>::create(url); }
+    QSharedPointer<Resource> createResourceCopy(const QSharedPointer<Resource>& resource) override {
+        return QSharedPointer<TestResource>::create(resource->getURL());
+    }
+};
+
+}
+
+void ResourceTests::concurrentUnusedResources() {
+    const int NUM_RESOURCES = 64;
+    const int NUM_THREADS = 4;
+    const int NUM_ITERATIONS = 20000;
+    const qint64 RESOURCE_SIZE = 1024;
+
+    TestResourceCache cache;
+    QVector<QSharedPointer<Resource>> resources;
+    for (int i = 0; i < NUM_RESOURCES; i++) {
+        auto resource = QSharedPointer<TestResource>::create(QUrl("test://resource/" + QString::number(i)));
+        resource->setSelf(resource);
+        resource->setBytes(RESOURCE_SIZE);
+        resources.push_back(resource);
+    }
+
+    // resources go in and out of the unused list on several threads while another keeps clearing it
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; t++) {
+        threads.emplace_back([&, t] {
+            std::mt19937 random(t);
+            for (int i = 0; i < NUM_ITERATIONS; i++) {
+                const auto& resource = resources[random() % NUM_RESOURCES];
+                if (random() & 1) {
+                    cache.addUnusedResource(resource);
+                } else {
+                    cache.removeUnusedResource(resource);
+                }
+            }
+        });
+    }
+    std::atomic<bool> done { false };
+    std::thread clearThread([&] {
+        while (!done) {
+            cache.clearUnusedResources();
+        }
+    });
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    done = true;
+    clearThread.join();
+
+    // the list and the flags still agree, so every resource goes in exactly once and comes out again
+    for (const auto& resource : resources) {
+        cache.addUnusedResource(resource);
+        cache.addUnusedResource(resource);
+    }
+    QCOMPARE(cache.getNumCachedResources(), (size_t)NUM_RESOURCES);
+    for (const auto& resource : resources) {
+        cache.removeUnusedResource(resource);
+    }
+    QCOMPARE(cache.getNumCachedResources(), (size_t)0);
+
+    cache.clearUnusedResources();
+}
@@ -0,0 +1,180 @@
+//
+//  EntitySpatialIndexTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntitySpatialIndexTests.h"
+
+#include <algorithm>
+#include <random>
+#include <set>
+
+#include <EntitySpatialIndex.h>
+#include <ShapeEntityItem.h>
+
+QTEST_MAIN(EntitySpatialIndexTests)
+
+using EntitySet = std::set<const EntityItem*>;
+
+static EntityItemPointer makeEntity() {
+    return std::make_shared<ShapeEntityItem>(EntityItemID(QUuid::createUuid()));
+}
+
+static EntitySet query(const EntitySpatialIndex& index, const AABox& box) {
+    EntitySet found;
+    index.forEachCandidate(box, [&](const EntityItemPointer& entity) {
+        // every entity must be reported once per query
+        QVERIFY(found.insert(entity.get()).second);
+    });
+    return found;
+}
+
+void EntitySpatialIndexTests::testInsertAndQuery() {
+    EntitySpatialIndex index;
+
+    auto small = makeEntity();
+    auto negative = makeEntity();
+    auto large = makeEntity();
+    index.insert(small, AACube(glm::vec3(1.0f), 2.0f));
+    index.insert(negative, AACube(glm::vec3(-40.0f, -8.0f, -40.0f), 4.0f));
+    // bigger than a cell, kept in the list every query checks
+    index.insert(large, AACube(glm::vec3(-100.0f), 200.0f));
+    QCOMPARE(index.size(), (size_t)3);
+
+    QCOMPARE(query(index, AABox(glm::vec3(0.0f), glm::vec3(4.0f))), EntitySet({ small.get(), large.get() }));
+    QCOMPARE(query(index, AABox(glm::vec3(-39.0f, -7.0f, -39.0f), glm::vec3(1.0f))),
+             EntitySet({ negative.get(), large.get() }));
+    // touching faces count
+    QCOMPARE(query(index, AABox(glm::vec3(3.0f, 1.0f, 1.0f), glm::vec3(1.0f))), EntitySet({ small.get(), large.get() }));
+    QCOMPARE(query(index, AABox(glm::vec3(500.0f), glm::vec3(1.0f))), EntitySet());
+    // a box covering more cells than are occupied takes the other path
+    QCOMPARE(query(index, AABox(glm::vec3(-1000.0f), glm::vec3(2000.0f))),
+             EntitySet({ small.get(), negative.get(), large.get() }));
+}
+
+void EntitySpatialIndexTests::testMove() {
+    EntitySpatialIndex index;
+
+    auto entity = makeEntity();
+    auto neighbor = makeEntity();
+    index.insert(entity, AACube(glm::vec3(1.0f), 1.0f));
+    index.insert(neighbor, AACube(glm::vec3(2.0f), 1.0f));
+
+    // inserting again moves it, across cells and into and out of the large list
+    index.insert(entity, AACube(glm::vec3(100.0f), 1.0f));
+    QCOMPARE(index.size(), (size_t)2);
+    QCOMPARE(query(index, AABox(glm::vec3(0.0f), glm::vec3(4.0f))), EntitySet({ neighbor.get() }));
+    QCOMPARE(query(index, AABox(glm::vec3(99.0f), glm::vec3(4.0f))), EntitySet({ entity.get() }));
+
+    index.insert(entity, AACube(glm::vec3(-64.0f), 128.0f));
+    QCOMPARE(index.size(), (size_t)2);
+    QCOMPARE(query(index, AABox(glm::vec3(99.0f), glm::vec3(4.0f))), EntitySet());
+    QCOMPARE(query(index, AABox(glm::vec3(0.0f), glm::vec3(4.0f))), EntitySet({ entity.get(), neighbor.get() }));
+
+    index.insert(entity, AACube(glm::vec3(1.0f), 1.0f));
+    QCOMPARE(index.size(), (size_t)2);
+    QCOMPARE(query(index, AABox(glm::vec3(-60.0f), glm::vec3(4.0f))), EntitySet());
+    QCOMPARE(query(index, AABox(glm::vec3(0.0f), glm::vec3(4.0f))), EntitySet({ entity.get(), neighbor.get() }));
+}
+
+void EntitySpatialIndexTests::testRemove() {
+    EntitySpatialIndex index;
+
+    // several entities in one cell, so removing from the middle swaps the last one into its place
+    std::vector<EntityItemPointer> entities;
+    for (int i = 0; i < 5; ++i) {
+        entities.push_back(makeEntity());
+        index.insert(entities.back(), AACube(glm::vec3((float)i, 1.0f, 1.0f), 0.5f));
+    }
+    auto large = makeEntity();
+    index.insert(large, AACube(glm::vec3(-64.0f), 128.0f));
+
+    index.remove(entities[1].get());
+    index.remove(large.get());
+    QCOMPARE(index.size(), (size_t)4);
+    QCOMPARE(query(index, AABox(glm::vec3(0.0f), glm::vec3(8.0f))),
+             EntitySet({ entities[0].get(), entities[2].get(), entities[3].get(), entities[4].get() }));
+
+    // the entity swapped into the removed slot must still be removable
+    index.remove(entities[4].get());
+    QCOMPARE(query(index, AABox(glm::vec3(0.0f), glm::vec3(8.0f))),
+             EntitySet({ entities[0].get(), entities[2].get(), entities[3].get() }));
+
+    // removing something that isn't indexed does nothing
+    index.remove(entities[1].get());
+    auto stranger = makeEntity();
+    index.remove(stranger.get());
+    QCOMPARE(index.size(), (size_t)3);
+
+    for (auto& entity : entities) {
+        index.remove(entity.get());
+    }
+    QCOMPARE(index.size(), (size_t)0);
+    QCOMPARE(query(index, AABox(glm::vec3(-1000.0f), glm::vec3(2000.0f))), EntitySet());
+
+    index.insert(entities[0], AACube(glm::vec3(1.0f), 1.0f));
+    index.clear();
+    QCOMPARE(index.size(), (size_t)0);
+    QCOMPARE(query(index, AABox(glm::vec3(0.0f), glm::vec3(4.0f))), EntitySet());
+}
+
+void EntitySpatialIndexTests::testMatchesBruteForce() {
+    std::mt19937 generator(19);
+    std::uniform_real_distribution<float> position(-200.0f, 200.0f);
+    std::uniform_int_distribution<int> scaleExponent(-2, 6);
+    std::uniform_int_distribution<int> operation(0, 9);
+
+    EntitySpatialIndex index;
+    std::vector<EntityItemPointer> entities;
+    std::vector<AACube> bounds;
+    std::vector<bool> indexed;
+    const int NUM_ENTITIES = 500;
+    for (int i = 0; i < NUM_ENTITIES; ++i) {
+        entities.push_back(makeEntity());
+        bounds.push_back(AACube());
+        indexed.push_back(false);
+    }
+
+    auto randomCube = [&] {
+        return AACube(glm::vec3(position(generator), position(generator), position(generator)),
+                      powf(2.0f, (float)scaleExponent(generator)));
+    };
+
+    const int NUM_ROUNDS = 20;
+    for (int round = 0; round < NUM_ROUNDS; ++round) {
+        // a mix of inserts, moves and removes
+        for (int i = 0; i < NUM_ENTITIES; ++i) {
+            int op = operation(generator);
+            if (op < 6) {
+                bounds[i] = randomCube();
+                index.insert(entities[i], bounds[i]);
+                indexed[i] = true;
+            } else if (op < 8) {
+                index.remove(entities[i].get());
+                indexed[i] = false;
+            }
+        }
+
+        size_t numIndexed = std::count(indexed.begin(), indexed.end(), true);
+        QCOMPARE(index.size(), numIndexed);
+
+        for (int q = 0; q < 20; ++q) {
+            glm::vec3 corner(position(generator), position(generator), position(generator));
+            float size = powf(2.0f, (float)scaleExponent(generator) + 1.0f);
+            AABox box(corner, glm::vec3(size, 0.5f * size, 2.0f * size));
+
+            EntitySet expected;
+            for (int i = 0; i < NUM_ENTITIES; ++i) {
+                if (indexed[i] && AABox(bounds[i]).touches(box)) {
+                    expected.insert(entities[i].get());
+                }
+            }
+            QCOMPARE(query(index, box), expected);
+        }
+    }
+}
@@ -0,0 +1,26 @@
+//
+//  EntitySpatialIndexTests.h
+//  tests/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntitySpatialIndexTests_h
+#define hifi_EntitySpatialIndexTests_h
+
+#include <QtTest/QtTest>
+
+class EntitySpatialIndexTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testInsertAndQuery();
+    void testMove();
+    void testRemove();
+    void testMatchesBruteForce();
+};
+
+#endif // hifi_EntitySpatialIndexTests_h
@@ -0,0 +1,242 @@
+//
+//  PhysicsEngineTests.cpp
+//  tests/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PhysicsEngineTests.h"
+
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <PhysicsEngine.h>
+#include <PhysicsHelpers.h>
+#include <PhysicsTaskScheduler.h>
+#include <ThreadSafeDynamicsWorld.h>
+
+QTEST_MAIN(PhysicsEngineTests)
+
+// a ground plate with a stack of boxes on it, owned by the test rather than by motion states
+class Pile {
+public:
+    Pile(PhysicsEngine& engine, int sideLength, int height) :
+        _world(static_cast<ThreadSafeDynamicsWorld*>(engine.getDynamicsWorld())),
+        _groundShape(btVector3(50.0f, 0.5f, 50.0f)),
+        _boxShape(btVector3(0.5f, 0.5f, 0.5f)) {
+        addBody(&_groundShape, 0.0f, btVector3(0.0f, -0.5f, 0.0f));
+
+        const float SPACING = 1.01f;
+        float offset = 0.5f * SPACING * (sideLength - 1);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < sideLength; ++x) {
+                for (int z = 0; z < sideLength; ++z) {
+                    btVector3 position(x * SPACING - offset, 0.5f + y * SPACING, z * SPACING - offset);
+                    addBody(&_boxShape, 1.0f, position);
+                }
+            }
+        }
+    }
+
+    ~Pile() {
+        for (auto& body : _bodies) {
+            _world->removeRigidBody(body.get());
+        }
+    }
+
+    int step(int numSubsteps) {
+        return _world->stepSimulationWithSubstepCallback(numSubsteps * PHYSICS_ENGINE_FIXED_SUBSTEP,
+                                                        PHYSICS_ENGINE_MAX_NUM_SUBSTEPS, PHYSICS_ENGINE_FIXED_SUBSTEP);
+    }
+
+    std::vector<btTransform> getTransforms() const {
+        std::vector<btTransform> transforms;
+        for (auto& body : _bodies) {
+            transforms.push_back(body->getWorldTransform());
+        }
+        return transforms;
+    }
+
+    ThreadSafeDynamicsWorld* getWorld() const { return _world; }
+
+private:
+    void addBody(btCollisionShape* shape, float mass, const btVector3& position) {
+        btVector3 inertia(0.0f, 0.0f, 0.0f);
+        if (mass > 0.0f) {
+            shape->calculateLocalInertia(mass, inertia);
+        }
+        btTransform transform;
+        transform.setIdentity();
+        transform.setOrigin(position);
+        btRigidBody::btRigidBodyConstructionInfo info(mass, nullptr, shape, inertia);
+        info.m_startWorldTransform = transform;
+        std::unique_ptr<btRigidBody> body(new btRigidBody(info));
+        _world->addRigidBody(body.get());
+        if (mass > 0.0f) {
+            body->setGravity(btVector3(0.0f, -9.8f, 0.0f));
+        }
+        _bodies.push_back(std::move(body));
+    }
+
+    ThreadSafeDynamicsWorld* _world;
+    btBoxShape _groundShape;
+    btBoxShape _boxShape;
+    std::vector<std::unique_ptr<btRigidBody>> _bodies;
+};
+
+void PhysicsEngineTests::testSubstepTimes() {
+    PhysicsEngine engine(glm::vec3(0.0f));
+    engine.init();
+    Pile pile(engine, 2, 2);
+
+    const int NUM_SUBSTEPS = 3;
+    QCOMPARE(pile.step(NUM_SUBSTEPS), NUM_SUBSTEPS);
+    QCOMPARE((int)pile.getWorld()->getLastSubstepTimes().size(), NUM_SUBSTEPS);
+
+    // a step too short to simulate clears the previous timings
+    pile.step(0);
+    QCOMPARE((int)pile.getWorld()->getLastSubstepTimes().size(), 0);
+}
+
+void PhysicsEngineTests::testDeterministicThreading() {
+    const int NUM_THREADS = 4;
+    const int NUM_STEPS = 60;
+    std::vector<std::vector<btTransform>> results;
+    for (int run = 0; run < 2; ++run) {
+        PhysicsEngine engine(glm::vec3(0.0f));
+        engine.init(NUM_THREADS, true);
+        Pile pile(engine, 6, 6);
+        for (int i = 0; i < NUM_STEPS; ++i) {
+            pile.step(1);
+        }
+        results.push_back(pile.getTransforms());
+    }
+
+    QCOMPARE(results[0].size(), results[1].size());
+    for (size_t i = 0; i < results[0].size(); ++i) {
+        // bitwise equal, not merely close
+        QCOMPARE(results[0][i].getOrigin(), results[1][i].getOrigin());
+        QCOMPARE(results[0][i].getRotation(), results[1][i].getRotation());
+    }
+}
+
+static std::vector<btTransform> simulatePile(int numThreads, bool deterministic, int numSteps) {
+    PhysicsEngine engine(glm::vec3(0.0f));
+    engine.init(numThreads, deterministic);
+    Pile pile(engine, 6, 6);
+    for (int i = 0; i < numSteps; ++i) {
+        pile.step(1);
+    }
+    return pile.getTransforms();
+}
+
+void PhysicsEngineTests::testSerialMatchesParallel() {
+    const int NUM_STEPS = 60;
+    std::vector<btTransform> serial = simulatePile(1, true, NUM_STEPS);
+
+    // islands are solved independently, so spreading them over threads must not change a bit
+    std::vector<btTransform> parallel = simulatePile(4, true, NUM_STEPS);
+    QCOMPARE(parallel.size(), serial.size());
+    for (size_t i = 0; i < serial.size(); ++i) {
+        QCOMPARE(parallel[i].getOrigin(), serial[i].getOrigin());
+        QCOMPARE(parallel[i].getRotation(), serial[i].getRotation());
+    }
+
+    // the multithreaded narrowphase and solver only match to within the solver's tolerance,
+    // but the pile must come to rest in the same place
+    std::vector<btTransform> unordered = simulatePile(4, false, NUM_STEPS);
+    QCOMPARE(unordered.size(), serial.size());
+    const btScalar TOLERANCE = 0.05f;
+    for (size_t i = 0; i < serial.size(); ++i) {
+        QVERIFY(unordered[i].getOrigin().distance(serial[i].getOrigin()) < TOLERANCE);
+    }
+}
+
+void PhysicsEngineTests::testSchedulerThreadIndices() {
+    // threads that touched Bullet before the scheduler already took the low indices
+    std::vector<std::thread> strangers;
+    for (int i = 0; i < 3; ++i) {
+        strangers.emplace_back([] { btGetCurrentThreadIndex(); });
+    }
+    for (auto& stranger : strangers) {
+        stranger.join();
+    }
+
+    const int NUM_THREADS = 4;
+    PhysicsTaskScheduler scheduler;
+    scheduler.setNumThreads(NUM_THREADS);
+    QVERIFY(scheduler.getNumActiveThreads() <= NUM_THREADS);
+    QVERIFY(scheduler.getNumThreads() <= (int)BT_MAX_THREAD_COUNT);
+
+    class RecordIndices : public btIParallelForBody {
+    public:
+        void forLoop(int iBegin, int iEnd) const override {
+            std::lock_guard<std::mutex> lock(mutex);
+            indices.insert((int)btGetCurrentThreadIndex());
+            numIterations += iEnd - iBegin;
+        }
+        mutable std::mutex mutex;
+        mutable std::set<int> indices;
+        mutable int numIterations { 0 };
+    };
+
+    // every loop body must run on a thread whose index fits in the slots Bullet sized its state by
+    const int NUM_ITERATIONS = 10000;
+    RecordIndices recorder;
+    for (int i = 0; i < 20; ++i) {
+        scheduler.parallelFor(0, NUM_ITERATIONS, 7, recorder);
+    }
+    QCOMPARE(recorder.numIterations, 20 * NUM_ITERATIONS);
+    QVERIFY((int)recorder.indices.size() <= scheduler.getNumActiveThreads());
+    for (int index : recorder.indices) {
+        QVERIFY(index < scheduler.getNumThreads());
+    }
+
+    // narrowing the pool keeps using the same workers
+    scheduler.setNumThreads(2);
+    recorder.indices.clear();
+    scheduler.parallelFor(0, NUM_ITERATIONS, 7, recorder);
+    QVERIFY((int)recorder.indices.size() <= 2);
+    for (int index : recorder.indices) {
+        QVERIFY(index < scheduler.getNumThreads());
+    }
+
+    class SumIndices : public btIParallelSumBody {
+    public:
+        btScalar sumLoop(int iBegin, int iEnd) const override {
+            btScalar sum = 0.0f;
+            for (int i = iBegin; i < iEnd; ++i) {
+                sum += 1.0f / (btScalar)(i + 1);
+            }
+            return sum;
+        }
+    };
+    SumIndices summer;
+    scheduler.setNumThreads(NUM_THREADS);
+    btScalar first = scheduler.parallelSum(0, NUM_ITERATIONS, 13, summer);
+    for (int i = 0; i < 10; ++i) {
+        QCOMPARE(scheduler.parallelSum(0, NUM_ITERATIONS, 13, summer), first);
+    }
+}
+
+void PhysicsEngineTests::benchmarkPile_data() {
+    QTest::addColumn<int>("numThreads");
+    QTest::newRow("1 thread") << 1;
+    QTest::newRow("4 threads") << 4;
+}
+
+void PhysicsEngineTests::benchmarkPile() {
+    QFETCH(int, numThreads);
+    PhysicsEngine engine(glm::vec3(0.0f));
+    engine.init(numThreads);
+    Pile pile(engine, 10, 10);
+    QBENCHMARK {
+        pile.step(1);
+    }
+}
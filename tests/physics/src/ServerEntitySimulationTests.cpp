@@ -0,0 +1,183 @@
+//
+//  ServerEntitySimulationTests.cpp
+//  tests/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ServerEntitySimulationTests.h"
+
+#include <AccountManager.h>
+#include <AddressManager.h>
+#include <EntityTree.h>
+#include <NodeList.h>
+#include <ServerEntitySimulation.h>
+#include <SimulationOwner.h>
+
+QTEST_MAIN(ServerEntitySimulationTests)
+
+static const QUuid SERVER_ID = QUuid::createUuid();
+static const QUuid CLIENT_ID = QUuid::createUuid();
+
+// an entity-server's tree with the simulation that adopts orphans
+class ServerWorld {
+public:
+    ServerWorld() :
+        tree(std::make_shared<EntityTree>()),
+        simulation(std::make_shared<ServerEntitySimulation>())
+    {
+        tree->setIsServer(true);
+        tree->createRootElement();
+        simulation->setEntityTree(tree);
+        tree->setSimulation(simulation);
+        tree->withWriteLock([&] {
+            simulation->setSessionID(SERVER_ID);
+        });
+    }
+
+    ~ServerWorld() {
+        tree->setSimulation(nullptr);
+    }
+
+    EntityItemPointer addBox(const glm::vec3& position, const glm::vec3& dimensions) {
+        EntityItemProperties properties;
+        properties.setType(EntityTypes::Box);
+        properties.setPosition(position);
+        properties.setDimensions(dimensions);
+        return tree->addEntity(EntityItemID(QUuid::createUuid()), properties);
+    }
+
+    // a dynamic box that loses its simulation owner, the way it does when that participant leaves the domain
+    EntityItemPointer addOrphan(const glm::vec3& position, const glm::vec3& velocity) {
+        EntityItemProperties properties;
+        properties.setType(EntityTypes::Box);
+        properties.setPosition(position);
+        properties.setDimensions(glm::vec3(0.2f));
+        properties.setDynamic(true);
+        properties.setVelocity(velocity);
+        properties.setGravity(glm::vec3(0.0f, -9.8f, 0.0f));
+        EntityItemPointer entity = tree->addEntity(EntityItemID(QUuid::createUuid()), properties);
+        changeOwner(entity, CLIENT_ID, RECRUIT_SIMULATION_PRIORITY);
+        simulation->clearOwnership(CLIENT_ID);
+        return entity;
+    }
+
+    // what the EntityTree does when it accepts a bid
+    void changeOwner(const EntityItemPointer& entity, const QUuid& id, uint8_t priority) {
+        entity->setSimulationOwner(SimulationOwner(id, priority));
+        simulation->changeEntity(entity);
+        update();
+    }
+
+    void update() {
+        tree->withWriteLock([&] {
+            simulation->processChangedEntities();
+            simulation->updateEntities();
+        });
+    }
+
+    EntityTreePointer tree;
+    ServerEntitySimulationPointer simulation;
+};
+
+void ServerEntitySimulationTests::initTestCase() {
+    // the EntityTree checks rez permissions with the NodeList
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<AccountManager>();
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::EntityServer, INVALID_PORT);
+}
+
+void ServerEntitySimulationTests::testAdoptsOrphanAboveIdleBids() {
+    ServerWorld world;
+    world.addBox(glm::vec3(0.0f, -0.5f, 0.0f), glm::vec3(20.0f, 1.0f, 20.0f));
+    EntityItemPointer orphan = world.addOrphan(glm::vec3(0.0f, 2.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+    QVERIFY(orphan->getSimulatorID().isNull());
+
+    world.update();
+    QCOMPARE(world.simulation->getNumAdoptedEntities(), 1);
+    QCOMPARE(orphan->getSimulatorID(), SERVER_ID);
+
+    // an idle client bids VOLUNTEER, and only while that is at least the current priority,
+    // so the server's claim must sit above it or the clients would take every orphan straight back
+    QVERIFY(orphan->getSimulationPriority() > VOLUNTEER_SIMULATION_PRIORITY);
+    QCOMPARE(orphan->getSimulationPriority(), RECRUIT_SIMULATION_PRIORITY);
+}
+
+void ServerEntitySimulationTests::testLandsOnEnvironment() {
+    ServerWorld world;
+    world.addBox(glm::vec3(0.0f, -0.5f, 0.0f), glm::vec3(20.0f, 1.0f, 20.0f));
+    EntityItemPointer orphan = world.addOrphan(glm::vec3(0.0f, 0.3f, 0.0f), glm::vec3(0.1f, 0.0f, 0.0f));
+
+    // the ground goes into the PhysicsEngine with the orphan, before its first step
+    world.update();
+    QCOMPARE(world.simulation->getNumAdoptedEntities(), 1);
+    QCOMPARE(world.simulation->getNumEnvironmentEntities(), 1);
+
+    // the PhysicsEngine steps in real time
+    for (int i = 0; i < 60; ++i) {
+        QTest::qSleep(16);
+        world.update();
+    }
+    QVERIFY(orphan->getWorldPosition().y > 0.05f);
+    QVERIFY(orphan->getWorldPosition().y < 0.3f);
+}
+
+void ServerEntitySimulationTests::testHandsOverToHigherBid() {
+    ServerWorld world;
+    world.addBox(glm::vec3(0.0f, -0.5f, 0.0f), glm::vec3(20.0f, 1.0f, 20.0f));
+    EntityItemPointer orphan = world.addOrphan(glm::vec3(0.0f, 2.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+    world.update();
+    QCOMPARE(world.simulation->getNumAdoptedEntities(), 1);
+
+    // a participant grabs it
+    const QUuid GRABBER_ID = QUuid::createUuid();
+    world.changeOwner(orphan, GRABBER_ID, SCRIPT_GRAB_SIMULATION_PRIORITY);
+    QCOMPARE(world.simulation->getNumAdoptedEntities(), 0);
+    QCOMPARE(orphan->getSimulatorID(), GRABBER_ID);
+    QCOMPARE(orphan->getSimulationPriority(), SCRIPT_GRAB_SIMULATION_PRIORITY);
+}
+
+void ServerEntitySimulationTests::testReleasesOnNewSession() {
+    ServerWorld world;
+    world.addBox(glm::vec3(0.0f, -0.5f, 0.0f), glm::vec3(20.0f, 1.0f, 20.0f));
+    EntityItemPointer orphan = world.addOrphan(glm::vec3(0.0f, 2.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+    world.update();
+    QCOMPARE(world.simulation->getNumAdoptedEntities(), 1);
+
+    // what was adopted under the old session ID is up for grabs, still moving
+    const QUuid NEW_SERVER_ID = QUuid::createUuid();
+    world.tree->withWriteLock([&] {
+        world.simulation->setSessionID(NEW_SERVER_ID);
+    });
+    QCOMPARE(world.simulation->getNumAdoptedEntities(), 0);
+    QVERIFY(orphan->getSimulatorID().isNull());
+    QVERIFY(orphan->hasLocalVelocity());
+
+    // and nobody volunteered, so the server takes it again under its new ID
+    world.update();
+    QCOMPARE(world.simulation->getNumAdoptedEntities(), 1);
+    QCOMPARE(orphan->getSimulatorID(), NEW_SERVER_ID);
+}
+
+void ServerEntitySimulationTests::testLeavesOrphanNextToModel() {
+    ServerWorld world;
+    world.addBox(glm::vec3(0.0f, -0.5f, 0.0f), glm::vec3(20.0f, 1.0f, 20.0f));
+
+    // the entity-server doesn't load models, it can't know the shape of this one
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Model);
+    properties.setPosition(glm::vec3(0.5f, 2.0f, 0.0f));
+    properties.setDimensions(glm::vec3(0.5f));
+    properties.setModelURL("http://localhost/model.fbx");
+    properties.setShapeType(SHAPE_TYPE_SIMPLE_HULL);
+    world.tree->addEntity(EntityItemID(QUuid::createUuid()), properties);
+
+    EntityItemPointer orphan = world.addOrphan(glm::vec3(0.0f, 2.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+    world.update();
+    QCOMPARE(world.simulation->getNumAdoptedEntities(), 0);
+    QVERIFY(orphan->getSimulatorID().isNull());
+}
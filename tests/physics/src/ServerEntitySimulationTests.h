@@ -0,0 +1,28 @@
+//
+//  ServerEntitySimulationTests.h
+//  tests/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ServerEntitySimulationTests_h
+#define hifi_ServerEntitySimulationTests_h
+
+#include <QtTest/QtTest>
+
+class ServerEntitySimulationTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void testAdoptsOrphanAboveIdleBids();
+    void testLandsOnEnvironment();
+    void testHandsOverToHigherBid();
+    void testReleasesOnNewSession();
+    void testLeavesOrphanNextToModel();
+};
+
+#endif // hifi_ServerEntitySimulationTests_h
@@ -13,6 +13,9 @@
 
 #include <iostream>
 
+#include <QTemporaryDir>
+
+#include <HullCache.h>
 #include <ShapeManager.h>
 #include <StreamUtils.h>
 #include <Extents.h>
@@ -244,3 +247,93 @@ void ShapeManagerTests::addCompoundShape() {
     QCOMPARE(shapeManager.getNumShapes(), 0);
     QCOMPARE(shapeManager.getNumReferences(info), 0);
 }
+
+static ShapeInfo makeCompoundInfo(float scale) {
+    QVector<glm::vec3> tetrahedron;
+    tetrahedron.push_back(glm::vec3(1.0f, 1.0f, 1.0f));
+    tetrahedron.push_back(glm::vec3(1.0f, -1.0f, -1.0f));
+    tetrahedron.push_back(glm::vec3(-1.0f, 1.0f, -1.0f));
+    tetrahedron.push_back(glm::vec3(-1.0f, -1.0f, 1.0f));
+
+    ShapeInfo::PointCollection pointCollection;
+    Extents extents;
+    const int NUM_HULLS = 3;
+    for (int i = 0; i < NUM_HULLS; ++i) {
+        ShapeInfo::PointList pointList;
+        for (const auto& corner : tetrahedron) {
+            glm::vec3 point = scale * (float)(i + 1) * corner + glm::vec3((float)i, 0.0f, 0.0f);
+            pointList.push_back(point);
+            extents.addPoint(point);
+        }
+        pointCollection.push_back(pointList);
+    }
+
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_COMPOUND, 0.5f * (extents.maximum - extents.minimum));
+    info.setPointCollection(pointCollection);
+    return info;
+}
+
+void ShapeManagerTests::hullCacheRoundTrip() {
+    ShapeInfo info = makeCompoundInfo(1.0f);
+    const btCollisionShape* shape = ShapeFactory::createShapeFromInfo(info);
+    QVERIFY(shape != nullptr);
+    const btCompoundShape* compound = static_cast<const btCompoundShape*>(shape);
+
+    HullCache::Hulls hulls;
+    for (int i = 0; i < compound->getNumChildShapes(); ++i) {
+        hulls.push_back(static_cast<btConvexHullShape*>(const_cast<btCollisionShape*>(compound->getChildShape(i))));
+    }
+    uint64_t fingerprint = HullCache::computeFingerprint(info);
+    QByteArray data = HullCache::serialize(fingerprint, hulls);
+
+    // a different fingerprint means the source points changed
+    HullCache::Hulls loaded;
+    QVERIFY(!HullCache::deserialize(data, fingerprint + 1, loaded));
+    QVERIFY(loaded.empty());
+    QVERIFY(!HullCache::deserialize(data.left(data.size() - 1), fingerprint, loaded));
+    QVERIFY(loaded.empty());
+
+    QVERIFY(HullCache::deserialize(data, fingerprint, loaded));
+    QCOMPARE(loaded.size(), hulls.size());
+    for (size_t i = 0; i < hulls.size(); ++i) {
+        QCOMPARE(loaded[i]->getNumPoints(), hulls[i]->getNumPoints());
+        QCOMPARE(loaded[i]->getMargin(), hulls[i]->getMargin());
+        for (int j = 0; j < hulls[i]->getNumPoints(); ++j) {
+            QCOMPARE(loaded[i]->getUnscaledPoints()[j], hulls[i]->getUnscaledPoints()[j]);
+        }
+        delete loaded[i];
+    }
+    ShapeFactory::deleteShape(shape);
+}
+
+void ShapeManagerTests::hullCacheHits() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    auto hullCache = std::make_shared<HullCache>(dir.path().toStdString());
+    hullCache->initialize();
+
+    ShapeInfo info = makeCompoundInfo(1.0f);
+    {
+        // first session computes the hulls and stores them
+        ShapeManager shapeManager;
+        shapeManager.setHullCache(hullCache);
+        const btCollisionShape* shape = shapeManager.getShape(info);
+        QVERIFY(shape != nullptr);
+        QCOMPARE(shapeManager.getNumHullCacheHits(), (uint32_t)0);
+        QCOMPARE(shapeManager.getNumHullCacheMisses(), (uint32_t)1);
+        shapeManager.releaseShape(shape);
+    }
+    {
+        // a later session loads them
+        ShapeManager shapeManager;
+        shapeManager.setHullCache(hullCache);
+        const btCollisionShape* shape = shapeManager.getShape(info);
+        QVERIFY(shape != nullptr);
+        QCOMPARE(shape->getShapeType(), (int)COMPOUND_SHAPE_PROXYTYPE);
+        QCOMPARE(static_cast<const btCompoundShape*>(shape)->getNumChildShapes(), 3);
+        QCOMPARE(shapeManager.getNumHullCacheHits(), (uint32_t)1);
+        QCOMPARE(shapeManager.getHullCacheHitRate(), 0.5f);
+        shapeManager.releaseShape(shape);
+    }
+}
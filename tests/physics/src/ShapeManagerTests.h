@@ -25,6 +25,8 @@ private slots:
     void addCylinderShape();
     void addCapsuleShape();
     void addCompoundShape();
+    void hullCacheRoundTrip();
+    void hullCacheHits();
 };
 
 #endif // hifi_ShapeManagerTests_h
@@ -0,0 +1,99 @@
+//
+//  SortTaskTests.cpp
+//  tests/render/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SortTaskTests.h"
+
+#include <algorithm>
+#include <random>
+
+#include <render/SortTask.h>
+
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(SortTaskTests)
+
+using namespace render;
+
+namespace {
+
+ItemSortKeys makeKeys(size_t numKeys, int numPipelines) {
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<float> distance(0.0f, 1000.0f);
+    std::uniform_int_distribution<int> pipeline(0, numPipelines - 1);
+    ItemSortKeys keys(numKeys);
+    for (size_t i = 0; i < numKeys; ++i) {
+        ShapeKey::Flags flags(1 << pipeline(generator));
+        keys[i] = { packSortKey(ShapeKey(flags), packSortDepth(distance(generator), true)), (uint32_t)i };
+    }
+    return keys;
+}
+
+bool lessKey(const ItemSortKey& left, const ItemSortKey& right) {
+    return left.key < right.key;
+}
+
+}
+
+void SortTaskTests::testPackSortDepth() {
+    QVERIFY(packSortDepth(0.5f, true) < packSortDepth(1.0f, true));
+    QVERIFY(packSortDepth(1.0f, true) < packSortDepth(1.0e6f, true));
+    QVERIFY(packSortDepth(0.5f, false) > packSortDepth(1.0f, false));
+    QCOMPARE(packSortDepth(-1.0f, true), packSortDepth(0.0f, true));
+}
+
+void SortTaskTests::testRadixSortKeys() {
+    // larger than one chunk so several workers scatter into the same digits
+    const size_t NUM_KEYS = 20011;
+    ItemSortKeys keys = makeKeys(NUM_KEYS, 8);
+    ItemSortKeys expected = keys;
+    std::stable_sort(expected.begin(), expected.end(), lessKey);
+
+    radixSortKeys(keys);
+    for (size_t i = 0; i < NUM_KEYS; ++i) {
+        QCOMPARE(keys[i].key, expected[i].key);
+        QCOMPARE(keys[i].index, expected[i].index);
+    }
+
+    // pipeline only, the items of a pipeline keep their order
+    keys = makeKeys(NUM_KEYS, 8);
+    radixSortKeys(keys, SORT_KEY_DEPTH_BITS);
+    for (size_t i = 1; i < NUM_KEYS; ++i) {
+        uint64_t previousPipeline = keys[i - 1].key >> SORT_KEY_DEPTH_BITS;
+        uint64_t pipeline = keys[i].key >> SORT_KEY_DEPTH_BITS;
+        QVERIFY(previousPipeline <= pipeline);
+        if (previousPipeline == pipeline) {
+            QVERIFY(keys[i - 1].index < keys[i].index);
+        }
+    }
+}
+
+void SortTaskTests::benchmarkRadixSortKeys() {
+    const size_t NUM_KEYS = 50000;
+    const int NUM_RUNS = 20;
+    const ItemSortKeys source = makeKeys(NUM_KEYS, 16);
+
+    QElapsedTimer timer;
+    qint64 radixTime = 0;
+    qint64 stdTime = 0;
+    for (int run = 0; run < NUM_RUNS; ++run) {
+        ItemSortKeys keys = source;
+        timer.start();
+        radixSortKeys(keys);
+        radixTime += timer.nsecsElapsed();
+
+        keys = source;
+        timer.start();
+        std::sort(keys.begin(), keys.end(), lessKey);
+        stdTime += timer.nsecsElapsed();
+    }
+
+    qDebug() << "radixSortKeys:" << NUM_KEYS << "keys in" << radixTime / (NUM_RUNS * 1000) << "usec";
+    qDebug() << "std::sort:" << NUM_KEYS << "keys in" << stdTime / (NUM_RUNS * 1000) << "usec";
+}
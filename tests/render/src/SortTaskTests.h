@@ -0,0 +1,24 @@
+//
+//  SortTaskTests.h
+//  tests/render/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SortTaskTests_h
+#define hifi_SortTaskTests_h
+
+#include <QtTest/QtTest>
+
+class SortTaskTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testPackSortDepth();
+    void testRadixSortKeys();
+    void benchmarkRadixSortKeys();
+};
+
+#endif // hifi_SortTaskTests_h
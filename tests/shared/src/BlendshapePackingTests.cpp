@@ -16,6 +16,8 @@
 #include <test-utils/QTestExtensions.h>
 
 #include <GLMHelpers.h>
+#include <SparseBlendshapes.h>
+#include <glm/gtc/packing.hpp>
 #include <glm/gtc/random.hpp>
 
 struct BlendshapeOffsetUnpacked {
@@ -146,3 +148,191 @@ void BlendshapePackingTests::testAVX2() {
         }
     }
 }
+
+namespace {
+
+const float NORMAL_COEFFICIENT_SCALE = 0.01f;
+
+struct TestBlendshape {
+    std::vector<int> indices;
+    std::vector<glm::vec3> vertices;
+    std::vector<glm::vec3> normals;
+    std::vector<glm::vec3> tangents;
+};
+
+// A head sized region of a larger mesh, moved by face tracking blendshapes
+std::vector<TestBlendshape> makeBlendshapes(int numVertices, int numFaceVertices, int numBlendshapes, int verticesPerBlendshape) {
+    std::vector<TestBlendshape> blendshapes(numBlendshapes);
+    for (auto& blendshape : blendshapes) {
+        int start = glm::linearRand(0, numFaceVertices - verticesPerBlendshape);
+        for (int i = 0; i < verticesPerBlendshape; ++i) {
+            blendshape.indices.push_back(numVertices - numFaceVertices + start + i);
+            blendshape.vertices.push_back(glm::linearRand(glm::vec3(-0.01f), glm::vec3(0.01f)));
+            blendshape.normals.push_back(glm::linearRand(glm::vec3(-1.0f), glm::vec3(1.0f)));
+            blendshape.tangents.push_back(glm::linearRand(glm::vec3(-1.0f), glm::vec3(1.0f)));
+        }
+    }
+    return blendshapes;
+}
+
+SparseBlendshapes makeSparse(int numVertices, const std::vector<TestBlendshape>& blendshapes) {
+    SparseBlendshapes sparse(numVertices);
+    for (const auto& blendshape : blendshapes) {
+        sparse.addBlendshape(blendshape.indices.data(), blendshape.vertices.data(), blendshape.normals.data(),
+                             blendshape.tangents.data(), (int)blendshape.tangents.size(), (int)blendshape.indices.size(),
+                             NORMAL_COEFFICIENT_SCALE);
+    }
+    sparse.finish();
+    return sparse;
+}
+
+// How the Blender evaluated every vertex of a mesh before the sparse layout
+void blendDense(int numVertices, const std::vector<TestBlendshape>& blendshapes, const std::vector<float>& coefficients,
+                std::vector<BlendshapeOffsetUnpacked>& unpacked, std::vector<BlendshapeOffsetPacked>& packed) {
+    memset(unpacked.data(), 0, numVertices * sizeof(BlendshapeOffsetUnpacked));
+    for (size_t i = 0; i < blendshapes.size() && i < coefficients.size(); ++i) {
+        float vertexCoefficient = coefficients[i];
+        const float EPSILON = 0.0001f;
+        if (vertexCoefficient < EPSILON) {
+            continue;
+        }
+        float normalCoefficient = vertexCoefficient * NORMAL_COEFFICIENT_SCALE;
+        const auto& blendshape = blendshapes[i];
+        for (size_t j = 0; j < blendshape.indices.size(); ++j) {
+            auto& offset = unpacked[blendshape.indices[j]];
+            offset.positionOffset += blendshape.vertices[j] * vertexCoefficient;
+            offset.normalOffset += blendshape.normals[j] * normalCoefficient;
+            offset.tangentOffset += blendshape.tangents[j] * normalCoefficient;
+        }
+    }
+    packBlendshapeOffsets(unpacked.data(), packed.data(), numVertices);
+}
+
+// Blend only the active vertices, then scatter them over the packed zero offset
+void blendSparse(const SparseBlendshapes& sparse, const std::vector<float>& coefficients, const BlendshapeOffsetPacked& packedZero,
+                 std::vector<BlendshapeOffsetUnpacked>& unpacked, std::vector<BlendshapeOffsetPacked>& packedActive,
+                 std::vector<BlendshapeOffsetPacked>& packed) {
+    const auto& activeVertices = sparse.getActiveVertices();
+    int numActive = (int)activeVertices.size();
+    memset(unpacked.data(), 0, numActive * sizeof(BlendshapeOffsetUnpacked));
+    sparse.blend(coefficients.data(), (int)coefficients.size(), (float(*)[SparseBlendshapes::OFFSET_SIZE])unpacked.data());
+    packBlendshapeOffsets(unpacked.data(), packedActive.data(), numActive);
+    sparse.scatter((const uint32_t(*)[4])packedActive.data(), (const uint32_t(&)[4])packedZero, (uint32_t(*)[4])packed.data());
+}
+
+// The inverse of packBlendshapeOffsetTo_Pos_F32_3xSN10_Nor_3xSN10_Tan_3xSN10
+BlendshapeOffsetUnpacked unpackBlendshapeOffset(const BlendshapeOffsetPacked& packed) {
+    BlendshapeOffsetUnpacked unpacked;
+    unpacked.positionOffset = glm::uintBitsToFloat(packed.packedPosNorTan.x) * glm::vec3(glm::unpackSnorm3x10_1x2(packed.packedPosNorTan.y));
+    unpacked.normalOffset = glm::vec3(glm::unpackSnorm3x10_1x2(packed.packedPosNorTan.z));
+    unpacked.tangentOffset = glm::vec3(glm::unpackSnorm3x10_1x2(packed.packedPosNorTan.w));
+    return unpacked;
+}
+
+}
+
+void BlendshapePackingTests::testSparseBlend() {
+    const int NUM_VERTICES = 2000;
+    auto blendshapes = makeBlendshapes(NUM_VERTICES, 600, 20, 100);
+    auto sparse = makeSparse(NUM_VERTICES, blendshapes);
+    const auto& activeVertices = sparse.getActiveVertices();
+    QVERIFY((int)activeVertices.size() <= 600);
+
+    std::vector<float> coefficients(blendshapes.size());
+    for (auto& coefficient : coefficients) {
+        coefficient = glm::linearRand(-0.5f, 1.0f);
+    }
+
+    std::vector<BlendshapeOffsetUnpacked> dense(NUM_VERTICES);
+    std::vector<BlendshapeOffsetPacked> packed(NUM_VERTICES);
+    blendDense(NUM_VERTICES, blendshapes, coefficients, dense, packed);
+
+    std::vector<BlendshapeOffsetUnpacked> unpacked(activeVertices.size());
+    memset(unpacked.data(), 0, unpacked.size() * sizeof(BlendshapeOffsetUnpacked));
+    sparse.blend(coefficients.data(), (int)coefficients.size(), (float(*)[SparseBlendshapes::OFFSET_SIZE])unpacked.data());
+
+    // the active vertices match the dense blend, and every other vertex has no offset
+    const float EPSILON = 1.0e-6f;
+    std::vector<bool> isActive(NUM_VERTICES, false);
+    for (size_t i = 0; i < activeVertices.size(); ++i) {
+        const auto& expected = dense[activeVertices[i]];
+        QCOMPARE_WITH_ABS_ERROR(unpacked[i].positionOffset.x, expected.positionOffset.x, EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(unpacked[i].positionOffset.y, expected.positionOffset.y, EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(unpacked[i].positionOffset.z, expected.positionOffset.z, EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(unpacked[i].normalOffset.x, expected.normalOffset.x, EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(unpacked[i].normalOffset.y, expected.normalOffset.y, EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(unpacked[i].normalOffset.z, expected.normalOffset.z, EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(unpacked[i].tangentOffset.x, expected.tangentOffset.x, EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(unpacked[i].tangentOffset.y, expected.tangentOffset.y, EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(unpacked[i].tangentOffset.z, expected.tangentOffset.z, EPSILON);
+        isActive[activeVertices[i]] = true;
+    }
+
+    BlendshapeOffsetUnpacked zero { glm::vec3(0.0f), glm::vec3(0.0f), glm::vec3(0.0f) };
+    BlendshapeOffsetPacked packedZero;
+    packBlendshapeOffsets_ref(&zero, &packedZero, 1);
+    for (int i = 0; i < NUM_VERTICES; ++i) {
+        if (!isActive[i]) {
+            QVERIFY(dense[i].positionOffset == glm::vec3(0.0f));
+            QVERIFY(packed[i].packedPosNorTan == packedZero.packedPosNorTan);
+        }
+    }
+
+    // the scattered output holds, at every vertex, the packed dense offset of that vertex
+    std::vector<BlendshapeOffsetUnpacked> sparseUnpacked(activeVertices.size());
+    std::vector<BlendshapeOffsetPacked> packedActive(activeVertices.size());
+    std::vector<BlendshapeOffsetPacked> sparsePacked(NUM_VERTICES);
+    blendSparse(sparse, coefficients, packedZero, sparseUnpacked, packedActive, sparsePacked);
+    const float SNORM10_EPSILON = 1.0f / 511.0f;
+    for (int i = 0; i < NUM_VERTICES; ++i) {
+        if (!isActive[i]) {
+            QVERIFY(sparsePacked[i].packedPosNorTan == packedZero.packedPosNorTan);
+            continue;
+        }
+        auto result = unpackBlendshapeOffset(sparsePacked[i]);
+        const auto& expected = dense[i];
+        float positionEpsilon = glm::compMax(glm::abs(expected.positionOffset)) * SNORM10_EPSILON + EPSILON;
+        for (int j = 0; j < 3; ++j) {
+            QCOMPARE_WITH_ABS_ERROR(result.positionOffset[j], expected.positionOffset[j], positionEpsilon);
+            QCOMPARE_WITH_ABS_ERROR(result.normalOffset[j], glm::clamp(expected.normalOffset[j], -1.0f, 1.0f), SNORM10_EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(result.tangentOffset[j], glm::clamp(expected.tangentOffset[j], -1.0f, 1.0f), SNORM10_EPSILON);
+        }
+    }
+}
+
+// A crowd of 50 talking avatars: 20k vertex meshes with face tracking blendshapes around 3k of them
+void BlendshapePackingTests::benchmarkSparseBlend() {
+    const int NUM_AVATARS = 50;
+    const int NUM_VERTICES = 20000;
+    auto blendshapes = makeBlendshapes(NUM_VERTICES, 3000, 50, 400);
+    auto sparse = makeSparse(NUM_VERTICES, blendshapes);
+
+    std::vector<float> coefficients(blendshapes.size());
+    for (auto& coefficient : coefficients) {
+        coefficient = glm::linearRand(0.0f, 1.0f);
+    }
+
+    std::vector<BlendshapeOffsetUnpacked> unpacked(NUM_VERTICES);
+    std::vector<BlendshapeOffsetPacked> packedActive(NUM_VERTICES);
+    std::vector<BlendshapeOffsetPacked> packed(NUM_VERTICES);
+    BlendshapeOffsetPacked packedZero;
+    BlendshapeOffsetUnpacked zero { glm::vec3(0.0f), glm::vec3(0.0f), glm::vec3(0.0f) };
+    packBlendshapeOffsets_ref(&zero, &packedZero, 1);
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < NUM_AVATARS; ++i) {
+        blendDense(NUM_VERTICES, blendshapes, coefficients, unpacked, packed);
+    }
+    qint64 denseNsecs = timer.nsecsElapsed();
+
+    timer.restart();
+    for (int i = 0; i < NUM_AVATARS; ++i) {
+        blendSparse(sparse, coefficients, packedZero, unpacked, packedActive, packed);
+    }
+    qint64 sparseNsecs = timer.nsecsElapsed();
+
+    qDebug() << "dense" << (double)denseNsecs / 1.0e6 << "ms for" << NUM_AVATARS << "blends";
+    qDebug() << "sparse" << (double)sparseNsecs / 1.0e6 << "ms for" << NUM_AVATARS << "blends,"
+             << sparse.getActiveVertices().size() << "of" << NUM_VERTICES << "vertices active";
+}
@@ -0,0 +1,171 @@
+//
+//  FrustumCullerTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FrustumCullerTests.h"
+
+#include <random>
+
+#include <glm/gtc/quaternion.hpp>
+
+#include <FrustumCuller.h>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(FrustumCullerTests)
+
+namespace {
+
+// boxes closer than this to a plane may be classified either way once the plane math is fused
+const float TOLERANCE = 1.0e-3f;
+
+ViewFrustum makeFrustum(const glm::vec3& position, const glm::quat& orientation, float nearClip, float farClip) {
+    ViewFrustum frustum;
+    frustum.setProjection(60.0f, 1.5f, nearClip, farClip);
+    frustum.setPosition(position);
+    frustum.setOrientation(orientation);
+    frustum.calculate();
+    return frustum;
+}
+
+std::vector<AABox> makeBoxes(int numBoxes) {
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> size(0.01f, 10.0f);
+    std::vector<AABox> boxes;
+    for (int i = 0; i < numBoxes; ++i) {
+        glm::vec3 corner(position(generator), position(generator), position(generator));
+        glm::vec3 scale(size(generator), size(generator), size(generator));
+        boxes.emplace_back(corner, scale);
+    }
+    return boxes;
+}
+
+bool isNearBoundary(const ViewFrustum& frustum, const AABox& box) {
+    const ::Plane* planes = frustum.getPlanes();
+    for (int p = 0; p < NUM_FRUSTUM_PLANES; ++p) {
+        const glm::vec3& normal = planes[p].getNormal();
+        if (fabsf(planes[p].distance(box.getFarthestVertex(normal))) < TOLERANCE ||
+            fabsf(planes[p].distance(box.getNearestVertex(normal))) < TOLERANCE) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}
+
+void FrustumCullerTests::testMatchesViewFrustum() {
+    // odd count so both the SIMD blocks and the scalar tail are covered
+    const int NUM_BOXES = 1001;
+    std::vector<AABox> boxes = makeBoxes(NUM_BOXES);
+    FrustumCuller::Boxes soa;
+    for (const auto& box : boxes) {
+        soa.push_back(box);
+    }
+
+    std::vector<ViewFrustum> frustums;
+    frustums.push_back(makeFrustum(glm::vec3(0.0f), glm::quat(), 0.1f, 50.0f));
+    frustums.push_back(makeFrustum(glm::vec3(10.0f, 5.0f, -3.0f), glm::angleAxis(1.0f, glm::vec3(0.0f, 1.0f, 0.0f)), 1.0f, 80.0f));
+    frustums.push_back(makeFrustum(glm::vec3(-20.0f, 0.0f, 20.0f), glm::angleAxis(-2.5f, glm::normalize(glm::vec3(1.0f, 1.0f, 0.0f))), 0.5f, 120.0f));
+
+    FrustumCuller culler;
+    for (const auto& frustum : frustums) {
+        culler.addView(frustum);
+    }
+    QCOMPARE(culler.getNumViews(), (int)frustums.size());
+
+    // cull a sub range to check the offsets
+    const size_t BEGIN = 3;
+    std::vector<FrustumCuller::ViewMask> masks(NUM_BOXES - BEGIN);
+    culler.cull(soa, BEGIN, NUM_BOXES, masks.data());
+
+    int numVisible = 0;
+    for (size_t i = BEGIN; i < (size_t)NUM_BOXES; ++i) {
+        for (size_t v = 0; v < frustums.size(); ++v) {
+            if (isNearBoundary(frustums[v], boxes[i])) {
+                continue;
+            }
+            bool expected = frustums[v].boxIntersectsFrustum(boxes[i]);
+            bool visible = (masks[i - BEGIN] & (1 << v)) != 0;
+            QCOMPARE(visible, expected);
+            numVisible += visible ? 1 : 0;
+        }
+    }
+    QVERIFY(numVisible > 0);
+}
+
+void FrustumCullerTests::testAntiFrustum() {
+    const int NUM_BOXES = 517;
+    std::vector<AABox> boxes = makeBoxes(NUM_BOXES);
+    FrustumCuller::Boxes soa;
+    for (const auto& box : boxes) {
+        soa.push_back(box);
+    }
+
+    ViewFrustum frustum = makeFrustum(glm::vec3(0.0f), glm::quat(), 0.1f, 150.0f);
+    ViewFrustum antiFrustum = makeFrustum(glm::vec3(0.0f), glm::quat(), 0.1f, 60.0f);
+    FrustumCuller culler;
+    FrustumCuller::ViewMask bit = culler.addView(frustum, &antiFrustum);
+    QCOMPARE(bit, (FrustumCuller::ViewMask)1);
+
+    std::vector<FrustumCuller::ViewMask> masks(NUM_BOXES);
+    culler.cull(soa, 0, NUM_BOXES, masks.data());
+
+    int numExcluded = 0;
+    for (int i = 0; i < NUM_BOXES; ++i) {
+        if (isNearBoundary(frustum, boxes[i]) || isNearBoundary(antiFrustum, boxes[i])) {
+            continue;
+        }
+        bool intersects = frustum.boxIntersectsFrustum(boxes[i]);
+        bool inside = antiFrustum.boxInsideFrustum(boxes[i]);
+        QCOMPARE((masks[i] & bit) != 0, intersects && !inside);
+        numExcluded += (intersects && inside) ? 1 : 0;
+    }
+    QVERIFY(numExcluded > 0);
+}
+
+void FrustumCullerTests::benchmarkCull() {
+    const int NUM_BOXES = 100000;
+    const int NUM_VIEWS = 4;
+    std::vector<AABox> boxes = makeBoxes(NUM_BOXES);
+    FrustumCuller::Boxes soa;
+    soa.reserve(NUM_BOXES);
+    for (const auto& box : boxes) {
+        soa.push_back(box);
+    }
+
+    std::vector<ViewFrustum> frustums;
+    FrustumCuller culler;
+    for (int v = 0; v < NUM_VIEWS; ++v) {
+        frustums.push_back(makeFrustum(glm::vec3(0.0f), glm::angleAxis((float)v, glm::vec3(0.0f, 1.0f, 0.0f)), 0.1f, 20.0f * (v + 1)));
+    }
+    for (const auto& frustum : frustums) {
+        culler.addView(frustum);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    int numVisible = 0;
+    for (const auto& frustum : frustums) {
+        for (const auto& box : boxes) {
+            numVisible += frustum.boxIntersectsFrustum(box) ? 1 : 0;
+        }
+    }
+    qint64 scalarTime = timer.nsecsElapsed();
+
+    std::vector<FrustumCuller::ViewMask> masks(NUM_BOXES);
+    timer.restart();
+    culler.cull(soa, 0, NUM_BOXES, masks.data());
+    qint64 batchTime = timer.nsecsElapsed();
+
+    qDebug() << "ViewFrustum:" << NUM_VIEWS << "views," << NUM_BOXES << "boxes," << numVisible << "visible in" << scalarTime / 1000 << "usec";
+    qDebug() << "FrustumCuller:" << NUM_VIEWS << "views," << NUM_BOXES << "boxes in" << batchTime / 1000 << "usec";
+}
@@ -0,0 +1,24 @@
+//
+//  FrustumCullerTests.h
+//  tests/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FrustumCullerTests_h
+#define hifi_FrustumCullerTests_h
+
+#include <QtTest/QtTest>
+
+class FrustumCullerTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testMatchesViewFrustum();
+    void testAntiFrustum();
+    void benchmarkCull();
+};
+
+#endif // hifi_FrustumCullerTests_h
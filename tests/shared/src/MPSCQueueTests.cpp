@@ -0,0 +1,92 @@
+//
+//  MPSCQueueTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MPSCQueueTests.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <shared/MPSCQueue.h>
+
+QTEST_MAIN(MPSCQueueTests)
+
+namespace {
+
+const int NUM_PRODUCERS = 4;
+const int NUM_PUSHES = 200000;
+
+}
+
+void MPSCQueueTests::testPopAllOrder() {
+    MPSCQueue<std::unique_ptr<int>> queue;
+    QVERIFY(queue.empty());
+
+    for (int i = 0; i < 10; ++i) {
+        queue.push(std::unique_ptr<int>(new int(i)));
+    }
+    QVERIFY(!queue.empty());
+
+    std::vector<std::unique_ptr<int>> values;
+    values.emplace_back(new int(-1));
+    QCOMPARE(queue.popAll(values), (size_t)10);
+    QVERIFY(queue.empty());
+
+    // Appended after what was already there, oldest first
+    QCOMPARE((int)values.size(), 11);
+    for (int i = 0; i < 11; ++i) {
+        QCOMPARE(*values[i], i - 1);
+    }
+
+    QCOMPARE(queue.popAll(values), (size_t)0);
+    QCOMPARE((int)values.size(), 11);
+}
+
+void MPSCQueueTests::testManyProducers() {
+    MPSCQueue<std::pair<int, int>> queue;
+    std::atomic<int> doneProducers { 0 };
+
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < NUM_PRODUCERS; ++producer) {
+        producers.emplace_back([&, producer] {
+            for (int i = 0; i < NUM_PUSHES; ++i) {
+                queue.push(std::make_pair(producer, i));
+            }
+            ++doneProducers;
+        });
+    }
+
+    // Drain while the producers are running, every producer's values must come out in the order it pushed them
+    std::vector<int> nextValues(NUM_PRODUCERS, 0);
+    int outOfOrder = 0;
+    std::vector<std::pair<int, int>> values;
+    bool done = false;
+    while (!done) {
+        done = (doneProducers == NUM_PRODUCERS);
+        values.clear();
+        queue.popAll(values);
+        for (const auto& value : values) {
+            if (value.second != nextValues[value.first]) {
+                ++outOfOrder;
+            }
+            nextValues[value.first] = value.second + 1;
+        }
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    QCOMPARE(outOfOrder, 0);
+    for (int producer = 0; producer < NUM_PRODUCERS; ++producer) {
+        QCOMPARE(nextValues[producer], NUM_PUSHES);
+    }
+    QVERIFY(queue.empty());
+}
@@ -0,0 +1,170 @@
+//
+//  ParticleSimulationTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ParticleSimulationTests.h"
+
+#include <deque>
+
+#include <ParticleSimulation.h>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(ParticleSimulationTests)
+
+namespace {
+
+const float TOLERANCE = 1.0e-4f;
+const float DELTA_TIME = 1.0f / 60.0f;
+
+ParticleSimulation::Particle makeParticle(int i) {
+    ParticleSimulation::Particle particle;
+    particle.seed = (float)(i % 200) / 100.0f - 1.0f;
+    particle.expiration = 1000 + i;
+    particle.basePosition = glm::vec3(1.0f, 2.0f, 3.0f);
+    particle.relativePosition = glm::vec3(0.01f * i, -0.02f * i, 0.0f);
+    particle.velocity = glm::vec3(1.0f, 0.5f * (i % 7), -0.25f);
+    particle.acceleration = glm::vec3(0.0f, -9.8f, 0.1f * (i % 3));
+    return particle;
+}
+
+// The array of structures integration the particle renderer used to do
+void integrateReference(ParticleSimulation::Particle& particle, float deltaTime) {
+    glm::vec3 atSquared = (0.5f * deltaTime * deltaTime) * particle.acceleration;
+    particle.relativePosition += particle.velocity * deltaTime + atSquared;
+    particle.velocity += particle.acceleration * deltaTime;
+    particle.lifetime += deltaTime;
+}
+
+}
+
+void ParticleSimulationTests::testIntegrate() {
+    // odd count so both the SIMD blocks and the scalar tail are covered
+    const int NUM_PARTICLES = 37;
+    ParticleSimulation simulation;
+    std::vector<ParticleSimulation::Particle> reference;
+    for (int i = 0; i < NUM_PARTICLES; ++i) {
+        simulation.add(makeParticle(i));
+        reference.push_back(makeParticle(i));
+    }
+
+    for (int step = 0; step < 30; ++step) {
+        simulation.integrate(DELTA_TIME);
+        for (auto& particle : reference) {
+            integrateReference(particle, DELTA_TIME);
+        }
+    }
+
+    QCOMPARE((int)simulation.size(), NUM_PARTICLES);
+    for (int i = 0; i < NUM_PARTICLES; ++i) {
+        auto particle = simulation.get(i);
+        QCOMPARE_WITH_ABS_ERROR(particle.relativePosition, reference[i].relativePosition, TOLERANCE);
+        QCOMPARE_WITH_ABS_ERROR(particle.velocity, reference[i].velocity, TOLERANCE);
+        QCOMPARE_WITH_ABS_ERROR(particle.lifetime, reference[i].lifetime, TOLERANCE);
+    }
+
+    ParticleSimulation::Instances instances;
+    simulation.writeInstances(glm::vec3(10.0f), true, instances);
+    QCOMPARE((int)instances.size(), NUM_PARTICLES);
+    for (int i = 0; i < NUM_PARTICLES; ++i) {
+        QCOMPARE_WITH_ABS_ERROR(instances[i].xyz, reference[i].relativePosition + reference[i].basePosition, TOLERANCE);
+        QCOMPARE(instances[i].uv.y, reference[i].seed);
+    }
+    simulation.writeInstances(glm::vec3(10.0f), false, instances);
+    QCOMPARE_WITH_ABS_ERROR(instances[0].xyz, reference[0].relativePosition + glm::vec3(10.0f), TOLERANCE);
+}
+
+void ParticleSimulationTests::testExpire() {
+    ParticleSimulation simulation;
+    for (int i = 0; i < 100; ++i) {
+        simulation.add(makeParticle(i));
+    }
+
+    // expiration of particle i is 1000 + i
+    simulation.expire(1009, 1000);
+    QCOMPARE((int)simulation.size(), 90);
+    QCOMPARE(simulation.get(0).expiration, (uint64_t)1010);
+
+    // over the max keeps the newest
+    simulation.expire(0, 20);
+    QCOMPARE((int)simulation.size(), 20);
+    QCOMPARE(simulation.get(0).expiration, (uint64_t)1080);
+    QCOMPARE(simulation.get(19).expiration, (uint64_t)1099);
+
+    // adding after a compaction keeps emission order
+    simulation.add(makeParticle(100));
+    QCOMPARE((int)simulation.size(), 21);
+    QCOMPARE(simulation.get(20).expiration, (uint64_t)1100);
+
+    simulation.expire(2000, 1000);
+    QVERIFY(simulation.empty());
+}
+
+void ParticleSimulationTests::testRebase() {
+    const glm::vec3 EMITTER_POSITION(-5.0f, 0.0f, 5.0f);
+    ParticleSimulation simulation;
+    simulation.add(makeParticle(3));
+    auto before = simulation.get(0);
+
+    // trailing particles keep their world position when the emitter stops trailing
+    simulation.rebase(EMITTER_POSITION, true);
+    auto after = simulation.get(0);
+    QCOMPARE_WITH_ABS_ERROR(after.basePosition, EMITTER_POSITION, TOLERANCE);
+    QCOMPARE_WITH_ABS_ERROR(after.relativePosition + after.basePosition, before.relativePosition + before.basePosition, TOLERANCE);
+
+    // particles that followed the emitter keep their offset
+    simulation.rebase(glm::vec3(0.0f), false);
+    QCOMPARE_WITH_ABS_ERROR(simulation.get(0).relativePosition, after.relativePosition, TOLERANCE);
+    QCOMPARE_WITH_ABS_ERROR(simulation.get(0).basePosition, glm::vec3(0.0f), TOLERANCE);
+}
+
+// One emitter at a typical maxParticles, stepped the way the renderer steps it every frame:
+// expire, integrate and write the instance buffer, against the deque of structures it replaced.
+void ParticleSimulationTests::benchmarkStep() {
+    const int NUM_PARTICLES = 10000;
+    const int NUM_STEPS = 1000;
+
+    std::deque<ParticleSimulation::Particle> particles;
+    ParticleSimulation simulation;
+    for (int i = 0; i < NUM_PARTICLES; ++i) {
+        particles.push_back(makeParticle(i));
+        simulation.add(makeParticle(i));
+    }
+    ParticleSimulation::Instances instances;
+    const glm::vec3 emitterPosition(1.0f);
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int step = 0; step < NUM_STEPS; ++step) {
+        while (particles.size() > (size_t)NUM_PARTICLES || (!particles.empty() && particles.front().expiration <= 0)) {
+            particles.pop_front();
+        }
+        for (auto& particle : particles) {
+            integrateReference(particle, DELTA_TIME);
+        }
+        instances.clear();
+        for (const auto& particle : particles) {
+            instances.emplace_back(particle.relativePosition + emitterPosition, glm::vec2(particle.lifetime, particle.seed));
+        }
+    }
+    qint64 dequeNsecs = timer.nsecsElapsed();
+
+    timer.restart();
+    for (int step = 0; step < NUM_STEPS; ++step) {
+        simulation.expire(0, NUM_PARTICLES);
+        simulation.integrate(DELTA_TIME);
+        simulation.writeInstances(emitterPosition, false, instances);
+    }
+    qint64 simulationNsecs = timer.nsecsElapsed();
+
+    QCOMPARE_WITH_ABS_ERROR(simulation.get(NUM_PARTICLES - 1).relativePosition, particles.back().relativePosition, 1.0e-2f);
+    qDebug() << "deque of particles" << (double)dequeNsecs / (NUM_STEPS * NUM_PARTICLES) << "ns per particle step";
+    qDebug() << "ParticleSimulation" << (double)simulationNsecs / (NUM_STEPS * NUM_PARTICLES) << "ns per particle step";
+}
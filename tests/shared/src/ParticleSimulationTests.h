@@ -0,0 +1,26 @@
+//
+//  ParticleSimulationTests.h
+//  tests/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ParticleSimulationTests_h
+#define hifi_ParticleSimulationTests_h
+
+#include <QtTest/QtTest>
+
+class ParticleSimulationTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testIntegrate();
+    void testExpire();
+    void testRebase();
+    void benchmarkStep();
+};
+
+#endif // hifi_ParticleSimulationTests_h
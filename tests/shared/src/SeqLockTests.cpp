@@ -0,0 +1,157 @@
+//
+//  SeqLockTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SeqLockTests.h"
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <SpatiallyNestable.h>
+#include <shared/ReadWriteLockable.h>
+#include <shared/SeqLock.h>
+
+QTEST_MAIN(SeqLockTests)
+
+namespace {
+
+struct Pose {
+    glm::vec3 position;
+    glm::vec3 velocity;
+};
+
+const int NUM_READERS = 4;
+const int NUM_WRITES = 200000;
+
+class TestNestable : public SpatiallyNestable {
+public:
+    TestNestable() : SpatiallyNestable(NestableType::Entity, QUuid::createUuid()) {}
+};
+
+}
+
+void SeqLockTests::testSnapshotConsistency() {
+    SeqLocked<Pose> pose;
+    std::atomic<bool> done { false };
+    std::atomic<int> tornReads { 0 };
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < NUM_READERS; ++i) {
+        readers.emplace_back([&] {
+            while (!done) {
+                Pose snapshot = pose.get();
+                if (snapshot.position != snapshot.velocity || snapshot.position.x != snapshot.position.z) {
+                    ++tornReads;
+                }
+            }
+        });
+    }
+    for (int i = 0; i < NUM_WRITES; ++i) {
+        pose.update([&](Pose& value) {
+            value.position = glm::vec3((float)i);
+            value.velocity = glm::vec3((float)i);
+        });
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    QCOMPARE(tornReads.load(), 0);
+    QCOMPARE(pose.get().position, glm::vec3((float)(NUM_WRITES - 1)));
+}
+
+void SeqLockTests::testNestableState() {
+    TestNestable nestable;
+    glm::vec3 position(1.0f, 2.0f, 3.0f);
+    glm::quat orientation = glm::angleAxis(0.5f, glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::vec3 velocity(0.0f, -9.8f, 0.0f);
+
+    nestable.setLocalPosition(position);
+    nestable.setLocalOrientation(orientation);
+    nestable.setLocalVelocity(velocity);
+    nestable.setLocalSNScale(glm::vec3(2.0f));
+
+    auto state = nestable.getLocalSpatialState();
+    QCOMPARE(state.translation, position);
+    QCOMPARE(state.rotation, orientation);
+    QCOMPARE(state.velocity, velocity);
+    QCOMPARE(state.scale, glm::vec3(2.0f));
+    QCOMPARE(nestable.getLocalTransform().getTranslation(), position);
+
+    // the snapshot follows transforms set as a whole too
+    Transform transform;
+    transform.setTranslation(glm::vec3(-4.0f));
+    nestable.setLocalTransform(transform);
+    QCOMPARE(nestable.getLocalPosition(), glm::vec3(-4.0f));
+    QCOMPARE(nestable.getLocalSNScale(), glm::vec3(1.0f));
+}
+
+// Many threads read a pose while one thread keeps writing it, the way send threads, physics and
+// rendering read entity transforms while the simulation moves them.
+void SeqLockTests::benchmarkManyReaders() {
+    const int NUM_READS = 1000000;
+
+    auto run = [&](std::function<Pose()> read, std::function<void(const Pose&)> write) {
+        std::atomic<bool> done { false };
+        std::thread writer([&] {
+            Pose pose;
+            while (!done) {
+                pose.position.x += 1.0f;
+                write(pose);
+            }
+        });
+        QElapsedTimer timer;
+        timer.start();
+        std::vector<std::thread> readers;
+        for (int i = 0; i < NUM_READERS; ++i) {
+            readers.emplace_back([&] {
+                volatile float last = 0.0f;
+                for (int j = 0; j < NUM_READS; ++j) {
+                    last = read().position.x;
+                }
+                Q_UNUSED(last);
+            });
+        }
+        for (auto& reader : readers) {
+            reader.join();
+        }
+        qint64 elapsed = timer.nsecsElapsed();
+        done = true;
+        writer.join();
+        return elapsed;
+    };
+
+    ReadWriteLockable lockable;
+    Pose lockedPose;
+    qint64 lockedNsecs = run([&] {
+        return lockable.resultWithReadLock<Pose>([&] { return lockedPose; });
+    }, [&](const Pose& pose) {
+        lockable.withWriteLock([&] { lockedPose = pose; });
+    });
+
+    SeqLocked<Pose> seqLockedPose;
+    SeqLockStats::reset();
+    qint64 seqLockedNsecs = run([&] {
+        return seqLockedPose.get();
+    }, [&](const Pose& pose) {
+        seqLockedPose.set(pose);
+    });
+
+    int numReads = NUM_READERS * NUM_READS;
+    qDebug() << NUM_READERS << "readers, 1 writer:";
+    qDebug() << "    read lock" << (double)lockedNsecs / numReads << "nsecs per read";
+    qDebug() << "    seqlock  " << (double)seqLockedNsecs / numReads << "nsecs per read,"
+             << SeqLockStats::getReadRetries() << "read retries," << SeqLockStats::getWriteWaits() << "write waits";
+}
@@ -0,0 +1,25 @@
+//
+//  SeqLockTests.h
+//  tests/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SeqLockTests_h
+#define hifi_SeqLockTests_h
+
+#include <QtTest/QtTest>
+
+class SeqLockTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testSnapshotConsistency();
+    void testNestableState();
+    void benchmarkManyReaders();
+};
+
+#endif // hifi_SeqLockTests_h
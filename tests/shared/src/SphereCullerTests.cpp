@@ -0,0 +1,157 @@
+//
+//  SphereCullerTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SphereCullerTests.h"
+
+#include <random>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <SphereCuller.h>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(SphereCullerTests)
+
+namespace {
+
+// spheres closer than this to a plane may be classified either way once the plane math is fused
+const float TOLERANCE = 1.0e-3f;
+
+SphereCuller::Spheres makeSpheres(int numSpheres) {
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> radius(0.1f, 20.0f);
+    SphereCuller::Spheres spheres;
+    for (int i = 0; i < numSpheres; ++i) {
+        spheres.push_back(glm::vec3(position(generator), position(generator), position(generator)), radius(generator));
+    }
+    return spheres;
+}
+
+glm::mat4 makeTransform() {
+    glm::mat4 transform = glm::translate(glm::mat4(), glm::vec3(3.0f, -7.0f, 12.0f));
+    return glm::rotate(transform, 0.7f, glm::normalize(glm::vec3(1.0f, 2.0f, -0.5f)));
+}
+
+// The planes of a light cluster grid: near range and the four sides of a 90 degree frustum
+std::vector<glm::vec4> makePlanes() {
+    const float HALF_SQRT_2 = 0.70710678f;
+    return {
+        glm::vec4(0.0f, 0.0f, -1.0f, -0.5f),
+        glm::vec4(HALF_SQRT_2, 0.0f, -HALF_SQRT_2, 0.0f),
+        glm::vec4(-HALF_SQRT_2, 0.0f, -HALF_SQRT_2, 0.0f),
+        glm::vec4(0.0f, HALF_SQRT_2, -HALF_SQRT_2, 0.0f),
+        glm::vec4(0.0f, -HALF_SQRT_2, -HALF_SQRT_2, 0.0f)
+    };
+}
+
+}
+
+void SphereCullerTests::testMatchesScalar() {
+    // odd count so both the SIMD blocks and the scalar tail are covered
+    const int NUM_SPHERES = 1001;
+    SphereCuller::Spheres spheres = makeSpheres(NUM_SPHERES);
+    glm::mat4 transform = makeTransform();
+    std::vector<glm::vec4> planes = makePlanes();
+
+    SphereCuller culler;
+    culler.setTransform(transform);
+    for (const auto& plane : planes) {
+        QVERIFY(culler.addPlane(plane));
+    }
+    QCOMPARE(culler.getNumPlanes(), (int)planes.size());
+
+    // cull a sub range to check the offsets
+    const size_t BEGIN = 3;
+    SphereCuller::Spheres viewSpheres;
+    viewSpheres.resize(NUM_SPHERES);
+    std::vector<uint8_t> inside(NUM_SPHERES - BEGIN);
+    culler.cull(spheres, BEGIN, NUM_SPHERES, viewSpheres, inside.data());
+
+    int numInside = 0;
+    for (size_t i = BEGIN; i < (size_t)NUM_SPHERES; ++i) {
+        glm::vec3 center = glm::vec3(transform * glm::vec4(spheres.x[i], spheres.y[i], spheres.z[i], 1.0f));
+        QCOMPARE_WITH_ABS_ERROR(glm::vec3(viewSpheres.x[i], viewSpheres.y[i], viewSpheres.z[i]), center, TOLERANCE);
+        QCOMPARE(viewSpheres.radius[i], spheres.radius[i]);
+
+        bool expected = true;
+        bool nearBoundary = false;
+        for (const auto& plane : planes) {
+            float distance = glm::dot(glm::vec3(plane), center) + plane.w + spheres.radius[i];
+            nearBoundary |= fabsf(distance) < TOLERANCE;
+            expected &= distance >= 0.0f;
+        }
+        if (nearBoundary) {
+            continue;
+        }
+        QCOMPARE(inside[i - BEGIN] != 0, expected);
+        numInside += expected ? 1 : 0;
+    }
+    QVERIFY(numInside > 0);
+}
+
+void SphereCullerTests::testPlaneLimit() {
+    SphereCuller culler;
+    for (int p = 0; p < SphereCuller::MAX_PLANES; ++p) {
+        QVERIFY(culler.addPlane(glm::vec4(0.0f, 0.0f, 1.0f, (float)p)));
+    }
+    QVERIFY(!culler.addPlane(glm::vec4(0.0f, 0.0f, 1.0f, 0.0f)));
+    QCOMPARE(culler.getNumPlanes(), (int)SphereCuller::MAX_PLANES);
+
+    // without planes nothing is culled
+    culler.clearPlanes();
+    SphereCuller::Spheres spheres = makeSpheres(37);
+    SphereCuller::Spheres viewSpheres;
+    viewSpheres.resize(spheres.size());
+    std::vector<uint8_t> inside(spheres.size());
+    culler.cull(spheres, 0, spheres.size(), viewSpheres, inside.data());
+    for (size_t i = 0; i < spheres.size(); ++i) {
+        QCOMPARE((int)inside[i], 1);
+        QCOMPARE(viewSpheres.x[i], spheres.x[i]);
+    }
+}
+
+void SphereCullerTests::benchmarkCull() {
+    const int NUM_SPHERES = 100000;
+    SphereCuller::Spheres spheres = makeSpheres(NUM_SPHERES);
+    glm::mat4 transform = makeTransform();
+    std::vector<glm::vec4> planes = makePlanes();
+
+    QElapsedTimer timer;
+    timer.start();
+    int numInside = 0;
+    std::vector<glm::vec3> centers(NUM_SPHERES);
+    for (int i = 0; i < NUM_SPHERES; ++i) {
+        centers[i] = glm::vec3(transform * glm::vec4(spheres.x[i], spheres.y[i], spheres.z[i], 1.0f));
+        bool isInside = true;
+        for (const auto& plane : planes) {
+            isInside &= glm::dot(glm::vec3(plane), centers[i]) + plane.w + spheres.radius[i] >= 0.0f;
+        }
+        numInside += isInside ? 1 : 0;
+    }
+    qint64 scalarTime = timer.nsecsElapsed();
+
+    SphereCuller culler;
+    culler.setTransform(transform);
+    for (const auto& plane : planes) {
+        culler.addPlane(plane);
+    }
+    SphereCuller::Spheres viewSpheres;
+    viewSpheres.resize(NUM_SPHERES);
+    std::vector<uint8_t> inside(NUM_SPHERES);
+    timer.restart();
+    culler.cull(spheres, 0, NUM_SPHERES, viewSpheres, inside.data());
+    qint64 batchTime = timer.nsecsElapsed();
+
+    qDebug() << "glm:" << NUM_SPHERES << "spheres," << numInside << "inside in" << scalarTime / 1000 << "usec";
+    qDebug() << "SphereCuller:" << NUM_SPHERES << "spheres in" << batchTime / 1000 << "usec";
+}
@@ -0,0 +1,24 @@
+//
+//  SphereCullerTests.h
+//  tests/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SphereCullerTests_h
+#define hifi_SphereCullerTests_h
+
+#include <QtTest/QtTest>
+
+class SphereCullerTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testMatchesScalar();
+    void testPlaneLimit();
+    void benchmarkCull();
+};
+
+#endif // hifi_SphereCullerTests_h
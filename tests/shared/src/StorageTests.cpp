@@ -75,3 +75,23 @@ void StorageTests::testConversion() {
         QCOMPARE(fileInfo.size(), (qint64)newSize);
     }
 }
+
+void StorageTests::testResidency() {
+    StoragePointer memoryStorage = std::make_shared<MemoryStorage>(_testData.size(), _testData.data());
+    QCOMPARE(memoryStorage->isMapped(), false);
+
+    StoragePointer fileStorage = memoryStorage->toFileStorage(_testFile);
+    QCOMPARE(fileStorage->isMapped(), true);
+
+    // Residency is only a paging hint, the content must survive being released and faulted back in
+    fileStorage->requestResidency();
+    fileStorage->releaseResidency();
+    QCOMPARE(memcmp(_testData.data(), fileStorage->data(), _testData.size()), 0);
+
+    auto view = fileStorage->createView(_testData.size() / 2, _testData.size() / 4);
+    QCOMPARE(view->isMapped(), true);
+    view->requestResidency();
+    view->releaseResidency();
+    QCOMPARE(memcmp(_testData.data() + _testData.size() / 4, view->data(), view->size()), 0);
+    QCOMPARE(memcmp(_testData.data(), fileStorage->data(), _testData.size()), 0);
+}
@@ -0,0 +1,421 @@
+//
+//  CrowdAgent.cpp
+//  tools/crowd-client/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CrowdAgent.h"
+
+#include <cmath>
+
+#include <AudioConstants.h>
+#include <AudioStreamStats.h>
+#include <AvatarHashMap.h>
+#include <ConicalViewFrustum.h>
+#include <EntityItem.h>
+#include <GLMHelpers.h>
+#include <NumericalConstants.h>
+#include <PositionalAudioStream.h>
+#include <SharedUtil.h>
+#include <ViewFrustum.h>
+
+static const quint64 STATS_INTERVAL_USECS = USECS_PER_SECOND;
+static const quint64 AVATAR_QUERY_INTERVAL_USECS = USECS_PER_SECOND;
+static const quint64 IDENTITY_INTERVAL_USECS = 5 * USECS_PER_SECOND;
+// don't burst to catch up after a stall, the mixer would only drop the extra frames
+static const quint64 MAX_AUDIO_FRAMES_BEHIND = 4;
+static const int CROWD_GRID_WIDTH = 32;
+static const float WALK_SPEED = 1.4f; // m/s
+static const float ENTITY_HEIGHT = 2.0f;
+static const float ENTITY_LIFETIME = 3600.0f;
+
+QByteArray CrowdAvatar::toByteArrayStateful(AvatarDataDetail dataDetail, bool dropFaceTracking) {
+    _globalPosition = getWorldPosition();
+    return AvatarData::toByteArrayStateful(dataDetail, dropFaceTracking);
+}
+
+std::unique_ptr<NLPacket> CrowdAvatar::createAvatarDataPacket() {
+    // about 2% of the time send a full update, like AvatarData::sendAvatarDataPacket
+    bool cullSmallData = randFloat() < AVATAR_SEND_FULL_UPDATE_RATIO;
+    auto dataDetail = cullSmallData ? SendAllData : CullSmallData;
+    QByteArray avatarByteArray = toByteArrayStateful(dataDetail);
+
+    int maximumByteArraySize = NLPacket::maxPayloadSize(PacketType::AvatarData) - sizeof(AvatarDataSequenceNumber);
+    if (avatarByteArray.size() > maximumByteArraySize) {
+        avatarByteArray = toByteArrayStateful(MinimumData, true);
+    }
+    doneEncoding(cullSmallData);
+
+    auto avatarPacket = NLPacket::create(PacketType::AvatarData, avatarByteArray.size() + sizeof(_sequenceNumber));
+    avatarPacket->writePrimitive(_sequenceNumber++);
+    avatarPacket->write(avatarByteArray);
+    return avatarPacket;
+}
+
+std::unique_ptr<NLPacketList> CrowdAvatar::createIdentityPacketList() {
+    if (_identityDataChanged) {
+        pushIdentitySequenceNumber();
+    }
+    auto packetList = NLPacketList::create(PacketType::AvatarIdentity, QByteArray(), true, true);
+    packetList->write(identityByteArray());
+    _identityDataChanged = false;
+    return packetList;
+}
+
+CrowdAgent::CrowdAgent(const CrowdAgentSettings& settings, const HifiSockAddr& domainSockAddr,
+                       const QUuid& machineFingerprint, QObject* parent) :
+    QObject(parent),
+    _settings(settings),
+    _nodeList(new CrowdNodeList(domainSockAddr, machineFingerprint,
+                                NodeSet() << NodeType::AudioMixer << NodeType::AvatarMixer << NodeType::EntityServer)),
+    _avatar(std::make_shared<CrowdAvatar>())
+{
+    _nodeList->setParent(this);
+
+    _avatar->setDisplayName(QString("Crowd %1").arg(_settings.index));
+    _avatar->setSkeletonModelURL(QUrl());
+    // force lazy initialization of the head data, used by the audio and avatar packets
+    _avatar->getHeadOrientation();
+
+    auto& packetReceiver = _nodeList->getPacketReceiver();
+    packetReceiver.registerListenerForTypes({ PacketType::MixedAudio, PacketType::SilentAudioFrame },
+                                            this, "handleMixedAudio");
+    packetReceiver.registerListener(PacketType::AudioStreamStats, this, "handleAudioStreamStats");
+    packetReceiver.registerListener(PacketType::SelectedAudioFormat, this, "handleSelectedAudioFormat");
+    packetReceiver.registerListener(PacketType::BulkAvatarData, this, "handleBulkAvatarData");
+
+    connect(_nodeList, &LimitedNodeList::nodeActivated, this, &CrowdAgent::nodeActivated);
+}
+
+void CrowdAgent::start() {
+    _clock.start();
+    _nodeList->connectToDomain();
+}
+
+void CrowdAgent::stop() {
+    if (!_entityID.isNull()) {
+        QByteArray eraseMessage(NLPacket::maxPayloadSize(PacketType::EntityErase), 0);
+        if (EntityItemProperties::encodeEraseEntityMessage(_entityID, eraseMessage)) {
+            sendEntityMessage(PacketType::EntityErase, eraseMessage);
+        }
+    }
+
+    // the avatar mixer keeps avatars around for as long as the node is connected, tell it we're gone
+    _nodeList->eachMatchingNode([](const SharedNodePointer& node)->bool {
+        return (node->getType() == NodeType::AvatarMixer || node->getType() == NodeType::AudioMixer) && node->getActiveSocket();
+    }, [&](const SharedNodePointer& node) {
+        auto packet = NLPacket::create(PacketType::KillAvatar, NUM_BYTES_RFC4122_UUID + sizeof(KillAvatarReason), true);
+        packet->write(_nodeList->getSessionUUID().toRfc4122());
+        packet->writePrimitive(KillAvatarReason::NoReason);
+        _nodeList->sendPacket(std::move(packet), *node);
+    });
+
+    _nodeList->disconnectFromDomain();
+}
+
+void CrowdAgent::nodeActivated(SharedNodePointer node) {
+    if (node->getType() == NodeType::AudioMixer) {
+        // a new mixer knows nothing of the codec we agreed with the last one
+        _isAudioFormatSelected = false;
+
+        // only offer the identity codec so the mic frames can be sent without an encoder
+        auto negotiateFormatPacket = NLPacket::create(PacketType::NegotiateAudioFormat);
+        quint8 numberOfCodecs = 1;
+        negotiateFormatPacket->writePrimitive(numberOfCodecs);
+        negotiateFormatPacket->writeString(QString("pcm"));
+        _nodeList->sendPacket(std::move(negotiateFormatPacket), *node);
+    } else if (node->getType() == NodeType::AvatarMixer) {
+        _avatar->setSessionUUID(_nodeList->getSessionUUID());
+        sendIdentity();
+    } else if (node->getType() == NodeType::EntityServer && _settings.entityEditsPerSecond > 0.0f && _entityID.isNull()) {
+        EntityItemID entityID = QUuid::createUuid();
+
+        EntityItemProperties properties;
+        properties.setType(EntityTypes::Box);
+        properties.setName(QString("Crowd %1").arg(_settings.index));
+        properties.setPosition(_avatar->getWorldPosition() + ENTITY_HEIGHT * Vectors::UP);
+        properties.setDimensions(glm::vec3(0.2f));
+        properties.setLifetime(ENTITY_LIFETIME);
+        properties.setLastEdited(usecTimestampNow());
+
+        QByteArray addMessage(NLPacket::maxPayloadSize(PacketType::EntityAdd), 0);
+        EntityPropertyFlags didntFitProperties;
+        if (EntityItemProperties::encodeEntityEditPacket(PacketType::EntityAdd, entityID, properties, addMessage,
+                                                         properties.getChangedProperties(), didntFitProperties) == OctreeElement::COMPLETED) {
+            sendEntityMessage(PacketType::EntityAdd, addMessage);
+            _entityID = entityID;
+        }
+    }
+}
+
+void CrowdAgent::update() {
+    quint64 now = (quint64)(_clock.nsecsElapsed() / NSECS_PER_USEC);
+    float nowSeconds = (float)now / USECS_PER_SECOND;
+    float deltaTime = nowSeconds - _lastUpdate;
+    _lastUpdate = nowSeconds;
+
+    simulateMotion(nowSeconds);
+
+    auto avatarMixer = _nodeList->soloNodeOfType(NodeType::AvatarMixer);
+    if (avatarMixer && avatarMixer->getActiveSocket()) {
+        if (now - _lastAvatarSend >= MIN_TIME_BETWEEN_MY_AVATAR_DATA_SENDS) {
+            sendAvatarData();
+            _lastAvatarSend = now;
+        }
+        if (now - _lastIdentity >= IDENTITY_INTERVAL_USECS) {
+            sendIdentity();
+            _lastIdentity = now;
+        }
+        if (now - _lastAvatarQuery >= AVATAR_QUERY_INTERVAL_USECS) {
+            queryAvatars();
+            _lastAvatarQuery = now;
+        }
+    }
+
+    // audio has to keep the mixer's cadence rather than our timer's
+    quint64 framesDue = now / AudioConstants::NETWORK_FRAME_USECS;
+    if (!_isAudioFormatSelected) {
+        _audioFramesDue = framesDue;
+    } else if (framesDue > _audioFramesDue + MAX_AUDIO_FRAMES_BEHIND) {
+        _audioFramesDue = framesDue - MAX_AUDIO_FRAMES_BEHIND;
+    }
+    while (_audioFramesDue < framesDue) {
+        sendAudioFrame();
+        ++_audioFramesDue;
+    }
+
+    if (!_entityID.isNull()) {
+        _entityEditsDue += deltaTime * _settings.entityEditsPerSecond;
+        while (_entityEditsDue >= 1.0f) {
+            sendEntityEdit();
+            _entityEditsDue -= 1.0f;
+        }
+    }
+
+    if (now - _lastStatsReport >= STATS_INTERVAL_USECS) {
+        reportStats();
+        _lastStatsReport = now;
+    }
+}
+
+void CrowdAgent::simulateMotion(float now) {
+    // each agent walks a circle around its own spot on a grid
+    glm::vec3 center((_settings.index % CROWD_GRID_WIDTH) * _settings.spacing, 0.0f,
+                     (_settings.index / CROWD_GRID_WIDTH) * _settings.spacing);
+    float phase = (float)_settings.index;
+    float angle = phase + now * WALK_SPEED / _settings.walkRadius;
+
+    _avatar->setWorldPosition(center + _settings.walkRadius * glm::vec3(cosf(angle), 0.0f, sinf(angle)));
+    glm::quat orientation = glm::angleAxis(-angle, Vectors::UP);
+    _avatar->setWorldOrientation(orientation);
+    _avatar->setHeadOrientation(orientation * glm::angleAxis(0.2f * sinf(now + phase), Vectors::UNIT_X));
+}
+
+void CrowdAgent::sendAvatarData() {
+    _nodeList->broadcastToNodes(_avatar->createAvatarDataPacket(), NodeSet() << NodeType::AvatarMixer);
+    ++_avatarPacketsSent;
+}
+
+void CrowdAgent::sendIdentity() {
+    auto avatarMixer = _nodeList->soloNodeOfType(NodeType::AvatarMixer);
+    if (avatarMixer && avatarMixer->getActiveSocket()) {
+        _nodeList->sendPacketList(_avatar->createIdentityPacketList(), *avatarMixer);
+    }
+}
+
+void CrowdAgent::sendAudioFrame() {
+    auto audioMixer = _nodeList->soloNodeOfType(NodeType::AudioMixer);
+    if (!audioMixer || !audioMixer->getActiveSocket()) {
+        return;
+    }
+
+    static const int FRAME_SAMPLES = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+    int16_t samples[FRAME_SAMPLES];
+
+    if (_settings.audio.size() >= (int)sizeof(samples)) {
+        // loop the recording
+        auto source = reinterpret_cast<const int16_t*>(_settings.audio.constData());
+        int numSourceSamples = _settings.audio.size() / AudioConstants::SAMPLE_SIZE;
+        for (int i = 0; i < FRAME_SAMPLES; ++i) {
+            samples[i] = source[_audioOffset];
+            _audioOffset = (_audioOffset + 1) % numSourceSamples;
+        }
+    } else {
+        // a quiet tone, pitched per agent so the mixes aren't trivially identical
+        static const float AMPLITUDE = 0.1f * AudioConstants::MAX_SAMPLE_VALUE;
+        float frequency = 200.0f + 10.0f * (_settings.index % 64);
+        for (int i = 0; i < FRAME_SAMPLES; ++i) {
+            float t = (float)(_audioOffset + i) / AudioConstants::SAMPLE_RATE;
+            samples[i] = (int16_t)(AMPLITUDE * sinf(TWO_PI * frequency * t));
+        }
+        _audioOffset = (_audioOffset + FRAME_SAMPLES) % AudioConstants::SAMPLE_RATE;
+    }
+
+    // the same layout as AbstractAudioInterface::emitAudioPacket, which sends through the NodeList singleton
+    auto audioPacket = NLPacket::create(PacketType::MicrophoneAudioNoEcho);
+    audioPacket->writePrimitive(_outgoingAudioSequence++);
+    audioPacket->writeString(_selectedCodecName);
+    quint8 channelFlag = 0;
+    audioPacket->writePrimitive(channelFlag);
+    audioPacket->writePrimitive(_avatar->getWorldPosition());
+    audioPacket->writePrimitive(_avatar->getHeadOrientation());
+    audioPacket->writePrimitive(_avatar->getWorldPosition());
+    audioPacket->writePrimitive(glm::vec3(0.0f));
+    audioPacket->write(reinterpret_cast<const char*>(samples), sizeof(samples));
+
+    _nodeList->sendUnreliablePacket(*audioPacket, *audioMixer);
+    ++_audioFramesSent;
+}
+
+void CrowdAgent::sendEntityEdit() {
+    EntityItemProperties properties;
+    properties.setPosition(_avatar->getWorldPosition() + ENTITY_HEIGHT * Vectors::UP);
+    properties.setLastEdited(usecTimestampNow());
+
+    QByteArray editMessage(NLPacket::maxPayloadSize(PacketType::EntityEdit), 0);
+    EntityPropertyFlags didntFitProperties;
+    if (EntityItemProperties::encodeEntityEditPacket(PacketType::EntityEdit, _entityID, properties, editMessage,
+                                                     properties.getChangedProperties(), didntFitProperties) == OctreeElement::COMPLETED) {
+        sendEntityMessage(PacketType::EntityEdit, editMessage);
+        ++_entityEditsSent;
+    }
+}
+
+void CrowdAgent::sendEntityMessage(PacketType type, QByteArray& editMessage) {
+    auto entityServer = _nodeList->soloNodeOfType(NodeType::EntityServer);
+    if (!entityServer || !entityServer->getActiveSocket()) {
+        return;
+    }
+
+    // the framing OctreeEditPacketSender uses: a sequence number and a timestamp in the server's clock
+    qint64 clockSkew = entityServer->getClockSkewUsec();
+    if (clockSkew != 0 && type != PacketType::EntityErase) {
+        EntityItem::adjustEditPacketForClockSkew(editMessage, clockSkew);
+    }
+    quint64 now = usecTimestampNow() + clockSkew;
+
+    if (type == PacketType::EntityAdd) {
+        auto packetList = NLPacketList::create(type, QByteArray(), true, true);
+        packetList->writePrimitive(_entitySequence++);
+        packetList->writePrimitive(now);
+        packetList->write(editMessage);
+        _nodeList->sendPacketList(std::move(packetList), *entityServer);
+    } else {
+        auto packet = NLPacket::create(type);
+        packet->writePrimitive(_entitySequence++);
+        packet->writePrimitive(now);
+        packet->write(editMessage);
+        _nodeList->sendPacket(std::move(packet), *entityServer);
+    }
+}
+
+void CrowdAgent::queryAvatars() {
+    ViewFrustum view;
+    view.setPosition(_avatar->getWorldPosition());
+    view.setOrientation(_avatar->getHeadOrientation());
+    view.setProjection(DEFAULT_FIELD_OF_VIEW_DEGREES, DEFAULT_ASPECT_RATIO, DEFAULT_NEAR_CLIP, DEFAULT_FAR_CLIP);
+    view.calculate();
+    ConicalViewFrustum conicalView { view };
+
+    auto avatarPacket = NLPacket::create(PacketType::AvatarQuery);
+    auto destinationBuffer = reinterpret_cast<unsigned char*>(avatarPacket->getPayload());
+    auto bufferStart = destinationBuffer;
+
+    uint8_t numFrustums = 1;
+    memcpy(destinationBuffer, &numFrustums, sizeof(numFrustums));
+    destinationBuffer += sizeof(numFrustums);
+    destinationBuffer += conicalView.serialize(destinationBuffer);
+    avatarPacket->setPayloadSize(destinationBuffer - bufferStart);
+
+    _nodeList->broadcastToNodes(std::move(avatarPacket), { NodeType::AvatarMixer });
+}
+
+void CrowdAgent::handleMixedAudio(QSharedPointer<ReceivedMessage> message) {
+    quint16 sequence;
+    message->readPrimitive(&sequence);
+    _incomingAudioSequence.sequenceNumberReceived(sequence);
+
+    // the mixer sends one frame per listener per mix, so the gaps between them track its frame time
+    quint64 now = (quint64)(_clock.nsecsElapsed() / NSECS_PER_USEC);
+    if (_lastMixedAudioTime != 0) {
+        _mixedAudioGaps.add(now - _lastMixedAudioTime);
+    }
+    _lastMixedAudioTime = now;
+}
+
+void CrowdAgent::handleAudioStreamStats(QSharedPointer<ReceivedMessage> message) {
+    quint8 appendFlag;
+    message->readPrimitive(&appendFlag);
+    quint16 numStreamStats;
+    message->readPrimitive(&numStreamStats);
+
+    AudioStreamStats streamStats;
+    for (quint16 i = 0; i < numStreamStats; i++) {
+        message->readPrimitive(&streamStats);
+        // the mixer's view of our own mic stream
+        if (streamStats._streamType == PositionalAudioStream::Microphone) {
+            _audioUpstreamLoss = streamStats._packetStreamWindowStats.getLostRate();
+        }
+    }
+}
+
+void CrowdAgent::handleSelectedAudioFormat(QSharedPointer<ReceivedMessage> message) {
+    _selectedCodecName = message->readString();
+
+    // we only offered pcm, an empty selection means the mixer takes the frames as they are
+    _isAudioFormatSelected = _selectedCodecName.isEmpty() || _selectedCodecName == "pcm";
+    if (!_isAudioFormatSelected) {
+        qWarning() << "Crowd agent" << _settings.index << "got an unexpected codec" << _selectedCodecName << ", not sending audio";
+    }
+}
+
+void CrowdAgent::handleBulkAvatarData(QSharedPointer<ReceivedMessage> message) {
+    ++_bulkAvatarPacketsReceived;
+
+    // a mixer frame can span several packets, only the first one after a pause marks a new frame
+    static const quint64 SAME_FRAME_USECS = 2 * USECS_PER_MSEC;
+    quint64 now = (quint64)(_clock.nsecsElapsed() / NSECS_PER_USEC);
+    if (_lastBulkAvatarTime != 0 && now - _lastBulkAvatarTime > SAME_FRAME_USECS) {
+        _bulkAvatarGaps.add(now - _lastBulkAvatarTime);
+    }
+    _lastBulkAvatarTime = now;
+}
+
+void CrowdAgent::reportStats() {
+    auto pingFor = [&](NodeType_t type) {
+        auto node = _nodeList->soloNodeOfType(type);
+        return (node && node->getActiveSocket()) ? node->getPingMs() : -1;
+    };
+
+    auto incomingAudioStats = _incomingAudioSequence.getStats();
+    auto incomingAudioInterval = incomingAudioStats - _lastIncomingAudioStats;
+    _lastIncomingAudioStats = incomingAudioStats;
+
+    QJsonObject stats;
+    stats["agent"] = _settings.index;
+    stats["audioMixerPing"] = pingFor(NodeType::AudioMixer);
+    stats["avatarMixerPing"] = pingFor(NodeType::AvatarMixer);
+    stats["entityServerPing"] = pingFor(NodeType::EntityServer);
+    stats["audioFramesSent"] = _audioFramesSent;
+    stats["avatarPacketsSent"] = _avatarPacketsSent;
+    stats["entityEditsSent"] = _entityEditsSent;
+    stats["bulkAvatarPacketsReceived"] = _bulkAvatarPacketsReceived;
+    stats["audioUpstreamLoss"] = _audioUpstreamLoss;
+    stats["audioDownstreamExpected"] = (int)incomingAudioInterval._expectedReceived;
+    stats["audioDownstreamLost"] = (int)incomingAudioInterval._lost;
+    stats["mixedAudioGaps"] = _mixedAudioGaps.toJson();
+    stats["bulkAvatarGaps"] = _bulkAvatarGaps.toJson();
+
+    emit statsReported(stats);
+
+    _audioFramesSent = 0;
+    _avatarPacketsSent = 0;
+    _entityEditsSent = 0;
+    _bulkAvatarPacketsReceived = 0;
+    _mixedAudioGaps.reset();
+    _bulkAvatarGaps.reset();
+}
@@ -0,0 +1,123 @@
+//
+//  CrowdAgent.h
+//  tools/crowd-client/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_CrowdAgent_h
+#define hifi_CrowdAgent_h
+
+#include <memory>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+
+#include <AvatarData.h>
+#include <EntityItemID.h>
+#include <EntityItemProperties.h>
+#include <ReceivedMessage.h>
+#include <SequenceNumberStats.h>
+
+#include "CrowdNodeList.h"
+#include "CrowdStats.h"
+
+// AvatarData only packs _globalPosition, keep it in sync with the simulated position like ScriptableAvatar does
+class CrowdAvatar : public AvatarData {
+public:
+    QByteArray toByteArrayStateful(AvatarDataDetail dataDetail, bool dropFaceTracking = false) override;
+
+    // AvatarData::sendAvatarDataPacket and sendIdentityPacket send through the NodeList singleton, with one
+    // sequence number shared by every avatar in the process. These build the packets for the agent's own node list.
+    std::unique_ptr<NLPacket> createAvatarDataPacket();
+    std::unique_ptr<NLPacketList> createIdentityPacketList();
+
+private:
+    AvatarDataSequenceNumber _sequenceNumber { 0 };
+};
+
+struct CrowdAgentSettings {
+    int index { 0 };
+    // raw 24kHz 16 bit mono samples to loop as mic input, a synthetic tone is sent when empty
+    QByteArray audio;
+    float entityEditsPerSecond { 0.0f };
+    float walkRadius { 2.0f };
+    float spacing { 3.0f };
+};
+
+// A single simulated user: scripted avatar motion, mic audio and entity edits over the real node protocol,
+// without the script engine an Agent assignment client carries.
+// Each agent has its own CrowdNodeList, so any number of them can run in one process. The owner drives update()
+// from the agent's thread, and gets a statsReported() every second to aggregate.
+class CrowdAgent : public QObject {
+    Q_OBJECT
+public:
+    CrowdAgent(const CrowdAgentSettings& settings, const HifiSockAddr& domainSockAddr, const QUuid& machineFingerprint,
+               QObject* parent = nullptr);
+
+    void start();
+    void update();
+    // Says goodbye to the mixers, the entity server and the domain
+    void stop();
+
+signals:
+    void statsReported(QJsonObject stats);
+
+private slots:
+    void nodeActivated(SharedNodePointer node);
+    void handleMixedAudio(QSharedPointer<ReceivedMessage> message);
+    void handleAudioStreamStats(QSharedPointer<ReceivedMessage> message);
+    void handleSelectedAudioFormat(QSharedPointer<ReceivedMessage> message);
+    void handleBulkAvatarData(QSharedPointer<ReceivedMessage> message);
+
+private:
+    void simulateMotion(float now);
+    void sendAvatarData();
+    void sendIdentity();
+    void sendAudioFrame();
+    void sendEntityEdit();
+    // EntityEditPacketSender is bound to the NodeList singleton, so the agent frames its own edit messages
+    void sendEntityMessage(PacketType type, QByteArray& editMessage);
+    void queryAvatars();
+    void reportStats();
+
+    CrowdAgentSettings _settings;
+    CrowdNodeList* _nodeList;
+    std::shared_ptr<CrowdAvatar> _avatar;
+    EntityItemID _entityID;
+    quint16 _entitySequence { 0 };
+
+    QElapsedTimer _clock;
+    quint64 _lastStatsReport { 0 };
+    quint64 _lastAvatarSend { 0 };
+    quint64 _lastAvatarQuery { 0 };
+    quint64 _lastIdentity { 0 };
+    quint64 _audioFramesDue { 0 };
+    float _entityEditsDue { 0.0f };
+    float _lastUpdate { 0.0f };
+
+    // the mixer only sets up our stream once it has picked a codec, don't send audio before that
+    bool _isAudioFormatSelected { false };
+    QString _selectedCodecName;
+    quint16 _outgoingAudioSequence { 0 };
+    int _audioOffset { 0 };
+
+    // per interval counters, reset after each report
+    int _audioFramesSent { 0 };
+    int _avatarPacketsSent { 0 };
+    int _entityEditsSent { 0 };
+    int _bulkAvatarPacketsReceived { 0 };
+    float _audioUpstreamLoss { 0.0f };
+    SequenceNumberStats _incomingAudioSequence;
+    PacketStreamStats _lastIncomingAudioStats;
+    quint64 _lastMixedAudioTime { 0 };
+    quint64 _lastBulkAvatarTime { 0 };
+    CrowdHistogram _mixedAudioGaps;
+    CrowdHistogram _bulkAvatarGaps;
+};
+
+#endif // hifi_CrowdAgent_h
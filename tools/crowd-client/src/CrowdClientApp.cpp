@@ -0,0 +1,299 @@
+//
+//  CrowdClientApp.cpp
+//  tools/crowd-client/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CrowdClientApp.h"
+
+#include <algorithm>
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QFile>
+#include <QtCore/QLoggingCategory>
+
+#include <DomainHandler.h>
+#include <FingerprintUtils.h>
+#include <NetworkLogging.h>
+#include <NumericalConstants.h>
+#include <SharedLogging.h>
+
+static const int UPDATE_INTERVAL_MSECS = 2;
+static const int REPORT_INTERVAL_MSECS = 5000;
+// time for the goodbyes sent over reliable connections to go out before the node lists are torn down
+static const int AGENT_SHUTDOWN_MSECS = 1000;
+
+void CrowdReport::add(const QJsonObject& stats) {
+    ++_numReports;
+    _audioFramesSent += stats["audioFramesSent"].toInt();
+    _avatarPacketsSent += stats["avatarPacketsSent"].toInt();
+    _entityEditsSent += stats["entityEditsSent"].toInt();
+    _bulkAvatarPacketsReceived += stats["bulkAvatarPacketsReceived"].toInt();
+    _audioDownstreamExpected += stats["audioDownstreamExpected"].toInt();
+    _audioDownstreamLost += stats["audioDownstreamLost"].toInt();
+
+    auto addPing = [&](CrowdHistogram& histogram, const char* key) {
+        int ping = stats[key].toInt(-1);
+        if (ping >= 0) {
+            histogram.add((quint64)ping);
+        }
+    };
+    addPing(_audioMixerPing, "audioMixerPing");
+    addPing(_avatarMixerPing, "avatarMixerPing");
+    addPing(_entityServerPing, "entityServerPing");
+
+    if (stats["audioMixerPing"].toInt(-1) >= 0) {
+        _audioUpstreamLoss += (float)stats["audioUpstreamLoss"].toDouble();
+        ++_audioUpstreamLossReports;
+    }
+
+    _mixedAudioGaps.merge(CrowdHistogram::fromJson(stats["mixedAudioGaps"].toObject()));
+    _bulkAvatarGaps.merge(CrowdHistogram::fromJson(stats["bulkAvatarGaps"].toObject()));
+}
+
+void CrowdReport::print(const QString& title, float seconds, int numAgents) const {
+    if (seconds <= 0.0f) {
+        return;
+    }
+    float upstreamLoss = _audioUpstreamLossReports > 0 ? _audioUpstreamLoss / _audioUpstreamLossReports : 0.0f;
+    float downstreamLoss = _audioDownstreamExpected > 0 ? (float)_audioDownstreamLost / _audioDownstreamExpected : 0.0f;
+
+    qInfo().noquote() << title << "-" << numAgents << "agents," << _numReports << "agent reports over" << seconds << "s";
+    qInfo().noquote() << "    sent/s:"
+        << "audio frames" << (int)(_audioFramesSent / seconds)
+        << "avatar packets" << (int)(_avatarPacketsSent / seconds)
+        << "entity edits" << (int)(_entityEditsSent / seconds);
+    qInfo().noquote() << "    audio loss: upstream" << QString::number(100.0f * upstreamLoss, 'f', 2) + "%"
+        << "downstream" << QString::number(100.0f * downstreamLoss, 'f', 2) + "%";
+    qInfo().noquote() << "    ping audio-mixer:" << _audioMixerPing.toString(1, "ms");
+    qInfo().noquote() << "    ping avatar-mixer:" << _avatarMixerPing.toString(1, "ms");
+    qInfo().noquote() << "    ping entity-server:" << _entityServerPing.toString(1, "ms");
+    qInfo().noquote() << "    audio-mixer frame gaps:" << _mixedAudioGaps.toString(USECS_PER_MSEC, "ms");
+    qInfo().noquote() << "    avatar-mixer frame gaps:" << _bulkAvatarGaps.toString(USECS_PER_MSEC, "ms")
+        << "bulk avatar packets/s" << (int)(_bulkAvatarPacketsReceived / seconds);
+}
+
+CrowdWorker::CrowdWorker(const CrowdAgentSettings& settings, const HifiSockAddr& domainSockAddr,
+                         const QUuid& machineFingerprint) :
+    _settings(settings),
+    _domainSockAddr(domainSockAddr),
+    _machineFingerprint(machineFingerprint)
+{
+    _updateTimer.setTimerType(Qt::PreciseTimer);
+    _updateTimer.setInterval(UPDATE_INTERVAL_MSECS);
+    connect(&_updateTimer, &QTimer::timeout, this, &CrowdWorker::update);
+}
+
+void CrowdWorker::addAgent(int index) {
+    CrowdAgentSettings settings = _settings;
+    settings.index = index;
+
+    // created on this thread, so the agent's node list and its socket live here too
+    auto agent = new CrowdAgent(settings, _domainSockAddr, _machineFingerprint, this);
+    connect(agent, &CrowdAgent::statsReported, this, &CrowdWorker::agentStats);
+    _agents.push_back(agent);
+    agent->start();
+
+    if (!_updateTimer.isActive()) {
+        _updateTimer.start();
+    }
+}
+
+void CrowdWorker::stopAgents() {
+    _updateTimer.stop();
+    for (auto agent : _agents) {
+        agent->stop();
+    }
+}
+
+void CrowdWorker::update() {
+    for (auto agent : _agents) {
+        agent->update();
+    }
+}
+
+CrowdClientApp::CrowdClientApp(int argc, char* argv[]) :
+    QCoreApplication(argc, argv)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("High Fidelity crowd client, simulates many users to load test a domain's mixers");
+
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption verboseOutput("v", "verbose output");
+    parser.addOption(verboseOutput);
+
+    const QCommandLineOption domainAddressOption("d", "domain-server address, host[:port]", "127.0.0.1");
+    parser.addOption(domainAddressOption);
+
+    const QCommandLineOption agentsOption("n", "number of simulated agents", "agents", "10");
+    parser.addOption(agentsOption);
+
+    const QCommandLineOption spawnRateOption("spawnRate", "agents started per second", "rate", "10");
+    parser.addOption(spawnRateOption);
+
+    const QCommandLineOption durationOption("duration", "seconds to run for", "seconds", "60");
+    parser.addOption(durationOption);
+
+    const QCommandLineOption audioOption("audio", "raw 24kHz 16 bit mono file to loop as mic input", "file");
+    parser.addOption(audioOption);
+
+    const QCommandLineOption entityEditsOption("entityEdits", "entity edits per second per agent", "rate", "0");
+    parser.addOption(entityEditsOption);
+
+    const QCommandLineOption threadsOption("threads", "worker threads to spread the agents over", "threads",
+                                           QString::number(QThread::idealThreadCount()));
+    parser.addOption(threadsOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    if (!parser.isSet(verboseOutput)) {
+        QLoggingCategory::setFilterRules("qt.network.ssl.warning=false");
+
+        const_cast<QLoggingCategory*>(&networking())->setEnabled(QtDebugMsg, false);
+        const_cast<QLoggingCategory*>(&networking())->setEnabled(QtInfoMsg, false);
+        const_cast<QLoggingCategory*>(&networking())->setEnabled(QtWarningMsg, false);
+
+        const_cast<QLoggingCategory*>(&shared())->setEnabled(QtDebugMsg, false);
+        const_cast<QLoggingCategory*>(&shared())->setEnabled(QtInfoMsg, false);
+        const_cast<QLoggingCategory*>(&shared())->setEnabled(QtWarningMsg, false);
+    }
+
+    _durationSecs = parser.value(durationOption).toInt();
+    _numAgents = parser.value(agentsOption).toInt();
+    _spawnRate = std::max(parser.value(spawnRateOption).toInt(), 1);
+
+    QString domainServerAddress = "127.0.0.1";
+    if (parser.isSet(domainAddressOption)) {
+        domainServerAddress = parser.value(domainAddressOption);
+    }
+    QString domainHostname = domainServerAddress.section(':', 0, 0);
+    quint16 domainPort = DEFAULT_DOMAIN_SERVER_PORT;
+    if (domainServerAddress.contains(':')) {
+        domainPort = (quint16)domainServerAddress.section(':', 1, 1).toUInt();
+    }
+    // resolve once up front rather than once per agent
+    HifiSockAddr domainSockAddr(domainHostname, domainPort, true);
+    if (domainSockAddr.getAddress().isNull()) {
+        qCritical() << "Unable to resolve the domain-server address" << domainServerAddress;
+        QTimer::singleShot(0, this, [] { QCoreApplication::exit(1); });
+        return;
+    }
+
+    // the settings every agent starts from, each gets its own copy with its index
+    CrowdAgentSettings settings;
+    settings.entityEditsPerSecond = parser.value(entityEditsOption).toFloat();
+    if (parser.isSet(audioOption)) {
+        QFile audioFile(parser.value(audioOption));
+        if (audioFile.open(QIODevice::ReadOnly)) {
+            settings.audio = audioFile.readAll();
+        } else {
+            qWarning() << "Unable to open audio file" << parser.value(audioOption) << ", sending a tone instead";
+        }
+    }
+
+    // the fingerprint may be read from and saved to the settings, so do it once here rather than from every agent
+    QUuid machineFingerprint = FingerprintUtils::getMachineFingerprint();
+
+    int numThreads = std::max(std::min(parser.value(threadsOption).toInt(), _numAgents), 1);
+    for (int i = 0; i < numThreads; ++i) {
+        auto thread = new QThread(this);
+        thread->setObjectName(QString("Crowd Worker %1").arg(i));
+
+        auto worker = new CrowdWorker(settings, domainSockAddr, machineFingerprint);
+        worker->moveToThread(thread);
+        connect(worker, &CrowdWorker::agentStats, this, &CrowdClientApp::addAgentStats);
+
+        thread->start();
+        _workerThreads.push_back(thread);
+        _workers.push_back(worker);
+    }
+
+    qInfo() << "Starting" << _numAgents << "agents on" << numThreads << "threads against" << domainSockAddr
+        << "for" << _durationSecs << "s";
+
+    _runTime.start();
+    _intervalTime.start();
+
+    connect(&_spawnTimer, &QTimer::timeout, this, &CrowdClientApp::spawnAgents);
+    _spawnTimer.start(MSECS_PER_SECOND);
+    spawnAgents();
+
+    connect(&_reportTimer, &QTimer::timeout, this, &CrowdClientApp::printReport);
+    _reportTimer.start(REPORT_INTERVAL_MSECS);
+
+    // give the last agents started the full duration too
+    int spawnSecs = (_numAgents + _spawnRate - 1) / _spawnRate;
+    QTimer::singleShot((_durationSecs + spawnSecs) * MSECS_PER_SECOND, this, &CrowdClientApp::finish);
+}
+
+CrowdClientApp::~CrowdClientApp() {
+    // only still running if we're torn down before finishing
+    for (auto thread : _workerThreads) {
+        thread->quit();
+        thread->wait();
+    }
+}
+
+void CrowdClientApp::spawnAgents() {
+    for (int i = 0; i < _spawnRate && _numAgentsStarted < _numAgents; ++i) {
+        auto worker = _workers[_numAgentsStarted % _workers.size()];
+        QMetaObject::invokeMethod(worker, "addAgent", Qt::QueuedConnection, Q_ARG(int, _numAgentsStarted));
+        ++_numAgentsStarted;
+    }
+
+    if (_numAgentsStarted >= _numAgents) {
+        _spawnTimer.stop();
+    }
+}
+
+void CrowdClientApp::addAgentStats(QJsonObject stats) {
+    _intervalReport.add(stats);
+    _totalReport.add(stats);
+}
+
+void CrowdClientApp::printReport() {
+    _intervalReport.print(QString("Last %1s").arg(REPORT_INTERVAL_MSECS / MSECS_PER_SECOND),
+                          (float)_intervalTime.restart() / MSECS_PER_SECOND, _numAgentsStarted);
+    _intervalReport = CrowdReport();
+}
+
+void CrowdClientApp::finish() {
+    _spawnTimer.stop();
+    _reportTimer.stop();
+
+    for (auto worker : _workers) {
+        QMetaObject::invokeMethod(worker, "stopAgents", Qt::BlockingQueuedConnection);
+    }
+
+    QTimer::singleShot(AGENT_SHUTDOWN_MSECS, this, &CrowdClientApp::shutdown);
+}
+
+void CrowdClientApp::shutdown() {
+    for (size_t i = 0; i < _workers.size(); ++i) {
+        // the worker takes its agents and their node lists with it, on its own thread
+        QMetaObject::invokeMethod(_workers[i], "deleteLater", Qt::QueuedConnection);
+        _workerThreads[i]->quit();
+        _workerThreads[i]->wait();
+    }
+    _workers.clear();
+
+    // stats the agents reported before they stopped are still queued for us
+    QCoreApplication::processEvents();
+
+    _totalReport.print("Total", (float)_runTime.elapsed() / MSECS_PER_SECOND, _numAgentsStarted);
+    QCoreApplication::exit(0);
+}
@@ -0,0 +1,102 @@
+//
+//  CrowdClientApp.h
+//  tools/crowd-client/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_CrowdClientApp_h
+#define hifi_CrowdClientApp_h
+
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
+
+#include "CrowdAgent.h"
+#include "CrowdStats.h"
+
+// Totals of the per agent stats over some interval
+class CrowdReport {
+public:
+    void add(const QJsonObject& stats);
+    void print(const QString& title, float seconds, int numAgents) const;
+
+private:
+    int _numReports { 0 };
+    quint64 _audioFramesSent { 0 };
+    quint64 _avatarPacketsSent { 0 };
+    quint64 _entityEditsSent { 0 };
+    quint64 _bulkAvatarPacketsReceived { 0 };
+    quint64 _audioDownstreamExpected { 0 };
+    quint64 _audioDownstreamLost { 0 };
+    float _audioUpstreamLoss { 0.0f };
+    int _audioUpstreamLossReports { 0 };
+    CrowdHistogram _audioMixerPing;
+    CrowdHistogram _avatarMixerPing;
+    CrowdHistogram _entityServerPing;
+    CrowdHistogram _mixedAudioGaps;
+    CrowdHistogram _bulkAvatarGaps;
+};
+
+// Runs a share of the crowd on its own thread, ticking all of its agents from one precise timer
+class CrowdWorker : public QObject {
+    Q_OBJECT
+public:
+    CrowdWorker(const CrowdAgentSettings& settings, const HifiSockAddr& domainSockAddr, const QUuid& machineFingerprint);
+
+public slots:
+    void addAgent(int index);
+    void stopAgents();
+
+signals:
+    void agentStats(QJsonObject stats);
+
+private:
+    void update();
+
+    CrowdAgentSettings _settings;
+    HifiSockAddr _domainSockAddr;
+    QUuid _machineFingerprint;
+    std::vector<CrowdAgent*> _agents;
+    QTimer _updateTimer { this };
+};
+
+// Runs a crowd of CrowdAgents against a domain and aggregates what they measure.
+// Every agent has its own node list and domain session, so the whole crowd shares this one process,
+// spread over a few worker threads.
+class CrowdClientApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    CrowdClientApp(int argc, char* argv[]);
+    ~CrowdClientApp();
+
+private slots:
+    void spawnAgents();
+    void addAgentStats(QJsonObject stats);
+    void printReport();
+    void finish();
+
+private:
+    void shutdown();
+
+    int _durationSecs { 60 };
+    int _numAgents { 0 };
+    int _spawnRate { 0 };
+    int _numAgentsStarted { 0 };
+    std::vector<QThread*> _workerThreads;
+    std::vector<CrowdWorker*> _workers;
+    QTimer _spawnTimer;
+    QTimer _reportTimer;
+    QElapsedTimer _runTime;
+    QElapsedTimer _intervalTime;
+    CrowdReport _intervalReport;
+    CrowdReport _totalReport;
+};
+
+#endif // hifi_CrowdClientApp_h
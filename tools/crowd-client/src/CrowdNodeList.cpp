@@ -0,0 +1,288 @@
+//
+//  CrowdNodeList.cpp
+//  tools/crowd-client/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CrowdNodeList.h"
+
+#include <chrono>
+
+#include <QtCore/QDataStream>
+
+#include <DomainHandler.h>
+#include <NetworkLogging.h>
+#include <NodeList.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+using namespace std::chrono;
+
+static const int KEEPALIVE_PING_INTERVAL_MS = 1000;
+
+CrowdNodeList::CrowdNodeList(const HifiSockAddr& domainSockAddr, const QUuid& machineFingerprint,
+                             const NodeSet& nodeTypesOfInterest) :
+    LimitedNodeList(0),
+    _domainSockAddr(domainSockAddr),
+    _machineFingerprint(machineFingerprint),
+    _nodeTypesOfInterest(nodeTypesOfInterest)
+{
+    // the domain-server talks to us over reliable connections too
+    _nodeSocket.setConnectionCreationFilterOperator([this](const HifiSockAddr& sockAddr) {
+        return sockAddr == _domainSockAddr || sockAddrBelongsToNode(sockAddr);
+    });
+
+    auto& packetReceiver = getPacketReceiver();
+    packetReceiver.registerListener(PacketType::DomainList, this, "processDomainServerList");
+    packetReceiver.registerListener(PacketType::DomainServerAddedNode, this, "processDomainServerAddedNode");
+    packetReceiver.registerListener(PacketType::DomainServerRemovedNode, this, "processDomainServerRemovedNode");
+    packetReceiver.registerListener(PacketType::DomainConnectionDenied, this, "processDomainServerConnectionDeniedPacket");
+    packetReceiver.registerListener(PacketType::Ping, this, "processPingPacket");
+    packetReceiver.registerListener(PacketType::PingReply, this, "processPingReplyPacket");
+
+    connect(this, &LimitedNodeList::nodeAdded, this, &CrowdNodeList::startNodeHolePunch);
+    connect(this, &LimitedNodeList::nodeSocketUpdated, this, &CrowdNodeList::startNodeHolePunch);
+
+    // check in with the domain as soon as we know our public socket, and whenever it changes
+    connect(this, &LimitedNodeList::publicSockAddrChanged, this, &CrowdNodeList::sendDomainServerCheckIn);
+
+    _checkInTimer.setInterval(DOMAIN_SERVER_CHECK_IN_MSECS);
+    connect(&_checkInTimer, &QTimer::timeout, this, &CrowdNodeList::sendDomainServerCheckIn);
+
+    _keepAlivePingTimer.setInterval(KEEPALIVE_PING_INTERVAL_MS);
+    connect(&_keepAlivePingTimer, &QTimer::timeout, this, &CrowdNodeList::sendKeepAlivePings);
+}
+
+void CrowdNodeList::connectToDomain() {
+    // a local domain-server publishes the port it actually listens on
+    if (_domainSockAddr.getAddress() == QHostAddress::LocalHost) {
+        quint16 domainPort = DEFAULT_DOMAIN_SERVER_PORT;
+        getLocalServerPortFromSharedMemory(DOMAIN_SERVER_LOCAL_PORT_SMEM_KEY, domainPort);
+        _domainSockAddr.setPort(domainPort);
+    }
+
+    startSTUNPublicSocketUpdate();
+    _checkInTimer.start();
+}
+
+void CrowdNodeList::disconnectFromDomain() {
+    _checkInTimer.stop();
+    _keepAlivePingTimer.stop();
+
+    if (_isConnected) {
+        auto disconnectPacket = NLPacket::create(PacketType::DomainDisconnectRequest, 0);
+        sendUnreliablePacket(*disconnectPacket, _domainSockAddr);
+    }
+    _isConnected = false;
+
+    getPacketReceiver().setShouldDropPackets(true);
+}
+
+void CrowdNodeList::sendDomainServerCheckIn() {
+    if (_publicSockAddr.isNull() || !_checkInTimer.isActive()) {
+        // wait for STUN, the domain hands our public socket to the mixers
+        return;
+    }
+
+    if (_checkInsSinceLastReply >= MAX_SILENT_DOMAIN_SERVER_CHECK_INS && _isConnected) {
+        resetDomainSession("Silent domain-server");
+    }
+
+    PacketType packetType = _isConnected ? PacketType::DomainListRequest : PacketType::DomainConnectRequest;
+    auto domainPacket = NLPacket::create(packetType);
+    QDataStream packetStream(domainPacket.get());
+
+    if (packetType == PacketType::DomainConnectRequest) {
+        // no assignment or ICE client ID to connect with
+        packetStream << QUuid();
+
+        QByteArray protocolVersionSig = protocolVersionsSignature();
+        packetStream.writeBytes(protocolVersionSig.constData(), protocolVersionSig.size());
+
+        // no hardware address or system info, the domain-server accepts them empty
+        packetStream << QString() << _machineFingerprint << QByteArray();
+        packetStream << (quint32)LimitedNodeList::Connect;
+
+        quint64 previousConnectionUptime = 0;
+        packetStream << previousConnectionUptime;
+    }
+
+    packetStream << quint64(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count());
+    packetStream << NodeType_t(NodeType::Agent) << _publicSockAddr << _localSockAddr << _nodeTypesOfInterest.toList();
+
+    // no place name, and connect as an anonymous user
+    packetStream << QString();
+    if (!_isConnected) {
+        packetStream << QString();
+    }
+
+    ++_checkInsSinceLastReply;
+    sendPacket(std::move(domainPacket), _domainSockAddr);
+}
+
+void CrowdNodeList::processDomainServerList(QSharedPointer<ReceivedMessage> message) {
+    QDataStream packetStream(message->getMessage());
+
+    QUuid domainUUID;
+    Node::LocalID domainLocalID;
+    packetStream >> domainUUID >> domainLocalID;
+
+    QUuid newUUID;
+    Node::LocalID newLocalID;
+    NodePermissions newPermissions;
+    bool isAuthenticated;
+    packetStream >> newUUID >> newLocalID >> newPermissions >> isAuthenticated;
+
+    // the timing fields only matter to the interface's connection stats
+    quint64 connectRequestTimestamp;
+    quint64 domainServerPingSendTime;
+    quint64 domainServerCheckinProcessingTime;
+    bool newConnection;
+    packetStream >> connectRequestTimestamp >> domainServerPingSendTime >> domainServerCheckinProcessingTime >> newConnection;
+
+    _checkInsSinceLastReply = 0;
+
+    if (_isConnected && (domainUUID != _domainUUID || newLocalID != getSessionLocalID() || newUUID != getSessionUUID())) {
+        resetDomainSession("Domain session changed");
+    }
+
+    setSessionLocalID(newLocalID);
+    setSessionUUID(newUUID);
+    setPermissions(newPermissions);
+    setAuthenticatePackets(isAuthenticated);
+
+    if (!_isConnected) {
+        _domainUUID = domainUUID;
+        _domainLocalID = domainLocalID;
+        _isConnected = true;
+        _keepAlivePingTimer.start();
+    }
+
+    while (packetStream.device()->pos() < message->getSize()) {
+        parseNodeFromPacketStream(packetStream);
+    }
+}
+
+void CrowdNodeList::processDomainServerAddedNode(QSharedPointer<ReceivedMessage> message) {
+    QDataStream packetStream(message->getMessage());
+    parseNodeFromPacketStream(packetStream);
+}
+
+void CrowdNodeList::processDomainServerRemovedNode(QSharedPointer<ReceivedMessage> message) {
+    QUuid nodeUUID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+    killNodeWithUUID(nodeUUID);
+    removeDelayedAdd(nodeUUID);
+}
+
+void CrowdNodeList::processDomainServerConnectionDeniedPacket(QSharedPointer<ReceivedMessage> message) {
+    _checkInsSinceLastReply = 0;
+
+    uint8_t reasonCode;
+    message->readPrimitive(&reasonCode);
+    quint16 reasonSize;
+    message->readPrimitive(&reasonSize);
+    QString reasonMessage = QString::fromUtf8(message->readWithoutCopy(reasonSize));
+
+    qCWarning(networking) << "The domain-server denied a crowd agent's connection request:" << reasonMessage;
+}
+
+void CrowdNodeList::processPingPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
+    auto replyPacket = constructPingReplyPacket(*message);
+    const HifiSockAddr& senderSockAddr = message->getSenderSockAddr();
+    sendPacket(std::move(replyPacket), *sendingNode, senderSockAddr);
+
+    // a node behind a symmetric NAT is only reachable on the socket its pings come from
+    if (sendingNode->getSymmetricSocket().isNull()) {
+        if (senderSockAddr != sendingNode->getLocalSocket() && senderSockAddr != sendingNode->getPublicSocket()) {
+            sendingNode->setSymmetricSocket(senderSockAddr);
+        }
+    }
+}
+
+void CrowdNodeList::processPingReplyPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
+    PingType_t pingType;
+    quint64 ourOriginalTime;
+    quint64 othersReplyTime;
+    message->readPrimitive(&pingType);
+    message->readPrimitive(&ourOriginalTime);
+    message->readPrimitive(&othersReplyTime);
+
+    // activate whichever socket answered first
+    if (pingType == PingType::Local && sendingNode->getActiveSocket() != &sendingNode->getLocalSocket()) {
+        sendingNode->activateLocalSocket();
+    } else if (pingType == PingType::Public && !sendingNode->getActiveSocket()) {
+        sendingNode->activatePublicSocket();
+    } else if (pingType == PingType::Symmetric && !sendingNode->getActiveSocket()) {
+        sendingNode->activateSymmetricSocket();
+    }
+
+    qint64 pingTime = usecTimestampNow() - ourOriginalTime;
+    sendingNode->setPingMs(pingTime / USECS_PER_MSEC);
+    sendingNode->updateClockSkewUsec(othersReplyTime - (ourOriginalTime + pingTime / 2));
+}
+
+void CrowdNodeList::startNodeHolePunch(const SharedNodePointer& node) {
+    if (!NodeType::isDownstream(node->getType()) && !node->isUpstream()) {
+        connect(node.data(), &Node::pingTimerTimeout, this, &CrowdNodeList::handleNodePingTimeout, Qt::UniqueConnection);
+        node->startPingTimer();
+        pingPunchForInactiveNode(node);
+    }
+}
+
+void CrowdNodeList::handleNodePingTimeout() {
+    Node* senderNode = qobject_cast<Node*>(sender());
+    if (senderNode) {
+        SharedNodePointer sharedNode = nodeWithUUID(senderNode->getUUID());
+        if (sharedNode && !sharedNode->getActiveSocket()) {
+            pingPunchForInactiveNode(sharedNode);
+        }
+    }
+}
+
+void CrowdNodeList::pingPunchForInactiveNode(const SharedNodePointer& node) {
+    auto nodeID = node->getUUID();
+    sendPacket(constructPingPacket(nodeID, PingType::Local), *node, node->getLocalSocket());
+    sendPacket(constructPingPacket(nodeID, PingType::Public), *node, node->getPublicSocket());
+    if (!node->getSymmetricSocket().isNull()) {
+        sendPacket(constructPingPacket(nodeID, PingType::Symmetric), *node, node->getSymmetricSocket());
+    }
+    node->incrementConnectionAttempts();
+}
+
+void CrowdNodeList::sendKeepAlivePings() {
+    eachMatchingNode([this](const SharedNodePointer& node)->bool {
+        return !node->isUpstream() && _nodeTypesOfInterest.contains(node->getType()) && node->getActiveSocket();
+    }, [&](const SharedNodePointer& node) {
+        sendPacket(constructPingPacket(node->getUUID()), *node);
+    });
+}
+
+void CrowdNodeList::parseNodeFromPacketStream(QDataStream& packetStream) {
+    NewNodeInfo info;
+    packetStream >> info.type
+                 >> info.uuid
+                 >> info.publicSocket
+                 >> info.localSocket
+                 >> info.permissions
+                 >> info.isReplicated
+                 >> info.sessionLocalID
+                 >> info.connectionSecretUUID;
+
+    // a null public address means the node shares the domain-server's
+    if (info.publicSocket.getAddress().isNull()) {
+        info.publicSocket.setAddress(_domainSockAddr.getAddress());
+    }
+
+    addNewNode(info);
+}
+
+void CrowdNodeList::resetDomainSession(const QString& reason) {
+    reset(reason);
+    _isConnected = false;
+    _checkInsSinceLastReply = 0;
+    _keepAlivePingTimer.stop();
+}
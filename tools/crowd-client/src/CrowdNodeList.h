@@ -0,0 +1,70 @@
+//
+//  CrowdNodeList.h
+//  tools/crowd-client/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_CrowdNodeList_h
+#define hifi_CrowdNodeList_h
+
+#include <QtCore/QTimer>
+#include <QtCore/QUuid>
+
+#include <LimitedNodeList.h>
+#include <ReceivedMessage.h>
+
+// A node list holding one agent's own socket and domain session, so that a whole crowd can share a process.
+// NodeList is a singleton tied to DomainHandler, AddressManager and AccountManager, this speaks just enough of
+// the client side of the domain protocol for an anonymous agent: connect / list requests, node hole punching
+// and keepalive pings. There is no ICE, place name lookup or login, the domain must be reachable directly.
+class CrowdNodeList : public LimitedNodeList {
+    Q_OBJECT
+public:
+    CrowdNodeList(const HifiSockAddr& domainSockAddr, const QUuid& machineFingerprint, const NodeSet& nodeTypesOfInterest);
+
+    bool isDomainServer() const override { return false; }
+    QUuid getDomainUUID() const override { return _domainUUID; }
+    Node::LocalID getDomainLocalID() const override { return _domainLocalID; }
+    HifiSockAddr getDomainSockAddr() const override { return _domainSockAddr; }
+
+    bool isConnected() const { return _isConnected; }
+
+    void connectToDomain();
+    // Tells the domain we're leaving and drops whatever arrives after
+    void disconnectFromDomain();
+
+private slots:
+    void sendDomainServerCheckIn();
+    void processDomainServerList(QSharedPointer<ReceivedMessage> message);
+    void processDomainServerAddedNode(QSharedPointer<ReceivedMessage> message);
+    void processDomainServerRemovedNode(QSharedPointer<ReceivedMessage> message);
+    void processDomainServerConnectionDeniedPacket(QSharedPointer<ReceivedMessage> message);
+    void processPingPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
+    void processPingReplyPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
+    void startNodeHolePunch(const SharedNodePointer& node);
+    void handleNodePingTimeout();
+    void sendKeepAlivePings();
+
+private:
+    void parseNodeFromPacketStream(QDataStream& packetStream);
+    void pingPunchForInactiveNode(const SharedNodePointer& node);
+    void resetDomainSession(const QString& reason);
+
+    HifiSockAddr _domainSockAddr;
+    QUuid _machineFingerprint;
+    NodeSet _nodeTypesOfInterest;
+
+    QUuid _domainUUID;
+    Node::LocalID _domainLocalID { Node::NULL_LOCAL_ID };
+    bool _isConnected { false };
+    int _checkInsSinceLastReply { 0 };
+
+    QTimer _checkInTimer { this };
+    QTimer _keepAlivePingTimer { this };
+};
+
+#endif // hifi_CrowdNodeList_h
@@ -0,0 +1,90 @@
+//
+//  CrowdStats.cpp
+//  tools/crowd-client/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CrowdStats.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QtCore/QJsonArray>
+
+void CrowdHistogram::add(quint64 value) {
+    int bucket = 0;
+    while (bucket < NUM_BUCKETS - 1 && (value >> bucket) != 0) {
+        ++bucket;
+    }
+    ++_buckets[bucket];
+    ++_count;
+    _max = std::max(_max, value);
+}
+
+void CrowdHistogram::merge(const CrowdHistogram& other) {
+    for (int i = 0; i < NUM_BUCKETS; ++i) {
+        _buckets[i] += other._buckets[i];
+    }
+    _count += other._count;
+    _max = std::max(_max, other._max);
+}
+
+void CrowdHistogram::reset() {
+    _buckets.fill(0);
+    _count = 0;
+    _max = 0;
+}
+
+quint64 CrowdHistogram::getPercentile(float percentile) const {
+    if (_count == 0) {
+        return 0;
+    }
+    quint64 rank = (quint64)std::ceil(_count * std::min(std::max(percentile, 0.0f), 100.0f) / 100.0f);
+    quint64 seen = 0;
+    for (int i = 0; i < NUM_BUCKETS; ++i) {
+        seen += _buckets[i];
+        if (seen >= rank && _buckets[i] > 0) {
+            quint64 upperBound = (i == 0) ? 0 : ((quint64)1 << i) - 1;
+            return std::min(upperBound, _max);
+        }
+    }
+    return _max;
+}
+
+QJsonObject CrowdHistogram::toJson() const {
+    QJsonArray buckets;
+    for (auto count : _buckets) {
+        buckets.append((double)count);
+    }
+    QJsonObject json;
+    json["buckets"] = buckets;
+    json["max"] = (double)_max;
+    return json;
+}
+
+CrowdHistogram CrowdHistogram::fromJson(const QJsonObject& json) {
+    CrowdHistogram result;
+    auto buckets = json["buckets"].toArray();
+    for (int i = 0; i < NUM_BUCKETS && i < buckets.size(); ++i) {
+        result._buckets[i] = (quint64)buckets[i].toDouble();
+        result._count += result._buckets[i];
+    }
+    result._max = (quint64)json["max"].toDouble();
+    return result;
+}
+
+QString CrowdHistogram::toString(quint64 divisor, const QString& unit) const {
+    if (_count == 0) {
+        return "n/a";
+    }
+    auto format = [&](quint64 value) {
+        return QString::number((double)value / divisor, 'f', divisor > 1 ? 1 : 0) + unit;
+    };
+    return QString("p50 <= %1 p99 <= %2 max %3 (%4 samples)")
+        .arg(format(getPercentile(50.0f)), format(getPercentile(99.0f)), format(_max))
+        .arg(_count);
+}
@@ -0,0 +1,46 @@
+//
+//  CrowdStats.h
+//  tools/crowd-client/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_CrowdStats_h
+#define hifi_CrowdStats_h
+
+#include <array>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+
+// Histogram with power of two buckets, cheap enough to keep per agent and to ship to the launcher every second.
+// Bucket 0 holds zero, bucket i holds values in [2^(i-1), 2^i).
+class CrowdHistogram {
+public:
+    static const int NUM_BUCKETS = 32;
+
+    void add(quint64 value);
+    void merge(const CrowdHistogram& other);
+    void reset();
+
+    quint64 getCount() const { return _count; }
+    quint64 getMax() const { return _max; }
+    // Upper bound of the bucket holding the given percentile (0 - 100)
+    quint64 getPercentile(float percentile) const;
+
+    QJsonObject toJson() const;
+    static CrowdHistogram fromJson(const QJsonObject& json);
+
+    // "p50 <= X p99 <= Y max Z" in the given unit
+    QString toString(quint64 divisor = 1, const QString& unit = QString()) const;
+
+private:
+    std::array<quint64, NUM_BUCKETS> _buckets {{}};
+    quint64 _count { 0 };
+    quint64 _max { 0 };
+};
+
+#endif // hifi_CrowdStats_h
@@ -96,6 +96,31 @@ void processKtxFile(const QFileInfo& inputFileInfo) {
     storage::FileStorage::create(finalFilename, outputStorage->size(), outputStorage->data());
 }
 
+// Print how much of a KTX container has to be resident when only the lower mips are in use,
+// starting from the smallest mip and requesting each larger one in turn
+void reportResidency(const QString& filename) {
+    auto ktx = ktx::KTX::create(std::make_shared<storage::FileStorage>(filename));
+    if (!ktx) {
+        qWarning() << "Unable to load texture using hifi::ktx" << filename;
+        return;
+    }
+
+    const auto& header = ktx->getHeader();
+    const auto& storage = ktx->getStorage();
+    qDebug() << filename << header.getPixelWidth() << "x" << header.getPixelHeight()
+             << "mips:" << ktx->_images.size() << "file size:" << storage->size()
+             << (storage->isMapped() ? "mapped" : "not mapped");
+
+    for (int mip = (int)ktx->_images.size() - 1; mip >= 0; --mip) {
+        ktx->requestMip((uint16_t)mip);
+        qDebug() << "    mip" << mip << "size:" << ktx->getMipSize((uint16_t)mip)
+                 << "resident from this mip down:" << ktx->evalResidentSize();
+    }
+    for (uint16_t mip = 0; mip < ktx->_images.size(); ++mip) {
+        ktx->releaseMip(mip);
+    }
+}
+
 void scanDir(const QDir& dir) {
 
     auto entries = dir.entryInfoList();
@@ -110,6 +135,13 @@ void scanDir(const QDir& dir) {
 
 int main(int argc, char** argv) {
     qInstallMessageHandler(messageHandler);
+    // ktx-tool --residency <file.ktx> ...
+    if (argc > 1 && std::string(argv[1]) == "--residency") {
+        for (int i = 2; i < argc; ++i) {
+            reportResidency(QString::fromLocal8Bit(argv[i]));
+        }
+        return 0;
+    }
     {
         QDir destFolder(DEST_FOLDER);
         if (!destFolder.exists() && !destFolder.mkpath(".")) {
@@ -0,0 +1,173 @@
+//
+//  ModelPerfApp.cpp
+//  tools/model-perf/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ModelPerfApp.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QUrl>
+#include <QDebug>
+
+#include <FBXSerializer.h>
+#include <GLTFSerializer.h>
+#include <OBJSerializer.h>
+#include <model-baker/Baker.h>
+
+static const int DEFAULT_NUM_ITERATIONS = 10;
+
+ModelPerfApp::ModelPerfApp(int argc, char* argv[]) : QCoreApplication(argc, argv) {
+    QCommandLineParser parser;
+    parser.setApplicationDescription("High Fidelity Model Loading Benchmark");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption iterationsOption("iterations", "number of times each model is loaded", "count",
+        QString::number(DEFAULT_NUM_ITERATIONS));
+    parser.addOption(iterationsOption);
+    parser.addPositionalArgument("models", "fbx, gltf, glb or obj files to load", "models...");
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    if (parser.isSet(helpOption) || parser.positionalArguments().isEmpty()) {
+        parser.showHelp();
+        return;
+    }
+
+    int iterations = std::max(1, parser.value(iterationsOption).toInt());
+    for (const auto& filename : parser.positionalArguments()) {
+        if (!benchmarkFile(filename, iterations)) {
+            _returnCode = 2;
+        }
+    }
+}
+
+ModelPerfApp::~ModelPerfApp() {
+}
+
+bool ModelPerfApp::benchmarkFile(const QString& filename, int iterations) {
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCritical() << "Failed to open file" << filename;
+        return false;
+    }
+
+    // Parse straight from the page cache when the file can be mapped
+    hifi::ByteArray data;
+    const uchar* mapped = file.map(0, file.size());
+    if (mapped) {
+        data = hifi::ByteArray::fromRawData((const char*)mapped, (int)file.size());
+    } else {
+        data = file.readAll();
+    }
+
+    hifi::URL url = QUrl::fromLocalFile(QFileInfo(filename).absoluteFilePath());
+    QString suffix = QFileInfo(filename).suffix().toLower();
+    qInfo().noquote() << QString("%1: %2 MB").arg(filename).arg((double)data.size() / (1024.0 * 1024.0), 0, 'f', 2);
+
+    ReadModel readModel;
+    if (suffix == "fbx") {
+        readModel = [&] { return FBXSerializer().read(data, hifi::VariantHash(), url); };
+    } else if (suffix == "gltf" || suffix == "glb") {
+        readModel = [&] { return GLTFSerializer().read(data, hifi::VariantHash(), url); };
+    } else if (suffix == "obj") {
+        readModel = [&] { return OBJSerializer().read(data, hifi::VariantHash(), url); };
+    } else {
+        qCritical() << "Unknown model format" << filename;
+        return false;
+    }
+
+    try {
+        if (suffix == "fbx") {
+            reportStep("parse", data.size(), iterations, [&] {
+                FBXSerializer::parseFBX(data);
+            });
+        }
+        reportStep("read", data.size(), iterations, [&] {
+            readModel();
+        });
+        reportBake(readModel, url, iterations);
+    } catch (const QString& error) {
+        qCritical() << "Failed to load" << filename << ":" << error;
+        return false;
+    }
+    return true;
+}
+
+void ModelPerfApp::reportStep(const QString& step, qint64 size, int iterations, const std::function<void()>& run) {
+    QElapsedTimer timer;
+    qint64 totalNsecs = 0;
+    qint64 minNsecs = std::numeric_limits<qint64>::max();
+    for (int i = 0; i < iterations; i++) {
+        timer.start();
+        run();
+        qint64 nsecs = timer.nsecsElapsed();
+        totalNsecs += nsecs;
+        minNsecs = std::min(minNsecs, nsecs);
+    }
+
+    double averageMs = (double)totalNsecs / (1.0e6 * iterations);
+    double megabytesPerSecond = ((double)size / (1024.0 * 1024.0)) / (averageMs / 1000.0);
+    qInfo().noquote() << QString("  %1 avg %2 ms, min %3 ms, %4 MB/s").arg(step, -8)
+        .arg(averageMs, 0, 'f', 3)
+        .arg((double)minNsecs / 1.0e6, 0, 'f', 3)
+        .arg(megabytesPerSecond, 0, 'f', 1);
+}
+
+void ModelPerfApp::reportBake(const ReadModel& readModel, const hifi::URL& url, int iterations) {
+    _jobTimings.clear();
+    QElapsedTimer timer;
+    qint64 totalNsecs = 0;
+    for (int i = 0; i < iterations; i++) {
+        // The baker modifies the model it is given, so each iteration bakes a freshly read one
+        auto hfmModel = readModel();
+        baker::Baker baker(hfmModel, hifi::VariantHash(), url);
+        timer.start();
+        baker.run();
+        totalNsecs += timer.nsecsElapsed();
+
+        size_t index = 0;
+        accumulateJobTimings(baker.getConfiguration().get(), 0, index);
+    }
+
+    qInfo().noquote() << QString("  %1 avg %2 ms").arg("bake", -8).arg((double)totalNsecs / (1.0e6 * iterations), 0, 'f', 3);
+    qInfo().noquote() << QString("    %1 %2 %3").arg("job", -40).arg("avg ms", 10).arg("max ms", 10);
+    for (const auto& timing : _jobTimings) {
+        QString name = QString(2 * timing.depth, ' ') + timing.name;
+        qInfo().noquote() << QString("    %1 %2 %3").arg(name, -40)
+            .arg(timing.totalMs / iterations, 10, 'f', 3)
+            .arg(timing.maxMs, 10, 'f', 3);
+    }
+}
+
+void ModelPerfApp::accumulateJobTimings(const task::JobConfig* config, int depth, size_t& index) {
+    if (index == _jobTimings.size()) {
+        JobTiming timing;
+        timing.name = config->objectName();
+        timing.depth = depth;
+        _jobTimings.push_back(timing);
+    }
+    JobTiming& timing = _jobTimings[index++];
+    double ms = config->getCPURunTime();
+    timing.totalMs += ms;
+    timing.maxMs = std::max(timing.maxMs, ms);
+
+    for (auto subConfig : config->getSubConfigs()) {
+        accumulateJobTimings(static_cast<const task::JobConfig*>(subConfig), depth + 1, index);
+    }
+}
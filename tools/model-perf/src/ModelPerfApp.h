@@ -0,0 +1,52 @@
+//
+//  ModelPerfApp.h
+//  tools/model-perf/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ModelPerfApp_h
+#define hifi_ModelPerfApp_h
+
+#include <functional>
+#include <vector>
+
+#include <QCoreApplication>
+
+#include <shared/HifiTypes.h>
+#include <hfm/HFM.h>
+#include <task/Config.h>
+
+// Loads model files a number of times and reports how fast each step goes through them, down to each job of the baker.
+class ModelPerfApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    ModelPerfApp(int argc, char* argv[]);
+    ~ModelPerfApp();
+
+    int getReturnCode() const { return _returnCode; }
+
+private:
+    using ReadModel = std::function<hfm::Model::Pointer()>;
+
+    struct JobTiming {
+        QString name;
+        int depth { 0 };
+        double totalMs { 0.0 };
+        double maxMs { 0.0 };
+    };
+
+    bool benchmarkFile(const QString& filename, int iterations);
+    void reportStep(const QString& step, qint64 size, int iterations, const std::function<void()>& run);
+    void reportBake(const ReadModel& readModel, const hifi::URL& url, int iterations);
+    void accumulateJobTimings(const task::JobConfig* config, int depth, size_t& index);
+
+    std::vector<JobTiming> _jobTimings;
+
+    int _returnCode { 0 };
+};
+
+#endif // hifi_ModelPerfApp_h
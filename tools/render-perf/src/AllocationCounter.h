@@ -0,0 +1,25 @@
+//
+//  AllocationCounter.h
+//  tools/render-perf/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AllocationCounter_h
+#define hifi_AllocationCounter_h
+
+#include <stdint.h>
+
+// Counts the calls to the global operator new and the bytes they ask for, from every thread.
+// The replacement operators are part of the executable, so on Windows the allocations made inside
+// other DLLs are not counted.
+class AllocationCounter {
+public:
+    static uint64_t getAllocationCount();
+    static uint64_t getAllocationSize();
+};
+
+#endif // hifi_AllocationCounter_h
@@ -0,0 +1,320 @@
+//
+//  BenchmarkScene.cpp
+//  tools/render-perf/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BenchmarkScene.h"
+
+#include <algorithm>
+#include <random>
+#include <unordered_set>
+
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QDebug>
+
+#include <GLMHelpers.h>
+#include <NumericalConstants.h>
+#include <Transform.h>
+#include <gpu/Batch.h>
+#include <gpu/Shader.h>
+#include <gpu/State.h>
+#include <shaders/Shaders.h>
+
+static const uint32_t MODEL_PART_VERTICES = 3000;
+static const uint32_t LIGHT_VERTICES = 36;
+static const uint32_t PARTICLES_VERTICES = 6 * 500;
+
+static const float CAMERA_FOV = 45.0f;
+static const float CAMERA_ASPECT_RATIO = 16.0f / 9.0f;
+static const float CAMERA_NEAR_CLIP = 0.1f;
+static const float CAMERA_FAR_CLIP = 1000.0f;
+
+static const float DYNAMIC_AMPLITUDE = 0.5f;
+static const float DYNAMIC_FREQUENCY = 0.05f;
+
+static const char* ENTITY_TYPE_NAMES[BenchmarkScene::NUM_ENTITY_TYPES] = { "model", "light", "particles" };
+
+namespace render {
+    template <> const ItemKey payloadGetKey(const BenchmarkItem::Pointer& item) {
+        return item->key;
+    }
+    template <> const Item::Bound payloadGetBound(const BenchmarkItem::Pointer& item) {
+        return item->bound;
+    }
+    template <> void payloadRender(const BenchmarkItem::Pointer& item, RenderArgs* args) {
+        if (args->_batch && item->numVertices > 0) {
+            Transform transform;
+            transform.setTranslation(item->bound.calcCenter());
+            transform.setScale(item->bound.getDimensions());
+            args->_batch->setModelTransform(transform);
+            args->_batch->draw(gpu::TRIANGLES, item->numVertices);
+        }
+    }
+    template <> const ShapeKey shapeGetShapeKey(const BenchmarkItem::Pointer& item) {
+        return item->shapeKey;
+    }
+    template <> uint32_t metaFetchMetaSubItems(const BenchmarkItem::Pointer& item, ItemIDs& subItems) {
+        subItems.insert(subItems.end(), item->subItems.begin(), item->subItems.end());
+        return (uint32_t)item->subItems.size();
+    }
+}
+
+// Spread the parts over a few material variants, deformed when the model moves
+static render::ShapeKey evalPartShapeKey(int part, bool dynamic) {
+    auto builder = render::ShapeKey::Builder().withMaterial();
+    if (part % 2) {
+        builder.withTangents();
+    }
+    if (part % 3 == 2) {
+        builder.withLightMap();
+    }
+    if (dynamic) {
+        builder.withDeformed();
+    }
+    return builder.build();
+}
+
+static glm::vec3 vec3FromJson(const QJsonValue& value, const glm::vec3& defaultValue) {
+    QJsonArray array = value.toArray();
+    if (array.size() != 3) {
+        return defaultValue;
+    }
+    return glm::vec3((float)array[0].toDouble(), (float)array[1].toDouble(), (float)array[2].toDouble());
+}
+
+static QJsonArray vec3ToJson(const glm::vec3& value) {
+    return QJsonArray({ value.x, value.y, value.z });
+}
+
+bool BenchmarkScene::load(const QString& filename) {
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Failed to open scene" << filename;
+        return false;
+    }
+    QJsonParseError error;
+    QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &error);
+    if (error.error != QJsonParseError::NoError) {
+        qWarning() << "Failed to parse scene" << filename << ":" << error.errorString() << "at offset" << error.offset;
+        return false;
+    }
+    QJsonObject root = document.object();
+
+    QJsonObject camera = root["camera"].toObject();
+    _cameraPosition = vec3FromJson(camera["position"], _cameraPosition);
+    _orbitRadius = (float)camera["orbitRadius"].toDouble(_orbitRadius);
+    _orbitFrames = std::max(1, camera["orbitFrames"].toInt(_orbitFrames));
+
+    _entities.clear();
+    for (const auto& value : root["entities"].toArray()) {
+        QJsonObject object = value.toObject();
+        QString type = object["type"].toString();
+        Entity entity;
+        entity.type = NUM_ENTITY_TYPES;
+        for (int i = 0; i < NUM_ENTITY_TYPES; i++) {
+            if (type == ENTITY_TYPE_NAMES[i]) {
+                entity.type = (EntityType)i;
+            }
+        }
+        if (entity.type == NUM_ENTITY_TYPES) {
+            qWarning() << "Skipping entity of unknown type" << type;
+            continue;
+        }
+        entity.position = vec3FromJson(object["position"], entity.position);
+        entity.dimensions = vec3FromJson(object["dimensions"], entity.dimensions);
+        entity.parts = std::max(1, object["parts"].toInt(entity.parts));
+        entity.dynamic = object["dynamic"].toBool(entity.type == PARTICLES);
+        _entities.push_back(entity);
+    }
+    return true;
+}
+
+bool BenchmarkScene::save(const QString& filename) const {
+    QJsonObject camera;
+    camera["position"] = vec3ToJson(_cameraPosition);
+    camera["orbitRadius"] = _orbitRadius;
+    camera["orbitFrames"] = (int)_orbitFrames;
+
+    QJsonArray entities;
+    for (const auto& entity : _entities) {
+        QJsonObject object;
+        object["type"] = ENTITY_TYPE_NAMES[entity.type];
+        object["position"] = vec3ToJson(entity.position);
+        object["dimensions"] = vec3ToJson(entity.dimensions);
+        if (entity.type == MODEL) {
+            object["parts"] = entity.parts;
+        }
+        object["dynamic"] = entity.dynamic;
+        entities.push_back(object);
+    }
+
+    QJsonObject root;
+    root["camera"] = camera;
+    root["entities"] = entities;
+
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to write scene" << filename;
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson());
+    return true;
+}
+
+void BenchmarkScene::generate(int numModels, int numLights, int numParticles, float size) {
+    const int MAX_MODEL_PARTS = 8;
+    const int DYNAMIC_MODEL_RATIO = 10;
+
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<float> position(-0.5f * size, 0.5f * size);
+    std::uniform_real_distribution<float> extent(0.5f, 10.0f);
+    std::uniform_int_distribution<int> parts(1, MAX_MODEL_PARTS);
+
+    auto randomEntity = [&](EntityType type) {
+        Entity entity;
+        entity.type = type;
+        entity.dimensions = glm::vec3(extent(generator), extent(generator), extent(generator));
+        entity.position = glm::vec3(position(generator), 0.5f * entity.dimensions.y, position(generator));
+        return entity;
+    };
+
+    _entities.clear();
+    for (int i = 0; i < numModels; i++) {
+        Entity entity = randomEntity(MODEL);
+        entity.parts = parts(generator);
+        entity.dynamic = (i % DYNAMIC_MODEL_RATIO) == 0;
+        _entities.push_back(entity);
+    }
+    for (int i = 0; i < numLights; i++) {
+        _entities.push_back(randomEntity(LIGHT));
+    }
+    for (int i = 0; i < numParticles; i++) {
+        Entity entity = randomEntity(PARTICLES);
+        entity.dynamic = true;
+        _entities.push_back(entity);
+    }
+
+    _cameraPosition = glm::vec3(0.0f, 2.0f, 0.0f);
+    _orbitRadius = 0.25f * size;
+}
+
+int BenchmarkScene::getNumEntities(EntityType type) const {
+    return (int)std::count_if(_entities.begin(), _entities.end(), [type](const Entity& entity) { return entity.type == type; });
+}
+
+render::ShapePlumberPointer BenchmarkScene::createShapePlumber() const {
+    std::unordered_set<render::ShapeKey, render::ShapeKey::Hash, render::ShapeKey::KeyEqual> keys;
+    for (const auto& entity : _entities) {
+        if (entity.type == MODEL) {
+            for (int part = 0; part < entity.parts; part++) {
+                keys.insert(evalPartShapeKey(part, entity.dynamic));
+            }
+        }
+    }
+
+    auto shapePlumber = std::make_shared<render::ShapePlumber>();
+    gpu::ShaderPointer program = gpu::Shader::createProgram(shader::render::program::drawItemBounds);
+    auto state = std::make_shared<gpu::State>();
+    state->setDepthTest(true, true, gpu::LESS_EQUAL);
+    for (const auto& key : keys) {
+        shapePlumber->addPipeline(key, program, state);
+    }
+    return shapePlumber;
+}
+
+void BenchmarkScene::addToScene(const render::ScenePointer& scene) {
+    render::Transaction transaction;
+    auto addItem = [&](const BenchmarkItem& item, bool dynamic) {
+        render::ItemID id = scene->allocateID();
+        transaction.resetItem(id, std::make_shared<BenchmarkItem::Payload>(std::make_shared<BenchmarkItem>(item)));
+        _items.push_back(id);
+        if (dynamic) {
+            float phase = (float)(_dynamicItems.size() % 97);
+            _dynamicItems.push_back({ id, item.bound.getCorner(), phase });
+        }
+        return id;
+    };
+
+    for (const auto& entity : _entities) {
+        AABox bound(entity.position - 0.5f * entity.dimensions, entity.dimensions);
+
+        BenchmarkItem item;
+        item.bound = bound;
+        switch (entity.type) {
+            case MODEL: {
+                // Slice the model along x, one part per slice
+                glm::vec3 partDimensions = entity.dimensions * glm::vec3(1.0f / entity.parts, 1.0f, 1.0f);
+                auto partKey = render::ItemKey::Builder::opaqueShape().withTagBits(render::ItemKey::TAG_BITS_0)
+                    .withShadowCaster().withSubMetaCulled();
+                if (entity.dynamic) {
+                    partKey.withDynamic().withDeformed();
+                }
+                for (int part = 0; part < entity.parts; part++) {
+                    BenchmarkItem partItem;
+                    partItem.key = partKey.build();
+                    partItem.shapeKey = evalPartShapeKey(part, entity.dynamic);
+                    partItem.bound = AABox(bound.getCorner() + glm::vec3(part * partDimensions.x, 0.0f, 0.0f), partDimensions);
+                    partItem.numVertices = MODEL_PART_VERTICES;
+                    item.subItems.push_back(addItem(partItem, entity.dynamic));
+                }
+                auto metaKey = render::ItemKey::Builder().withTypeMeta().withTagBits(render::ItemKey::TAG_BITS_0)
+                    .withMetaCullGroup();
+                if (entity.dynamic) {
+                    metaKey.withDynamic();
+                }
+                item.key = metaKey.build();
+                break;
+            }
+            case LIGHT:
+                item.key = render::ItemKey::Builder::light().withTagBits(render::ItemKey::TAG_BITS_0).build();
+                item.numVertices = LIGHT_VERTICES;
+                break;
+            case PARTICLES:
+                item.key = render::ItemKey::Builder::transparentShape().withTagBits(render::ItemKey::TAG_BITS_0)
+                    .withDynamic().build();
+                item.numVertices = PARTICLES_VERTICES;
+                break;
+            default:
+                continue;
+        }
+        addItem(item, entity.dynamic);
+    }
+
+    scene->enqueueTransaction(transaction);
+}
+
+void BenchmarkScene::update(const render::ScenePointer& scene, uint32_t frame) {
+    if (_dynamicItems.empty()) {
+        return;
+    }
+
+    render::Transaction transaction;
+    for (const auto& dynamicItem : _dynamicItems) {
+        glm::vec3 corner = dynamicItem.position;
+        corner.y += DYNAMIC_AMPLITUDE * sinf(DYNAMIC_FREQUENCY * (float)frame + dynamicItem.phase);
+        transaction.updateItemConcurrently<BenchmarkItem>(dynamicItem.id, [corner](BenchmarkItem& item) {
+            item.bound.setBox(corner, item.bound.getDimensions());
+        });
+    }
+    scene->enqueueTransaction(transaction);
+}
+
+ViewFrustum BenchmarkScene::evalViewFrustum(uint32_t frame) const {
+    float angle = TWO_PI * (float)(frame % _orbitFrames) / (float)_orbitFrames;
+    glm::quat orientation = glm::angleAxis(angle, Vectors::UNIT_Y);
+
+    ViewFrustum viewFrustum;
+    viewFrustum.setProjection(CAMERA_FOV, CAMERA_ASPECT_RATIO, CAMERA_NEAR_CLIP, CAMERA_FAR_CLIP);
+    viewFrustum.setPosition(_cameraPosition + _orbitRadius * glm::vec3(sinf(angle), 0.0f, cosf(angle)));
+    viewFrustum.setOrientation(orientation);
+    viewFrustum.calculate();
+    return viewFrustum;
+}
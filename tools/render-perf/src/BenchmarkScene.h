@@ -0,0 +1,109 @@
+//
+//  BenchmarkScene.h
+//  tools/render-perf/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BenchmarkScene_h
+#define hifi_BenchmarkScene_h
+
+#include <vector>
+
+#include <QtCore/QString>
+
+#include <ViewFrustum.h>
+#include <render/Scene.h>
+#include <render/ShapePipeline.h>
+
+// The render item of every benchmark entry: models are a meta item grouping one shape item per part,
+// lights are light items and particle systems are transparent shape items.
+// Rendering records a transform and a draw call, which is all the null backend needs.
+class BenchmarkItem {
+public:
+    using Payload = render::Payload<BenchmarkItem>;
+    using Pointer = Payload::DataPointer;
+
+    render::ItemKey key;
+    render::ShapeKey shapeKey { render::ShapeKey::Builder::ownPipeline() };
+    AABox bound;
+    uint32_t numVertices { 0 };
+    render::ItemIDs subItems;
+};
+
+namespace render {
+    template <> const ItemKey payloadGetKey(const BenchmarkItem::Pointer& item);
+    template <> const Item::Bound payloadGetBound(const BenchmarkItem::Pointer& item);
+    template <> void payloadRender(const BenchmarkItem::Pointer& item, RenderArgs* args);
+    template <> const ShapeKey shapeGetShapeKey(const BenchmarkItem::Pointer& item);
+    template <> uint32_t metaFetchMetaSubItems(const BenchmarkItem::Pointer& item, ItemIDs& subItems);
+}
+
+// A recorded scene of models, lights and particle systems, and the camera path to render it from.
+//
+// The JSON format is:
+// {
+//     "camera": { "position": [x, y, z], "orbitRadius": r, "orbitFrames": n },
+//     "entities": [
+//         { "type": "model", "position": [x, y, z], "dimensions": [x, y, z], "parts": n, "dynamic": false },
+//         { "type": "light", "position": [x, y, z], "dimensions": [x, y, z] },
+//         { "type": "particles", "position": [x, y, z], "dimensions": [x, y, z] }
+//     ]
+// }
+//
+// Dynamic models and particle systems move every frame, so every frame carries a transaction.
+class BenchmarkScene {
+public:
+    enum EntityType {
+        MODEL = 0,
+        LIGHT,
+        PARTICLES,
+
+        NUM_ENTITY_TYPES
+    };
+
+    struct Entity {
+        EntityType type { MODEL };
+        glm::vec3 position;
+        glm::vec3 dimensions { 1.0f };
+        int parts { 1 };
+        bool dynamic { false };
+    };
+
+    bool load(const QString& filename);
+    bool save(const QString& filename) const;
+
+    // Scatters entities over a size x size square, always the same ones for the same arguments
+    void generate(int numModels, int numLights, int numParticles, float size);
+
+    int getNumEntities(EntityType type) const;
+    int getNumItems() const { return (int)_items.size(); }
+
+    // One pipeline per shape key in use, so the draw jobs go through the regular pipeline selection
+    render::ShapePlumberPointer createShapePlumber() const;
+
+    void addToScene(const render::ScenePointer& scene);
+    void update(const render::ScenePointer& scene, uint32_t frame);
+
+    ViewFrustum evalViewFrustum(uint32_t frame) const;
+
+private:
+    struct DynamicItem {
+        render::ItemID id;
+        glm::vec3 position;
+        float phase;
+    };
+
+    std::vector<Entity> _entities;
+    glm::vec3 _cameraPosition { 0.0f, 2.0f, 0.0f };
+    float _orbitRadius { 0.0f };
+    uint32_t _orbitFrames { 600 };
+
+    render::ItemIDs _items;
+    std::vector<DynamicItem> _dynamicItems;
+};
+
+#endif // hifi_BenchmarkScene_h
@@ -0,0 +1,90 @@
+//
+//  BenchmarkTask.cpp
+//  tools/render-perf/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BenchmarkTask.h"
+
+#include <gpu/Context.h>
+#include <render/DrawTask.h>
+#include <render/HighlightStage.h>
+#include <render/SceneTask.h>
+#include <render/SortTask.h>
+#include <render/TransitionStage.h>
+
+using namespace render;
+
+void UpdateBenchmarkSceneTask::build(JobModel& task, const Varying& input, Varying& output) {
+    task.addJob<TransitionStageSetup>("TransitionStageSetup");
+    task.addJob<HighlightStageSetup>("HighlightStageSetup");
+
+    task.addJob<PerformSceneTransaction>("PerformSceneTransaction");
+}
+
+static void setupCamera(RenderArgs* args, gpu::Batch& batch) {
+    glm::mat4 projMat;
+    Transform viewMat;
+    args->getViewFrustum().evalProjectionMatrix(projMat);
+    args->getViewFrustum().evalViewTransform(viewMat);
+
+    batch.setViewportTransform(args->_viewport);
+    batch.setStateScissorRect(args->_viewport);
+    batch.setProjectionTransform(projMat);
+    batch.setViewTransform(viewMat);
+}
+
+void DrawBenchmarkShapes::run(const RenderContextPointer& renderContext, const ItemBounds& inItems) {
+    assert(renderContext->args);
+    assert(renderContext->args->hasViewFrustum());
+    RenderArgs* args = renderContext->args;
+
+    gpu::doInBatch("DrawBenchmarkShapes::run", args->_context, [&](gpu::Batch& batch) {
+        args->_batch = &batch;
+        setupCamera(args, batch);
+        if (_stateSort) {
+            renderStateSortShapes(renderContext, _shapePlumber, inItems);
+        } else {
+            renderShapes(renderContext, _shapePlumber, inItems);
+        }
+        args->_batch = nullptr;
+    });
+}
+
+void DrawBenchmarkSortedShapes::run(const RenderContextPointer& renderContext, const ShapeBounds& inShapes) {
+    assert(renderContext->args);
+    assert(renderContext->args->hasViewFrustum());
+    RenderArgs* args = renderContext->args;
+
+    gpu::doInBatch("DrawBenchmarkSortedShapes::run", args->_context, [&](gpu::Batch& batch) {
+        args->_batch = &batch;
+        setupCamera(args, batch);
+        for (const auto& items : inShapes) {
+            renderShapes(renderContext, _shapePlumber, items.second, -1, items.first);
+        }
+        args->_batch = nullptr;
+    });
+}
+
+void RenderBenchmarkTask::build(JobModel& task, const Varying& input, Varying& output,
+        const ShapePlumberPointer& shapePlumber, CullFunctor cullFunctor) {
+    const auto items = task.addJob<RenderFetchCullSortTask>("FetchCullSort", cullFunctor,
+        ItemKey::TAG_BITS_0, ItemKey::TAG_BITS_0);
+    const auto buckets = items.getN<RenderFetchCullSortTask::Output>(0);
+    const auto opaques = buckets.getN<RenderFetchCullSortTask::BucketList>(RenderFetchCullSortTask::OPAQUE_SHAPE);
+    const auto transparents = buckets.getN<RenderFetchCullSortTask::BucketList>(RenderFetchCullSortTask::TRANSPARENT_SHAPE);
+    const auto lights = buckets.getN<RenderFetchCullSortTask::BucketList>(RenderFetchCullSortTask::LIGHT);
+
+    task.addJob<DrawBenchmarkShapes>("DrawOpaqueDeferred", opaques, shapePlumber, true);
+    task.addJob<DrawLight>("DrawLight", lights);
+    task.addJob<DrawBenchmarkShapes>("DrawTransparentDeferred", transparents, shapePlumber, false);
+
+    // The shadow casters are sorted by pipeline then by depth before being drawn
+    const auto sortedPipelines = task.addJob<PipelineSortShapes>("PipelineSortShadow", opaques);
+    const auto sortedShapes = task.addJob<DepthSortShapes>("DepthSortShadow", sortedPipelines);
+    task.addJob<DrawBenchmarkSortedShapes>("DrawShadow", sortedShapes, shapePlumber);
+}
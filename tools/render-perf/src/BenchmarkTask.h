@@ -0,0 +1,64 @@
+//
+//  BenchmarkTask.h
+//  tools/render-perf/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BenchmarkTask_h
+#define hifi_BenchmarkTask_h
+
+#include <render/Engine.h>
+#include <render/RenderFetchCullSortTask.h>
+#include <render/ShapePipeline.h>
+
+// The stage setup and scene transactions of UpdateSceneTask that live in the render library
+class UpdateBenchmarkSceneTask {
+public:
+    using JobModel = render::Task::Model<UpdateBenchmarkSceneTask>;
+
+    void build(JobModel& task, const render::Varying& inputs, render::Varying& outputs);
+};
+
+// Records the shapes of a bucket into a batch, the way the deferred draw jobs do
+class DrawBenchmarkShapes {
+public:
+    using JobModel = render::Job::ModelI<DrawBenchmarkShapes, render::ItemBounds>;
+
+    DrawBenchmarkShapes(const render::ShapePlumberPointer& shapePlumber, bool stateSort) :
+        _shapePlumber(shapePlumber), _stateSort(stateSort) {}
+
+    void run(const render::RenderContextPointer& renderContext, const render::ItemBounds& inItems);
+
+protected:
+    render::ShapePlumberPointer _shapePlumber;
+    bool _stateSort;
+};
+
+// Records pipeline sorted shapes into a batch, the way the shadow cascades are drawn
+class DrawBenchmarkSortedShapes {
+public:
+    using JobModel = render::Job::ModelI<DrawBenchmarkSortedShapes, render::ShapeBounds>;
+
+    DrawBenchmarkSortedShapes(const render::ShapePlumberPointer& shapePlumber) : _shapePlumber(shapePlumber) {}
+
+    void run(const render::RenderContextPointer& renderContext, const render::ShapeBounds& inShapes);
+
+protected:
+    render::ShapePlumberPointer _shapePlumber;
+};
+
+// The CPU side of RenderDeferredTask: fetch, cull and sort the scene, then record the opaque, transparent,
+// light and shadow caster batches.  The GPU side effects (framebuffers, lighting, post processing) are left out.
+class RenderBenchmarkTask {
+public:
+    using JobModel = render::Task::Model<RenderBenchmarkTask>;
+
+    void build(JobModel& task, const render::Varying& inputs, render::Varying& outputs,
+        const render::ShapePlumberPointer& shapePlumber, render::CullFunctor cullFunctor);
+};
+
+#endif // hifi_BenchmarkTask_h
@@ -0,0 +1,225 @@
+//
+//  RenderPerfApp.cpp
+//  tools/render-perf/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "RenderPerfApp.h"
+
+#include <algorithm>
+
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QDebug>
+
+#include <OctreeConstants.h>
+#include <gpu/Context.h>
+#include <gpu/Frame.h>
+#include <gpu/null/NullBackend.h>
+#include <render/Engine.h>
+
+#include "AllocationCounter.h"
+#include "BenchmarkTask.h"
+
+static const int DEFAULT_NUM_MODELS = 2000;
+static const int DEFAULT_NUM_LIGHTS = 200;
+static const int DEFAULT_NUM_PARTICLES = 300;
+static const float DEFAULT_SCENE_SIZE = 400.0f;
+static const uint32_t DEFAULT_NUM_FRAMES = 600;
+static const uint32_t DEFAULT_NUM_WARMUP_FRAMES = 60;
+
+static const glm::ivec4 VIEWPORT { 0, 0, 1920, 1080 };
+
+// Same as LODManager::shouldRender() at the default LOD
+static bool shouldRender(const RenderArgs* args, const AABox& bounds) {
+    auto pos = args->getViewFrustum().getPosition() - bounds.calcCenter();
+    auto halfTanAdjacentSq = glm::dot(pos, pos);
+    auto dim = bounds.getDimensions();
+    auto halfTanOppositeSq = 0.25f * glm::dot(dim, dim);
+    return (halfTanOppositeSq >= args->_lodAngleHalfTanSq * halfTanAdjacentSq);
+}
+
+RenderPerfApp::RenderPerfApp(int argc, char* argv[]) : QCoreApplication(argc, argv) {
+    QCommandLineParser parser;
+    parser.setApplicationDescription("High Fidelity Render Engine CPU Benchmark");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption sceneOption("scene", "recorded scene to render, a synthetic scene is generated otherwise", "scene.json");
+    parser.addOption(sceneOption);
+    const QCommandLineOption saveOption("save", "save the scene before rendering it", "scene.json");
+    parser.addOption(saveOption);
+    const QCommandLineOption modelsOption("models", "number of models in the synthetic scene", "count",
+        QString::number(DEFAULT_NUM_MODELS));
+    parser.addOption(modelsOption);
+    const QCommandLineOption lightsOption("lights", "number of lights in the synthetic scene", "count",
+        QString::number(DEFAULT_NUM_LIGHTS));
+    parser.addOption(lightsOption);
+    const QCommandLineOption particlesOption("particles", "number of particle systems in the synthetic scene", "count",
+        QString::number(DEFAULT_NUM_PARTICLES));
+    parser.addOption(particlesOption);
+    const QCommandLineOption sizeOption("size", "size in meters of the synthetic scene", "meters",
+        QString::number(DEFAULT_SCENE_SIZE));
+    parser.addOption(sizeOption);
+    const QCommandLineOption framesOption("frames", "number of measured frames", "count",
+        QString::number(DEFAULT_NUM_FRAMES));
+    parser.addOption(framesOption);
+    const QCommandLineOption warmupOption("warmup", "number of frames rendered before measuring", "count",
+        QString::number(DEFAULT_NUM_WARMUP_FRAMES));
+    parser.addOption(warmupOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        return;
+    }
+
+    BenchmarkScene scene;
+    if (parser.isSet(sceneOption)) {
+        if (!scene.load(parser.value(sceneOption))) {
+            _returnCode = 2;
+            return;
+        }
+    } else {
+        scene.generate(parser.value(modelsOption).toInt(), parser.value(lightsOption).toInt(),
+            parser.value(particlesOption).toInt(), parser.value(sizeOption).toFloat());
+    }
+
+    if (parser.isSet(saveOption) && !scene.save(parser.value(saveOption))) {
+        _returnCode = 2;
+        return;
+    }
+
+    uint32_t frames = std::max(1, parser.value(framesOption).toInt());
+    uint32_t warmupFrames = std::max(0, parser.value(warmupOption).toInt());
+    runBenchmark(scene, warmupFrames, frames);
+}
+
+RenderPerfApp::~RenderPerfApp() {
+}
+
+void RenderPerfApp::runBenchmark(BenchmarkScene& scene, uint32_t warmupFrames, uint32_t frames) {
+    gpu::Context::init<gpu::null::Backend>();
+    auto gpuContext = std::make_shared<gpu::Context>();
+
+    auto renderScene = std::make_shared<render::Scene>(glm::vec3(-0.5f * (float)TREE_SCALE), (float)TREE_SCALE);
+    auto renderEngine = std::make_shared<render::RenderEngine>();
+    renderEngine->addJob<UpdateBenchmarkSceneTask>("UpdateScene");
+    renderEngine->addJob<RenderBenchmarkTask>("RenderMainView", scene.createShapePlumber(), shouldRender);
+    renderEngine->registerScene(renderScene);
+
+    RenderArgs args(gpuContext);
+    args._viewport = VIEWPORT;
+    renderEngine->getRenderContext()->args = &args;
+
+    scene.addToScene(renderScene);
+
+    const uint32_t totalFrames = warmupFrames + frames;
+    QElapsedTimer timer;
+    qint64 totalNsecs = 0;
+    for (uint32_t frame = 0; frame <= totalFrames; frame++) {
+        gpuContext->beginFrame();
+
+        // The batch arena stats are those of the frame before
+        if (frame > warmupFrames) {
+            _frameStats.batchAllocationCount += gpu::Context::getFrameBatchAllocationCount();
+            _frameStats.batchAllocationSize += gpu::Context::getFrameBatchAllocationSize();
+        }
+        if (frame == totalFrames) {
+            gpuContext->endFrame();
+            break;
+        }
+
+        uint64_t heapAllocationCount = AllocationCounter::getAllocationCount();
+        uint64_t heapAllocationSize = AllocationCounter::getAllocationSize();
+        timer.start();
+
+        scene.update(renderScene, frame);
+        renderScene->enqueueFrame();
+        args.setViewFrustum(scene.evalViewFrustum(frame));
+        renderEngine->run();
+        auto gpuFrame = gpuContext->endFrame();
+        gpuContext->executeFrame(gpuFrame);
+
+        if (frame < warmupFrames) {
+            continue;
+        }
+
+        totalNsecs += timer.nsecsElapsed();
+        _frameStats.heapAllocationCount += AllocationCounter::getAllocationCount() - heapAllocationCount;
+        _frameStats.heapAllocationSize += AllocationCounter::getAllocationSize() - heapAllocationSize;
+        _frameStats.batchCount += gpuFrame->batches.size();
+        for (const auto& batch : gpuFrame->batches) {
+            _frameStats.commandCount += batch->getCommands().size();
+        }
+
+        const auto& transactionStats = renderScene->getTransactionStats();
+        _frameStats.itemUpdateCount += transactionStats.numUpdates;
+        _frameStats.concurrentItemUpdateCount += transactionStats.numConcurrentUpdates;
+
+        size_t index = 0;
+        accumulateJobTimings(renderEngine->getConfiguration().get(), 0, index);
+    }
+
+    report(scene, frames, (double)totalNsecs / 1.0e6);
+
+    renderEngine->getRenderContext()->args = nullptr;
+}
+
+void RenderPerfApp::accumulateJobTimings(const task::JobConfig* config, int depth, size_t& index) {
+    if (index == _jobTimings.size()) {
+        JobTiming timing;
+        timing.name = config->objectName();
+        timing.depth = depth;
+        _jobTimings.push_back(timing);
+    }
+    JobTiming& timing = _jobTimings[index++];
+    double ms = config->getCPURunTime();
+    timing.totalMs += ms;
+    timing.maxMs = std::max(timing.maxMs, ms);
+
+    for (auto subConfig : config->getSubConfigs()) {
+        accumulateJobTimings(static_cast<const task::JobConfig*>(subConfig), depth + 1, index);
+    }
+}
+
+void RenderPerfApp::report(const BenchmarkScene& scene, uint32_t frames, double totalMs) const {
+    qInfo().noquote() << QString("%1 models, %2 lights, %3 particle systems, %4 render items, %5 frames")
+        .arg(scene.getNumEntities(BenchmarkScene::MODEL))
+        .arg(scene.getNumEntities(BenchmarkScene::LIGHT))
+        .arg(scene.getNumEntities(BenchmarkScene::PARTICLES))
+        .arg(scene.getNumItems())
+        .arg(frames);
+    qInfo().noquote() << QString("frame: %1 ms").arg(totalMs / frames, 0, 'f', 3);
+
+    qInfo().noquote() << QString("%1 %2 %3").arg("job", -48).arg("avg ms", 10).arg("max ms", 10);
+    for (const auto& timing : _jobTimings) {
+        QString name = QString(2 * timing.depth, ' ') + timing.name;
+        qInfo().noquote() << QString("%1 %2 %3").arg(name, -48)
+            .arg(timing.totalMs / frames, 10, 'f', 3)
+            .arg(timing.maxMs, 10, 'f', 3);
+    }
+
+    qInfo().noquote() << "per frame:";
+    qInfo().noquote() << QString("  heap allocations: %1 (%2 KB)")
+        .arg(_frameStats.heapAllocationCount / frames)
+        .arg(_frameStats.heapAllocationSize / frames / 1024);
+    qInfo().noquote() << QString("  batch allocations: %1 (%2 KB)")
+        .arg(_frameStats.batchAllocationCount / frames)
+        .arg(_frameStats.batchAllocationSize / frames / 1024);
+    qInfo().noquote() << QString("  batches: %1, commands: %2")
+        .arg(_frameStats.batchCount / frames)
+        .arg(_frameStats.commandCount / frames);
+    qInfo().noquote() << QString("  item updates: %1, concurrent: %2")
+        .arg(_frameStats.itemUpdateCount / frames)
+        .arg(_frameStats.concurrentItemUpdateCount / frames);
+}
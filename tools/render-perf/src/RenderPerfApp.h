@@ -0,0 +1,60 @@
+//
+//  RenderPerfApp.h
+//  tools/render-perf/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_RenderPerfApp_h
+#define hifi_RenderPerfApp_h
+
+#include <vector>
+
+#include <QCoreApplication>
+
+#include <task/Config.h>
+
+#include "BenchmarkScene.h"
+
+// Runs the CPU side of the render engine over a recorded scene for a number of frames on the null gpu backend,
+// then reports the average time spent in each job and the allocations made per frame.
+class RenderPerfApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    RenderPerfApp(int argc, char* argv[]);
+    ~RenderPerfApp();
+
+    int getReturnCode() const { return _returnCode; }
+
+private:
+    struct JobTiming {
+        QString name;
+        int depth { 0 };
+        double totalMs { 0.0 };
+        double maxMs { 0.0 };
+    };
+
+    struct FrameStats {
+        uint64_t heapAllocationCount { 0 };
+        uint64_t heapAllocationSize { 0 };
+        uint64_t batchAllocationCount { 0 };
+        uint64_t batchAllocationSize { 0 };
+        uint64_t batchCount { 0 };
+        uint64_t commandCount { 0 };
+        uint64_t itemUpdateCount { 0 };
+        uint64_t concurrentItemUpdateCount { 0 };
+    };
+
+    void runBenchmark(BenchmarkScene& scene, uint32_t warmupFrames, uint32_t frames);
+    void accumulateJobTimings(const task::JobConfig* config, int depth, size_t& index);
+    void report(const BenchmarkScene& scene, uint32_t frames, double totalMs) const;
+
+    std::vector<JobTiming> _jobTimings;
+    FrameStats _frameStats;
+    int _returnCode { 0 };
+};
+
+#endif // hifi_RenderPerfApp_h
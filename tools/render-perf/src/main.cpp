@@ -0,0 +1,20 @@
+//
+//  main.cpp
+//  tools/render-perf/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <SharedUtil.h>
+
+#include "RenderPerfApp.h"
+
+int main(int argc, char* argv[]) {
+    setupHifiApplication("Render Perf");
+
+    RenderPerfApp app(argc, argv);
+    return app.getReturnCode();
+}